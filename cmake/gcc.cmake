@@ -22,5 +22,9 @@
 ## DEALINGS IN THE SOFTWARE.                                                  ##
 ## ========================================================================== ##
 
-SET(CMAKE_CXX_FLAGS "-std=c++11 -march=native ${CMAKE_CXX_FLAGS}")
+SET(CMAKE_CXX_FLAGS "-std=c++11 ${CMAKE_CXX_FLAGS}")
+
+IF (PSIMD_BUILD_NATIVE)
+  SET(CMAKE_CXX_FLAGS "-march=native ${CMAKE_CXX_FLAGS}")
+ENDIF()
 
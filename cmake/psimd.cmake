@@ -50,6 +50,10 @@ endmacro()
 ## Compiler configuration macro ##
 
 macro(psimd_configure_compiler)
+  # NOTE: turn off to build binaries which run on any x86-64 host,
+  #       relying on psimd/dispatch.h to select wider ISAs at runtime
+  option(PSIMD_BUILD_NATIVE "Compile for the ISA of the build machine" ON)
+
   if(${CMAKE_CXX_COMPILER_ID} STREQUAL "Intel")
     include(cmake/icc.cmake)
   elseif(${CMAKE_CXX_COMPILER_ID} STREQUAL "GNU")
@@ -72,3 +76,46 @@ macro(psimd_configure_compiler)
         "${CMAKE_EXE_LINKER_FLAGS} ${OpenMP_EXE_LINKER_FLAGS}")
   endif()
 endmacro()
+
+## Runtime ISA dispatch macro ##
+
+# Compile each of the given kernel sources once per dispatch target (see
+# psimd/dispatch.h), returning the per-target sources in <var> to be added to
+# an executable or library
+macro(psimd_dispatch_sources var)
+  set(${var} "")
+
+  if(${CMAKE_CXX_COMPILER_ID} STREQUAL "MSVC")
+    set(PSIMD_DISPATCH_FLAGS_generic "")
+    set(PSIMD_DISPATCH_FLAGS_sse42   "")
+    set(PSIMD_DISPATCH_FLAGS_avx2    "/arch:AVX2")
+    set(PSIMD_DISPATCH_FLAGS_avx512  "/arch:AVX512")
+  else()
+    # NOTE: every variant starts over from baseline x86-64, as the last
+    #       -march wins over the -march=native of PSIMD_BUILD_NATIVE (and
+    #       any other -march in CMAKE_CXX_FLAGS)
+    set(PSIMD_DISPATCH_FLAGS_generic "-march=x86-64")
+    set(PSIMD_DISPATCH_FLAGS_sse42
+        "${PSIMD_DISPATCH_FLAGS_generic} -msse4.2 -mpopcnt")
+    set(PSIMD_DISPATCH_FLAGS_avx2
+        "${PSIMD_DISPATCH_FLAGS_generic} -mavx2 -mfma -mf16c -mbmi -mbmi2 -mlzcnt")
+    set(PSIMD_DISPATCH_FLAGS_avx512
+        "${PSIMD_DISPATCH_FLAGS_avx2} -mavx512f -mavx512cd -mavx512bw -mavx512dq -mavx512vl")
+  endif()
+
+  foreach(src ${ARGN})
+    get_filename_component(src_name ${src} NAME_WE)
+    get_filename_component(src_path ${src} ABSOLUTE)
+    foreach(isa generic sse42 avx2 avx512)
+      set(isa_src ${CMAKE_CURRENT_BINARY_DIR}/${src_name}_${isa}.cpp)
+      file(WRITE ${isa_src}.in "#include \"${src_path}\"\n")
+      configure_file(${isa_src}.in ${isa_src} COPYONLY)
+      set_source_files_properties(${isa_src} PROPERTIES
+        COMPILE_FLAGS "${PSIMD_DISPATCH_FLAGS_${isa}}"
+        COMPILE_DEFINITIONS PSIMD_DISPATCH_ISA=${isa}
+        OBJECT_DEPENDS ${src_path}
+      )
+      list(APPEND ${var} ${isa_src})
+    endforeach()
+  endforeach()
+endmacro()
@@ -0,0 +1,97 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../mandelbrot/pico_bench.h"
+
+#include "psimd/psimd.h"
+
+// Stream compaction of floats below a threshold with psimd::copy_if() (one
+// compress_store() per pack) vs. std::copy_if(), whose data dependent
+// branch mispredicts most at selectivities near 50%
+
+static const int num_values = 1 << 20;
+
+using vfloat = psimd::pack<float>;
+
+template <typename FCN>
+float bench(FCN &&fcn)
+{
+  using namespace std::chrono;
+
+  auto bencher = pico_bench::Benchmarker<microseconds>{64, seconds{1}};
+
+  auto stats = bencher(fcn);
+
+  return stats.min().count();
+}
+
+int main()
+{
+  std::cout << "starting benchmarks (pack<float>, " << vfloat::static_size
+            << " lanes, " << num_values << " values)... " << '\n';
+
+  std::vector<float> in(num_values), out(num_values);
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> dist(0.f, 1.f);
+  for (auto &v : in)
+    v = dist(rng);
+
+  for (float selectivity : {0.1f, 0.5f, 0.9f}) {
+    size_t std_count = 0, psimd_count = 0;
+
+    const vfloat threshold(selectivity);
+
+    const float std_time = bench([&](){
+      auto end = std::copy_if(in.begin(), in.end(), out.begin(),
+                              [=](float v) { return v < selectivity; });
+      std_count = end - out.begin();
+    });
+
+    const float psimd_time = bench([&](){
+      float *end = psimd::copy_if(in.data(), in.data() + in.size(),
+                                  out.data(),
+                                  [=](const vfloat &v) {
+                                    return v < threshold;
+                                  });
+      psimd_count = end - out.data();
+    });
+
+    std::cout << int(100 * selectivity) << "% selected: std::copy_if() "
+              << std_time << " us, psimd::copy_if() " << psimd_time
+              << " us --> " << std_time / psimd_time << "x" << '\n';
+
+    if (std_count != psimd_count)
+      std::cout << "  (count mismatch: " << std_count << " vs. "
+                << psimd_count << ")" << '\n';
+  }
+
+  return 0;
+}
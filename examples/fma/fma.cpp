@@ -0,0 +1,124 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+#include <iostream>
+#include <vector>
+
+#include "../mandelbrot/pico_bench.h"
+
+#include "psimd/psimd.h"
+
+// Throughput of psimd::fma() vs. separate multiply and add: several
+// independent accumulator chains per iteration, so the loop is bound by
+// instruction throughput rather than by the latency of a single chain
+
+using vfloat = psimd::pack<float>;
+
+static const int num_chains = 8;
+static const int iterations = 1 << 22;
+
+inline float sum_lanes(const vfloat &v)
+{
+  float result = 0.f;
+  for (int i = 0; i < vfloat::static_size; ++i)
+    result += v[i];
+  return result;
+}
+
+float mul_add(float a, float b)
+{
+  vfloat acc[num_chains];
+  for (auto &v : acc)
+    v = vfloat(0.f);
+
+  const vfloat va(a), vb(b);
+
+  for (int i = 0; i < iterations; ++i) {
+    for (auto &v : acc) {
+      vfloat p = v * va;
+      v = p + vb;
+    }
+  }
+
+  float result = 0.f;
+  for (auto &v : acc)
+    result += sum_lanes(v);
+  return result;
+}
+
+float fused(float a, float b)
+{
+  vfloat acc[num_chains];
+  for (auto &v : acc)
+    v = vfloat(0.f);
+
+  const vfloat va(a), vb(b);
+
+  for (int i = 0; i < iterations; ++i) {
+    for (auto &v : acc)
+      v = psimd::fma(v, va, vb);
+  }
+
+  float result = 0.f;
+  for (auto &v : acc)
+    result += sum_lanes(v);
+  return result;
+}
+
+int main()
+{
+  using namespace std::chrono;
+
+  auto bencher = pico_bench::Benchmarker<microseconds>{16, seconds{4}};
+
+  // NOTE: inputs and results go through volatiles so the loops are neither
+  //       constant folded nor optimized away
+  volatile float a = 0.5f, b = 1.f;
+  volatile float sink = 0.f;
+
+  std::cout << "starting benchmarks (results in 'us')... " << '\n';
+
+  auto stats = bencher([&](){ sink = mul_add(a, b); });
+  const float mul_add_min = stats.min().count();
+  std::cout << '\n' << "a * b + c " << stats << '\n';
+
+  stats = bencher([&](){ sink = fused(a, b); });
+  const float fused_min = stats.min().count();
+  std::cout << '\n' << "fma(a, b, c) " << stats << '\n';
+
+  const double flops = 2.0 * num_chains * vfloat::static_size * iterations;
+
+  std::cout << '\n' << "Conclusions: " << '\n';
+
+  std::cout << '\n' << "--> a * b + c: " << flops / (mul_add_min * 1e3)
+            << " GFLOP/s" << '\n';
+
+  std::cout << '\n' << "--> fma(a, b, c): " << flops / (fused_min * 1e3)
+            << " GFLOP/s" << '\n';
+
+  std::cout << '\n' << "--> fma() was " << mul_add_min / fused_min
+            << "x the speed of a * b + c" << '\n';
+
+  return 0;
+}
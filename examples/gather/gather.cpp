@@ -0,0 +1,170 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+
+
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../mandelbrot/pico_bench.h"
+
+#include "psimd/psimd.h"
+
+// Table lookups through per-lane loops (gather() and scatter() before they
+// lowered to vgatherdps/vscatterdps) vs. gather<vfloat, 4>() with 32 and 64
+// bit offsets and scatter<4>(), for random and sequential indices into a
+// table which fits in L2
+
+static const int table_size  = 1 << 16;
+static const int num_lookups = 1 << 20;
+
+using vfloat = psimd::pack<float>;
+using vint   = psimd::pack<int>;
+using vllong = psimd::pack<long long, vfloat::static_size>;
+
+static const int width = vfloat::static_size;
+
+template <typename FCN>
+float bench(FCN &&fcn)
+{
+  using namespace std::chrono;
+
+  auto bencher = pico_bench::Benchmarker<microseconds>{64, seconds{1}};
+
+  auto stats = bencher(fcn);
+
+  return stats.min().count();
+}
+
+template <typename OFFSET_T>
+vfloat gather_lanes(const float *table, const OFFSET_T *indices)
+{
+  vfloat result;
+
+  for (int i = 0; i < width; ++i)
+    result[i] = table[indices[i]];
+
+  return result;
+}
+
+void scatter_lanes(const vfloat &p, float *table, const int *indices)
+{
+  for (int i = 0; i < width; ++i)
+    table[indices[i]] = p[i];
+}
+
+int main()
+{
+  std::cout << "starting benchmarks (pack<float>, " << width << " lanes, "
+            << num_lookups << " lookups into " << table_size
+            << " floats)... " << '\n';
+
+  std::vector<float> table(table_size);
+  std::iota(table.begin(), table.end(), 0.f);
+
+  std::vector<float> out(table_size);
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> dist(0, table_size - 1);
+
+  std::vector<int> random(num_lookups), sequential(num_lookups);
+  for (int i = 0; i < num_lookups; ++i) {
+    random[i]     = dist(rng);
+    sequential[i] = i % table_size;
+  }
+
+  for (auto *pattern : {&random, &sequential}) {
+    const std::vector<int> &indices = *pattern;
+    const std::vector<long long> indices64(indices.begin(), indices.end());
+
+    std::cout << (pattern == &random ? "random" : "sequential")
+              << " indices:" << '\n';
+
+    vfloat sum_lanes(0.f), sum_gather(0.f);
+    vfloat sum_lanes64(0.f), sum_gather64(0.f);
+
+    const float lanes_time = bench([&](){
+      sum_lanes = vfloat(0.f);
+      for (int i = 0; i < num_lookups; i += width)
+        sum_lanes += gather_lanes(table.data(), indices.data() + i);
+    });
+
+    const float gather_time = bench([&](){
+      sum_gather = vfloat(0.f);
+      for (int i = 0; i < num_lookups; i += width) {
+        auto o = psimd::load_unaligned<vint>(indices.data() + i);
+        sum_gather += psimd::gather<vfloat, 4>(table.data(), o);
+      }
+    });
+
+    const float lanes64_time = bench([&](){
+      sum_lanes64 = vfloat(0.f);
+      for (int i = 0; i < num_lookups; i += width)
+        sum_lanes64 += gather_lanes(table.data(), indices64.data() + i);
+    });
+
+    const float gather64_time = bench([&](){
+      sum_gather64 = vfloat(0.f);
+      for (int i = 0; i < num_lookups; i += width) {
+        auto o = psimd::load_unaligned<vllong>(indices64.data() + i);
+        sum_gather64 += psimd::gather<vfloat, 4>(table.data(), o);
+      }
+    });
+
+    std::cout << "  32 bit gather: lane loop " << lanes_time
+              << " us, gather<vfloat, 4>() " << gather_time << " us --> "
+              << lanes_time / gather_time << "x" << '\n';
+
+    std::cout << "  64 bit gather: lane loop " << lanes64_time
+              << " us, gather<vfloat, 4>() " << gather64_time << " us --> "
+              << lanes64_time / gather64_time << "x" << '\n';
+
+    if (psimd::any(sum_lanes != sum_gather) ||
+        psimd::any(sum_lanes != sum_lanes64) ||
+        psimd::any(sum_lanes != sum_gather64))
+      std::cout << "  (sum mismatch)" << '\n';
+  }
+
+  const vfloat value(1.f);
+
+  const float scatter_lanes_time = bench([&](){
+    for (int i = 0; i < num_lookups; i += width)
+      scatter_lanes(value, out.data(), random.data() + i);
+  });
+
+  const float scatter_time = bench([&](){
+    for (int i = 0; i < num_lookups; i += width) {
+      auto o = psimd::load_unaligned<vint>(random.data() + i);
+      psimd::scatter<4>(value, out.data(), o);
+    }
+  });
+
+  std::cout << "random scatter: lane loop " << scatter_lanes_time
+            << " us, scatter<4>() " << scatter_time << " us --> "
+            << scatter_lanes_time / scatter_time << "x" << '\n';
+
+  return 0;
+}
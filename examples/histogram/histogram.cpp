@@ -0,0 +1,125 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../mandelbrot/pico_bench.h"
+
+#include "psimd/psimd.h"
+
+// Histograms of uniform and of skewed samples (most falling in the first few
+// bins) with a scalar loop vs. psimd::scatter_add() of a pack of samples,
+// which merges lanes hitting the same bin before one gather/scatter. A plain
+// gather(), add and scatter() shows the cost of that merging: it is faster,
+// but loses the counts of lanes which share a bin
+
+static const int num_samples = 1 << 16;
+static const int num_bins    = 256;
+
+using vint = psimd::pack<int>;
+
+template <typename FCN>
+float bench(FCN &&fcn)
+{
+  using namespace std::chrono;
+
+  auto bencher = pico_bench::Benchmarker<microseconds>{64, seconds{1}};
+
+  auto stats = bencher(fcn);
+
+  return stats.min().count();
+}
+
+int main()
+{
+  std::cout << "starting benchmarks (pack<int>, " << vint::static_size
+            << " lanes, " << num_samples << " samples into " << num_bins
+            << " bins)... " << '\n';
+
+  std::mt19937 rng(42);
+
+  std::vector<int> uniform(num_samples), skewed(num_samples);
+
+  std::uniform_int_distribution<int> uniform_dist(0, num_bins - 1);
+  std::geometric_distribution<int> skewed_dist(0.25);
+
+  for (int i = 0; i < num_samples; ++i) {
+    uniform[i] = uniform_dist(rng);
+    skewed[i]  = std::min(skewed_dist(rng), num_bins - 1);
+  }
+
+  std::vector<int> scalar_bins(num_bins), psimd_bins(num_bins);
+  std::vector<int> plain_bins(num_bins);
+
+  const vint ones(1);
+
+  for (auto *samples : {&uniform, &skewed}) {
+    const std::vector<int> &s = *samples;
+
+    const float scalar_time = bench([&](){
+      std::fill(scalar_bins.begin(), scalar_bins.end(), 0);
+      for (int i = 0; i < num_samples; ++i)
+        ++scalar_bins[s[i]];
+    });
+
+    const float psimd_time = bench([&](){
+      std::fill(psimd_bins.begin(), psimd_bins.end(), 0);
+      for (int i = 0; i < num_samples; i += vint::static_size) {
+        auto bins = psimd::load_unaligned<vint>(s.data() + i);
+        psimd::scatter_add(psimd_bins.data(), bins, ones);
+      }
+    });
+
+    const float plain_time = bench([&](){
+      std::fill(plain_bins.begin(), plain_bins.end(), 0);
+      for (int i = 0; i < num_samples; i += vint::static_size) {
+        auto bins   = psimd::load_unaligned<vint>(s.data() + i);
+        auto counts = psimd::gather<vint>(plain_bins.data(), bins);
+        psimd::scatter(vint(counts + ones), plain_bins.data(), bins);
+      }
+    });
+
+    const int lost = num_samples - std::accumulate(plain_bins.begin(),
+                                                   plain_bins.end(), 0);
+
+    std::cout << (samples == &uniform ? "uniform" : "skewed")
+              << " samples: scalar " << scalar_time << " us, scatter_add() "
+              << psimd_time << " us --> " << scalar_time / psimd_time << "x"
+              << '\n';
+
+    std::cout << "  plain gather()/scatter() " << plain_time << " us, "
+              << lost << " of " << num_samples << " samples lost" << '\n';
+
+    if (scalar_bins != psimd_bins)
+      std::cout << "  (histogram mismatch)" << '\n';
+  }
+
+  return 0;
+}
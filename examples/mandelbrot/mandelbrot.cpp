@@ -103,7 +103,7 @@ void mandelbrot(float x0, float y0,
   float dy = (y1 - y0) / height;
 
   for (int j = 0; j < height; j++) {
-    for (int i = 0; i < width; i += DEFAULT_WIDTH) {
+    for (int i = 0; i < width; i += vfloat::static_size) {
       vfloat x = x0 + (i + programIndex.as<float>()) * dx;
       vfloat y = y0 + j * dy;
 
@@ -174,7 +174,7 @@ void mandelbrot(float x0, float y0,
   float dy = (y1 - y0) / height;
 
   for (int j = 0; j < height; j++) {
-    for (int i = 0; i < width; i += DEFAULT_WIDTH) {
+    for (int i = 0; i < width; i += vfloat::size) {
       vfloat x = x0 + (i + vfloat(programIndex)) * dx;
       vfloat y = y0 + j * dy;
 
@@ -183,7 +183,7 @@ void mandelbrot(float x0, float y0,
       int base_index = (j * width + i);
       auto result = mandel(active, x, y, maxIters);
 
-      vint::store(active, output + base_index, result);
+      vint::storeu(active, output + base_index, result);
     }
   }
 }
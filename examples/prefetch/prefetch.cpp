@@ -0,0 +1,113 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../mandelbrot/pico_bench.h"
+
+#include "psimd/psimd.h"
+
+// Table lookups through gather() at random offsets into a table much larger
+// than the last level cache, each followed by some arithmetic on the values
+// looked up, with prefetch_gather() of the offsets 'distance' packs ahead.
+// Without prefetching the arithmetic fills the out-of-order window and the
+// next gathers only miss once it drains; prefetching far enough ahead keeps
+// more misses in flight
+
+static const int table_size  = 1 << 26;
+static const int num_lookups = 1 << 22;
+static const int max_distance = 64;
+
+using vfloat = psimd::pack<float>;
+using vint   = psimd::pack<int>;
+
+static const int W = vfloat::static_size;
+
+float lookups(std::vector<float> &table, std::vector<int> &offsets,
+              int distance, float &checksum)
+{
+  using namespace std::chrono;
+
+  auto bencher = pico_bench::Benchmarker<microseconds>{16, seconds{2}};
+
+  auto stats = bencher([&](){
+    vfloat sum(0.f);
+
+    for (int i = 0; i < num_lookups; i += W) {
+      if (distance > 0) {
+        const vint ahead = psimd::load<vint>(&offsets[i + distance * W]);
+        psimd::prefetch_gather(table.data(), ahead);
+      }
+
+      const vint o = psimd::load<vint>(&offsets[i]);
+      vfloat value = psimd::gather<vfloat>(table.data(), o);
+
+      for (int k = 0; k < 16; ++k)
+        value = psimd::fma(value, vfloat(0.5f), vfloat(1.f));
+
+      sum += value;
+    }
+
+    checksum = psimd::reduce_add(sum);
+  });
+
+  return stats.min().count();
+}
+
+int main()
+{
+  std::cout << "starting benchmarks (pack<float>, " << W << " lanes, "
+            << num_lookups << " lookups into " << table_size
+            << " floats)... " << '\n';
+
+  std::vector<float> table(table_size);
+  for (int i = 0; i < table_size; ++i)
+    table[i] = float(i % 7);
+
+  // NOTE: offsets are padded so prefetches up to 'max_distance' packs
+  //       ahead of the last lookup stay in bounds
+  std::vector<int> offsets(num_lookups + max_distance * W);
+
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> dist(0, table_size - 1);
+  for (auto &o : offsets)
+    o = dist(rng);
+
+  float checksum = 0.f;
+  const float baseline = lookups(table, offsets, 0, checksum);
+  std::cout << "no prefetch      : " << baseline << " us (checksum "
+            << checksum << ")" << '\n';
+
+  for (int distance = 1; distance <= max_distance; distance *= 2) {
+    const float time = lookups(table, offsets, distance, checksum);
+    std::cout << "distance " << distance << (distance < 10 ? "  " : " ")
+              << "packs : " << time << " us --> " << baseline / time
+              << "x (checksum " << checksum << ")" << '\n';
+  }
+
+  return 0;
+}
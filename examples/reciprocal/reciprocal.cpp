@@ -0,0 +1,117 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../mandelbrot/pico_bench.h"
+
+#include "psimd/psimd.h"
+
+// Throughput of rcp()/rcp_fast() vs. 1.f / x and of rsqrt()/rsqrt_fast() vs.
+// 1.f / sqrt(x), with the largest relative error of each over the inputs
+
+static const int num_values = 1 << 16;
+
+using vfloat = psimd::pack<float>;
+
+template <typename FCN>
+float bench(std::vector<float> &in, std::vector<float> &out, FCN &&fcn)
+{
+  using namespace std::chrono;
+
+  const int W = vfloat::static_size;
+
+  auto bencher = pico_bench::Benchmarker<microseconds>{16, seconds{1}};
+
+  auto stats = bencher([&](){
+    for (size_t i = 0; i < in.size(); i += W) {
+      vfloat v = psimd::load<vfloat>(&in[i]);
+      vfloat r = fcn(v);
+      psimd::store(r, &out[i]);
+    }
+  });
+
+  return stats.min().count();
+}
+
+template <typename FCN, typename REF_FCN>
+void compare(const std::string &name,
+             std::vector<float> &in,
+             std::vector<float> &out,
+             float baseline,
+             FCN &&fcn,
+             REF_FCN &&ref)
+{
+  const float time = bench(in, out, fcn);
+
+  double max_error = 0.0;
+  for (size_t i = 0; i < in.size(); ++i) {
+    const double expected = ref(double(in[i]));
+    max_error = std::max(max_error, std::abs(out[i] - expected) / expected);
+  }
+
+  std::cout << name << ": " << time << " us --> " << baseline / time
+            << "x, max relative error " << max_error << '\n';
+}
+
+int main()
+{
+  std::cout << "starting benchmarks (pack<float>, " << vfloat::static_size
+            << " lanes)... " << '\n';
+
+  std::vector<float> in(num_values), out(num_values);
+
+  for (int i = 0; i < num_values; ++i)
+    in[i] = 0.001f + 1000.f * float(i) / float(num_values);
+
+  auto rcp_ref   = [](double x) { return 1.0 / x; };
+  auto rsqrt_ref = [](double x) { return 1.0 / std::sqrt(x); };
+
+  const float divide = bench(in, out, [](const vfloat &v) {
+    return vfloat(1.f / v);
+  });
+  std::cout << "1.f / x         : " << divide << " us" << '\n';
+
+  compare("rcp()           ", in, out, divide,
+          [](const vfloat &v) { return psimd::rcp(v); }, rcp_ref);
+  compare("rcp_fast()      ", in, out, divide,
+          [](const vfloat &v) { return psimd::rcp_fast(v); }, rcp_ref);
+
+  const float divide_sqrt = bench(in, out, [](const vfloat &v) {
+    return vfloat(1.f / psimd::sqrt(v));
+  });
+  std::cout << "1.f / sqrt(x)   : " << divide_sqrt << " us" << '\n';
+
+  compare("rsqrt()         ", in, out, divide_sqrt,
+          [](const vfloat &v) { return psimd::rsqrt(v); }, rsqrt_ref);
+  compare("rsqrt_fast()    ", in, out, divide_sqrt,
+          [](const vfloat &v) { return psimd::rsqrt_fast(v); }, rsqrt_ref);
+
+  return 0;
+}
@@ -0,0 +1,173 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../mandelbrot/pico_bench.h"
+
+#include "psimd/psimd.h"
+
+// STREAM-style memory bandwidth (copy, scale, add, triad) with store_aligned()
+// vs. store_stream(). On arrays larger than the last level cache, plain stores
+// first read each destination line into the cache (and later evict it), while
+// streaming stores write around the caches, saving a third to a half of the
+// memory traffic of each kernel
+
+using vfloat = psimd::pack<float>;
+
+static const int W = vfloat::static_size;
+
+// Arrays of floats aligned for load_aligned()/store_aligned()/store_stream()
+
+class aligned_array
+{
+public:
+
+  explicit aligned_array(size_t size)
+    : storage(size + W)
+  {
+    void *ptr   = storage.data();
+    size_t room = storage.size() * sizeof(float);
+    data = (float*) std::align(vfloat::static_alignment,
+                               size * sizeof(float), ptr, room);
+  }
+
+  float *data;
+
+private:
+
+  std::vector<float> storage;
+};
+
+struct plain_store
+{
+  void operator()(const vfloat &p, float *dst) const
+  {
+    psimd::store_aligned(p, dst);
+  }
+
+  void finish() const {}
+};
+
+struct streaming_store
+{
+  void operator()(const vfloat &p, float *dst) const
+  {
+    psimd::store_stream(p, dst);
+  }
+
+  void finish() const { psimd::stream_fence(); }
+};
+
+// Best bandwidth over the benchmark runs of 'kernel', in GB/s, where each
+// run moves 'bytes'
+
+template <typename KERNEL>
+double bandwidth(double bytes, KERNEL &&kernel)
+{
+  using namespace std::chrono;
+
+  auto bencher = pico_bench::Benchmarker<microseconds>{16, seconds{2}};
+
+  auto stats = bencher(kernel);
+
+  return bytes / (1e3 * stats.min().count());
+}
+
+template <typename STORE>
+void run_kernels(const std::string &name,
+                 size_t size,
+                 float *a,
+                 float *b,
+                 float *c,
+                 STORE store)
+{
+  const float scalar = 3.f;
+  const double array_bytes = double(size * sizeof(float));
+
+  const double copy = bandwidth(2 * array_bytes, [&](){
+    for (size_t i = 0; i < size; i += W)
+      store(psimd::load_aligned<vfloat>(a + i), c + i);
+    store.finish();
+  });
+
+  const double scale = bandwidth(2 * array_bytes, [&](){
+    for (size_t i = 0; i < size; i += W)
+      store(vfloat(scalar * psimd::load_aligned<vfloat>(c + i)), b + i);
+    store.finish();
+  });
+
+  const double add = bandwidth(3 * array_bytes, [&](){
+    for (size_t i = 0; i < size; i += W) {
+      const vfloat va = psimd::load_aligned<vfloat>(a + i);
+      const vfloat vb = psimd::load_aligned<vfloat>(b + i);
+      store(vfloat(va + vb), c + i);
+    }
+    store.finish();
+  });
+
+  const double triad = bandwidth(3 * array_bytes, [&](){
+    for (size_t i = 0; i < size; i += W) {
+      const vfloat vb = psimd::load_aligned<vfloat>(b + i);
+      const vfloat vc = psimd::load_aligned<vfloat>(c + i);
+      store(psimd::fma(vfloat(scalar), vc, vb), a + i);
+    }
+    store.finish();
+  });
+
+  std::cout << name << ": copy " << copy << " GB/s, scale " << scale
+            << " GB/s, add " << add << " GB/s, triad " << triad << " GB/s"
+            << '\n';
+}
+
+int main(int argc, const char *argv[])
+{
+  // NOTE: the default of 2^25 floats (128 MiB) per array is meant to
+  //       be well beyond the last level cache, pass a size to change it
+  size_t size = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : (1u << 25);
+  size = (size + W - 1) / W * W;
+
+  std::cout << "starting benchmarks (pack<float>, " << W << " lanes, "
+            << size << " floats per array)... " << '\n';
+
+  aligned_array a(size), b(size), c(size);
+
+  for (size_t i = 0; i < size; ++i) {
+    a.data[i] = 1.f;
+    b.data[i] = 2.f;
+    c.data[i] = 0.f;
+  }
+
+  run_kernels("store_aligned()", size, a.data, b.data, c.data,
+              plain_store());
+  run_kernels("store_stream() ", size, a.data, b.data, c.data,
+              streaming_store());
+
+  return 0;
+}
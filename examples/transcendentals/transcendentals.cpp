@@ -0,0 +1,129 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../mandelbrot/pico_bench.h"
+
+#include "psimd/psimd.h"
+
+// Throughput of the vectorized transcendental functions vs. calling the
+// standard library on each lane, over arrays of float and double inputs
+
+static const int num_values = 1 << 16;
+
+template <typename T>
+using vtype = psimd::pack<T>;
+
+template <typename T, typename PACK_FCN, typename STD_FCN>
+void compare(const std::string &name,
+             std::vector<T> &in,
+             std::vector<T> &out,
+             PACK_FCN &&pack_fcn,
+             STD_FCN &&std_fcn)
+{
+  using namespace std::chrono;
+
+  const int W = vtype<T>::static_size;
+
+  auto bencher = pico_bench::Benchmarker<microseconds>{16, seconds{1}};
+
+  auto stats = bencher([&](){
+    for (size_t i = 0; i < in.size(); i += W) {
+      vtype<T> v = psimd::load<vtype<T>>(&in[i]);
+      vtype<T> r = std_fcn(v);
+      psimd::store(r, &out[i]);
+    }
+  });
+  const float std_min = stats.min().count();
+
+  stats = bencher([&](){
+    for (size_t i = 0; i < in.size(); i += W) {
+      vtype<T> v = psimd::load<vtype<T>>(&in[i]);
+      vtype<T> r = pack_fcn(v);
+      psimd::store(r, &out[i]);
+    }
+  });
+  const float pack_min = stats.min().count();
+
+  std::cout << name << ": std:: " << std_min << " us, psimd:: " << pack_min
+            << " us --> " << std_min / pack_min << "x" << '\n';
+}
+
+// Applies the standard library version of a function to each lane
+#define PER_LANE(FCN)                               \
+  [](const vtype<T> &v) {                           \
+    vtype<T> r;                                     \
+    for (int i = 0; i < vtype<T>::static_size; ++i) \
+      r[i] = std::FCN(v[i]);                        \
+    return r;                                       \
+  }
+
+#define PACKED(FCN) [](const vtype<T> &v) { return psimd::FCN(v); }
+
+template <typename T>
+void run(const std::string &type)
+{
+  std::vector<T> in(num_values), out(num_values);
+
+  auto fill = [&](T lo, T hi) {
+    for (int i = 0; i < num_values; ++i)
+      in[i] = lo + (hi - lo) * T(i) / T(num_values);
+  };
+
+  std::cout << '\n' << "--> pack<" << type << "> ("
+            << vtype<T>::static_size << " lanes)" << '\n';
+
+  fill(T(-80), T(80));
+  compare(type + " exp  ", in, out, PACKED(exp),  PER_LANE(exp));
+  compare(type + " exp2 ", in, out, PACKED(exp2), PER_LANE(exp2));
+
+  fill(T(0.001), T(1000));
+  compare(type + " log  ", in, out, PACKED(log),  PER_LANE(log));
+  compare(type + " log2 ", in, out, PACKED(log2), PER_LANE(log2));
+
+  fill(T(-100), T(100));
+  compare(type + " sin  ", in, out, PACKED(sin),  PER_LANE(sin));
+  compare(type + " cos  ", in, out, PACKED(cos),  PER_LANE(cos));
+  compare(type + " tan  ", in, out, PACKED(tan),  PER_LANE(tan));
+  compare(type + " atan ", in, out, PACKED(atan), PER_LANE(atan));
+
+  fill(T(-1), T(1));
+  compare(type + " asin ", in, out, PACKED(asin), PER_LANE(asin));
+  compare(type + " acos ", in, out, PACKED(acos), PER_LANE(acos));
+}
+
+int main()
+{
+  std::cout << "starting benchmarks (std:: per lane vs. psimd::)... " << '\n';
+  std::cout << "hardware FMA: " << (PSIMD_NATIVE_FMA ? "yes" : "no") << '\n';
+
+  run<float>("float");
+  run<double>("double");
+
+  return 0;
+}
@@ -0,0 +1,197 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "pack.h"
+
+PSIMD_NAMESPACE_BEGIN
+
+  namespace detail {
+
+    // Smallest unsigned integer holding one bit per lane, which matches the
+    // AVX-512 __mmask8/__mmask16 types for 8 and 16 lanes //
+
+    template <int W>
+    struct bitmask_storage
+    {
+      static_assert(W > 0 && W <= 64, "bitmask<> supports 1 to 64 lanes");
+
+      using type = typename std::conditional<(W <= 8), uint8_t,
+                   typename std::conditional<(W <= 16), uint16_t,
+                   typename std::conditional<(W <= 32), uint32_t,
+                   uint64_t>::type>::type>::type;
+    };
+
+  } // ::psimd::detail
+
+  // One bit per lane alternative to the lane-wide mask<> //
+
+  template <int W = PSIMD_DEFAULT_WIDTH(int)>
+  struct bitmask
+  {
+    using bits_type = typename detail::bitmask_storage<W>::type;
+
+    bitmask() = default;
+    bitmask(bool value);
+
+    bool operator[](int i) const;
+    void set(int i, bool value);
+
+    static bitmask<W> from_bits(bits_type bits);
+
+    // Compile-time info //
+
+    enum {static_size = W};
+
+    static constexpr bits_type all_bits()
+    {
+      return W == int(8 * sizeof(bits_type)) ?
+             bits_type(~bits_type(0)) :
+             bits_type((uint64_t(1) << (W % 64)) - 1);
+    }
+
+    // Data //
+
+    bits_type bits;
+  };
+
+  // bitmask<> inlined members ////////////////////////////////////////////////
+
+  template <int W>
+  inline bitmask<W>::bitmask(bool value)
+    : bits(value ? all_bits() : bits_type(0))
+  {
+  }
+
+  template <int W>
+  inline bool bitmask<W>::operator[](int i) const
+  {
+    return (bits >> i) & 1;
+  }
+
+  template <int W>
+  inline void bitmask<W>::set(int i, bool value)
+  {
+    if (value)
+      bits |= bits_type(bits_type(1) << i);
+    else
+      bits &= bits_type(~(bits_type(1) << i));
+  }
+
+  template <int W>
+  inline bitmask<W> bitmask<W>::from_bits(bits_type bits)
+  {
+    bitmask<W> result;
+    result.bits = bits & all_bits();
+    return result;
+  }
+
+  // mask<> <--> bitmask<> conversions ////////////////////////////////////////
+
+  namespace detail {
+
+    template <typename M, int W>
+    inline bitmask<W> lanes_to_bitmask(const pack<M, W> &m)
+    {
+      typename bitmask<W>::bits_type bits = 0;
+
+      for (int i = 0; i < W; ++i)
+        if (m[i])
+          bits |= typename bitmask<W>::bits_type(1) << i;
+
+      return bitmask<W>::from_bits(bits);
+    }
+
+  } // ::psimd::detail
+
+  template <int W>
+  inline bitmask<W> to_bitmask(const mask<W> &m)
+  {
+    return detail::lanes_to_bitmask(m);
+  }
+
+  template <int W>
+  inline bitmask<W> to_bitmask(const pack<long long, W> &m)
+  {
+    return detail::lanes_to_bitmask(m);
+  }
+
+  template <int W>
+  inline mask<W> to_mask(const bitmask<W> &m)
+  {
+    mask<W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      result[i] = m[i] ? 0xFFFFFFFF : 0x00000000;
+
+    return result;
+  }
+
+  namespace detail {
+
+    // bitmask<> to lane-wide masks with M lanes, specialized by the native
+    // backends //
+
+    template <typename M, int W>
+    struct bitmask_expander
+    {
+      static pack<M, W> expand(const bitmask<W> &m)
+      {
+        pack<M, W> result;
+
+        #pragma omp simd
+        for (int i = 0; i < W; ++i)
+          result[i] = m[i] ? M(-1) : M(0);
+
+        return result;
+      }
+    };
+
+    template <int W>
+    struct bitmask_expander<int, W>
+    {
+      static mask<W> expand(const bitmask<W> &m)
+      {
+        return to_mask(m);
+      }
+    };
+
+  } // ::psimd::detail
+
+  // to_mask<T>(): the mask_for<T, W> of a bitmask<W>, e.g. to select() between
+  //               packs of double //
+
+  template <typename T, int W>
+  inline mask_for<T, W> to_mask(const bitmask<W> &m)
+  {
+    using M = typename detail::mask_element<T>::type;
+    return detail::bitmask_expander<M, W>::expand(m);
+  }
+
+PSIMD_NAMESPACE_END // ::psimd
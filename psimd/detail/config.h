@@ -24,12 +24,152 @@
 
 #pragma once
 
-#ifndef DEFAULT_WIDTH
-#  define DEFAULT_WIDTH 8
-#endif
-
 #ifdef _WIN32
 #  define PSIMD_ALIGN(...) __declspec(align(__VA_ARGS__))
 #else
 #  define PSIMD_ALIGN(...) __attribute__((aligned(__VA_ARGS__)))
-#endif
\ No newline at end of file
+#endif
+
+#ifndef PSIMD_MAX_ALIGNMENT
+#  define PSIMD_MAX_ALIGNMENT 64
+#endif
+
+#ifndef PSIMD_CACHE_LINE_SIZE
+#  define PSIMD_CACHE_LINE_SIZE 64
+#endif
+
+// Everything in psimd lives in an inline namespace named after the ISA the
+// including translation unit is compiled for. This keeps the inline functions
+// of translation units built for different ISAs (see psimd/dispatch.h) from
+// being merged by the linker into a single, possibly unsupported, definition //
+
+#ifndef PSIMD_ISA_NAMESPACE
+#  if defined(PSIMD_DISABLE_NATIVE)
+#    define PSIMD_ISA_NAMESPACE isa_generic
+#  elif defined(__AVX512F__)
+#    define PSIMD_ISA_NAMESPACE isa_avx512
+#  elif defined(__AVX2__)
+#    define PSIMD_ISA_NAMESPACE isa_avx2
+#  elif defined(__AVX__)
+#    define PSIMD_ISA_NAMESPACE isa_avx
+#  elif defined(__SSE4_2__)
+#    define PSIMD_ISA_NAMESPACE isa_sse42
+#  elif defined(__SSE2__) || defined(_M_X64) || \
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define PSIMD_ISA_NAMESPACE isa_sse2
+#  else
+#    define PSIMD_ISA_NAMESPACE isa_generic
+#  endif
+#endif
+
+#define PSIMD_NAMESPACE_BEGIN \
+  namespace psimd { inline namespace PSIMD_ISA_NAMESPACE {
+#define PSIMD_NAMESPACE_END } }
+
+PSIMD_NAMESPACE_BEGIN
+
+  namespace detail {
+
+    constexpr int next_power_of_two(int value, int p = 1)
+    {
+      return p >= value ? p : next_power_of_two(value, 2 * p);
+    }
+
+  } // ::psimd::detail
+
+  // Alignment (in bytes) of a pack<T, W>: its data size rounded up to a power
+  // of two, capped at PSIMD_MAX_ALIGNMENT //
+
+  template <typename T, int W>
+  struct pack_alignment
+  {
+    static constexpr int size  = int(sizeof(T)) * W;
+    static constexpr int value =
+        detail::next_power_of_two(size) < PSIMD_MAX_ALIGNMENT ?
+        detail::next_power_of_two(size) : PSIMD_MAX_ALIGNMENT;
+  };
+
+PSIMD_NAMESPACE_END // ::psimd
+
+// Native instruction sets available to the native backends //
+
+#if defined(PSIMD_DISABLE_NATIVE)
+#  define PSIMD_NATIVE_SSE2     0
+#  define PSIMD_NATIVE_SSE4_1   0
+#  define PSIMD_NATIVE_AVX2     0
+#  define PSIMD_NATIVE_AVX512   0
+#  define PSIMD_NATIVE_AVX512CD 0
+#  define PSIMD_NATIVE_FMA      0
+#else
+#  if defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define PSIMD_NATIVE_SSE2 1
+#  else
+#    define PSIMD_NATIVE_SSE2 0
+#  endif
+#  if defined(__SSE4_1__) || defined(__AVX__)
+#    define PSIMD_NATIVE_SSE4_1 1
+#  else
+#    define PSIMD_NATIVE_SSE4_1 0
+#  endif
+#  if defined(__AVX2__)
+#    define PSIMD_NATIVE_AVX2 1
+#  else
+#    define PSIMD_NATIVE_AVX2 0
+#  endif
+#  if defined(__AVX512F__)
+#    define PSIMD_NATIVE_AVX512 1
+#  else
+#    define PSIMD_NATIVE_AVX512 0
+#  endif
+#  if defined(__AVX512F__) && defined(__AVX512CD__)
+#    define PSIMD_NATIVE_AVX512CD 1
+#  else
+#    define PSIMD_NATIVE_AVX512CD 0
+#  endif
+#  if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+#    define PSIMD_NATIVE_FMA 1
+#  else
+#    define PSIMD_NATIVE_FMA 0
+#  endif
+#endif
+
+// Width of the widest native register available, in bytes //
+
+#if PSIMD_NATIVE_AVX512
+#  define PSIMD_NATIVE_REGISTER_SIZE 64
+#elif PSIMD_NATIVE_AVX2
+#  define PSIMD_NATIVE_REGISTER_SIZE 32
+#elif PSIMD_NATIVE_SSE2
+#  define PSIMD_NATIVE_REGISTER_SIZE 16
+#else
+#  define PSIMD_NATIVE_REGISTER_SIZE 32
+#endif
+
+PSIMD_NAMESPACE_BEGIN
+
+  // Number of T lanes which fill one native register //
+
+  template <typename T>
+  constexpr int native_width()
+  {
+    return int(sizeof(T)) < PSIMD_NATIVE_REGISTER_SIZE ?
+        PSIMD_NATIVE_REGISTER_SIZE / int(sizeof(T)) : 1;
+  }
+
+PSIMD_NAMESPACE_END // ::psimd
+
+// Default W of pack<T>, unless fixed for all T by a user-defined
+// DEFAULT_WIDTH //
+
+#ifdef DEFAULT_WIDTH
+#  define PSIMD_USER_DEFAULT_WIDTH 1
+#  define PSIMD_DEFAULT_WIDTH(T) DEFAULT_WIDTH
+#else
+#  define PSIMD_USER_DEFAULT_WIDTH 0
+#  define PSIMD_DEFAULT_WIDTH(T) ::psimd::native_width<T>()
+// NOTE: deprecated, the default width of pack<float> for code written
+//       against the old fixed DEFAULT_WIDTH; a constant expression, but no
+//       longer usable in #if
+#  define DEFAULT_WIDTH PSIMD_DEFAULT_WIDTH(float)
+#endif
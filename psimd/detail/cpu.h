@@ -0,0 +1,176 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+#pragma once
+
+#include "config.h"
+
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#elif defined(__i386__) || defined(__x86_64__)
+#  include <cpuid.h>
+#endif
+
+PSIMD_NAMESPACE_BEGIN
+
+  // Instruction set levels which kernels can be dispatched to, in increasing
+  // order of capability //
+
+  enum class isa
+  {
+    generic,
+    sse42,  // SSE4.2 + POPCNT
+    avx2,   // AVX2 + FMA + F16C + BMI1/2 + LZCNT
+    avx512, // AVX-512 F/CD/BW/DQ/VL (Skylake-X)
+  };
+
+  inline const char *isa_name(isa i)
+  {
+    switch (i) {
+    case isa::sse42 : return "SSE4.2";
+    case isa::avx2  : return "AVX2";
+    case isa::avx512: return "AVX-512";
+    default         : return "generic";
+    }
+  }
+
+  namespace detail {
+
+    // NOTE: CPU feature detection below is adapted from embc's
+    //       getCPUFeatures() (examples/embc/sys/sysinfo.cpp), reduced
+    //       to the bits needed to pick a dispatch target.
+
+    inline void cpuid(int out[4], int leaf, int subleaf = 0)
+    {
+#if defined(_MSC_VER)
+      __cpuidex(out, leaf, subleaf);
+#elif defined(__i386__) || defined(__x86_64__)
+      unsigned int r[4];
+      __cpuid_count(leaf, subleaf, r[0], r[1], r[2], r[3]);
+      for (int i = 0; i < 4; ++i)
+        out[i] = int(r[i]);
+#else
+      (void)leaf;
+      (void)subleaf;
+      out[0] = out[1] = out[2] = out[3] = 0;
+#endif
+    }
+
+    inline long long get_xcr0()
+    {
+#if defined(_MSC_VER)
+      return (long long)_xgetbv(0);
+#elif defined(__i386__) || defined(__x86_64__)
+      unsigned int eax, edx;
+      __asm__ ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+      return (long long)(((unsigned long long)edx << 32) | eax);
+#else
+      return 0;
+#endif
+    }
+
+    inline isa query_cpu_isa()
+    {
+      /* constants to access destination registers of CPUID instruction */
+      const int EAX = 0, EBX = 1, ECX = 2;
+
+      /* cpuid[eax=1].ecx */
+      const int BIT_FMA3   = 1 << 12;
+      const int BIT_SSE4_2 = 1 << 20;
+      const int BIT_POPCNT = 1 << 23;
+      const int BIT_OXSAVE = 1 << 27;
+      const int BIT_AVX    = 1 << 28;
+      const int BIT_F16C   = 1 << 29;
+
+      /* cpuid[eax=7,ecx=0].ebx */
+      const int BIT_BMI1     = 1 << 3;
+      const int BIT_AVX2     = 1 << 5;
+      const int BIT_BMI2     = 1 << 8;
+      const int BIT_AVX512F  = 1 << 16;
+      const int BIT_AVX512DQ = 1 << 17;
+      const int BIT_AVX512CD = 1 << 28;
+      const int BIT_AVX512BW = 1 << 30;
+      const int BIT_AVX512VL = int(1u << 31);
+
+      /* cpuid[eax=0x80000001].ecx */
+      const int BIT_LZCNT = 1 << 5;
+
+      int leaf0[4]        = {0, 0, 0, 0};
+      int leaf1[4]        = {0, 0, 0, 0};
+      int leaf7[4]        = {0, 0, 0, 0};
+      int leaf80000000[4] = {0, 0, 0, 0};
+      int leaf80000001[4] = {0, 0, 0, 0};
+
+      cpuid(leaf0, 0);
+      if (leaf0[EAX] >= 1) cpuid(leaf1, 1);
+      if (leaf0[EAX] >= 7) cpuid(leaf7, 7, 0);
+
+      cpuid(leaf80000000, int(0x80000000u));
+      if (unsigned(leaf80000000[EAX]) >= 0x80000001u)
+        cpuid(leaf80000001, int(0x80000001u));
+
+      /* detect if OS saves XMM, YMM, and ZMM states */
+      bool xmm_enabled = false;
+      bool ymm_enabled = false;
+      bool zmm_enabled = false;
+      if (leaf1[ECX] & BIT_OXSAVE) {
+        const long long xcr0 = get_xcr0();
+        xmm_enabled = (xcr0 & 0x02) == 0x02;
+        ymm_enabled = xmm_enabled && (xcr0 & 0x04) == 0x04;
+        zmm_enabled = ymm_enabled && (xcr0 & 0xE0) == 0xE0;
+      }
+
+      auto has = [](int reg, int bits) { return (reg & bits) == bits; };
+
+      const int avx512_bits =
+          BIT_AVX512F | BIT_AVX512DQ | BIT_AVX512CD | BIT_AVX512BW |
+          BIT_AVX512VL;
+
+      /* everything the avx2 target is compiled with (see cmake/psimd.cmake) */
+      const bool avx2 = ymm_enabled &&
+                        has(leaf1[ECX], BIT_AVX | BIT_FMA3 | BIT_F16C) &&
+                        has(leaf7[EBX], BIT_AVX2 | BIT_BMI1 | BIT_BMI2) &&
+                        has(leaf80000001[ECX], BIT_LZCNT);
+
+      if (avx2 && zmm_enabled && has(leaf7[EBX], avx512_bits))
+        return isa::avx512;
+      if (avx2)
+        return isa::avx2;
+      if (has(leaf1[ECX], BIT_SSE4_2 | BIT_POPCNT))
+        return isa::sse42;
+      return isa::generic;
+    }
+
+  } // ::psimd::detail
+
+  // Best instruction set level supported by the host CPU and OS (queried once,
+  // then cached) //
+
+  inline isa detect_isa()
+  {
+    static const isa host_isa = detail::query_cpu_isa();
+    return host_isa;
+  }
+
+PSIMD_NAMESPACE_END // ::psimd
@@ -24,9 +24,12 @@
 
 #pragma once
 
+#include <type_traits>
+
+#include "../bitmask.h"
 #include "../pack.h"
 
-namespace psimd {
+PSIMD_NAMESPACE_BEGIN
 
   template <typename T, int W, typename FCN_T>
   inline void foreach(pack<T, W> &p, FCN_T &&fcn)
@@ -36,8 +39,28 @@ namespace psimd {
       fcn(p[i], i);
   }
 
+  template <typename M, int W, typename FCN_T>
+  inline typename std::enable_if<detail::is_mask_element<M>::value>::type
+  foreach_active(const pack<M, W> &m, FCN_T &&fcn)
+  {
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      if (m[i])
+        fcn(i);
+  }
+
+  template <typename M, typename T, int W, typename FCN_T>
+  inline typename std::enable_if<detail::is_mask_element<M>::value>::type
+  foreach_active(const pack<M, W> &m, pack<T, W> &p, FCN_T &&fcn)
+  {
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      if (m[i])
+        fcn(p[i]);
+  }
+
   template <int W, typename FCN_T>
-  inline void foreach_active(const mask<W> &m, FCN_T &&fcn)
+  inline void foreach_active(const bitmask<W> &m, FCN_T &&fcn)
   {
     #pragma omp simd
     for (int i = 0; i < W; ++i)
@@ -46,7 +69,7 @@ namespace psimd {
   }
 
   template <typename T, int W, typename FCN_T>
-  inline void foreach_active(const mask<W> &m, pack<T, W> &p, FCN_T &&fcn)
+  inline void foreach_active(const bitmask<W> &m, pack<T, W> &p, FCN_T &&fcn)
   {
     #pragma omp simd
     for (int i = 0; i < W; ++i)
@@ -54,8 +77,10 @@ namespace psimd {
         fcn(p[i]);
   }
 
-  template <int W>
-  inline bool any(const mask<W> &m)
+  template <typename M, int W,
+            detail::lanewise<M, W> = 0>
+  inline typename std::enable_if<detail::is_mask_element<M>::value, bool>::type
+  any(const pack<M, W> &m)
   {
     bool result = false;
 
@@ -67,14 +92,17 @@ namespace psimd {
     return result;
   }
 
-  template <int W>
-  inline bool none(const mask<W> &m)
+  template <typename M, int W>
+  inline typename std::enable_if<detail::is_mask_element<M>::value, bool>::type
+  none(const pack<M, W> &m)
   {
     return !any(m);
   }
 
-  template <int W>
-  inline bool all(const mask<W> &m)
+  template <typename M, int W,
+            detail::lanewise<M, W> = 0>
+  inline typename std::enable_if<detail::is_mask_element<M>::value, bool>::type
+  all(const pack<M, W> &m)
   {
     bool result = true;
 
@@ -86,8 +114,45 @@ namespace psimd {
     return result;
   }
 
+  template <int W>
+  inline bool any(const bitmask<W> &m)
+  {
+    return m.bits != 0;
+  }
+
+  template <int W>
+  inline bool none(const bitmask<W> &m)
+  {
+    return m.bits == 0;
+  }
+
+  template <int W>
+  inline bool all(const bitmask<W> &m)
+  {
+    return m.bits == bitmask<W>::all_bits();
+  }
+
+  template <typename M, typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline typename
+  std::enable_if<detail::is_mask_element<M>::value, pack<T, W>>::type
+  select(const pack<M, W> &m, const pack<T, W> &t, const pack<T, W> &f)
+  {
+    pack<T, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W; ++i) {
+      if (m[i])
+        result[i] = t[i];
+      else
+        result[i] = f[i];
+    }
+
+    return result;
+  }
+
   template <typename T, int W>
-  inline pack<T, W> select(const mask<W> &m,
+  inline pack<T, W> select(const bitmask<W> &m,
                            const pack<T, W> &t,
                            const pack<T, W> &f)
   {
@@ -104,4 +169,4 @@ namespace psimd {
     return result;
   }
 
-} // ::psimd
\ No newline at end of file
+PSIMD_NAMESPACE_END // ::psimd
\ No newline at end of file
@@ -0,0 +1,124 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+
+#pragma once
+
+// Classification of floating point lanes as in <cmath>. Every test works on
+// the bits of the lanes with integer operations, so the results hold in
+// -ffast-math builds where compilers may fold away x != x and compares with
+// infinity.
+
+#include <limits>
+
+#include "../pack.h"
+
+PSIMD_NAMESPACE_BEGIN
+
+  namespace detail {
+
+    // Sign bit alone, as lane bits and as a pack<T, W> //
+
+    template <typename T, int W>
+    inline mask_for<T, W> sign_bits()
+    {
+      using I = typename mask_for<T, W>::type;
+      return mask_for<T, W>(std::numeric_limits<I>::min());
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> sign_mask()
+    {
+      return bit_cast<pack<T, W>>(sign_bits<T, W>());
+    }
+
+    // All exponent bits set, i.e. the bits of infinity //
+
+    template <typename T, int W>
+    inline mask_for<T, W> inf_bits()
+    {
+      const pack<T, W> inf(std::numeric_limits<T>::infinity());
+      return bit_cast<mask_for<T, W>>(inf);
+    }
+
+    // Lane bits without the sign bit, ordered as |p| //
+
+    template <typename T, int W>
+    inline mask_for<T, W> magnitude_bits(const pack<T, W> &p)
+    {
+      return andnot(bit_cast<mask_for<T, W>>(p), sign_bits<T, W>());
+    }
+
+  } // ::psimd::detail
+
+  // isnan() //
+
+  template <typename T, int W, detail::floating_point<T> = 0>
+  inline mask_for<T, W> isnan(const pack<T, W> &p)
+  {
+    return detail::magnitude_bits(p) > detail::inf_bits<T, W>();
+  }
+
+  // isinf() //
+
+  template <typename T, int W, detail::floating_point<T> = 0>
+  inline mask_for<T, W> isinf(const pack<T, W> &p)
+  {
+    return detail::magnitude_bits(p) == detail::inf_bits<T, W>();
+  }
+
+  // isfinite() //
+
+  template <typename T, int W, detail::floating_point<T> = 0>
+  inline mask_for<T, W> isfinite(const pack<T, W> &p)
+  {
+    return detail::magnitude_bits(p) < detail::inf_bits<T, W>();
+  }
+
+  // signbit(): set where the sign bit is, -0 and negative NaN included //
+
+  template <typename T, int W, detail::floating_point<T> = 0>
+  inline mask_for<T, W> signbit(const pack<T, W> &p)
+  {
+    return bit_cast<mask_for<T, W>>(p) < mask_for<T, W>(0);
+  }
+
+  // copysign(): magnitude of x with the sign of y //
+
+  template <typename T, int W, detail::floating_point<T> = 0>
+  inline pack<T, W> copysign(const pack<T, W> &x, const pack<T, W> &y)
+  {
+    const pack<T, W> sign = detail::sign_mask<T, W>();
+    return andnot(x, sign) | (y & sign);
+  }
+
+  // flipsign(): x negated in the lanes where y has its sign bit set //
+
+  template <typename T, int W, detail::floating_point<T> = 0>
+  inline pack<T, W> flipsign(const pack<T, W> &x, const pack<T, W> &y)
+  {
+    return x ^ (y & detail::sign_mask<T, W>());
+  }
+
+PSIMD_NAMESPACE_END // ::psimd
@@ -0,0 +1,199 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+
+#pragma once
+
+// Stream compaction: compress_store() writes the active lanes of a pack to
+// consecutive elements in memory, expand_load() reads consecutive elements
+// into the active lanes of a pack. The native backends lower them to
+// vcompressps/vexpandps (AVX-512) or to a permutation looked up by the mask
+// bits (AVX2), and copy_if() runs them over arrays.
+
+#include <type_traits>
+
+#include "../operators/logic.h"
+#include "memory.h"
+
+PSIMD_NAMESPACE_BEGIN
+
+  namespace detail {
+
+    // compress() and expand() are overloaded by the native backends //
+
+    template <typename T, int W>
+    int compress(const pack<T, W> &p, const mask_for<T, W> &m, T *dst);
+
+    template <typename T, int W>
+    pack<T, W> expand(const mask_for<T, W> &m, const T *src);
+
+    template <typename T, int W>
+    inline int compress_lanes(const pack<T, W> &p,
+                              const mask_for<T, W> &m,
+                              T *dst,
+                              std::false_type /*blocked*/)
+    {
+      int count = 0;
+
+      for (int i = 0; i < W; ++i)
+        if (m[i])
+          dst[count++] = p[i];
+
+      return count;
+    }
+
+    template <typename T, int W>
+    inline int compress_lanes(const pack<T, W> &p,
+                              const mask_for<T, W> &m,
+                              T *dst,
+                              std::true_type /*blocked*/)
+    {
+      constexpr int block_size = blocking<T, W>::block_size;
+
+      int count = 0;
+
+      for (int b = 0; b < blocking<T, W>::blocks; ++b) {
+        mask_for<T, block_size> block_mask;
+        for (int i = 0; i < block_size; ++i)
+          block_mask[i] = m[b * block_size + i];
+
+        count += compress(p.v.block[b], block_mask, dst + count);
+      }
+
+      return count;
+    }
+
+    template <typename T, int W>
+    inline int compress(const pack<T, W> &p, const mask_for<T, W> &m, T *dst)
+    {
+      return compress_lanes(p, m, dst, is_blocked<T, W>());
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> expand_lanes(const mask_for<T, W> &m,
+                                   const T *src,
+                                   std::false_type /*blocked*/)
+    {
+      pack<T, W> result(T(0));
+
+      int count = 0;
+
+      for (int i = 0; i < W; ++i)
+        if (m[i])
+          result[i] = src[count++];
+
+      return result;
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> expand_lanes(const mask_for<T, W> &m,
+                                   const T *src,
+                                   std::true_type /*blocked*/)
+    {
+      constexpr int block_size = blocking<T, W>::block_size;
+
+      pack<T, W> result;
+
+      int count = 0;
+
+      for (int b = 0; b < blocking<T, W>::blocks; ++b) {
+        mask_for<T, block_size> block_mask;
+        for (int i = 0; i < block_size; ++i)
+          block_mask[i] = m[b * block_size + i];
+
+        result.v.block[b] = expand(block_mask, src + count);
+
+        for (int i = 0; i < block_size; ++i)
+          count += block_mask[i] ? 1 : 0;
+      }
+
+      return result;
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> expand(const mask_for<T, W> &m, const T *src)
+    {
+      return expand_lanes(m, src, is_blocked<T, W>());
+    }
+
+  } // ::psimd::detail
+
+  // compress_store(): stores the active lanes of p, in order, to consecutive
+  //                   elements from _dst on, returning how many were stored.
+  //                   Memory past them is left untouched //
+
+  template <typename T, int W, typename M>
+  inline typename std::enable_if<detail::is_mask_element<M>::value, int>::type
+  compress_store(const pack<T, W> &p, const pack<M, W> &m, void* _dst)
+  {
+    const auto &active = detail::lane_mask<T>(m, detail::is_lane_mask<T, M>());
+    return detail::compress(p, active, (T*) _dst);
+  }
+
+  // expand_load(): loads consecutive elements from _src on, in order, into
+  //                the active lanes of the result, zeroing the inactive lanes.
+  //                Only as many elements as there are active lanes are read //
+
+  template <typename PACK_T, typename M>
+  inline typename
+  std::enable_if<detail::is_mask_element<M>::value, PACK_T>::type
+  expand_load(const void* _src, const pack<M, PACK_T::static_size> &m)
+  {
+    using T = typename PACK_T::type;
+    const auto &active = detail::lane_mask<T>(m, detail::is_lane_mask<T, M>());
+    return detail::expand(active, (const T*) _src);
+  }
+
+  // copy_if(): std::copy_if() of [first, last) to d_first, with 'pred'
+  //            taking a pack<T> of elements and returning a mask of those to
+  //            copy, e.g. [](const pack<float> &v) { return v > 0.f; } //
+
+  template <typename T, typename PRED_T>
+  inline T* copy_if(const T *first, const T *last, T *d_first, PRED_T pred)
+  {
+    constexpr int W = PSIMD_DEFAULT_WIDTH(T);
+
+    using pack_t = pack<T, W>;
+    using mask_t = mask_for<T, W>;
+
+    for (; last - first >= W; first += W) {
+      const pack_t p = load_unaligned<pack_t>(first);
+      d_first += compress_store(p, pred(p), d_first);
+    }
+
+    if (first != last) {
+      const int remaining = int(last - first);
+
+      mask_t tail;
+      for (int i = 0; i < W; ++i)
+        tail[i] = i < remaining ? -1 : 0;
+
+      const pack_t p = expand_load<pack_t>(first, tail);
+      d_first += compress_store(p, tail && mask_cast<T>(pred(p)), d_first);
+    }
+
+    return d_first;
+  }
+
+PSIMD_NAMESPACE_END // ::psimd
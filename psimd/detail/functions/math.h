@@ -26,12 +26,14 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "../pack.h"
 
-namespace psimd {
+PSIMD_NAMESPACE_BEGIN
 
-  template <typename T, int W>
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
   inline pack<T, W> abs(const pack<T, W> &p)
   {
     pack<T, W> result;
@@ -43,7 +45,8 @@ namespace psimd {
     return result;
   }
 
-  template <typename T, int W>
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
   inline pack<T, W> sqrt(const pack<T, W> &p)
   {
     pack<T, W> result;
@@ -91,40 +94,411 @@ namespace psimd {
     return result;
   }
 
-  template <typename T, int W>
-  inline pack<T, W> pow(const pack<T, W> &v, const float b)
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline pack<T, W> max(const pack<T, W> &a, const pack<T, W> &b)
   {
     pack<T, W> result;
 
     #pragma omp simd
     for (int i = 0; i < W; ++i)
-      result[i] = std::pow(v[i], b);
+      result[i] = std::max(a[i], b[i]);
 
     return result;
   }
 
-  template <typename T, int W>
-  inline pack<T, W> max(const pack<T, W> &a, const pack<T, W> &b)
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline pack<T, W> min(const pack<T, W> &a, const pack<T, W> &b)
   {
     pack<T, W> result;
 
     #pragma omp simd
     for (int i = 0; i < W; ++i)
-      result[i] = std::max(a[i], b[i]);
+      result[i] = std::min(a[i], b[i]);
+
+    return result;
+  }
+
+  // Rounding /////////////////////////////////////////////////////////////////
+
+  // floor(): largest integer not greater than p //
+
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline pack<T, W> floor(const pack<T, W> &p)
+  {
+    pack<T, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      result[i] = std::floor(p[i]);
 
     return result;
   }
 
+  // ceil(): smallest integer not less than p //
+
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline pack<T, W> ceil(const pack<T, W> &p)
+  {
+    pack<T, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      result[i] = std::ceil(p[i]);
+
+    return result;
+  }
+
+  // trunc(): nearest integer not greater in magnitude than p //
+
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline pack<T, W> trunc(const pack<T, W> &p)
+  {
+    pack<T, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      result[i] = std::trunc(p[i]);
+
+    return result;
+  }
+
+  // nearbyint(): nearest integer in the current rounding mode (ties to even by
+  // default), without raising the inexact exception //
+
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline pack<T, W> nearbyint(const pack<T, W> &p)
+  {
+    pack<T, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      result[i] = std::nearbyint(p[i]);
+
+    return result;
+  }
+
+  // round(): nearest integer, halfway cases away from zero as std::round() //
+
   template <typename T, int W>
-  inline pack<T, W> min(const pack<T, W> &a, const pack<T, W> &b)
+  inline typename
+  std::enable_if<std::is_floating_point<T>::value, pack<T, W>>::type
+  round(const pack<T, W> &p)
+  {
+    // p - trunc(p) is exact, so only the halfway test decides
+    const pack<T, W> t = trunc(p);
+    const pack<T, W> d = p - t;
+    const pack<T, W> away = select(p < T(0), pack<T, W>(T(-1)),
+                                             pack<T, W>(T(1)));
+    return select(abs(d) >= T(0.5), pack<T, W>(t + away), t);
+  }
+
+  // frac(): p - floor(p), in [0, 1] ([0, 1) but for negative p within half
+  //         an ulp of an integer) //
+
+  template <typename T, int W>
+  inline typename
+  std::enable_if<std::is_floating_point<T>::value, pack<T, W>>::type
+  frac(const pack<T, W> &p)
+  {
+    return pack<T, W>(p - floor(p));
+  }
+
+  // Conversions to int with explicit rounding ////////////////////////////////
+
+  // NOTE: lanes out of the range of int (NaN included) convert to INT_MIN,
+  //       which is what the x86 conversion instructions return
+
+  namespace detail {
+
+    template <typename T>
+    inline int to_int(T integral)
+    {
+      return integral >= T(-2147483648.0) && integral < T(2147483648.0) ?
+          int(integral) : std::numeric_limits<int>::min();
+    }
+
+  } // ::psimd::detail
+
+  // to_int_round(): to the nearest int in the current rounding mode (ties to
+  //                 even by default), as std::lrint() //
+
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline pack<int, W> to_int_round(const pack<T, W> &p)
+  {
+    pack<int, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      result[i] = detail::to_int(std::nearbyint(p[i]));
+
+    return result;
+  }
+
+  // to_int_trunc(): to the nearest int not greater in magnitude, as a C++
+  //                 conversion //
+
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline pack<int, W> to_int_trunc(const pack<T, W> &p)
+  {
+    pack<int, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      result[i] = detail::to_int(std::trunc(p[i]));
+
+    return result;
+  }
+
+  // Fused multiply-add family //////////////////////////////////////////////
+
+  // NOTE: fma() and friends round each lane once on every target, through
+  //       std::fma() where there is no hardware FMA; only the contraction of
+  //       a * b + c in PSIMD_LAZY expressions and the library's internal
+  //       multiply-adds (detail::contract_fma() and co.) may round twice
+  //       without it
+
+  namespace detail {
+
+    template <typename T>
+    inline typename std::enable_if<std::is_floating_point<T>::value, T>::type
+    multiply_add(T a, T b, T c)
+    {
+      return std::fma(a, b, c);
+    }
+
+    template <typename T>
+    inline typename std::enable_if<!std::is_floating_point<T>::value, T>::type
+    multiply_add(T a, T b, T c)
+    {
+      return a * b + c;
+    }
+
+    // a * b + c, fused only when the target has hardware FMA //
+
+    template <typename T>
+    inline T contract_multiply_add(T a, T b, T c)
+    {
+#if PSIMD_NATIVE_FMA
+      return multiply_add(a, b, c);
+#else
+      return a * b + c;
+#endif
+    }
+
+  } // ::psimd::detail
+
+  // fma(): a * b + c //
+
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline pack<T, W> fma(const pack<T, W> &a,
+                         const pack<T, W> &b,
+                         const pack<T, W> &c)
   {
     pack<T, W> result;
 
     #pragma omp simd
     for (int i = 0; i < W; ++i)
-      result[i] = std::min(a[i], b[i]);
+      result[i] = detail::multiply_add(a[i], b[i], c[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  fma(const pack<T, W> &a, const pack<T, W> &b, const OTHER_T &c)
+  {
+    return fma(a, b, pack<T, W>(c));
+  }
+
+  template <typename T, int W, typename OTHER_T>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  fma(const pack<T, W> &a, const OTHER_T &b, const pack<T, W> &c)
+  {
+    return fma(a, pack<T, W>(b), c);
+  }
+
+  template <typename T, int W, typename OTHER_T>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  fma(const OTHER_T &a, const pack<T, W> &b, const pack<T, W> &c)
+  {
+    return fma(pack<T, W>(a), b, c);
+  }
+
+  // fms(): a * b - c //
+
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline pack<T, W> fms(const pack<T, W> &a,
+                         const pack<T, W> &b,
+                         const pack<T, W> &c)
+  {
+    pack<T, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      result[i] = detail::multiply_add(a[i], b[i], T(-c[i]));
 
     return result;
   }
 
-} // ::psimd
\ No newline at end of file
+  template <typename T, int W, typename OTHER_T>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  fms(const pack<T, W> &a, const pack<T, W> &b, const OTHER_T &c)
+  {
+    return fms(a, b, pack<T, W>(c));
+  }
+
+  template <typename T, int W, typename OTHER_T>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  fms(const pack<T, W> &a, const OTHER_T &b, const pack<T, W> &c)
+  {
+    return fms(a, pack<T, W>(b), c);
+  }
+
+  template <typename T, int W, typename OTHER_T>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  fms(const OTHER_T &a, const pack<T, W> &b, const pack<T, W> &c)
+  {
+    return fms(pack<T, W>(a), b, c);
+  }
+
+  // fnma(): -(a * b) + c //
+
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline pack<T, W> fnma(const pack<T, W> &a,
+                          const pack<T, W> &b,
+                          const pack<T, W> &c)
+  {
+    pack<T, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      result[i] = detail::multiply_add(T(-a[i]), b[i], c[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  fnma(const pack<T, W> &a, const pack<T, W> &b, const OTHER_T &c)
+  {
+    return fnma(a, b, pack<T, W>(c));
+  }
+
+  template <typename T, int W, typename OTHER_T>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  fnma(const pack<T, W> &a, const OTHER_T &b, const pack<T, W> &c)
+  {
+    return fnma(a, pack<T, W>(b), c);
+  }
+
+  template <typename T, int W, typename OTHER_T>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  fnma(const OTHER_T &a, const pack<T, W> &b, const pack<T, W> &c)
+  {
+    return fnma(pack<T, W>(a), b, c);
+  }
+
+  // fnms(): -(a * b) - c //
+
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline pack<T, W> fnms(const pack<T, W> &a,
+                          const pack<T, W> &b,
+                          const pack<T, W> &c)
+  {
+    pack<T, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      result[i] = detail::multiply_add(T(-a[i]), b[i], T(-c[i]));
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  fnms(const pack<T, W> &a, const pack<T, W> &b, const OTHER_T &c)
+  {
+    return fnms(a, b, pack<T, W>(c));
+  }
+
+  template <typename T, int W, typename OTHER_T>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  fnms(const pack<T, W> &a, const OTHER_T &b, const pack<T, W> &c)
+  {
+    return fnms(a, pack<T, W>(b), c);
+  }
+
+  template <typename T, int W, typename OTHER_T>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  fnms(const OTHER_T &a, const pack<T, W> &b, const pack<T, W> &c)
+  {
+    return fnms(pack<T, W>(a), b, c);
+  }
+
+  namespace detail {
+
+    // fma(), fms() and fnma() for the polynomials and argument reductions
+    // of the library's own functions: fused only with hardware FMA, as the
+    // lane-by-lane std::fma() elsewhere costs far more than the second
+    // rounding it saves //
+
+    template <typename A, typename B, typename C>
+    inline auto contract_fma(const A &a, const B &b, const C &c)
+        -> decltype(fma(a, b, c))
+    {
+#if PSIMD_NATIVE_FMA
+      return fma(a, b, c);
+#else
+      return decltype(fma(a, b, c))(a * b + c);
+#endif
+    }
+
+    template <typename A, typename B, typename C>
+    inline auto contract_fms(const A &a, const B &b, const C &c)
+        -> decltype(fms(a, b, c))
+    {
+#if PSIMD_NATIVE_FMA
+      return fms(a, b, c);
+#else
+      return decltype(fms(a, b, c))(a * b - c);
+#endif
+    }
+
+    template <typename A, typename B, typename C>
+    inline auto contract_fnma(const A &a, const B &b, const C &c)
+        -> decltype(fnma(a, b, c))
+    {
+#if PSIMD_NATIVE_FMA
+      return fnma(a, b, c);
+#else
+      return decltype(fnma(a, b, c))(c - a * b);
+#endif
+    }
+
+  } // ::psimd::detail
+
+PSIMD_NAMESPACE_END // ::psimd
\ No newline at end of file
@@ -24,12 +24,66 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "../bitmask.h"
 #include "../pack.h"
 
-namespace psimd {
+PSIMD_NAMESPACE_BEGIN
+
+  namespace detail {
+
+    // ptr, which the caller guarantees is aligned to ALIGNMENT bytes //
+
+    template <int ALIGNMENT, typename T>
+    inline T* assume_aligned(T *ptr)
+    {
+#if defined(__GNUC__)
+      return static_cast<T*>(__builtin_assume_aligned(ptr, ALIGNMENT));
+#else
+      return ptr;
+#endif
+    }
+
+    // Masks of T's lane width as they are, others converted to one //
+
+    template <typename T, typename M>
+    using is_lane_mask = std::is_same<M, typename mask_element<T>::type>;
+
+    template <typename T, typename M, int W>
+    inline const mask_for<T, W> &lane_mask(const pack<M, W> &m,
+                                           std::true_type /*same width*/)
+    {
+      return m;
+    }
+
+    template <typename T, typename M, int W>
+    inline mask_for<T, W> lane_mask(const pack<M, W> &m,
+                                    std::false_type /*same width*/)
+    {
+      using to_mask_t = typename mask_element<T>::type;
+      return mask_converter<to_mask_t, M, W>::convert(m);
+    }
+
+  } // ::psimd::detail
+
+  // Cache levels which prefetch() brings lines into //
+
+  enum class cache_level
+  {
+    l1,           // prefetcht0
+    l2,           // prefetcht1
+    l3,           // prefetcht2
+    non_temporal, // prefetchnta: close to the core, minimizing pollution
+  };
 
   // load() //
 
+  // NOTE: masked loads zero the inactive lanes of the result
+
   template <typename PACK_T>
   inline PACK_T load(void* _src)
   {
@@ -43,12 +97,12 @@ namespace psimd {
     return result;
   }
 
-  template <typename PACK_T>
+  template <typename PACK_T, typename M>
   inline PACK_T load(void* _src,
-                     const mask<PACK_T::static_size> &m)
+                     const pack<M, PACK_T::static_size> &m)
   {
     auto *src = (typename PACK_T::type*) _src;
-    PACK_T result;
+    PACK_T result(typename PACK_T::type(0));
 
     #pragma omp simd
     for (int i = 0; i < PACK_T::static_size; ++i)
@@ -58,35 +112,192 @@ namespace psimd {
     return result;
   }
 
-  // gather() //
-
-  template <typename PACK_T, typename OFFSET_T>
-  inline PACK_T gather(void* _src, const pack<OFFSET_T, PACK_T::static_size> &o)
+  template <typename PACK_T>
+  inline PACK_T load(void* _src,
+                     const bitmask<PACK_T::static_size> &m)
   {
     auto *src = (typename PACK_T::type*) _src;
-    PACK_T result;
+    PACK_T result(typename PACK_T::type(0));
 
     #pragma omp simd
     for (int i = 0; i < PACK_T::static_size; ++i)
-      result[i] = src[o[i]];
+      if (m[i])
+        result[i] = src[i];
 
     return result;
   }
 
+  // load_aligned() / load_unaligned() //
+
+  // NOTE: load_aligned() requires _src to be aligned to
+  //       PACK_T::static_alignment, as are packs stored in arrays; load() and
+  //       load_unaligned() accept any address
+
+  namespace detail {
+
+    // Loads of whole packs, specialized by native backends so that the
+    // loaded register is not first assembled in memory, and per sub-pack for
+    // register-blocked packs (see native/blocked.h) //
+
+    template <typename T, int W, bool BLOCKED = is_blocked<T, W>::value>
+    struct pack_loader
+    {
+      static pack<T, W> aligned(const T *_src)
+      {
+        auto *src = assume_aligned<pack<T, W>::static_alignment>(_src);
+        pack<T, W> result;
+
+        #pragma omp simd
+        for (int i = 0; i < W; ++i)
+          result[i] = src[i];
+
+        return result;
+      }
+
+      static pack<T, W> unaligned(const T *src)
+      {
+        pack<T, W> result;
+
+        #pragma omp simd
+        for (int i = 0; i < W; ++i)
+          result[i] = src[i];
+
+        return result;
+      }
+    };
+
+  } // ::psimd::detail
+
+  template <typename PACK_T>
+  inline PACK_T load_aligned(const void* _src)
+  {
+    using T = typename PACK_T::type;
+    return detail::pack_loader<T, PACK_T::static_size>::aligned(
+        (const T*) _src);
+  }
+
+  template <typename PACK_T>
+  inline PACK_T load_unaligned(const void* _src)
+  {
+    using T = typename PACK_T::type;
+    return detail::pack_loader<T, PACK_T::static_size>::unaligned(
+        (const T*) _src);
+  }
+
+  // gather() //
+
+  // NOTE: gather<PACK_T, SCALE>() loads lane i from the byte address
+  //       base + o[i] * SCALE, for a SCALE of 1, 2, 4 or 8 as in the
+  //       addressing of vgatherdps; the other forms index elements of
+  //       PACK_T::type. Masked gathers zero the inactive lanes of the result
+
+  namespace detail {
+
+    // Gathers of pack<T, W> by pack<OFFSET_T, W> offsets, specialized by the
+    // native backends with hardware gathers and per sub-pack for
+    // register-blocked packs (see native/blocked.h) //
+
+    template <typename T, int W, typename OFFSET_T,
+              bool BLOCKED = is_blocked<T, W>::value>
+    struct pack_gatherer
+    {
+      template <int SCALE>
+      static pack<T, W> gather(const void *base, const pack<OFFSET_T, W> &o)
+      {
+        auto *bytes = (const char*) base;
+        pack<T, W> result;
+
+        #pragma omp simd
+        for (int i = 0; i < W; ++i)
+          result[i] = *(const T*) (bytes + std::ptrdiff_t(o[i]) * SCALE);
+
+        return result;
+      }
+
+      template <int SCALE>
+      static pack<T, W> gather(const void *base,
+                               const pack<OFFSET_T, W> &o,
+                               const mask_for<T, W> &m)
+      {
+        auto *bytes = (const char*) base;
+        pack<T, W> result(T(0));
+
+        #pragma omp simd
+        for (int i = 0; i < W; ++i)
+          if (m[i])
+            result[i] = *(const T*) (bytes + std::ptrdiff_t(o[i]) * SCALE);
+
+        return result;
+      }
+    };
+
+  } // ::psimd::detail
+
+  template <typename PACK_T, int SCALE, typename OFFSET_T>
+  inline PACK_T gather(const void *base,
+                       const pack<OFFSET_T, PACK_T::static_size> &o)
+  {
+    static_assert(SCALE == 1 || SCALE == 2 || SCALE == 4 || SCALE == 8,
+                  "gather<>() scale must be 1, 2, 4 or 8");
+
+    using T        = typename PACK_T::type;
+    using gatherer = detail::pack_gatherer<T, PACK_T::static_size, OFFSET_T>;
+
+    return gatherer::template gather<SCALE>(base, o);
+  }
+
+  template <typename PACK_T, int SCALE, typename OFFSET_T, typename M>
+  inline PACK_T gather(const void *base,
+                       const pack<OFFSET_T, PACK_T::static_size> &o,
+                       const pack<M, PACK_T::static_size> &m)
+  {
+    static_assert(SCALE == 1 || SCALE == 2 || SCALE == 4 || SCALE == 8,
+                  "gather<>() scale must be 1, 2, 4 or 8");
+
+    using T        = typename PACK_T::type;
+    using gatherer = detail::pack_gatherer<T, PACK_T::static_size, OFFSET_T>;
+
+    const auto &active = detail::lane_mask<T>(m, detail::is_lane_mask<T, M>());
+    return gatherer::template gather<SCALE>(base, o, active);
+  }
+
   template <typename PACK_T, typename OFFSET_T>
+  inline PACK_T gather(void* _src, const pack<OFFSET_T, PACK_T::static_size> &o)
+  {
+    using T = typename PACK_T::type;
+    return gather<PACK_T, int(sizeof(T))>(_src, o);
+  }
+
+  template <typename PACK_T, typename OFFSET_T, typename M>
   inline PACK_T gather(void* _src,
                        const pack<OFFSET_T, PACK_T::static_size> &o,
-                       const mask<PACK_T::static_size> &m)
+                       const pack<M, PACK_T::static_size> &m)
   {
-    auto *src = (typename PACK_T::type*) _src;
-    PACK_T result;
+    using T = typename PACK_T::type;
+    return gather<PACK_T, int(sizeof(T))>(_src, o, m);
+  }
 
-    #pragma omp simd
-    for (int i = 0; i < PACK_T::static_size; ++i)
-      if(m[i])
-        result[i] = src[o[i]];
+  template <typename PACK_T, int SCALE, typename OFFSET_T>
+  inline PACK_T gather(const void *base,
+                       const pack<OFFSET_T, PACK_T::static_size> &o,
+                       const bitmask<PACK_T::static_size> &m)
+  {
+    static_assert(SCALE == 1 || SCALE == 2 || SCALE == 4 || SCALE == 8,
+                  "gather<>() scale must be 1, 2, 4 or 8");
 
-    return result;
+    using T        = typename PACK_T::type;
+    using gatherer = detail::pack_gatherer<T, PACK_T::static_size, OFFSET_T>;
+
+    return gatherer::template gather<SCALE>(base, o, to_mask<T>(m));
+  }
+
+  template <typename PACK_T, typename OFFSET_T>
+  inline PACK_T gather(void* _src,
+                       const pack<OFFSET_T, PACK_T::static_size> &o,
+                       const bitmask<PACK_T::static_size> &m)
+  {
+    using T = typename PACK_T::type;
+    return gather<PACK_T, int(sizeof(T))>(_src, o, m);
   }
 
   // store() //
@@ -101,10 +312,23 @@ namespace psimd {
       dst[i] = p[i];
   }
 
+  template <typename PACK_T, typename M>
+  inline void store(const PACK_T &p,
+                    void* _dst,
+                    const pack<M, PACK_T::static_size> &m)
+  {
+    auto *dst = (typename PACK_T::type*) _dst;
+
+    #pragma omp simd
+    for (int i = 0; i < PACK_T::static_size; ++i)
+      if (m[i])
+        dst[i] = p[i];
+  }
+
   template <typename PACK_T>
   inline void store(const PACK_T &p,
                     void* _dst,
-                    const mask<PACK_T::static_size> &m)
+                    const bitmask<PACK_T::static_size> &m)
   {
     auto *dst = (typename PACK_T::type*) _dst;
 
@@ -114,32 +338,288 @@ namespace psimd {
         dst[i] = p[i];
   }
 
+  // store_aligned() / store_unaligned() //
+
+  // NOTE: store_aligned() requires _dst to be aligned to
+  //       PACK_T::static_alignment; store() and store_unaligned() accept any
+  //       address
+
+  template <typename PACK_T>
+  inline void store_aligned(const PACK_T &p, void* _dst)
+  {
+    constexpr int alignment = PACK_T::static_alignment;
+    auto *dst = detail::assume_aligned<alignment>(
+        (typename PACK_T::type*) _dst);
+
+    #pragma omp simd
+    for (int i = 0; i < PACK_T::static_size; ++i)
+      dst[i] = p[i];
+  }
+
+  template <typename PACK_T>
+  inline void store_unaligned(const PACK_T &p, void* _dst)
+  {
+    auto *dst = (typename PACK_T::type*) _dst;
+
+    #pragma omp simd
+    for (int i = 0; i < PACK_T::static_size; ++i)
+      dst[i] = p[i];
+  }
+
+  // store_stream() //
+
+  // NOTE: streaming (non-temporal) stores write around the caches, for output
+  //       which is not read again soon, e.g. a framebuffer larger than the
+  //       last level cache. _dst must be aligned as for store_aligned().
+  //       Streaming stores are weakly ordered: call stream_fence() before
+  //       other threads read what was written. Native backends lower
+  //       store_stream() to movntps/movntpd/movntdq, other packs fall back to
+  //       store_aligned()
+
+  template <typename PACK_T>
+  inline void store_stream(const PACK_T &p, void* _dst)
+  {
+    store_aligned(p, _dst);
+  }
+
+  // stream_fence(): orders preceding streaming stores before any later store,
+  //                 as sfence //
+
+  inline void stream_fence()
+  {
+#if PSIMD_NATIVE_SSE2
+    _mm_sfence();
+#else
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+#endif
+  }
+
+  // prefetch<LEVEL>(): hint to bring the cache line holding ptr into LEVEL
+  //                    ahead of its use, a no-op on targets without
+  //                    prefetch instructions //
+
+  template <cache_level LEVEL = cache_level::l1>
+  inline void prefetch(const void* ptr)
+  {
+#if PSIMD_NATIVE_SSE2
+    constexpr auto hint = LEVEL == cache_level::l1 ? _MM_HINT_T0 :
+                          LEVEL == cache_level::l2 ? _MM_HINT_T1 :
+                          LEVEL == cache_level::l3 ? _MM_HINT_T2 :
+                                                     _MM_HINT_NTA;
+    _mm_prefetch((const char*) ptr, hint);
+#elif defined(__GNUC__)
+    constexpr int locality = LEVEL == cache_level::l1 ? 3 :
+                             LEVEL == cache_level::l2 ? 2 :
+                             LEVEL == cache_level::l3 ? 1 : 0;
+    __builtin_prefetch(ptr, 0, locality);
+#else
+    (void) ptr;
+#endif
+  }
+
+  // prefetch_gather<LEVEL>(): prefetch() of &base[o[i]] for each (active)
+  //                           lane i, once per cache line //
+
+  namespace detail {
+
+    struct all_lanes_active
+    {
+      bool operator[](int) const { return true; }
+    };
+
+    template <cache_level LEVEL, typename T, typename OFFSET_T, int W,
+              typename MASK_T>
+    inline void prefetch_lines(const T *base,
+                               const pack<OFFSET_T, W> &o,
+                               const MASK_T &m)
+    {
+      std::uintptr_t lines[W];
+      int num_lines = 0;
+
+      for (int i = 0; i < W; ++i) {
+        if (!m[i])
+          continue;
+
+        const T *address = base + o[i];
+        const std::uintptr_t line =
+            reinterpret_cast<std::uintptr_t>(address) / PSIMD_CACHE_LINE_SIZE;
+
+        bool seen = false;
+        for (int j = 0; j < num_lines; ++j)
+          seen |= lines[j] == line;
+
+        if (!seen) {
+          lines[num_lines++] = line;
+          prefetch<LEVEL>(address);
+        }
+      }
+    }
+
+  } // ::psimd::detail
+
+  template <cache_level LEVEL = cache_level::l1,
+            typename T, typename OFFSET_T, int W>
+  inline void prefetch_gather(const T *base, const pack<OFFSET_T, W> &o)
+  {
+    detail::prefetch_lines<LEVEL>(base, o, detail::all_lanes_active());
+  }
+
+  template <cache_level LEVEL = cache_level::l1,
+            typename T, typename OFFSET_T, int W, typename M>
+  inline void prefetch_gather(const T *base,
+                              const pack<OFFSET_T, W> &o,
+                              const pack<M, W> &m)
+  {
+    detail::prefetch_lines<LEVEL>(base, o, m);
+  }
+
+  template <cache_level LEVEL = cache_level::l1,
+            typename T, typename OFFSET_T, int W>
+  inline void prefetch_gather(const T *base,
+                              const pack<OFFSET_T, W> &o,
+                              const bitmask<W> &m)
+  {
+    detail::prefetch_lines<LEVEL>(base, o, m);
+  }
+
   // scatter() //
 
+  // NOTE: scatter<SCALE>() stores lane i to the byte address
+  //       base + o[i] * SCALE, as gather<PACK_T, SCALE>(); where lanes share
+  //       an address the highest of them is stored last
+
+  namespace detail {
+
+    // Scatters of pack<T, W> by pack<OFFSET_T, W> offsets, specialized by the
+    // native backends with hardware scatters and per sub-pack for
+    // register-blocked packs (see native/blocked.h) //
+
+    template <typename T, int W, typename OFFSET_T,
+              bool BLOCKED = is_blocked<T, W>::value>
+    struct pack_scatterer
+    {
+      template <int SCALE>
+      static void scatter(const pack<T, W> &p,
+                          void *base,
+                          const pack<OFFSET_T, W> &o)
+      {
+        auto *bytes = (char*) base;
+
+        for (int i = 0; i < W; ++i)
+          *(T*) (bytes + std::ptrdiff_t(o[i]) * SCALE) = p[i];
+      }
+
+      template <int SCALE>
+      static void scatter(const pack<T, W> &p,
+                          void *base,
+                          const pack<OFFSET_T, W> &o,
+                          const mask_for<T, W> &m)
+      {
+        auto *bytes = (char*) base;
+
+        for (int i = 0; i < W; ++i)
+          if (m[i])
+            *(T*) (bytes + std::ptrdiff_t(o[i]) * SCALE) = p[i];
+      }
+    };
+
+  } // ::psimd::detail
+
+  template <int SCALE, typename T, int W, typename OFFSET_T>
+  inline void scatter(const pack<T, W> &p,
+                      void *base,
+                      const pack<OFFSET_T, W> &o)
+  {
+    static_assert(SCALE == 1 || SCALE == 2 || SCALE == 4 || SCALE == 8,
+                  "scatter<>() scale must be 1, 2, 4 or 8");
+
+    using scatterer = detail::pack_scatterer<T, W, OFFSET_T>;
+
+    scatterer::template scatter<SCALE>(p, base, o);
+  }
+
+  template <int SCALE, typename T, int W, typename OFFSET_T, typename M>
+  inline void scatter(const pack<T, W> &p,
+                      void *base,
+                      const pack<OFFSET_T, W> &o,
+                      const pack<M, W> &m)
+  {
+    static_assert(SCALE == 1 || SCALE == 2 || SCALE == 4 || SCALE == 8,
+                  "scatter<>() scale must be 1, 2, 4 or 8");
+
+    using scatterer = detail::pack_scatterer<T, W, OFFSET_T>;
+
+    const auto &active = detail::lane_mask<T>(m, detail::is_lane_mask<T, M>());
+    scatterer::template scatter<SCALE>(p, base, o, active);
+  }
+
   template <typename PACK_T, typename OFFSET_T>
   inline void scatter(const PACK_T &p,
                       void* _dst,
                       const pack<OFFSET_T, PACK_T::static_size> &o)
   {
-    auto *dst = (typename PACK_T::type*) _dst;
+    scatter<int(sizeof(typename PACK_T::type))>(p, _dst, o);
+  }
 
-    #pragma omp simd
-    for (int i = 0; i < PACK_T::static_size; ++i)
-      dst[o[i]] = p[i];
+  template <typename PACK_T, typename OFFSET_T, typename M>
+  inline void scatter(const PACK_T &p,
+                      void* _dst,
+                      const pack<OFFSET_T, PACK_T::static_size> &o,
+                      const pack<M, PACK_T::static_size> &m)
+  {
+    scatter<int(sizeof(typename PACK_T::type))>(p, _dst, o, m);
+  }
+
+  template <int SCALE, typename T, int W, typename OFFSET_T>
+  inline void scatter(const pack<T, W> &p,
+                      void *base,
+                      const pack<OFFSET_T, W> &o,
+                      const bitmask<W> &m)
+  {
+    static_assert(SCALE == 1 || SCALE == 2 || SCALE == 4 || SCALE == 8,
+                  "scatter<>() scale must be 1, 2, 4 or 8");
+
+    using scatterer = detail::pack_scatterer<T, W, OFFSET_T>;
+
+    scatterer::template scatter<SCALE>(p, base, o, to_mask<T>(m));
   }
 
   template <typename PACK_T, typename OFFSET_T>
   inline void scatter(const PACK_T &p,
                       void* _dst,
                       const pack<OFFSET_T, PACK_T::static_size> &o,
-                      const mask<PACK_T::static_size> &m)
+                      const bitmask<PACK_T::static_size> &m)
   {
-    auto *dst = (typename PACK_T::type*) _dst;
-
-    #pragma omp simd
-    for (int i = 0; i < PACK_T::static_size; ++i)
-      if (m[i])
-        dst[o[i]] = p[i];
+    scatter<int(sizeof(typename PACK_T::type))>(p, _dst, o, m);
   }
 
-} // ::psimd
\ No newline at end of file
+  namespace detail {
+
+    // Lanes scattering to the same address as an earlier one: lane i of
+    // previous() is the nearest active lane j < i with o[j] == o[i], or -1
+    // (see functions/scatter_reduce.h). Specialized by the native backends,
+    // with vpconflictd on AVX-512CD //
+
+    template <typename OFFSET_T, int W>
+    struct conflict_detector
+    {
+      static pack<int, W> previous(const pack<OFFSET_T, W> &o,
+                                   const mask_for<OFFSET_T, W> &m)
+      {
+        pack<int, W> result(-1);
+
+        // nearest last: farther matches are overwritten
+        for (int d = W - 1; d > 0; --d) {
+          #pragma omp simd
+          for (int i = d; i < W; ++i)
+            if (m[i] && m[i - d] && o[i] == o[i - d])
+              result[i] = i - d;
+        }
+
+        return result;
+      }
+    };
+
+  } // ::psimd::detail
+
+PSIMD_NAMESPACE_END // ::psimd
\ No newline at end of file
@@ -0,0 +1,239 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+
+#pragma once
+
+// Moving lanes within and between packs. Compile-time shuffles, broadcasts,
+// rotations and reversals are permute() with a constant index pack, which
+// the native backends lower to a single vpermps/vpermd (AVX2, AVX-512)
+// permutation. Lane shifts lower to vpalignr/valignd.
+
+#include <type_traits>
+
+#include "../pack.h"
+
+PSIMD_NAMESPACE_BEGIN
+
+  namespace detail {
+
+    // Lane i of the result is lane i - D of p, or of 'fill' for i < D //
+
+    template <typename T, int W, int D>
+    inline pack<T, W> shift_lanes_up(const pack<T, W> &p,
+                                     const pack<T, W> &fill,
+                                     std::integral_constant<int, D>)
+    {
+      pack<T, W> result;
+
+      #pragma omp simd
+      for (int i = 0; i < W; ++i)
+        result[i] = i >= D ? p[i - D] : fill[i];
+
+      return result;
+    }
+
+    // Lane i of the result is lane i + D of p, or of 'fill' for i >= W - D //
+
+    template <typename T, int W, int D>
+    inline pack<T, W> shift_lanes_down(const pack<T, W> &p,
+                                       const pack<T, W> &fill,
+                                       std::integral_constant<int, D>)
+    {
+      pack<T, W> result;
+
+      #pragma omp simd
+      for (int i = 0; i < W; ++i)
+        result[i] = i + D < W ? p[i + D] : fill[i];
+
+      return result;
+    }
+
+    template <int W, int... I>
+    inline pack<int, W> index_pack()
+    {
+      const int indices[W] = {I...};
+
+      pack<int, W> result;
+
+      for (int i = 0; i < W; ++i)
+        result[i] = indices[i];
+
+      return result;
+    }
+
+    // Lane shifts by N, 0 < |N| < W, or none or every lane shifted out //
+
+    template <int N, int W>
+    using shift_direction = std::integral_constant<int,
+        (N == 0 ? 0 : (N >= W || N <= -W) ? 2 : N > 0 ? 1 : -1)>;
+
+    template <int N, typename T, int W>
+    inline pack<T, W> shift_lanes(const pack<T, W> &p,
+                                  std::integral_constant<int, 0>)
+    {
+      return p;
+    }
+
+    template <int N, typename T, int W>
+    inline pack<T, W> shift_lanes(const pack<T, W> &,
+                                  std::integral_constant<int, 2>)
+    {
+      return pack<T, W>(T(0));
+    }
+
+    template <int N, typename T, int W>
+    inline pack<T, W> shift_lanes(const pack<T, W> &p,
+                                  std::integral_constant<int, 1>)
+    {
+      return shift_lanes_up(p, pack<T, W>(T(0)),
+                            std::integral_constant<int, N>());
+    }
+
+    template <int N, typename T, int W>
+    inline pack<T, W> shift_lanes(const pack<T, W> &p,
+                                  std::integral_constant<int, -1>)
+    {
+      return shift_lanes_down(p, pack<T, W>(T(0)),
+                              std::integral_constant<int, -N>());
+    }
+
+  } // ::psimd::detail
+
+  // permute(): lane i of the result is lane indices[i] of p, for indices in
+  //            [0, W) //
+
+  template <typename T, int W>
+  inline pack<T, W> permute(const pack<T, W> &p, const pack<int, W> &indices)
+  {
+    pack<T, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      result[i] = p[indices[i]];
+
+    return result;
+  }
+
+  // shuffle<I0, ..., IW-1>(): permute() by compile-time indices //
+
+  template <int... I, typename T, int W>
+  inline pack<T, W> shuffle(const pack<T, W> &p)
+  {
+    static_assert(sizeof...(I) == W, "shuffle<>() takes one index per lane");
+    return permute(p, detail::index_pack<W, I...>());
+  }
+
+  // broadcast<L>(): lane L of p in every lane //
+
+  template <int L, typename T, int W>
+  inline pack<T, W> broadcast(const pack<T, W> &p)
+  {
+    static_assert(L >= 0 && L < W, "broadcast<>() lane out of range");
+    return permute(p, pack<int, W>(L));
+  }
+
+  // rotate_left<N>(): lane i of the result is lane (i + N) mod W of p, as
+  //                   std::rotate() by N //
+
+  template <int N, typename T, int W>
+  inline pack<T, W> rotate_left(const pack<T, W> &p)
+  {
+    constexpr int n = ((N % W) + W) % W;
+
+    pack<int, W> indices;
+
+    for (int i = 0; i < W; ++i)
+      indices[i] = (i + n) % W;
+
+    return permute(p, indices);
+  }
+
+  // rotate_right<N>(): lane i of the result is lane (i - N) mod W of p //
+
+  template <int N, typename T, int W>
+  inline pack<T, W> rotate_right(const pack<T, W> &p)
+  {
+    return rotate_left<-(N % W)>(p);
+  }
+
+  // shift_lanes<N>(): lane i of the result is lane i - N of p, zero where
+  //                   that is out of the pack (N < 0 shifts down) //
+
+  template <int N, typename T, int W>
+  inline pack<T, W> shift_lanes(const pack<T, W> &p)
+  {
+    return detail::shift_lanes<N>(p, detail::shift_direction<N, W>());
+  }
+
+  // reverse(): lane i of the result is lane W - 1 - i of p //
+
+  template <typename T, int W>
+  inline pack<T, W> reverse(const pack<T, W> &p)
+  {
+    pack<int, W> indices;
+
+    for (int i = 0; i < W; ++i)
+      indices[i] = W - 1 - i;
+
+    return permute(p, indices);
+  }
+
+  // interleave_lo(): a[0], b[0], a[1], b[1], ... from the lower halves //
+
+  template <typename T, int W>
+  inline pack<T, W> interleave_lo(const pack<T, W> &a, const pack<T, W> &b)
+  {
+    static_assert(W % 2 == 0, "interleave_lo() requires an even width");
+
+    pack<T, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W / 2; ++i) {
+      result[2 * i]     = a[i];
+      result[2 * i + 1] = b[i];
+    }
+
+    return result;
+  }
+
+  // interleave_hi(): a[W/2], b[W/2], a[W/2 + 1], ... from the upper halves //
+
+  template <typename T, int W>
+  inline pack<T, W> interleave_hi(const pack<T, W> &a, const pack<T, W> &b)
+  {
+    static_assert(W % 2 == 0, "interleave_hi() requires an even width");
+
+    pack<T, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W / 2; ++i) {
+      result[2 * i]     = a[W / 2 + i];
+      result[2 * i + 1] = b[W / 2 + i];
+    }
+
+    return result;
+  }
+
+PSIMD_NAMESPACE_END // ::psimd
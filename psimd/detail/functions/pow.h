@@ -0,0 +1,159 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+
+#pragma once
+
+// pow(), pow<N>() and powi()
+//
+// pow<N>(x) and powi(x, n) raise x to an integral power by squaring and
+// multiplying, pow<N>() with the chain unrolled at compile time, and take
+// the reciprocal of the result for negative powers. The error grows with
+// |n|: up to 5 ulp for n = 8 and 7 ulp for n = -8.
+//
+// pow(x, y) of float and double lanes is pow<precision::accurate>(x, y), see
+// precision.h, except for a scalar y which is an integer of magnitude 8 or
+// less: such powers go through powi() and never reach the standard library.
+// For double lanes the accurate version is std::pow() on each lane, exact
+// but not vectorized. Other lane types call std::pow() on each lane too.
+
+#include <cmath>
+#include <type_traits>
+
+#include "../pack.h"
+#include "precision.h"
+
+PSIMD_NAMESPACE_BEGIN
+
+  namespace detail {
+
+    // x^N, N >= 0, by squaring and multiplying //
+
+    template <typename T, int W>
+    inline pack<T, W> pow_chain(const pack<T, W> &,
+                                std::integral_constant<int, 0>)
+    {
+      return pack<T, W>(T(1));
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> pow_chain(const pack<T, W> &x,
+                                std::integral_constant<int, 1>)
+    {
+      return x;
+    }
+
+    template <typename T, int W, int N>
+    inline pack<T, W> pow_chain(const pack<T, W> &x,
+                                std::integral_constant<int, N>)
+    {
+      const pack<T, W> half =
+          pow_chain(x, std::integral_constant<int, N / 2>());
+      const pack<T, W> squared = half * half;
+      return N % 2 ? pack<T, W>(squared * x) : squared;
+    }
+
+  } // ::psimd::detail
+
+  // pow<N>() /////////////////////////////////////////////////////////////////
+
+  template <int N, typename T, int W>
+  inline pack<T, W> pow(const pack<T, W> &x)
+  {
+    const pack<T, W> result =
+        detail::pow_chain(x, std::integral_constant<int, (N < 0 ? -N : N)>());
+    return N < 0 ? pack<T, W>(T(1) / result) : result;
+  }
+
+  // powi() ///////////////////////////////////////////////////////////////////
+
+  template <typename T, int W>
+  inline pack<T, W> powi(const pack<T, W> &x, const int n)
+  {
+    unsigned int e = n < 0 ? 0u - unsigned(n) : unsigned(n);
+
+    pack<T, W> result(T(1));
+    pack<T, W> base = x;
+
+    while (e != 0) {
+      if (e & 1)
+        result = result * base;
+      e >>= 1;
+      if (e != 0)
+        base = base * base;
+    }
+
+    return n < 0 ? pack<T, W>(T(1) / result) : result;
+  }
+
+  // pow() ////////////////////////////////////////////////////////////////////
+
+  namespace detail {
+
+    template <typename T, int W, typename OTHER_T>
+    inline pack<T, W> pow_scalar(const pack<T, W> &x,
+                                 const OTHER_T y,
+                                 std::true_type)
+    {
+      const double n = double(y);
+
+      if (std::abs(n) <= 8.0 && n == double(int(n)))
+        return powi(x, int(n));
+
+      return pow_impl(precision::accurate(), x, pack<T, W>(T(y)));
+    }
+
+    template <typename T, int W, typename OTHER_T>
+    inline pack<T, W> pow_scalar(const pack<T, W> &x,
+                                 const OTHER_T y,
+                                 std::false_type)
+    {
+      pack<T, W> result;
+
+      #pragma omp simd
+      for (int i = 0; i < W; ++i)
+        result[i] = std::pow(x[i], y);
+
+      return result;
+    }
+
+  } // ::psimd::detail
+
+  template <typename T, int W>
+  inline typename
+  std::enable_if<std::is_floating_point<T>::value, pack<T, W>>::type
+  pow(const pack<T, W> &x, const pack<T, W> &y)
+  {
+    return detail::pow_impl(precision::accurate(), x, y);
+  }
+
+  template <typename T, int W, typename OTHER_T>
+  inline typename
+  std::enable_if<std::is_arithmetic<OTHER_T>::value, pack<T, W>>::type
+  pow(const pack<T, W> &x, const OTHER_T y)
+  {
+    return detail::pow_scalar(x, y, std::is_floating_point<T>());
+  }
+
+PSIMD_NAMESPACE_END // ::psimd
@@ -0,0 +1,405 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+
+#pragma once
+
+// Precision policies for sqrt(), sin(), cos(), pow() and divide()
+//
+// The policy is given as the first template argument of the call, e.g.
+// psimd::sin<psimd::precision::fast>(x) or
+// psimd::divide<psimd::precision::exact>(a, b):
+//
+//   precision::exact     the standard library functions, lane by lane, and
+//                        the IEEE-754 square root and division
+//   precision::accurate  the bounded-ULP approximations of transcendental.h;
+//                        pow() is evaluated in double precision for float
+//                        lanes and is the exact std::pow(), lane by lane,
+//                        for double lanes; sqrt() and divide() are exact
+//   precision::fast      sqrt() and divide() from rsqrt() and rcp() of
+//                        reciprocal.h (hardware estimates refined with
+//                        Newton-Raphson steps), sin() and cos() without the
+//                        double precision reduction of float lanes nor the
+//                        standard library fallback, and pow() as
+//                        exp2(y log2(x)) in the lane precision
+//
+// Maximum error measured as in transcendental.h:
+//
+//   function         float                  double
+//   --------------   --------------------   ---------------------
+//   fast sqrt        4 ulp (3 on AVX-512)   3 ulp on AVX-512
+//   fast divide      3 ulp (1.5 on AVX-512) 1.5 ulp on AVX-512
+//   fast sin, cos    1.5e-7 absolute        as accurate
+//                    (|x| < 8192)
+//   fast pow         about 1 ulp per unit of |y log2(x)|
+//   accurate pow     1 ulp                  exact (std::pow() per lane)
+//
+// NOTE: double lanes have no vectorized accurate pow(): 1 ulp would need a
+//       log2() and exp2() carried with extra bits, which transcendental.h
+//       does not have, so they pay for a std::pow() call on each lane.
+//       precision::fast is the vectorized alternative.
+//
+// Where the backend has no hardware estimate (double lanes before AVX-512 and
+// the generic backend), the fast sqrt() and divide() are the exact ones.
+// Elsewhere they handle zero and infinite arguments; a denormal divisor gives
+// +-inf like zero does, a denormal sqrt() argument is not handled.
+//
+// Without a policy, sqrt() and operator/() are IEEE-754 exact, sin() and
+// cos() are the accurate versions and pow() is the accurate one with a fast
+// path for small integral exponents (see pow.h).
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "algorithm.h"
+#include "math.h"
+#include "reciprocal.h"
+#include "transcendental.h"
+
+PSIMD_NAMESPACE_BEGIN
+
+  namespace precision {
+
+    struct exact    {};
+    struct accurate {};
+    struct fast     {};
+
+  } // ::psimd::precision
+
+  namespace detail {
+
+    template <typename P>
+    struct is_precision
+        : std::integral_constant<bool,
+            std::is_same<P, precision::exact>::value ||
+            std::is_same<P, precision::accurate>::value ||
+            std::is_same<P, precision::fast>::value>
+    {
+    };
+
+    template <typename P, typename T, int W>
+    using precision_result =
+        typename std::enable_if<is_precision<P>::value &&
+                                std::is_floating_point<T>::value,
+                                pack<T, W>>::type;
+
+    // sqrt() //////////////////////////////////////////////////////////////
+
+    template <typename T, int W>
+    inline pack<T, W> sqrt_impl(precision::exact, const pack<T, W> &x)
+    {
+      return sqrt(x);
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> sqrt_impl(precision::accurate, const pack<T, W> &x)
+    {
+      return sqrt(x);
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> sqrt_fast(const pack<T, W> &x, std::false_type)
+    {
+      return sqrt(x);
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> sqrt_fast(const pack<T, W> &x, std::true_type)
+    {
+      const pack<T, W> result = x * rsqrt(x);
+      const T inf = std::numeric_limits<T>::infinity();
+      const auto keep = (x == T(0)) || (x == inf);
+      return select(keep, x, result);
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> sqrt_impl(precision::fast, const pack<T, W> &x)
+    {
+      return sqrt_fast(x, has_native_estimate<T, W>());
+    }
+
+    // divide() ////////////////////////////////////////////////////////////
+
+    template <typename T, int W>
+    inline pack<T, W> divide_impl(precision::exact,
+                                  const pack<T, W> &a,
+                                  const pack<T, W> &b)
+    {
+      return a / b;
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> divide_impl(precision::accurate,
+                                  const pack<T, W> &a,
+                                  const pack<T, W> &b)
+    {
+      return a / b;
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> divide_fast(const pack<T, W> &a,
+                                  const pack<T, W> &b,
+                                  std::false_type)
+    {
+      return a / b;
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> divide_fast(const pack<T, W> &a,
+                                  const pack<T, W> &b,
+                                  std::true_type)
+    {
+      return a * rcp(b);
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> divide_impl(precision::fast,
+                                  const pack<T, W> &a,
+                                  const pack<T, W> &b)
+    {
+      return divide_fast(a, b, has_native_estimate<T, W>());
+    }
+
+    // sin() and cos() /////////////////////////////////////////////////////
+
+    // NOTE: the exact versions are deliberately not '#pragma omp simd'
+    //       loops, which may be compiled to calls of the vector math
+    //       library (libmvec, SVML) instead of the scalar functions
+
+    template <typename T, int W>
+    inline pack<T, W> sin_impl(precision::exact, const pack<T, W> &x)
+    {
+      pack<T, W> result;
+
+      for (int i = 0; i < W; ++i)
+        result[i] = std::sin(x[i]);
+
+      return result;
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> sin_impl(precision::accurate, const pack<T, W> &x)
+    {
+      return sin(x);
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> sin_impl(precision::fast, const pack<T, W> &x)
+    {
+      pack<T, W> s, c;
+      sincos_fast(x, s, c);
+      return s;
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> cos_impl(precision::exact, const pack<T, W> &x)
+    {
+      pack<T, W> result;
+
+      for (int i = 0; i < W; ++i)
+        result[i] = std::cos(x[i]);
+
+      return result;
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> cos_impl(precision::accurate, const pack<T, W> &x)
+    {
+      return cos(x);
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> cos_impl(precision::fast, const pack<T, W> &x)
+    {
+      pack<T, W> s, c;
+      sincos_fast(x, s, c);
+      return c;
+    }
+
+    // pow() ///////////////////////////////////////////////////////////////
+
+    // |x|^y, in the precision of T //
+
+    template <typename T, int W>
+    inline pack<T, W> pow_magnitude(const pack<T, W> &ax, const pack<T, W> &y)
+    {
+      const pack<T, W> l = log2(ax);
+      return exp2(pack<T, W>(y * l));
+    }
+
+    // pow(x, y) from r = |x|^y: sign of negative bases and the special cases
+    // of std::pow() which exp2(y log2(|x|)) does not produce on its own //
+
+    template <typename T, int W>
+    inline pack<T, W> pow_special(const pack<T, W> &x,
+                                  const pack<T, W> &y,
+                                  const pack<T, W> &r)
+    {
+      using limits = std::numeric_limits<T>;
+      using int_type = typename float_layout<T>::int_type;
+
+      // every |y| >= 2^m is an integer, every |y| >= 2^(m + 1) an even one
+      const T two_m = T(1ll << float_layout<T>::mantissa_bits);
+
+      const pack<T, W> ax = abs(x);
+      const pack<T, W> ay = abs(y);
+      const pack<T, W> half = ay * T(0.5);
+
+      // integer parts of ay and ay / 2 (trunc() rather than adding and
+      // subtracting 2^m, which -ffast-math folds away)
+      const pack<T, W> ay_int   = trunc(ay);
+      const pack<T, W> half_int = trunc(half);
+
+      const auto integral     = (ay >= two_m) || (ay_int == ay);
+      const auto non_integral = (ay < two_m) && (ay_int != ay);
+      const auto odd = integral && (ay < T(2) * two_m) && (half_int != half);
+
+      const auto negative = bit_cast<pack<int_type, W>>(x) < int_type(0);
+
+      pack<T, W> result = select(negative && odd, pack<T, W>(-r), r);
+      const auto finite_negative = (x < T(0)) && (ax < limits::infinity());
+      result = select(finite_negative && non_integral,
+                      pack<T, W>(limits::quiet_NaN()), result);
+
+      // pow(x, 0) and pow(1, y) are 1 even for NaN, pow(-1, +-inf) is 1
+      const auto one = (y == T(0)) || (x == T(1)) ||
+                       ((ax == T(1)) && (ay == limits::infinity()));
+      return select(one, pack<T, W>(T(1)), result);
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> pow_impl(precision::exact,
+                               const pack<T, W> &x,
+                               const pack<T, W> &y)
+    {
+      pack<T, W> result;
+
+      for (int i = 0; i < W; ++i)
+        result[i] = std::pow(x[i], y[i]);
+
+      return result;
+    }
+
+    template <int W>
+    inline pack<float, W> pow_impl(precision::accurate,
+                                   const pack<float, W> &x,
+                                   const pack<float, W> &y)
+    {
+      const pack<double, W> r = pow_magnitude(abs(x).template as<double>(),
+                                              y.template as<double>());
+      return pow_special(x, y, r.template as<float>());
+    }
+
+    // std::pow() on each lane, see the NOTE at the top //
+
+    template <int W>
+    inline pack<double, W> pow_impl(precision::accurate,
+                                    const pack<double, W> &x,
+                                    const pack<double, W> &y)
+    {
+      return pow_impl(precision::exact(), x, y);
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> pow_impl(precision::fast,
+                               const pack<T, W> &x,
+                               const pack<T, W> &y)
+    {
+      return pow_special(x, y, pow_magnitude(pack<T, W>(abs(x)), y));
+    }
+
+  } // ::psimd::detail
+
+  // sqrt() ///////////////////////////////////////////////////////////////////
+
+  template <typename PRECISION, typename T, int W>
+  inline detail::precision_result<PRECISION, T, W>
+  sqrt(const pack<T, W> &x)
+  {
+    return detail::sqrt_impl(PRECISION(), x);
+  }
+
+  // divide() /////////////////////////////////////////////////////////////////
+
+  template <typename PRECISION, typename T, int W>
+  inline detail::precision_result<PRECISION, T, W>
+  divide(const pack<T, W> &a, const pack<T, W> &b)
+  {
+    return detail::divide_impl(PRECISION(), a, b);
+  }
+
+  template <typename PRECISION, typename T, int W, typename OTHER_T>
+  inline typename std::enable_if<std::is_convertible<OTHER_T, T>::value,
+                                 detail::precision_result<PRECISION, T, W>
+                                >::type
+  divide(const pack<T, W> &a, const OTHER_T &b)
+  {
+    return detail::divide_impl(PRECISION(), a, pack<T, W>(b));
+  }
+
+  template <typename PRECISION, typename T, int W, typename OTHER_T>
+  inline typename std::enable_if<std::is_convertible<OTHER_T, T>::value,
+                                 detail::precision_result<PRECISION, T, W>
+                                >::type
+  divide(const OTHER_T &a, const pack<T, W> &b)
+  {
+    return detail::divide_impl(PRECISION(), pack<T, W>(a), b);
+  }
+
+  // sin() and cos() //////////////////////////////////////////////////////////
+
+  template <typename PRECISION, typename T, int W>
+  inline detail::precision_result<PRECISION, T, W>
+  sin(const pack<T, W> &x)
+  {
+    return detail::sin_impl(PRECISION(), x);
+  }
+
+  template <typename PRECISION, typename T, int W>
+  inline detail::precision_result<PRECISION, T, W>
+  cos(const pack<T, W> &x)
+  {
+    return detail::cos_impl(PRECISION(), x);
+  }
+
+  // pow() ////////////////////////////////////////////////////////////////////
+
+  template <typename PRECISION, typename T, int W>
+  inline detail::precision_result<PRECISION, T, W>
+  pow(const pack<T, W> &x, const pack<T, W> &y)
+  {
+    return detail::pow_impl(PRECISION(), x, y);
+  }
+
+  template <typename PRECISION, typename T, int W, typename OTHER_T>
+  inline typename std::enable_if<std::is_convertible<OTHER_T, T>::value,
+                                 detail::precision_result<PRECISION, T, W>
+                                >::type
+  pow(const pack<T, W> &x, const OTHER_T &y)
+  {
+    return detail::pow_impl(PRECISION(), x, pack<T, W>(y));
+  }
+
+PSIMD_NAMESPACE_END // ::psimd
@@ -0,0 +1,212 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+
+#pragma once
+
+// Reciprocal and reciprocal square root
+//
+// rcp_fast() and rsqrt_fast() are the hardware estimates of 1 / x and
+// 1 / sqrt(x): rcpps/rsqrtps (relative error below 1.5 * 2^-12) or, on
+// AVX-512, rcp14/rsqrt14 (below 2^-14). rcp() and rsqrt() refine the
+// estimates with Newton-Raphson steps, one for float and two for double
+// lanes, as rcp()/rsqrt() of embc's vfloat8 do. Maximum error measured as in
+// transcendental.h:
+//
+//   function     float                    double
+//   ----------   ----------------------   -----------------
+//   rcp          3 ulp (1 on AVX-512)     1 ulp on AVX-512
+//   rsqrt        4 ulp (2 on AVX-512)     2.5 ulp on AVX-512
+//
+// Packs without hardware estimates (double lanes before AVX-512 and the
+// generic backend) compute 1 / x and 1 / sqrt(x) instead, for all four
+// functions. rcp(+-0) and rsqrt(+-0) are +-inf, rcp(+-inf) and rsqrt(inf)
+// are +-0, also under -ffast-math, NaN propagates. rcp() of a denormal is
+// +-inf, as the hardware estimates flush it to zero (the exact reciprocal of
+// the largest denormals would still be finite); rsqrt() of denormals is not
+// handled. Where the reciprocal itself is denormal, i.e. for float arguments
+// above 2^126 on SSE and AVX2, the flushed estimate makes rcp() +-0.
+
+#include <limits>
+#include <type_traits>
+
+#include "algorithm.h"
+#include "classify.h"
+#include "math.h"
+
+PSIMD_NAMESPACE_BEGIN
+
+  namespace detail {
+
+    template <typename T, int W>
+    using reciprocal_result =
+        typename std::enable_if<std::is_floating_point<T>::value,
+                                pack<T, W>>::type;
+
+    // Newton-Raphson steps taking an estimate with at least 12 bits to the
+    // full precision of T //
+
+    template <typename T>
+    constexpr int newton_steps()
+    {
+      return sizeof(T) == 8 ? 2 : 1;
+    }
+
+    // The bits of the smallest normal number, below which magnitude_bits()
+    // are those of zero or a denormal //
+
+    template <typename T, int W>
+    inline mask_for<T, W> min_normal_bits()
+    {
+      const pack<T, W> min_normal(std::numeric_limits<T>::min());
+      return bit_cast<mask_for<T, W>>(min_normal);
+    }
+
+    // NOTE: a Newton step turns the exact estimates of 0 and inf into NaN
+    //       (0 * inf), and so do the steps compilers emit for 1 / x and
+    //       1 / sqrt(x) under -ffast-math; those lanes are set from the bits
+    //       of x, which no floating point assumption can fold away
+
+    template <typename T, int W>
+    inline pack<T, W> rcp_special_lanes(const pack<T, W> &x,
+                                        const pack<T, W> &y)
+    {
+      const mask_for<T, W> bits = magnitude_bits(x);
+      const pack<T, W> inf(std::numeric_limits<T>::infinity());
+
+      // zero and denormal lanes, whose estimates are inf
+      const pack<T, W> r = select(bits < min_normal_bits<T, W>(),
+                                  copysign(inf, x),
+                                  y);
+      return select(bits == inf_bits<T, W>(),
+                    copysign(pack<T, W>(T(0)), x),
+                    r);
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> rsqrt_special_lanes(const pack<T, W> &x,
+                                          const pack<T, W> &y)
+    {
+      const pack<T, W> inf(std::numeric_limits<T>::infinity());
+
+      const pack<T, W> r = select(magnitude_bits(x) == mask_for<T, W>(0),
+                                  copysign(inf, x),
+                                  y);
+      return select(bit_cast<mask_for<T, W>>(x) == inf_bits<T, W>(),
+                    pack<T, W>(T(0)),
+                    r);
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> rcp_impl(const pack<T, W> &x, std::true_type)
+    {
+      pack<T, W> y = rcp_estimate(x);
+
+      // y (2 - x y)
+      for (int i = 0; i < newton_steps<T>(); ++i)
+        y = contract_fma(y, contract_fnma(x, y, T(1)), y);
+
+      return rcp_special_lanes(x, y);
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> rcp_impl(const pack<T, W> &x, std::false_type)
+    {
+      return rcp_special_lanes(x, pack<T, W>(T(1) / x));
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> rsqrt_impl(const pack<T, W> &x, std::true_type)
+    {
+      pack<T, W> y = rsqrt_estimate(x);
+      const pack<T, W> half_x = x * T(0.5);
+
+      // y (3/2 - x/2 y^2)
+      for (int i = 0; i < newton_steps<T>(); ++i)
+        y = y * contract_fnma(half_x * y, y, T(1.5));
+
+      return rsqrt_special_lanes(x, y);
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> rsqrt_impl(const pack<T, W> &x, std::false_type)
+    {
+      return rsqrt_special_lanes(x, pack<T, W>(T(1) / sqrt(x)));
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> rcp_fast_impl(const pack<T, W> &x, std::true_type)
+    {
+      return rcp_estimate(x);
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> rcp_fast_impl(const pack<T, W> &x, std::false_type)
+    {
+      return pack<T, W>(T(1) / x);
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> rsqrt_fast_impl(const pack<T, W> &x, std::true_type)
+    {
+      return rsqrt_estimate(x);
+    }
+
+    template <typename T, int W>
+    inline pack<T, W> rsqrt_fast_impl(const pack<T, W> &x, std::false_type)
+    {
+      return pack<T, W>(T(1) / sqrt(x));
+    }
+
+  } // ::psimd::detail
+
+  // rcp() and rcp_fast() /////////////////////////////////////////////////////
+
+  template <typename T, int W>
+  inline detail::reciprocal_result<T, W> rcp(const pack<T, W> &x)
+  {
+    return detail::rcp_impl(x, detail::has_native_estimate<T, W>());
+  }
+
+  template <typename T, int W>
+  inline detail::reciprocal_result<T, W> rcp_fast(const pack<T, W> &x)
+  {
+    return detail::rcp_fast_impl(x, detail::has_native_estimate<T, W>());
+  }
+
+  // rsqrt() and rsqrt_fast() /////////////////////////////////////////////////
+
+  template <typename T, int W>
+  inline detail::reciprocal_result<T, W> rsqrt(const pack<T, W> &x)
+  {
+    return detail::rsqrt_impl(x, detail::has_native_estimate<T, W>());
+  }
+
+  template <typename T, int W>
+  inline detail::reciprocal_result<T, W> rsqrt_fast(const pack<T, W> &x)
+  {
+    return detail::rsqrt_fast_impl(x, detail::has_native_estimate<T, W>());
+  }
+
+PSIMD_NAMESPACE_END // ::psimd
@@ -0,0 +1,338 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+
+#pragma once
+
+// Horizontal reductions of a pack to a scalar. Lanes are combined as a tree:
+// a power of two wide pack takes log2(W) steps of one butterfly shuffle and
+// one lanewise operation, instead of a chain of W - 1 dependent operations.
+// Register-blocked packs first combine their sub-packs, also as a tree.
+//
+// NOTE: floating point reduce_add() and reduce_mul() therefore round
+//       differently than a left to right loop over the lanes.
+//
+// The masked variants substitute the identity of the operation for inactive
+// lanes, which is also their result when no lane is active.
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#include "../pack.h"
+
+PSIMD_NAMESPACE_BEGIN
+
+  namespace detail {
+
+    // Lane i of the result is lane i ^ S of p, specialized by the native
+    // backends as register shuffles //
+
+    template <typename T, int W, int S>
+    inline pack<T, W> butterfly(const pack<T, W> &p,
+                                std::integral_constant<int, S>)
+    {
+      pack<T, W> result;
+
+      #pragma omp simd
+      for (int i = 0; i < W; ++i)
+        result[i] = p[i ^ S];
+
+      return result;
+    }
+
+    // Operations and their identities, applicable to packs and lanes alike //
+
+    struct reduce_add_op
+    {
+      template <typename V>
+      V operator()(const V &a, const V &b) const { return V(a + b); }
+
+      template <typename T>
+      static T identity() { return T(0); }
+    };
+
+    struct reduce_mul_op
+    {
+      template <typename V>
+      V operator()(const V &a, const V &b) const { return V(a * b); }
+
+      template <typename T>
+      static T identity() { return T(1); }
+    };
+
+    struct reduce_min_op
+    {
+      template <typename V>
+      V operator()(const V &a, const V &b) const
+      {
+        using std::min;
+        return min(a, b);
+      }
+
+      template <typename T>
+      static T identity()
+      {
+        using limits = std::numeric_limits<T>;
+        return limits::has_infinity ? limits::infinity() : limits::max();
+      }
+    };
+
+    struct reduce_max_op
+    {
+      template <typename V>
+      V operator()(const V &a, const V &b) const
+      {
+        using std::max;
+        return max(a, b);
+      }
+
+      template <typename T>
+      static T identity()
+      {
+        using limits = std::numeric_limits<T>;
+        return limits::has_infinity ? -limits::infinity() : limits::lowest();
+      }
+    };
+
+    struct reduce_and_op
+    {
+      template <typename V>
+      V operator()(const V &a, const V &b) const { return V(a & b); }
+
+      template <typename T>
+      static T identity() { return T(~T(0)); }
+    };
+
+    struct reduce_or_op
+    {
+      template <typename V>
+      V operator()(const V &a, const V &b) const { return V(a | b); }
+
+      template <typename T>
+      static T identity() { return T(0); }
+    };
+
+    struct reduce_xor_op
+    {
+      template <typename V>
+      V operator()(const V &a, const V &b) const { return V(a ^ b); }
+
+      template <typename T>
+      static T identity() { return T(0); }
+    };
+
+    // Butterfly steps S = W / 2, ..., 1, leaving the result in every lane //
+
+    template <typename T, int W, typename OP>
+    inline pack<T, W> reduce_steps(const pack<T, W> &p, OP,
+                                   std::integral_constant<int, 0>)
+    {
+      return p;
+    }
+
+    template <typename T, int W, typename OP, int S>
+    inline pack<T, W> reduce_steps(const pack<T, W> &p, OP op,
+                                   std::integral_constant<int, S>)
+    {
+      const pack<T, W> folded =
+          op(p, butterfly(p, std::integral_constant<int, S>()));
+      return reduce_steps(folded, op, std::integral_constant<int, S / 2>());
+    }
+
+    // Tree over the first n elements of 'values', combining the upper half
+    // into the lower one until a single element is left //
+
+    template <typename V, typename OP>
+    inline V reduce_array(V *values, int n, OP op)
+    {
+      for (; n > 1; n -= n / 2) {
+        const int half = n / 2;
+        for (int i = 0; i < half; ++i)
+          values[i] = op(values[i], values[n - half + i]);
+      }
+
+      return values[0];
+    }
+
+    template <typename T, int W, typename OP>
+    inline T reduce_lanes(const pack<T, W> &p, OP op,
+                          std::true_type /*power of two*/)
+    {
+      return reduce_steps(p, op, std::integral_constant<int, W / 2>())[0];
+    }
+
+    template <typename T, int W, typename OP>
+    inline T reduce_lanes(const pack<T, W> &p, OP op,
+                          std::false_type /*power of two*/)
+    {
+      pack<T, W> lanes = p;
+      return reduce_array(lanes.data, W, op);
+    }
+
+    template <typename T, int W, typename OP>
+    inline T reduce(const pack<T, W> &p, OP op,
+                    std::false_type /*blocked*/)
+    {
+      using power_of_two = std::integral_constant<bool, (W & (W - 1)) == 0>;
+      return reduce_lanes(p, op, power_of_two());
+    }
+
+    template <typename T, int W, typename OP>
+    inline T reduce(const pack<T, W> &p, OP op,
+                    std::true_type /*blocked*/)
+    {
+      constexpr int block_size = blocking<T, W>::block_size;
+
+      pack<T, W> blocks = p;
+      const pack<T, block_size> combined =
+          reduce_array(blocks.v.block, blocking<T, W>::blocks, op);
+
+      return reduce(combined, op, std::false_type());
+    }
+
+    template <typename T, int W, typename OP>
+    inline T reduce(const pack<T, W> &p, OP op)
+    {
+      return reduce(p, op, is_blocked<T, W>());
+    }
+
+    template <typename T, int W, typename M, typename OP>
+    inline T reduce(const pack<T, W> &p, const pack<M, W> &m, OP op)
+    {
+      const pack<T, W> identity(OP::template identity<T>());
+      return reduce(select(m, p, identity), op);
+    }
+
+  } // ::psimd::detail
+
+  // reduce_add(): sum of the lanes //
+
+  template <typename T, int W>
+  inline T reduce_add(const pack<T, W> &p)
+  {
+    return detail::reduce(p, detail::reduce_add_op());
+  }
+
+  template <typename T, int W, typename M>
+  inline typename std::enable_if<detail::is_mask_element<M>::value, T>::type
+  reduce_add(const pack<T, W> &p, const pack<M, W> &m)
+  {
+    return detail::reduce(p, m, detail::reduce_add_op());
+  }
+
+  // reduce_mul(): product of the lanes //
+
+  template <typename T, int W>
+  inline T reduce_mul(const pack<T, W> &p)
+  {
+    return detail::reduce(p, detail::reduce_mul_op());
+  }
+
+  template <typename T, int W, typename M>
+  inline typename std::enable_if<detail::is_mask_element<M>::value, T>::type
+  reduce_mul(const pack<T, W> &p, const pack<M, W> &m)
+  {
+    return detail::reduce(p, m, detail::reduce_mul_op());
+  }
+
+  // reduce_min(): smallest lane //
+
+  template <typename T, int W>
+  inline T reduce_min(const pack<T, W> &p)
+  {
+    return detail::reduce(p, detail::reduce_min_op());
+  }
+
+  template <typename T, int W, typename M>
+  inline typename std::enable_if<detail::is_mask_element<M>::value, T>::type
+  reduce_min(const pack<T, W> &p, const pack<M, W> &m)
+  {
+    return detail::reduce(p, m, detail::reduce_min_op());
+  }
+
+  // reduce_max(): largest lane //
+
+  template <typename T, int W>
+  inline T reduce_max(const pack<T, W> &p)
+  {
+    return detail::reduce(p, detail::reduce_max_op());
+  }
+
+  template <typename T, int W, typename M>
+  inline typename std::enable_if<detail::is_mask_element<M>::value, T>::type
+  reduce_max(const pack<T, W> &p, const pack<M, W> &m)
+  {
+    return detail::reduce(p, m, detail::reduce_max_op());
+  }
+
+  // reduce_and(): bitwise and of the lanes //
+
+  template <typename T, int W, detail::integral<T> = 0>
+  inline T reduce_and(const pack<T, W> &p)
+  {
+    return detail::reduce(p, detail::reduce_and_op());
+  }
+
+  template <typename T, int W, typename M,
+            detail::integral<T> = 0>
+  inline typename std::enable_if<detail::is_mask_element<M>::value, T>::type
+  reduce_and(const pack<T, W> &p, const pack<M, W> &m)
+  {
+    return detail::reduce(p, m, detail::reduce_and_op());
+  }
+
+  // reduce_or(): bitwise or of the lanes //
+
+  template <typename T, int W, detail::integral<T> = 0>
+  inline T reduce_or(const pack<T, W> &p)
+  {
+    return detail::reduce(p, detail::reduce_or_op());
+  }
+
+  template <typename T, int W, typename M,
+            detail::integral<T> = 0>
+  inline typename std::enable_if<detail::is_mask_element<M>::value, T>::type
+  reduce_or(const pack<T, W> &p, const pack<M, W> &m)
+  {
+    return detail::reduce(p, m, detail::reduce_or_op());
+  }
+
+  // reduce_xor(): bitwise xor of the lanes //
+
+  template <typename T, int W, detail::integral<T> = 0>
+  inline T reduce_xor(const pack<T, W> &p)
+  {
+    return detail::reduce(p, detail::reduce_xor_op());
+  }
+
+  template <typename T, int W, typename M,
+            detail::integral<T> = 0>
+  inline typename std::enable_if<detail::is_mask_element<M>::value, T>::type
+  reduce_xor(const pack<T, W> &p, const pack<M, W> &m)
+  {
+    return detail::reduce(p, m, detail::reduce_xor_op());
+  }
+
+PSIMD_NAMESPACE_END // ::psimd
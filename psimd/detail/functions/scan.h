@@ -0,0 +1,277 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+
+#pragma once
+
+// Prefix scans within a pack, in log2(W) steps: step D = 1, 2, 4, ... combines
+// each lane with the lane D below it, shifting in the identity of the
+// operation at the bottom. A register-blocked pack scans its sub-packs in
+// order, carrying the last lane of one into the next.
+//
+// The segmented variants take a mask of segment heads: a scan restarts at
+// every active lane, so that no lane combines with lanes below its head.
+
+#include <type_traits>
+
+#include "permute.h"
+#include "reduce.h"
+
+PSIMD_NAMESPACE_BEGIN
+
+  // Operations of the scans, e.g. inclusive_scan(p, maximum()) //
+
+  using plus    = detail::reduce_add_op;
+  using minimum = detail::reduce_min_op;
+  using maximum = detail::reduce_max_op;
+
+  namespace detail {
+
+    template <int D, int W>
+    using scan_continues = std::integral_constant<bool, (D < W)>;
+
+    // Inclusive scan steps D, 2D, ... below W //
+
+    template <typename T, int W, typename OP, int D>
+    inline pack<T, W> scan_steps(const pack<T, W> &p,
+                                 const pack<T, W> &,
+                                 OP,
+                                 std::integral_constant<int, D>,
+                                 std::false_type /*continues*/)
+    {
+      return p;
+    }
+
+    template <typename T, int W, typename OP, int D>
+    inline pack<T, W> scan_steps(const pack<T, W> &p,
+                                 const pack<T, W> &identity,
+                                 OP op,
+                                 std::integral_constant<int, D>,
+                                 std::true_type /*continues*/)
+    {
+      const pack<T, W> below =
+          shift_lanes_up(p, identity, std::integral_constant<int, D>());
+
+      return scan_steps(op(below, p), identity, op,
+                        std::integral_constant<int, 2 * D>(),
+                        scan_continues<2 * D, W>());
+    }
+
+    // Segmented steps, where 'done' marks the lanes which already combine
+    // every lane down to their head //
+
+    template <typename T, int W, typename OP, int D>
+    inline pack<T, W> segmented_scan_steps(const pack<T, W> &p,
+                                           mask_for<T, W> &,
+                                           const pack<T, W> &,
+                                           OP,
+                                           std::integral_constant<int, D>,
+                                           std::false_type /*continues*/)
+    {
+      return p;
+    }
+
+    template <typename T, int W, typename OP, int D>
+    inline pack<T, W> segmented_scan_steps(const pack<T, W> &p,
+                                           mask_for<T, W> &done,
+                                           const pack<T, W> &identity,
+                                           OP op,
+                                           std::integral_constant<int, D>,
+                                           std::true_type /*continues*/)
+    {
+      using step = std::integral_constant<int, D>;
+
+      const pack<T, W> below = shift_lanes_up(p, identity, step());
+      const pack<T, W> next  = select(done, p, op(below, p));
+
+      done = done | shift_lanes_up(done, mask_for<T, W>(0), step());
+
+      return segmented_scan_steps(next, done, identity, op,
+                                  std::integral_constant<int, 2 * D>(),
+                                  scan_continues<2 * D, W>());
+    }
+
+    template <typename T, int W, typename OP>
+    inline pack<T, W> scan_lanes(const pack<T, W> &p,
+                                 const pack<T, W> &identity,
+                                 OP op)
+    {
+      return scan_steps(p, identity, op,
+                        std::integral_constant<int, 1>(),
+                        scan_continues<1, W>());
+    }
+
+    template <typename T, int W, typename OP>
+    inline pack<T, W> segmented_scan_lanes(const pack<T, W> &p,
+                                           mask_for<T, W> &done,
+                                           const pack<T, W> &identity,
+                                           OP op)
+    {
+      return segmented_scan_steps(p, done, identity, op,
+                                  std::integral_constant<int, 1>(),
+                                  scan_continues<1, W>());
+    }
+
+    // Scans of whole packs //
+
+    template <typename T, int W, typename OP>
+    inline pack<T, W> scan(const pack<T, W> &p,
+                           OP op,
+                           bool exclusive,
+                           std::false_type /*blocked*/)
+    {
+      const pack<T, W> identity(OP::template identity<T>());
+      const pack<T, W> inclusive = scan_lanes(p, identity, op);
+
+      return exclusive ? shift_lanes_up(inclusive, identity,
+                                        std::integral_constant<int, 1>()) :
+                         inclusive;
+    }
+
+    template <typename T, int W, typename OP>
+    inline pack<T, W> scan(const pack<T, W> &p,
+                           OP op,
+                           bool exclusive,
+                           std::true_type /*blocked*/)
+    {
+      constexpr int block_size = blocking<T, W>::block_size;
+      using block_t = pack<T, block_size>;
+
+      const block_t identity(OP::template identity<T>());
+      block_t carry = identity;
+
+      pack<T, W> result;
+
+      for (int b = 0; b < blocking<T, W>::blocks; ++b) {
+        const block_t inclusive =
+            op(carry, scan_lanes(p.v.block[b], identity, op));
+
+        result.v.block[b] = exclusive ?
+            shift_lanes_up(inclusive, carry,
+                           std::integral_constant<int, 1>()) :
+            inclusive;
+
+        carry = block_t(inclusive[block_size - 1]);
+      }
+
+      return result;
+    }
+
+    template <typename T, int W, typename OP>
+    inline pack<T, W> segmented_scan(const pack<T, W> &p,
+                                     const mask_for<T, W> &heads,
+                                     OP op,
+                                     bool exclusive,
+                                     std::false_type /*blocked*/)
+    {
+      const pack<T, W> identity(OP::template identity<T>());
+
+      mask_for<T, W> done = heads;
+      const pack<T, W> inclusive = segmented_scan_lanes(p, done, identity, op);
+
+      if (!exclusive)
+        return inclusive;
+
+      return select(heads, identity, shift_lanes_up(
+          inclusive, identity, std::integral_constant<int, 1>()));
+    }
+
+    template <typename T, int W, typename OP>
+    inline pack<T, W> segmented_scan(const pack<T, W> &p,
+                                     const mask_for<T, W> &heads,
+                                     OP op,
+                                     bool exclusive,
+                                     std::true_type /*blocked*/)
+    {
+      constexpr int block_size = blocking<T, W>::block_size;
+      using block_t = pack<T, block_size>;
+      using block_mask_t = mask_for<T, block_size>;
+
+      const block_t identity(OP::template identity<T>());
+      block_t carry = identity;
+
+      pack<T, W> result;
+
+      for (int b = 0; b < blocking<T, W>::blocks; ++b) {
+        block_mask_t block_heads;
+        for (int i = 0; i < block_size; ++i)
+          block_heads[i] = heads[b * block_size + i];
+
+        // lanes without a head at or below them continue the previous block
+        block_mask_t done = block_heads;
+        const block_t scanned =
+            segmented_scan_lanes(p.v.block[b], done, identity, op);
+        const block_t inclusive = select(done, scanned, op(carry, scanned));
+
+        result.v.block[b] = exclusive ?
+            select(block_heads, identity, shift_lanes_up(
+                inclusive, carry, std::integral_constant<int, 1>())) :
+            inclusive;
+
+        carry = block_t(inclusive[block_size - 1]);
+      }
+
+      return result;
+    }
+
+  } // ::psimd::detail
+
+  // inclusive_scan(): lane i combines lanes 0 to i //
+
+  template <typename T, int W, typename OP = plus>
+  inline pack<T, W> inclusive_scan(const pack<T, W> &p, OP op = OP())
+  {
+    return detail::scan(p, op, false, detail::is_blocked<T, W>());
+  }
+
+  // exclusive_scan(): lane i combines lanes 0 to i - 1, lane 0 is the
+  //                   identity of the operation //
+
+  template <typename T, int W, typename OP = plus>
+  inline pack<T, W> exclusive_scan(const pack<T, W> &p, OP op = OP())
+  {
+    return detail::scan(p, op, true, detail::is_blocked<T, W>());
+  }
+
+  // Segmented versions, restarting at the lanes active in 'heads' //
+
+  template <typename T, int W, typename M, typename OP = plus>
+  inline typename
+  std::enable_if<detail::is_mask_element<M>::value, pack<T, W>>::type
+  inclusive_scan(const pack<T, W> &p, const pack<M, W> &heads, OP op = OP())
+  {
+    return detail::segmented_scan(p, mask_cast<T>(heads), op, false,
+                                  detail::is_blocked<T, W>());
+  }
+
+  template <typename T, int W, typename M, typename OP = plus>
+  inline typename
+  std::enable_if<detail::is_mask_element<M>::value, pack<T, W>>::type
+  exclusive_scan(const pack<T, W> &p, const pack<M, W> &heads, OP op = OP())
+  {
+    return detail::segmented_scan(p, mask_cast<T>(heads), op, true,
+                                  detail::is_blocked<T, W>());
+  }
+
+PSIMD_NAMESPACE_END // ::psimd
@@ -0,0 +1,166 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+
+#pragma once
+
+// Read-modify-write scatters: scatter_add(), scatter_min() and scatter_max()
+// combine each lane's value into base[o[i]], also where several lanes share
+// an offset (e.g. a histogram of a pack of samples). Lanes repeating an
+// earlier lane's offset are found by detail::conflict_detector<>, vpconflictd
+// on AVX-512CD, and each lane is combined with the lanes before it of the same
+// offset by pointer jumping along those links, which takes log2 of the
+// largest group of equal offsets steps. The memory the group updates is then
+// gathered, combined and scattered once, where the highest lane of the group
+// stores last and so holds the whole group's contribution.
+//
+// NOTE: the lanes of a group are combined in a tree, not in lane order, so
+//       floating point scatter_add() may round differently than a loop
+
+#include <type_traits>
+
+#include "../operators/logic.h"
+#include "memory.h"
+#include "permute.h"
+#include "reduce.h"
+
+PSIMD_NAMESPACE_BEGIN
+
+  namespace detail {
+
+    template <typename T, int W, typename OFFSET_T, typename OP_T>
+    inline void scatter_reduce(T *base,
+                               const pack<OFFSET_T, W> &o,
+                               const pack<T, W> &values,
+                               const mask_for<T, W> &m,
+                               OP_T op)
+    {
+      using mask_t   = typename mask_element<T>::type;
+      using detector = conflict_detector<OFFSET_T, W>;
+
+      const pack<int, W> previous = detector::previous(
+          o, lane_mask<OFFSET_T>(m, is_lane_mask<OFFSET_T, mask_t>()));
+
+      pack<T, W> combined = values;
+      mask<W> linked = previous >= 0;
+
+      if (any(linked)) {
+        pack<int, W> lanes;
+
+        #pragma omp simd
+        for (int i = 0; i < W; ++i)
+          lanes[i] = i;
+
+        pack<int, W> link = select(linked, previous, lanes);
+
+        // lane i takes in the lanes up to its link, then links to its link's
+        // link: the sets of lanes combined double until each lane holds its
+        // group's lanes up to and including itself
+        do {
+          combined = select(lane_mask<T>(linked, is_lane_mask<T, int>()),
+                            op(combined, permute(combined, link)),
+                            combined);
+          linked = linked & permute(linked, link);
+          link   = permute(link, link);
+        } while (any(linked));
+      }
+
+      constexpr int scale = int(sizeof(T));
+
+      const auto current = gather<pack<T, W>, scale>(base, o, m);
+      scatter<scale>(op(current, combined), base, o, m);
+    }
+
+  } // ::psimd::detail
+
+  // scatter_add(): base[o[i]] += values[i] for each (active) lane i, summing
+  //                every lane of an offset shared by several lanes //
+
+  template <typename T, int W, typename OFFSET_T>
+  inline void scatter_add(T *base,
+                          const pack<OFFSET_T, W> &o,
+                          const pack<T, W> &values)
+  {
+    detail::scatter_reduce(base, o, values, mask_for<T, W>(-1),
+                           detail::reduce_add_op());
+  }
+
+  template <typename T, int W, typename OFFSET_T, typename M>
+  inline typename std::enable_if<detail::is_mask_element<M>::value>::type
+  scatter_add(T *base,
+              const pack<OFFSET_T, W> &o,
+              const pack<T, W> &values,
+              const pack<M, W> &m)
+  {
+    const auto &active = detail::lane_mask<T>(m, detail::is_lane_mask<T, M>());
+    detail::scatter_reduce(base, o, values, active, detail::reduce_add_op());
+  }
+
+  // scatter_min(): base[o[i]] = min(base[o[i]], values[i]) for each (active)
+  //                lane i //
+
+  template <typename T, int W, typename OFFSET_T>
+  inline void scatter_min(T *base,
+                          const pack<OFFSET_T, W> &o,
+                          const pack<T, W> &values)
+  {
+    detail::scatter_reduce(base, o, values, mask_for<T, W>(-1),
+                           detail::reduce_min_op());
+  }
+
+  template <typename T, int W, typename OFFSET_T, typename M>
+  inline typename std::enable_if<detail::is_mask_element<M>::value>::type
+  scatter_min(T *base,
+              const pack<OFFSET_T, W> &o,
+              const pack<T, W> &values,
+              const pack<M, W> &m)
+  {
+    const auto &active = detail::lane_mask<T>(m, detail::is_lane_mask<T, M>());
+    detail::scatter_reduce(base, o, values, active, detail::reduce_min_op());
+  }
+
+  // scatter_max(): base[o[i]] = max(base[o[i]], values[i]) for each (active)
+  //                lane i //
+
+  template <typename T, int W, typename OFFSET_T>
+  inline void scatter_max(T *base,
+                          const pack<OFFSET_T, W> &o,
+                          const pack<T, W> &values)
+  {
+    detail::scatter_reduce(base, o, values, mask_for<T, W>(-1),
+                           detail::reduce_max_op());
+  }
+
+  template <typename T, int W, typename OFFSET_T, typename M>
+  inline typename std::enable_if<detail::is_mask_element<M>::value>::type
+  scatter_max(T *base,
+              const pack<OFFSET_T, W> &o,
+              const pack<T, W> &values,
+              const pack<M, W> &m)
+  {
+    const auto &active = detail::lane_mask<T>(m, detail::is_lane_mask<T, M>());
+    detail::scatter_reduce(base, o, values, active, detail::reduce_max_op());
+  }
+
+PSIMD_NAMESPACE_END // ::psimd
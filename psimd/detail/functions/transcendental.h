@@ -0,0 +1,946 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+#pragma once
+
+// Vectorized transcendental functions for pack<float, W> and pack<double, W>
+//
+// Everything here is written in terms of pack operations (arithmetic,
+// multiply-adds, comparisons and select()), so each function runs on
+// whichever backend the pack maps to, including register-blocked packs. The
+// multiply-adds are fused only with hardware FMA (detail::contract_fma()).
+// The argument reductions and polynomial/rational approximations are those
+// of the Cephes library.
+//
+// Maximum error measured against a long double reference, with and without
+// hardware FMA (float: every 61st input, double: 10^6 random inputs per
+// range):
+//
+//   function     float     double
+//   ----------   -------   -------
+//   exp, exp2    1.5 ulp   2 ulp
+//   log, log2    1.5 ulp   1.5 ulp
+//   sin, cos     2.5 ulp   2.5 ulp   (|x| < 2^30)
+//   tan          4.5 ulp   4.5 ulp   (|x| < 2^30)
+//   atan         3 ulp     1 ulp
+//   atan2        3 ulp     2 ulp
+//   asin, acos   2.5 ulp   1.5 ulp
+//
+// The double argument reduction carries ~2^-100 |x| absolute error, which
+// only shows next to the zeros of sin() and cos() at large |x|. Lanes of
+// sin(), cos(), sincos() and tan() beyond |x| = 2^30 (including inf and NaN)
+// fall back to the standard library. Denormal inputs and results are
+// handled; NaN propagates through every function.
+
+#include <cmath>
+#include <limits>
+
+#include "algorithm.h"
+#include "classify.h"
+#include "math.h"
+
+PSIMD_NAMESPACE_BEGIN
+
+  namespace detail {
+
+    // IEEE-754 layout of T //
+
+    template <typename T>
+    struct float_layout;
+
+    template <>
+    struct float_layout<float>
+    {
+      using int_type = int;
+      static constexpr int mantissa_bits = 23;
+      static constexpr int exponent_bias = 127;
+    };
+
+    template <>
+    struct float_layout<double>
+    {
+      using int_type = long long;
+      static constexpr int mantissa_bits = 52;
+      static constexpr int exponent_bias = 1023;
+    };
+
+    template <typename T, int W>
+    using int_pack = pack<typename float_layout<T>::int_type, W>;
+
+    // Horner evaluation, coefficients given highest degree first //
+
+    template <typename T, int W>
+    inline pack<T, W> polevl(const pack<T, W> &, const pack<T, W> &acc)
+    {
+      return acc;
+    }
+
+    template <typename T, int W, typename... COEFFS>
+    inline pack<T, W> polevl(const pack<T, W> &x,
+                             const pack<T, W> &acc,
+                             typename pack<T, W>::type c,
+                             COEFFS... coeffs)
+    {
+      return polevl(x, contract_fma(acc, x, c), coeffs...);
+    }
+
+    // Round to the nearest integer (ties to even)
+    //
+    // NOTE: this is a real rounding instruction (roundps/vrndscaleps in the
+    //       native backends) rather than the (x + 1.5 * 2^m) - 1.5 * 2^m
+    //       trick, which -ffast-math folds back to x //
+
+    template <typename T, int W>
+    inline pack<T, W> round_nearest(const pack<T, W> &x)
+    {
+      return nearbyint(x);
+    }
+
+    // Clamp x to [lo, hi], NaN lanes included (they become lo) so that the
+    // result can always be converted to an integer //
+
+    template <typename T, int W>
+    inline pack<T, W> clamp(const pack<T, W> &x,
+                            const pack<T, W> &lo,
+                            const pack<T, W> &hi)
+    {
+      const pack<T, W> above = select(x > lo, x, lo);
+      return select(above < hi, above, hi);
+    }
+
+    // Exponent arithmetic stays in the floating point domain: an integer k
+    // with 0 <= k < 2^m (m the mantissa bits) is read from the low bits of
+    // 2^m + k, and written back as bits(2^m + k) - 2^m, so that no
+    // conversion between double and 64-bit integer lanes (which has no
+    // native version before AVX-512) is needed. Neither step can be folded
+    // away under -ffast-math, as both go through integer lanes //
+
+    template <typename T>
+    constexpr T exponent_shifter()
+    {
+      return T(1ll << float_layout<T>::mantissa_bits);
+    }
+
+    // x * 2^n for integral n within twice the exponent range, applied in two
+    // steps so that results in the denormal range are rounded once //
+
+    template <typename T, int W>
+    inline pack<T, W> ldexp(const pack<T, W> &x, const pack<T, W> &n)
+    {
+      using int_pack = detail::int_pack<T, W>;
+
+      const int bias          = float_layout<T>::exponent_bias;
+      const int mantissa_bits = float_layout<T>::mantissa_bits;
+      const T   shifter       = exponent_shifter<T>();
+
+      // biased exponents of n1 = n / 2 (rounded) and n2 = n - n1; shifting
+      // the low bits up drops those of the shifter
+      const int_pack e1 =
+          bit_cast<int_pack>(pack<T, W>(n * T(0.5) + T(shifter + bias)));
+      const int_pack e12 =
+          bit_cast<int_pack>(pack<T, W>(n + T(shifter + 2 * bias)));
+      const int_pack e2 = e12 - e1;
+
+      const pack<T, W> scaled =
+          x * bit_cast<pack<T, W>>(int_pack(e1 << mantissa_bits));
+      return pack<T, W>(
+        scaled * bit_cast<pack<T, W>>(int_pack(e2 << mantissa_bits))
+      );
+    }
+
+    // Split |x| into a mantissa in [0.5, 1) and an exponent, as std::frexp()
+    // (meaningful for non-zero, finite x only) //
+
+    template <typename T, int W>
+    inline pack<T, W> frexp(const pack<T, W> &x, pack<T, W> &e)
+    {
+      using int_pack = detail::int_pack<T, W>;
+      using I        = typename int_pack::type;
+
+      const int bias          = float_layout<T>::exponent_bias;
+      const int mantissa_bits = float_layout<T>::mantissa_bits;
+      const int prescale      = mantissa_bits + 2;
+      const T   shifter       = exponent_shifter<T>();
+
+      const pack<T, W> ax = abs(x);
+
+      const auto denormal = ax < std::numeric_limits<T>::min();
+      const pack<T, W> scaled = ax * T(1ll << prescale);
+      const pack<T, W> normal = select(denormal, scaled, ax);
+
+      const int_pack bits     = bit_cast<int_pack>(normal);
+      const int_pack exponent = bits >> mantissa_bits;
+
+      // replace the exponent field by the one of 0.5
+      const I        half     = I(bias - 1) << mantissa_bits;
+      const int_pack stripped = bits - int_pack(exponent << mantissa_bits);
+      const int_pack mantissa = stripped + half;
+
+      const int_pack shifted =
+          exponent | bit_cast<int_pack>(pack<T, W>(shifter));
+      const pack<T, W> biased = bit_cast<pack<T, W>>(shifted) - shifter;
+
+      e = select(denormal,
+                 pack<T, W>(biased - T(bias - 1 + prescale)),
+                 pack<T, W>(biased - T(bias - 1)));
+
+      return bit_cast<pack<T, W>>(mantissa);
+    }
+
+    // Patch lanes where 'm' is not set with the standard library version of
+    // a function (out of range arguments of the trigonometric functions) //
+
+    template <typename M, typename T, int W, typename FCN_T>
+    inline void std_fallback(const pack<M, W> &m,
+                             const pack<T, W> &x,
+                             pack<T, W> &result,
+                             FCN_T &&fcn)
+    {
+      for (int i = 0; i < W; ++i)
+        if (!m[i])
+          result[i] = fcn(x[i]);
+    }
+
+    // Trigonometric argument reduction and kernels //////////////////////////
+
+    // Largest |x| the trigonometric argument reduction is accurate for //
+
+    static constexpr double trig_max_arg = 1.073741824e9;
+
+    // r = |x| - k pi/2 in [-pi/4, pi/4], with pi/2 split in three parts
+    // whose products with k are exact (Cody-Waite); q = k mod 4 is returned
+    // as a floating point value so that no integer lanes are involved //
+
+    template <int W>
+    inline pack<double, W> trig_reduce(const pack<double, W> &ax,
+                                       pack<double, W> &q)
+    {
+      const pack<double, W> k =
+          round_nearest(pack<double, W>(ax * 0.63661977236758134308));
+
+      pack<double, W> r = contract_fnma(k, 1.57079625129699707031e0, ax);
+      r = contract_fnma(k, 7.54978941586159635335e-8, r);
+      r = contract_fnma(k, 5.39030285815811905290e-15, r);
+
+      // k - 4 round((k - 1.5) / 4) is in {0, 1, 2, 3} for integral k
+      const pack<double, W> t = contract_fma(k, 0.25, pack<double, W>(-0.375));
+      q = contract_fnma(round_nearest(t), 4.0, k);
+
+      return r;
+    }
+
+    // NOTE: a float reduction loses most of the bits of r next to the
+    //       zeros of sin() and cos() (hundreds of ulps by |x| ~ 250),
+    //       so float lanes are reduced in double precision
+
+    template <int W>
+    inline pack<float, W> trig_reduce(const pack<float, W> &ax,
+                                      pack<float, W> &q)
+    {
+      pack<double, W> qd;
+      const pack<double, W> r = trig_reduce(ax.template as<double>(), qd);
+      q = qd.template as<float>();
+      return r.template as<float>();
+    }
+
+    // sin(r) and cos(r) for |r| <= pi/4, z = r * r //
+
+    template <int W>
+    inline pack<float, W> sin_kernel(const pack<float, W> &r,
+                                     const pack<float, W> &z)
+    {
+      const pack<float, W> p = polevl(z, pack<float, W>(-1.9515295891e-4f),
+                                      8.3321608736e-3f,
+                                      -1.6666654611e-1f);
+      const pack<float, W> pz = p * z;
+      return contract_fma(pz, r, r);
+    }
+
+    template <int W>
+    inline pack<float, W> cos_kernel(const pack<float, W> &z)
+    {
+      const pack<float, W> p = polevl(z, pack<float, W>(2.443315711809948e-5f),
+                                      -1.388731625493765e-3f,
+                                      4.166664568298827e-2f);
+      const pack<float, W> zz = z * z;
+      const pack<float, W> y  =
+          contract_fnma(z, 0.5f, contract_fma(p, zz, 1.f));
+      return y;
+    }
+
+    template <int W>
+    inline pack<double, W> sin_kernel(const pack<double, W> &r,
+                                      const pack<double, W> &z)
+    {
+      const pack<double, W> p =
+          polevl(z, pack<double, W>(1.58962301576546568060e-10),
+                 -2.50507477628578072866e-8,
+                 2.75573136213857245213e-6,
+                 -1.98412698295895385996e-4,
+                 8.33333333332211858878e-3,
+                 -1.66666666666666307295e-1);
+      const pack<double, W> pz = p * z;
+      return contract_fma(pz, r, r);
+    }
+
+    template <int W>
+    inline pack<double, W> cos_kernel(const pack<double, W> &z)
+    {
+      const pack<double, W> p =
+          polevl(z, pack<double, W>(-1.13585365213876817300e-11),
+                 2.08757008419747316778e-9,
+                 -2.75573141792967388112e-7,
+                 2.48015872888517045348e-5,
+                 -1.38888888888730564116e-3,
+                 4.16666666666665929218e-2);
+      const pack<double, W> zz = z * z;
+      const pack<double, W> y  =
+          contract_fnma(z, 0.5, contract_fma(p, zz, 1.0));
+      return y;
+    }
+
+    // sin(x) and cos(x) from the reduced argument r and quadrant q of |x| //
+
+    template <typename T, int W>
+    inline void sincos_reduced(const pack<T, W> &x,
+                               const pack<T, W> &r,
+                               const pack<T, W> &q,
+                               pack<T, W> &s,
+                               pack<T, W> &c)
+    {
+      const pack<T, W> z  = r * r;
+      const pack<T, W> ps = sin_kernel(r, z);
+      const pack<T, W> pc = cos_kernel(z);
+
+      const mask_for<T, W> odd = (q == T(1)) || (q == T(3));
+
+      // from the sign bit, so that sin(-0) and tan(-0) are -0
+      const mask_for<T, W> negate_sin = (q >= T(2)) != signbit(x);
+      const mask_for<T, W> negate_cos = (q == T(1)) || (q == T(2));
+
+      const pack<T, W> sin_r = select(odd, pc, ps);
+      const pack<T, W> cos_r = select(odd, ps, pc);
+
+      s = select(negate_sin, pack<T, W>(-sin_r), sin_r);
+      c = select(negate_cos, pack<T, W>(-cos_r), cos_r);
+    }
+
+    // sin(x) and cos(x) of the lanes within trig_max_arg, returns the mask
+    // of those lanes //
+
+    template <typename T, int W>
+    inline mask_for<T, W> sincos(const pack<T, W> &x,
+                                 pack<T, W> &s,
+                                 pack<T, W> &c)
+    {
+      const pack<T, W> ax = abs(x);
+      const mask_for<T, W> in_range = ax <= T(trig_max_arg);
+      const pack<T, W> cx = select(in_range, ax, pack<T, W>(T(0)));
+
+      pack<T, W> q;
+      const pack<T, W> r = trig_reduce(cx, q);
+
+      sincos_reduced(x, r, q, s, c);
+
+      return in_range;
+    }
+
+    // Reduced precision variant: float lanes are reduced in float, which is
+    // only accurate in absolute terms and for |x| < 8192 (Cephes' sinf()
+    // range), and no lane falls back to the standard library //
+
+    template <int W>
+    inline pack<float, W> trig_reduce_fast(const pack<float, W> &ax,
+                                           pack<float, W> &q)
+    {
+      const pack<float, W> k =
+          round_nearest(pack<float, W>(ax * 0.636619772367581343f));
+
+      pack<float, W> r = contract_fnma(k, 1.5703125f, ax);
+      r = contract_fnma(k, 4.837512969970703125e-4f, r);
+      r = contract_fnma(k, 7.54978995489188216e-8f, r);
+
+      const pack<float, W> t = contract_fma(k, 0.25f, pack<float, W>(-0.375f));
+      q = contract_fnma(round_nearest(t), 4.f, k);
+
+      return r;
+    }
+
+    template <int W>
+    inline pack<double, W> trig_reduce_fast(const pack<double, W> &ax,
+                                            pack<double, W> &q)
+    {
+      return trig_reduce(ax, q);
+    }
+
+    template <typename T, int W>
+    inline void sincos_fast(const pack<T, W> &x,
+                            pack<T, W> &s,
+                            pack<T, W> &c)
+    {
+      pack<T, W> q;
+      const pack<T, W> r = trig_reduce_fast(pack<T, W>(abs(x)), q);
+      sincos_reduced(x, r, q, s, c);
+    }
+
+    // Inverse trigonometric kernels ////////////////////////////////////////
+
+    // atan(x) for x >= 0 //
+
+    template <int W>
+    inline pack<float, W> atan_positive(const pack<float, W> &x)
+    {
+      using vfloat = pack<float, W>;
+
+      const auto large  = x > 2.414213562373095f;
+      const auto medium = x > 0.4142135623730950f;
+
+      const vfloat inv   = vfloat(-1.f) / x;
+      const vfloat ratio = vfloat(x - 1.f) / vfloat(x + 1.f);
+
+      const vfloat r  = select(large, inv, select(medium, ratio, x));
+      const vfloat y0 = select(large, vfloat(1.5707963267948966f),
+                               select(medium, vfloat(0.7853981633974483f),
+                                      vfloat(0.f)));
+
+      const vfloat z = r * r;
+      const vfloat p = polevl(z, vfloat(8.05374449538e-2f),
+                              -1.38776856032e-1f,
+                              1.99777106478e-1f,
+                              -3.33329491539e-1f);
+      const vfloat pz = p * z;
+
+      return vfloat(y0 + contract_fma(pz, r, r));
+    }
+
+    template <int W>
+    inline pack<double, W> atan_positive(const pack<double, W> &x)
+    {
+      using vdouble = pack<double, W>;
+
+      const double more_bits = 6.123233995736765886130e-17;
+
+      const auto large  = x > 2.41421356237309504880;
+      const auto medium = x > 0.66;
+
+      const vdouble inv   = vdouble(-1.0) / x;
+      const vdouble ratio = vdouble(x - 1.0) / vdouble(x + 1.0);
+
+      const vdouble r  = select(large, inv, select(medium, ratio, x));
+      const vdouble y0 = select(large, vdouble(1.57079632679489661923),
+                                select(medium, vdouble(0.78539816339744830962),
+                                       vdouble(0.0)));
+      const vdouble extra = select(large, vdouble(more_bits),
+                                   select(medium, vdouble(0.5 * more_bits),
+                                          vdouble(0.0)));
+
+      const vdouble z = r * r;
+      const vdouble p = polevl(z, vdouble(-8.750608600031904122785e-1),
+                               -1.615753718733365076637e1,
+                               -7.500855792314704667340e1,
+                               -1.228866684490136173410e2,
+                               -6.485021904942025371773e1);
+      const vdouble q = polevl(z, vdouble(z + 2.485846490142306297962e1),
+                               1.650270098316988542046e2,
+                               4.328810604912902668951e2,
+                               4.853903996359136964868e2,
+                               1.945506571482613964425e2);
+      const vdouble pq = vdouble(z * p) / q;
+      const vdouble a  = contract_fma(pq, r, r);
+
+      return vdouble(y0 + vdouble(a + extra));
+    }
+
+    // asin(x) for x >= 0 //
+
+    template <int W>
+    inline pack<float, W> asin_positive(const pack<float, W> &x)
+    {
+      using vfloat = pack<float, W>;
+
+      const auto large = x > 0.5f;
+
+      const vfloat half_c = contract_fnma(x, 0.5f, vfloat(0.5f));
+      const vfloat z = select(large, half_c, vfloat(x * x));
+      const vfloat r = select(large, sqrt(z), x);
+
+      const vfloat p = polevl(z, vfloat(4.2163199048e-2f),
+                              2.4181311049e-2f,
+                              4.5470025998e-2f,
+                              7.4953002686e-2f,
+                              1.6666752422e-1f);
+      const vfloat pz = p * z;
+      const vfloat a  = contract_fma(pz, r, r);
+
+      const vfloat reflected =
+          contract_fnma(a, 2.f, vfloat(1.5707963267948966f));
+      return select(large, reflected, a);
+    }
+
+    template <int W>
+    inline pack<double, W> asin_positive(const pack<double, W> &x)
+    {
+      using vdouble = pack<double, W>;
+
+      const double pio4      = 7.85398163397448309616e-1;
+      const double more_bits = 6.123233995736765886130e-17;
+
+      const auto large = x > 0.625;
+
+      // |x| > 0.625: pi/2 - 2 asin(sqrt((1 - x) / 2)), with a rational
+      // approximation in 1 - x
+      const vdouble zl = vdouble(1.0) - x;
+      const vdouble pl = polevl(zl, vdouble(2.967721961301243206100e-3),
+                                -5.634242780008963776856e-1,
+                                6.968710824104713396794e0,
+                                -2.556901049652824852289e1,
+                                2.853665548261061424989e1);
+      const vdouble ql = polevl(zl, vdouble(zl - 2.194779531642920639778e1),
+                                1.470656354026814941758e2,
+                                -3.838770957603691357202e2,
+                                3.424398657913078477438e2);
+      const vdouble rl  = vdouble(zl * pl) / ql;
+      const vdouble sl  = sqrt(vdouble(zl + zl));
+      const vdouble tl  = contract_fms(sl, rl, vdouble(more_bits));
+      const vdouble al  = vdouble(vdouble(pio4 - sl) - tl) + pio4;
+
+      // |x| <= 0.625: x + x^3 P(x^2) / Q(x^2)
+      const vdouble zs = x * x;
+      const vdouble ps = polevl(zs, vdouble(4.253011369004428248960e-3),
+                                -6.019598008014123785661e-1,
+                                5.444622390564711410273e0,
+                                -1.626247967210700244449e1,
+                                1.956261983317594739197e1,
+                                -8.198089802484824371615e0);
+      const vdouble qs = polevl(zs, vdouble(zs - 1.474091372988853791896e1),
+                                7.049610280856842141659e1,
+                                -1.471791292232726029859e2,
+                                1.395105614657485689735e2,
+                                -4.918853881490881290097e1);
+      const vdouble rs = vdouble(zs * ps) / qs;
+      const vdouble as = contract_fma(rs, x, x);
+
+      return select(large, al, as);
+    }
+
+  } // ::psimd::detail
+
+  // exp() ////////////////////////////////////////////////////////////////////
+
+  template <int W>
+  inline pack<float, W> exp(const pack<float, W> &x)
+  {
+    using vfloat = pack<float, W>;
+
+    const vfloat cx = detail::clamp(x, vfloat(-104.f), vfloat(89.f));
+
+    // exp(x) = 2^n * exp(r), r = x - n ln(2) in [-ln(2)/2, ln(2)/2]
+    const vfloat n = detail::round_nearest(vfloat(cx * 1.44269504088896341f));
+
+    vfloat r = detail::contract_fnma(n, 0.693359375f, cx);
+    r = detail::contract_fnma(n, -2.12194440e-4f, r);
+
+    const vfloat z = r * r;
+    const vfloat p = detail::polevl(r, vfloat(1.9875691500e-4f),
+                                    1.3981999507e-3f,
+                                    8.3334519073e-3f,
+                                    4.1665795894e-2f,
+                                    1.6666665459e-1f,
+                                    5.0000001201e-1f);
+    const vfloat y = detail::contract_fma(p, z, vfloat(r + 1.f));
+
+    const vfloat result = detail::ldexp(y, n);
+    return select(x != x, x, result);
+  }
+
+  template <int W>
+  inline pack<double, W> exp(const pack<double, W> &x)
+  {
+    using vdouble = pack<double, W>;
+
+    const vdouble cx = detail::clamp(x, vdouble(-746.0), vdouble(710.0));
+
+    const vdouble n =
+        detail::round_nearest(vdouble(cx * 1.4426950408889634073599));
+
+    vdouble r = detail::contract_fnma(n, 6.93145751953125e-1, cx);
+    r = detail::contract_fnma(n, 1.42860682030941723212e-6, r);
+
+    // exp(r) = 1 + 2 r P(r^2) / (Q(r^2) - r P(r^2))
+    const vdouble z = r * r;
+    const vdouble p = detail::polevl(z, vdouble(1.26177193074810590878e-4),
+                                     3.02994407707441961300e-2,
+                                     9.99999999999999999910e-1);
+    const vdouble q = detail::polevl(z, vdouble(3.00198505138664455042e-6),
+                                     2.52448340349684104192e-3,
+                                     2.27265548208155028766e-1,
+                                     2.00000000000000000009e0);
+    const vdouble rp = r * p;
+    const vdouble e  = rp / vdouble(q - rp);
+    const vdouble y  = detail::contract_fma(e, 2.0, vdouble(1.0));
+
+    const vdouble result = detail::ldexp(y, n);
+    return select(x != x, x, result);
+  }
+
+  // exp2() ///////////////////////////////////////////////////////////////////
+
+  template <int W>
+  inline pack<float, W> exp2(const pack<float, W> &x)
+  {
+    using vfloat = pack<float, W>;
+
+    const vfloat cx = detail::clamp(x, vfloat(-151.f), vfloat(129.f));
+
+    const vfloat n = detail::round_nearest(cx);
+    const vfloat r = cx - n;
+
+    const vfloat p = detail::polevl(r, vfloat(1.535336188319500e-4f),
+                                    1.339887440266574e-3f,
+                                    9.618437357674640e-3f,
+                                    5.550332471162809e-2f,
+                                    2.402264791363012e-1f,
+                                    6.931472028550421e-1f);
+    const vfloat y = detail::contract_fma(p, r, 1.f);
+
+    const vfloat result = detail::ldexp(y, n);
+    return select(x != x, x, result);
+  }
+
+  template <int W>
+  inline pack<double, W> exp2(const pack<double, W> &x)
+  {
+    using vdouble = pack<double, W>;
+
+    const vdouble cx = detail::clamp(x, vdouble(-1076.0), vdouble(1025.0));
+
+    const vdouble n = detail::round_nearest(cx);
+    const vdouble r = cx - n;
+
+    // 2^r = 1 + 2 r P(r^2) / (Q(r^2) - r P(r^2))
+    const vdouble z = r * r;
+    const vdouble p = detail::polevl(z, vdouble(2.30933477057345225087e-2),
+                                     2.02020656693165307700e1,
+                                     1.51390680115615096133e3);
+    const vdouble q = detail::polevl(z, vdouble(z + 2.33184211722314911771e2),
+                                     4.36821166879210612817e3);
+    const vdouble rp = r * p;
+    const vdouble e  = rp / vdouble(q - rp);
+    const vdouble y  = detail::contract_fma(e, 2.0, vdouble(1.0));
+
+    const vdouble result = detail::ldexp(y, n);
+    return select(x != x, x, result);
+  }
+
+  // log() and log2() /////////////////////////////////////////////////////////
+
+  namespace detail {
+
+    // Reduce x to x = 2^e * (1 + m), m in [sqrt(1/2) - 1, sqrt(2) - 1] //
+
+    template <typename T, int W>
+    inline pack<T, W> log_reduce(const pack<T, W> &x, pack<T, W> &e)
+    {
+      const pack<T, W> f = frexp(x, e);
+
+      const auto small = f < T(0.707106781186547524);
+      e = select(small, pack<T, W>(e - T(1)), e);
+
+      const pack<T, W> doubled = f + f;
+      return select(small, pack<T, W>(doubled - T(1)), pack<T, W>(f - T(1)));
+    }
+
+    // log(1 + m) - m + m^2 / 2 //
+
+    template <int W>
+    inline pack<float, W> log_kernel(const pack<float, W> &m,
+                                     const pack<float, W> &z)
+    {
+      using vfloat = pack<float, W>;
+
+      const vfloat p = polevl(m, vfloat(7.0376836292e-2f),
+                              -1.1514610310e-1f,
+                              1.1676998740e-1f,
+                              -1.2420140846e-1f,
+                              1.4249322787e-1f,
+                              -1.6668057665e-1f,
+                              2.0000714765e-1f,
+                              -2.4999993993e-1f,
+                              3.3333331174e-1f);
+      const vfloat mz = m * z;
+      return vfloat(mz * p);
+    }
+
+    template <int W>
+    inline pack<double, W> log_kernel(const pack<double, W> &m,
+                                      const pack<double, W> &z)
+    {
+      using vdouble = pack<double, W>;
+
+      const vdouble p = polevl(m, vdouble(1.01875663804580931796e-4),
+                               4.97494994976747001425e-1,
+                               4.70579119878881725854e0,
+                               1.44989225341610930846e1,
+                               1.79368678507819816313e1,
+                               7.70838733755885391666e0);
+      const vdouble q = polevl(m, vdouble(m + 1.12873587189167450590e1),
+                               4.52279145837532221105e1,
+                               8.29875266912776603211e1,
+                               7.11544750618563894466e1,
+                               2.31251620126765340583e1);
+      const vdouble mz = m * z;
+      return vdouble(vdouble(mz * p) / q);
+    }
+
+    // Results for x <= 0, inf and NaN //
+
+    template <typename T, int W>
+    inline pack<T, W> log_special(const pack<T, W> &x,
+                                  const pack<T, W> &result)
+    {
+      using limits = std::numeric_limits<T>;
+
+      const pack<T, W> nan(limits::quiet_NaN());
+      const pack<T, W> inf(limits::infinity());
+
+      pack<T, W> r = select(x == limits::infinity(), inf, result);
+      r = select(x == T(0), pack<T, W>(-inf), r);
+      return select(x >= T(0), r, nan);
+    }
+
+  } // ::psimd::detail
+
+  template <typename T, int W>
+  inline typename
+  std::enable_if<std::is_floating_point<T>::value, pack<T, W>>::type
+  log(const pack<T, W> &x)
+  {
+    pack<T, W> e;
+    const pack<T, W> m = detail::log_reduce(x, e);
+    const pack<T, W> z = m * m;
+
+    // log(x) = e ln(2) + m - m^2 / 2 + kernel, ln(2) split in two parts
+    pack<T, W> y = detail::log_kernel(m, z);
+    y = detail::contract_fma(e, T(-2.121944400546905827679e-4), y);
+    y = detail::contract_fnma(z, T(0.5), y);
+
+    pack<T, W> result = m + y;
+    result = detail::contract_fma(e, T(0.693359375), result);
+
+    return detail::log_special(x, result);
+  }
+
+  template <typename T, int W>
+  inline typename
+  std::enable_if<std::is_floating_point<T>::value, pack<T, W>>::type
+  log2(const pack<T, W> &x)
+  {
+    // log2(e) - 1
+    const T log2ea = T(4.4269504088896340735992e-1);
+
+    pack<T, W> e;
+    const pack<T, W> m = detail::log_reduce(x, e);
+    const pack<T, W> z = m * m;
+
+    pack<T, W> y = detail::log_kernel(m, z);
+    y = detail::contract_fnma(z, T(0.5), y);
+
+    // log2(x) = e + (m + y) log2(e), summed from the smallest term up
+    pack<T, W> result = y * log2ea;
+    result = detail::contract_fma(m, log2ea, result);
+    result = result + y;
+    result = result + m;
+    result = result + e;
+
+    return detail::log_special(x, result);
+  }
+
+  // sin(), cos(), sincos() and tan() /////////////////////////////////////////
+
+  template <typename T, int W>
+  inline typename std::enable_if<std::is_floating_point<T>::value>::type
+  sincos(const pack<T, W> &x, pack<T, W> &s, pack<T, W> &c)
+  {
+    const mask_for<T, W> in_range = detail::sincos(x, s, c);
+
+    if (!all(in_range)) {
+      detail::std_fallback(in_range, x, s, [](T v){ return std::sin(v); });
+      detail::std_fallback(in_range, x, c, [](T v){ return std::cos(v); });
+    }
+  }
+
+  template <int W>
+  inline pack<float, W> sin(const pack<float, W> &x)
+  {
+    pack<float, W> s, c;
+    sincos(x, s, c);
+    return s;
+  }
+
+  template <int W>
+  inline pack<double, W> sin(const pack<double, W> &x)
+  {
+    pack<double, W> s, c;
+    sincos(x, s, c);
+    return s;
+  }
+
+  template <int W>
+  inline pack<float, W> cos(const pack<float, W> &x)
+  {
+    pack<float, W> s, c;
+    sincos(x, s, c);
+    return c;
+  }
+
+  template <int W>
+  inline pack<double, W> cos(const pack<double, W> &x)
+  {
+    pack<double, W> s, c;
+    sincos(x, s, c);
+    return c;
+  }
+
+  template <int W>
+  inline pack<float, W> tan(const pack<float, W> &x)
+  {
+    pack<float, W> s, c;
+    const auto in_range = detail::sincos(x, s, c);
+
+    pack<float, W> result = s / c;
+
+    if (!all(in_range)) {
+      detail::std_fallback(in_range, x, result,
+                           [](float v){ return std::tan(v); });
+    }
+
+    return result;
+  }
+
+  template <int W>
+  inline pack<double, W> tan(const pack<double, W> &x)
+  {
+    pack<double, W> s, c;
+    const auto in_range = detail::sincos(x, s, c);
+
+    pack<double, W> result = s / c;
+
+    if (!all(in_range)) {
+      detail::std_fallback(in_range, x, result,
+                           [](double v){ return std::tan(v); });
+    }
+
+    return result;
+  }
+
+  // atan() and atan2() ///////////////////////////////////////////////////////
+
+  template <typename T, int W>
+  inline typename
+  std::enable_if<std::is_floating_point<T>::value, pack<T, W>>::type
+  atan(const pack<T, W> &x)
+  {
+    const pack<T, W> a = detail::atan_positive(pack<T, W>(abs(x)));
+    return flipsign(a, x);
+  }
+
+  // NOTE: the sign of zero is not distinguished: atan2(+-0, x < 0) is
+  //       +pi and atan2(y, +-0) follows the sign of y
+
+  template <typename T, int W>
+  inline typename
+  std::enable_if<std::is_floating_point<T>::value, pack<T, W>>::type
+  atan2(const pack<T, W> &y, const pack<T, W> &x)
+  {
+    const T pi = T(3.14159265358979323846);
+
+    const pack<T, W> ax = abs(x);
+    const pack<T, W> ay = abs(y);
+
+    // angle in the first quadrant, from the smaller of |y| / |x| and
+    // |x| / |y| so that the reduction stays accurate
+    const auto steep = ay > ax;
+    const pack<T, W> num = select(steep, ax, ay);
+    const pack<T, W> den = select(steep, ay, ax);
+    const pack<T, W> q   = num / den;
+
+    pack<T, W> a = detail::atan_positive(q);
+    a = select(steep, pack<T, W>(T(pi / 2) - a), a);
+    a = select(den == T(0), pack<T, W>(T(0)), a);
+
+    // both infinite: atan(inf / inf) is pi/4
+    const auto both_inf = (ax == std::numeric_limits<T>::infinity()) &&
+                          (ay == std::numeric_limits<T>::infinity());
+    a = select(both_inf, pack<T, W>(T(pi / 4)), a);
+
+    a = select(x < T(0), pack<T, W>(pi - a), a);
+    a = select(y < T(0), pack<T, W>(-a), a);
+
+    const auto nan = (x != x) || (y != y);
+    return select(nan, pack<T, W>(x + y), a);
+  }
+
+  // asin() and acos() ////////////////////////////////////////////////////////
+
+  template <typename T, int W>
+  inline typename
+  std::enable_if<std::is_floating_point<T>::value, pack<T, W>>::type
+  asin(const pack<T, W> &x)
+  {
+    const pack<T, W> ax = abs(x);
+    const pack<T, W> a  = detail::asin_positive(ax);
+
+    const pack<T, W> result = flipsign(a, x);
+    return select(ax > T(1),
+                  pack<T, W>(std::numeric_limits<T>::quiet_NaN()),
+                  result);
+  }
+
+  template <typename T, int W>
+  inline typename
+  std::enable_if<std::is_floating_point<T>::value, pack<T, W>>::type
+  acos(const pack<T, W> &x)
+  {
+    const T pi = T(3.14159265358979323846);
+
+    const pack<T, W> ax = abs(x);
+
+    // |x| > 0.5: acos(|x|) = 2 asin(sqrt((1 - |x|) / 2))
+    const pack<T, W> h  = detail::contract_fnma(ax, T(0.5), pack<T, W>(T(0.5)));
+    const pack<T, W> ah = detail::asin_positive(pack<T, W>(sqrt(h)));
+    const pack<T, W> a2 = ah + ah;
+    const pack<T, W> large = select(x < T(0), pack<T, W>(pi - a2), a2);
+
+    // |x| <= 0.5: acos(x) = pi/2 - asin(x)
+    const pack<T, W> as = detail::asin_positive(ax);
+    const pack<T, W> sa = flipsign(as, x);
+    const pack<T, W> small = T(pi / 2) - sa;
+
+    const pack<T, W> result = select(ax > T(0.5), large, small);
+    return select(ax > T(1),
+                  pack<T, W>(std::numeric_limits<T>::quiet_NaN()),
+                  result);
+  }
+
+PSIMD_NAMESPACE_END // ::psimd
@@ -0,0 +1,3197 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+#pragma once
+
+#include <cstdint>
+
+#include "sse.h"
+
+#if PSIMD_NATIVE_AVX2
+
+PSIMD_NAMESPACE_BEGIN
+
+  namespace detail {
+
+    inline pack<float, 8> as_pack(const __m256 &v)
+    {
+      pack<float, 8> result;
+      result.v = v;
+      return result;
+    }
+
+    inline pack<int, 8> as_pack(const __m256i &v)
+    {
+      pack<int, 8> result;
+      result.v = v;
+      return result;
+    }
+
+    inline pack<double, 4> as_pack(const __m256d &v)
+    {
+      pack<double, 4> result;
+      result.v = v;
+      return result;
+    }
+
+    inline __m256i avx_inactive(const __m256i &m)
+    {
+      return _mm256_cmpeq_epi32(m, _mm256_setzero_si256());
+    }
+
+    inline __m256i avx_inactive64(const __m256i &m)
+    {
+      return _mm256_cmpeq_epi64(m, _mm256_setzero_si256());
+    }
+
+    inline __m256i avx_not(const __m256i &m)
+    {
+      return _mm256_xor_si256(m, _mm256_set1_epi32(-1));
+    }
+
+    // bit_cast<>() as register casts //
+
+    template <>
+    struct bit_caster<int, float, 8>
+    {
+      static pack<int, 8> convert(const pack<float, 8> &p)
+      {
+        return as_pack(_mm256_castps_si256(p.v));
+      }
+    };
+
+    template <>
+    struct bit_caster<float, int, 8>
+    {
+      static pack<float, 8> convert(const pack<int, 8> &p)
+      {
+        return as_pack(_mm256_castsi256_ps(p.v));
+      }
+    };
+
+    template <>
+    struct bit_caster<long long, double, 4>
+    {
+      static pack<long long, 4> convert(const pack<double, 4> &p)
+      {
+        return as_pack<long long, 4>(_mm256_castpd_si256(p.v));
+      }
+    };
+
+    template <>
+    struct bit_caster<double, long long, 4>
+    {
+      static pack<double, 4> convert(const pack<long long, 4> &p)
+      {
+        return as_pack(_mm256_castsi256_pd(p.v));
+      }
+    };
+
+  } // ::psimd::detail
+
+  // pack<float, 4> / pack<int, 4> masked stores //////////////////////////////
+
+  inline void store(const pack<float, 4> &p, void* _dst, const mask<4> &m)
+  {
+    const __m128i active = detail::sse_not(detail::sse_inactive(m.v));
+    _mm_maskstore_ps((float*) _dst, active, p.v);
+  }
+
+  inline void store(const pack<int, 4> &p, void* _dst, const mask<4> &m)
+  {
+    const __m128i active = detail::sse_not(detail::sse_inactive(m.v));
+    _mm_maskstore_epi32((int*) _dst, active, p.v);
+  }
+
+  // pack<float, 4> / pack<int, 4> permutations ///////////////////////////////
+
+  inline pack<float, 4> permute(const pack<float, 4> &p,
+                                const pack<int, 4> &indices)
+  {
+    return detail::as_pack(_mm_permutevar_ps(p.v, indices.v));
+  }
+
+  inline pack<int, 4> permute(const pack<int, 4> &p,
+                              const pack<int, 4> &indices)
+  {
+    const __m128 v = _mm_castsi128_ps(p.v);
+    return detail::as_pack(_mm_castps_si128(_mm_permutevar_ps(v, indices.v)));
+  }
+
+  // pack<int, 4> variable shifts /////////////////////////////////////////////
+
+  inline pack<int, 4> operator<<(const pack<int, 4> &p1,
+                                 const pack<int, 4> &p2)
+  {
+    return detail::as_pack(_mm_sllv_epi32(p1.v, p2.v));
+  }
+
+  inline pack<int, 4> operator>>(const pack<int, 4> &p1,
+                                 const pack<int, 4> &p2)
+  {
+    return detail::as_pack(_mm_srav_epi32(p1.v, p2.v));
+  }
+
+#if PSIMD_NATIVE_FMA
+
+  // Fused multiply-add ///////////////////////////////////////////////////////
+
+  inline pack<float, 4> fma(const pack<float, 4> &a,
+                            const pack<float, 4> &b,
+                            const pack<float, 4> &c)
+  {
+    return detail::as_pack(_mm_fmadd_ps(a.v, b.v, c.v));
+  }
+
+  inline pack<float, 4> fms(const pack<float, 4> &a,
+                            const pack<float, 4> &b,
+                            const pack<float, 4> &c)
+  {
+    return detail::as_pack(_mm_fmsub_ps(a.v, b.v, c.v));
+  }
+
+  inline pack<float, 4> fnma(const pack<float, 4> &a,
+                             const pack<float, 4> &b,
+                             const pack<float, 4> &c)
+  {
+    return detail::as_pack(_mm_fnmadd_ps(a.v, b.v, c.v));
+  }
+
+  inline pack<float, 4> fnms(const pack<float, 4> &a,
+                             const pack<float, 4> &b,
+                             const pack<float, 4> &c)
+  {
+    return detail::as_pack(_mm_fnmsub_ps(a.v, b.v, c.v));
+  }
+
+
+  inline pack<double, 2> fma(const pack<double, 2> &a,
+                             const pack<double, 2> &b,
+                             const pack<double, 2> &c)
+  {
+    return detail::as_pack(_mm_fmadd_pd(a.v, b.v, c.v));
+  }
+
+  inline pack<double, 2> fms(const pack<double, 2> &a,
+                             const pack<double, 2> &b,
+                             const pack<double, 2> &c)
+  {
+    return detail::as_pack(_mm_fmsub_pd(a.v, b.v, c.v));
+  }
+
+  inline pack<double, 2> fnma(const pack<double, 2> &a,
+                              const pack<double, 2> &b,
+                              const pack<double, 2> &c)
+  {
+    return detail::as_pack(_mm_fnmadd_pd(a.v, b.v, c.v));
+  }
+
+  inline pack<double, 2> fnms(const pack<double, 2> &a,
+                              const pack<double, 2> &b,
+                              const pack<double, 2> &c)
+  {
+    return detail::as_pack(_mm_fnmsub_pd(a.v, b.v, c.v));
+  }
+
+
+  inline pack<float, 8> fma(const pack<float, 8> &a,
+                            const pack<float, 8> &b,
+                            const pack<float, 8> &c)
+  {
+    return detail::as_pack(_mm256_fmadd_ps(a.v, b.v, c.v));
+  }
+
+  inline pack<float, 8> fms(const pack<float, 8> &a,
+                            const pack<float, 8> &b,
+                            const pack<float, 8> &c)
+  {
+    return detail::as_pack(_mm256_fmsub_ps(a.v, b.v, c.v));
+  }
+
+  inline pack<float, 8> fnma(const pack<float, 8> &a,
+                             const pack<float, 8> &b,
+                             const pack<float, 8> &c)
+  {
+    return detail::as_pack(_mm256_fnmadd_ps(a.v, b.v, c.v));
+  }
+
+  inline pack<float, 8> fnms(const pack<float, 8> &a,
+                             const pack<float, 8> &b,
+                             const pack<float, 8> &c)
+  {
+    return detail::as_pack(_mm256_fnmsub_ps(a.v, b.v, c.v));
+  }
+
+
+  inline pack<double, 4> fma(const pack<double, 4> &a,
+                             const pack<double, 4> &b,
+                             const pack<double, 4> &c)
+  {
+    return detail::as_pack(_mm256_fmadd_pd(a.v, b.v, c.v));
+  }
+
+  inline pack<double, 4> fms(const pack<double, 4> &a,
+                             const pack<double, 4> &b,
+                             const pack<double, 4> &c)
+  {
+    return detail::as_pack(_mm256_fmsub_pd(a.v, b.v, c.v));
+  }
+
+  inline pack<double, 4> fnma(const pack<double, 4> &a,
+                              const pack<double, 4> &b,
+                              const pack<double, 4> &c)
+  {
+    return detail::as_pack(_mm256_fnmadd_pd(a.v, b.v, c.v));
+  }
+
+  inline pack<double, 4> fnms(const pack<double, 4> &a,
+                              const pack<double, 4> &b,
+                              const pack<double, 4> &c)
+  {
+    return detail::as_pack(_mm256_fnmsub_pd(a.v, b.v, c.v));
+  }
+
+#endif
+
+  // pack<float, 8> ///////////////////////////////////////////////////////////
+
+  // binary operator+() //
+
+  inline pack<float, 8> operator+(const pack<float, 8> &p1,
+                                  const pack<float, 8> &p2)
+  {
+    return detail::as_pack(_mm256_add_ps(p1.v, p2.v));
+  }
+
+  inline pack<float, 8> operator+(const pack<float, 8> &p1, float v)
+  {
+    return p1 + pack<float, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 8> operator+(const pack<float, 8> &p1, const OTHER_T &v)
+  {
+    return p1 + float(v);
+  }
+
+  inline pack<float, 8> operator+(float v, const pack<float, 8> &p1)
+  {
+    return pack<float, 8>(v) + p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 8> operator+(const OTHER_T &v, const pack<float, 8> &p1)
+  {
+    return float(v) + p1;
+  }
+
+  // binary operator-() //
+
+  inline pack<float, 8> operator-(const pack<float, 8> &p1,
+                                  const pack<float, 8> &p2)
+  {
+    return detail::as_pack(_mm256_sub_ps(p1.v, p2.v));
+  }
+
+  inline pack<float, 8> operator-(const pack<float, 8> &p1, float v)
+  {
+    return p1 - pack<float, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 8> operator-(const pack<float, 8> &p1, const OTHER_T &v)
+  {
+    return p1 - float(v);
+  }
+
+  inline pack<float, 8> operator-(float v, const pack<float, 8> &p1)
+  {
+    return pack<float, 8>(v) - p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 8> operator-(const OTHER_T &v, const pack<float, 8> &p1)
+  {
+    return float(v) - p1;
+  }
+
+  // binary operator*() //
+
+  inline pack<float, 8> operator*(const pack<float, 8> &p1,
+                                  const pack<float, 8> &p2)
+  {
+    return detail::as_pack(_mm256_mul_ps(p1.v, p2.v));
+  }
+
+  inline pack<float, 8> operator*(const pack<float, 8> &p1, float v)
+  {
+    return p1 * pack<float, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 8> operator*(const pack<float, 8> &p1, const OTHER_T &v)
+  {
+    return p1 * float(v);
+  }
+
+  inline pack<float, 8> operator*(float v, const pack<float, 8> &p1)
+  {
+    return pack<float, 8>(v) * p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 8> operator*(const OTHER_T &v, const pack<float, 8> &p1)
+  {
+    return float(v) * p1;
+  }
+
+  // binary operator/() //
+
+  inline pack<float, 8> operator/(const pack<float, 8> &p1,
+                                  const pack<float, 8> &p2)
+  {
+    return detail::as_pack(_mm256_div_ps(p1.v, p2.v));
+  }
+
+  inline pack<float, 8> operator/(const pack<float, 8> &p1, float v)
+  {
+    return p1 / pack<float, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 8> operator/(const pack<float, 8> &p1, const OTHER_T &v)
+  {
+    return p1 / float(v);
+  }
+
+  inline pack<float, 8> operator/(float v, const pack<float, 8> &p1)
+  {
+    return pack<float, 8>(v) / p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 8> operator/(const OTHER_T &v, const pack<float, 8> &p1)
+  {
+    return float(v) / p1;
+  }
+
+  // unary operator-() //
+
+  inline pack<float, 8> operator-(const pack<float, 8> &p)
+  {
+    return detail::as_pack(_mm256_xor_ps(p.v, _mm256_set1_ps(-0.f)));
+  }
+
+  // binary operator==() //
+
+  inline mask<8> operator==(const pack<float, 8> &p1,
+                            const pack<float, 8> &p2)
+  {
+    return detail::as_pack(
+      _mm256_castps_si256(_mm256_cmp_ps(p1.v, p2.v, _CMP_EQ_OQ))
+    );
+  }
+
+  inline mask<8> operator==(const pack<float, 8> &p1, float v)
+  {
+    return p1 == pack<float, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<8> operator==(const pack<float, 8> &p1, const OTHER_T &v)
+  {
+    return p1 == float(v);
+  }
+
+  inline mask<8> operator==(float v, const pack<float, 8> &p1)
+  {
+    return pack<float, 8>(v) == p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<8> operator==(const OTHER_T &v, const pack<float, 8> &p1)
+  {
+    return float(v) == p1;
+  }
+
+  // binary operator!=() //
+
+  inline mask<8> operator!=(const pack<float, 8> &p1,
+                            const pack<float, 8> &p2)
+  {
+    return detail::as_pack(
+      _mm256_castps_si256(_mm256_cmp_ps(p1.v, p2.v, _CMP_NEQ_UQ))
+    );
+  }
+
+  inline mask<8> operator!=(const pack<float, 8> &p1, float v)
+  {
+    return p1 != pack<float, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<8> operator!=(const pack<float, 8> &p1, const OTHER_T &v)
+  {
+    return p1 != float(v);
+  }
+
+  inline mask<8> operator!=(float v, const pack<float, 8> &p1)
+  {
+    return pack<float, 8>(v) != p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<8> operator!=(const OTHER_T &v, const pack<float, 8> &p1)
+  {
+    return float(v) != p1;
+  }
+
+  // binary operator<() //
+
+  inline mask<8> operator<(const pack<float, 8> &p1,
+                           const pack<float, 8> &p2)
+  {
+    return detail::as_pack(
+      _mm256_castps_si256(_mm256_cmp_ps(p1.v, p2.v, _CMP_LT_OQ))
+    );
+  }
+
+  inline mask<8> operator<(const pack<float, 8> &p1, float v)
+  {
+    return p1 < pack<float, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<8> operator<(const pack<float, 8> &p1, const OTHER_T &v)
+  {
+    return p1 < float(v);
+  }
+
+  inline mask<8> operator<(float v, const pack<float, 8> &p1)
+  {
+    return pack<float, 8>(v) < p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<8> operator<(const OTHER_T &v, const pack<float, 8> &p1)
+  {
+    return float(v) < p1;
+  }
+
+  // binary operator<=() //
+
+  inline mask<8> operator<=(const pack<float, 8> &p1,
+                            const pack<float, 8> &p2)
+  {
+    return detail::as_pack(
+      _mm256_castps_si256(_mm256_cmp_ps(p1.v, p2.v, _CMP_LE_OQ))
+    );
+  }
+
+  inline mask<8> operator<=(const pack<float, 8> &p1, float v)
+  {
+    return p1 <= pack<float, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<8> operator<=(const pack<float, 8> &p1, const OTHER_T &v)
+  {
+    return p1 <= float(v);
+  }
+
+  inline mask<8> operator<=(float v, const pack<float, 8> &p1)
+  {
+    return pack<float, 8>(v) <= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<8> operator<=(const OTHER_T &v, const pack<float, 8> &p1)
+  {
+    return float(v) <= p1;
+  }
+
+  // binary operator>() //
+
+  inline mask<8> operator>(const pack<float, 8> &p1,
+                           const pack<float, 8> &p2)
+  {
+    return detail::as_pack(
+      _mm256_castps_si256(_mm256_cmp_ps(p1.v, p2.v, _CMP_GT_OQ))
+    );
+  }
+
+  inline mask<8> operator>(const pack<float, 8> &p1, float v)
+  {
+    return p1 > pack<float, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<8> operator>(const pack<float, 8> &p1, const OTHER_T &v)
+  {
+    return p1 > float(v);
+  }
+
+  inline mask<8> operator>(float v, const pack<float, 8> &p1)
+  {
+    return pack<float, 8>(v) > p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<8> operator>(const OTHER_T &v, const pack<float, 8> &p1)
+  {
+    return float(v) > p1;
+  }
+
+  // binary operator>=() //
+
+  inline mask<8> operator>=(const pack<float, 8> &p1,
+                            const pack<float, 8> &p2)
+  {
+    return detail::as_pack(
+      _mm256_castps_si256(_mm256_cmp_ps(p1.v, p2.v, _CMP_GE_OQ))
+    );
+  }
+
+  inline mask<8> operator>=(const pack<float, 8> &p1, float v)
+  {
+    return p1 >= pack<float, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<8> operator>=(const pack<float, 8> &p1, const OTHER_T &v)
+  {
+    return p1 >= float(v);
+  }
+
+  inline mask<8> operator>=(float v, const pack<float, 8> &p1)
+  {
+    return pack<float, 8>(v) >= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<8> operator>=(const OTHER_T &v, const pack<float, 8> &p1)
+  {
+    return float(v) >= p1;
+  }
+
+  // abs() //
+
+  inline pack<float, 8> abs(const pack<float, 8> &p)
+  {
+    return detail::as_pack(_mm256_andnot_ps(_mm256_set1_ps(-0.f), p.v));
+  }
+
+  // sqrt() //
+
+  inline pack<float, 8> sqrt(const pack<float, 8> &p)
+  {
+    return detail::as_pack(_mm256_sqrt_ps(p.v));
+  }
+
+  // rcp_estimate() and rsqrt_estimate() //
+
+  namespace detail {
+
+    inline pack<float, 8> rcp_estimate(const pack<float, 8> &p)
+    {
+      return as_pack(_mm256_rcp_ps(p.v));
+    }
+
+    inline pack<float, 8> rsqrt_estimate(const pack<float, 8> &p)
+    {
+      return as_pack(_mm256_rsqrt_ps(p.v));
+    }
+
+  } // ::psimd::detail
+
+  // max() //
+
+  inline pack<float, 8> max(const pack<float, 8> &a,
+                            const pack<float, 8> &b)
+  {
+    return detail::as_pack(_mm256_max_ps(b.v, a.v));
+  }
+
+  // min() //
+
+  inline pack<float, 8> min(const pack<float, 8> &a,
+                            const pack<float, 8> &b)
+  {
+    return detail::as_pack(_mm256_min_ps(b.v, a.v));
+  }
+
+  // select() //
+
+  inline pack<float, 8> select(const mask<8> &m,
+                               const pack<float, 8> &t,
+                               const pack<float, 8> &f)
+  {
+    const __m256i inactive = detail::avx_inactive(m.v);
+    return detail::as_pack(
+      _mm256_blendv_ps(t.v, f.v, _mm256_castsi256_ps(inactive))
+    );
+  }
+
+  // store() //
+
+  inline void store(const pack<float, 8> &p, void* _dst, const mask<8> &m)
+  {
+    const __m256i active = detail::avx_not(detail::avx_inactive(m.v));
+    _mm256_maskstore_ps((float*) _dst, active, p.v);
+  }
+
+  // pack<int, 8> /////////////////////////////////////////////////////////////
+
+  // binary operator+() //
+
+  inline pack<int, 8> operator+(const pack<int, 8> &p1,
+                                const pack<int, 8> &p2)
+  {
+    return detail::as_pack(_mm256_add_epi32(p1.v, p2.v));
+  }
+
+  inline pack<int, 8> operator+(const pack<int, 8> &p1, int v)
+  {
+    return p1 + pack<int, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 8> operator+(const pack<int, 8> &p1, const OTHER_T &v)
+  {
+    return p1 + int(v);
+  }
+
+  inline pack<int, 8> operator+(int v, const pack<int, 8> &p1)
+  {
+    return pack<int, 8>(v) + p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 8> operator+(const OTHER_T &v, const pack<int, 8> &p1)
+  {
+    return int(v) + p1;
+  }
+
+  // binary operator-() //
+
+  inline pack<int, 8> operator-(const pack<int, 8> &p1,
+                                const pack<int, 8> &p2)
+  {
+    return detail::as_pack(_mm256_sub_epi32(p1.v, p2.v));
+  }
+
+  inline pack<int, 8> operator-(const pack<int, 8> &p1, int v)
+  {
+    return p1 - pack<int, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 8> operator-(const pack<int, 8> &p1, const OTHER_T &v)
+  {
+    return p1 - int(v);
+  }
+
+  inline pack<int, 8> operator-(int v, const pack<int, 8> &p1)
+  {
+    return pack<int, 8>(v) - p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 8> operator-(const OTHER_T &v, const pack<int, 8> &p1)
+  {
+    return int(v) - p1;
+  }
+
+  // binary operator*() //
+
+  inline pack<int, 8> operator*(const pack<int, 8> &p1,
+                                const pack<int, 8> &p2)
+  {
+    return detail::as_pack(_mm256_mullo_epi32(p1.v, p2.v));
+  }
+
+  inline pack<int, 8> operator*(const pack<int, 8> &p1, int v)
+  {
+    return p1 * pack<int, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 8> operator*(const pack<int, 8> &p1, const OTHER_T &v)
+  {
+    return p1 * int(v);
+  }
+
+  inline pack<int, 8> operator*(int v, const pack<int, 8> &p1)
+  {
+    return pack<int, 8>(v) * p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 8> operator*(const OTHER_T &v, const pack<int, 8> &p1)
+  {
+    return int(v) * p1;
+  }
+
+  // unary operator-() //
+
+  inline pack<int, 8> operator-(const pack<int, 8> &p)
+  {
+    return detail::as_pack(_mm256_sub_epi32(_mm256_setzero_si256(), p.v));
+  }
+
+  // binary operator&() //
+
+  inline pack<int, 8> operator&(const pack<int, 8> &p1,
+                                const pack<int, 8> &p2)
+  {
+    return detail::as_pack(_mm256_and_si256(p1.v, p2.v));
+  }
+
+  inline pack<int, 8> operator&(const pack<int, 8> &p1, int v)
+  {
+    return p1 & pack<int, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 8> operator&(const pack<int, 8> &p1, const OTHER_T &v)
+  {
+    return p1 & int(v);
+  }
+
+  inline pack<int, 8> operator&(int v, const pack<int, 8> &p1)
+  {
+    return pack<int, 8>(v) & p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 8> operator&(const OTHER_T &v, const pack<int, 8> &p1)
+  {
+    return int(v) & p1;
+  }
+
+  // binary operator|() //
+
+  inline pack<int, 8> operator|(const pack<int, 8> &p1,
+                                const pack<int, 8> &p2)
+  {
+    return detail::as_pack(_mm256_or_si256(p1.v, p2.v));
+  }
+
+  inline pack<int, 8> operator|(const pack<int, 8> &p1, int v)
+  {
+    return p1 | pack<int, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 8> operator|(const pack<int, 8> &p1, const OTHER_T &v)
+  {
+    return p1 | int(v);
+  }
+
+  inline pack<int, 8> operator|(int v, const pack<int, 8> &p1)
+  {
+    return pack<int, 8>(v) | p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 8> operator|(const OTHER_T &v, const pack<int, 8> &p1)
+  {
+    return int(v) | p1;
+  }
+
+  // unary operator~() //
+
+  inline pack<int, 8> operator~(const pack<int, 8> &p)
+  {
+    return detail::as_pack(detail::avx_not(p.v));
+  }
+
+  // andnot() //
+
+  inline pack<int, 8> andnot(const pack<int, 8> &p1,
+                             const pack<int, 8> &p2)
+  {
+    return detail::as_pack(_mm256_andnot_si256(p2.v, p1.v));
+  }
+
+  // binary operator^() //
+
+  inline pack<int, 8> operator^(const pack<int, 8> &p1,
+                                const pack<int, 8> &p2)
+  {
+    return detail::as_pack(_mm256_xor_si256(p1.v, p2.v));
+  }
+
+  inline pack<int, 8> operator^(const pack<int, 8> &p1, int v)
+  {
+    return p1 ^ pack<int, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 8> operator^(const pack<int, 8> &p1, const OTHER_T &v)
+  {
+    return p1 ^ int(v);
+  }
+
+  inline pack<int, 8> operator^(int v, const pack<int, 8> &p1)
+  {
+    return pack<int, 8>(v) ^ p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 8> operator^(const OTHER_T &v, const pack<int, 8> &p1)
+  {
+    return int(v) ^ p1;
+  }
+
+  // binary operator<<() //
+
+  inline pack<int, 8> operator<<(const pack<int, 8> &p1, int v)
+  {
+    return detail::as_pack(_mm256_sll_epi32(p1.v, _mm_cvtsi32_si128(v)));
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 8> operator<<(const pack<int, 8> &p1, const OTHER_T &v)
+  {
+    return p1 << int(v);
+  }
+
+  inline pack<int, 8> operator<<(const pack<int, 8> &p1,
+                                 const pack<int, 8> &p2)
+  {
+    return detail::as_pack(_mm256_sllv_epi32(p1.v, p2.v));
+  }
+
+  // binary operator>>() //
+
+  inline pack<int, 8> operator>>(const pack<int, 8> &p1, int v)
+  {
+    return detail::as_pack(_mm256_sra_epi32(p1.v, _mm_cvtsi32_si128(v)));
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 8> operator>>(const pack<int, 8> &p1, const OTHER_T &v)
+  {
+    return p1 >> int(v);
+  }
+
+  inline pack<int, 8> operator>>(const pack<int, 8> &p1,
+                                 const pack<int, 8> &p2)
+  {
+    return detail::as_pack(_mm256_srav_epi32(p1.v, p2.v));
+  }
+
+  // binary operator==() //
+
+  inline mask<8> operator==(const pack<int, 8> &p1,
+                            const pack<int, 8> &p2)
+  {
+    return detail::as_pack(_mm256_cmpeq_epi32(p1.v, p2.v));
+  }
+
+  inline mask<8> operator==(const pack<int, 8> &p1, int v)
+  {
+    return p1 == pack<int, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<8> operator==(const pack<int, 8> &p1, const OTHER_T &v)
+  {
+    return p1 == int(v);
+  }
+
+  inline mask<8> operator==(int v, const pack<int, 8> &p1)
+  {
+    return pack<int, 8>(v) == p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<8> operator==(const OTHER_T &v, const pack<int, 8> &p1)
+  {
+    return int(v) == p1;
+  }
+
+  // binary operator!=() //
+
+  inline mask<8> operator!=(const pack<int, 8> &p1,
+                            const pack<int, 8> &p2)
+  {
+    return detail::as_pack(detail::avx_not(_mm256_cmpeq_epi32(p1.v, p2.v)));
+  }
+
+  inline mask<8> operator!=(const pack<int, 8> &p1, int v)
+  {
+    return p1 != pack<int, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<8> operator!=(const pack<int, 8> &p1, const OTHER_T &v)
+  {
+    return p1 != int(v);
+  }
+
+  inline mask<8> operator!=(int v, const pack<int, 8> &p1)
+  {
+    return pack<int, 8>(v) != p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<8> operator!=(const OTHER_T &v, const pack<int, 8> &p1)
+  {
+    return int(v) != p1;
+  }
+
+  // binary operator<() //
+
+  inline mask<8> operator<(const pack<int, 8> &p1,
+                           const pack<int, 8> &p2)
+  {
+    return detail::as_pack(_mm256_cmpgt_epi32(p2.v, p1.v));
+  }
+
+  inline mask<8> operator<(const pack<int, 8> &p1, int v)
+  {
+    return p1 < pack<int, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<8> operator<(const pack<int, 8> &p1, const OTHER_T &v)
+  {
+    return p1 < int(v);
+  }
+
+  inline mask<8> operator<(int v, const pack<int, 8> &p1)
+  {
+    return pack<int, 8>(v) < p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<8> operator<(const OTHER_T &v, const pack<int, 8> &p1)
+  {
+    return int(v) < p1;
+  }
+
+  // binary operator<=() //
+
+  inline mask<8> operator<=(const pack<int, 8> &p1,
+                            const pack<int, 8> &p2)
+  {
+    return detail::as_pack(detail::avx_not(_mm256_cmpgt_epi32(p1.v, p2.v)));
+  }
+
+  inline mask<8> operator<=(const pack<int, 8> &p1, int v)
+  {
+    return p1 <= pack<int, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<8> operator<=(const pack<int, 8> &p1, const OTHER_T &v)
+  {
+    return p1 <= int(v);
+  }
+
+  inline mask<8> operator<=(int v, const pack<int, 8> &p1)
+  {
+    return pack<int, 8>(v) <= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<8> operator<=(const OTHER_T &v, const pack<int, 8> &p1)
+  {
+    return int(v) <= p1;
+  }
+
+  // binary operator>() //
+
+  inline mask<8> operator>(const pack<int, 8> &p1,
+                           const pack<int, 8> &p2)
+  {
+    return detail::as_pack(_mm256_cmpgt_epi32(p1.v, p2.v));
+  }
+
+  inline mask<8> operator>(const pack<int, 8> &p1, int v)
+  {
+    return p1 > pack<int, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<8> operator>(const pack<int, 8> &p1, const OTHER_T &v)
+  {
+    return p1 > int(v);
+  }
+
+  inline mask<8> operator>(int v, const pack<int, 8> &p1)
+  {
+    return pack<int, 8>(v) > p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<8> operator>(const OTHER_T &v, const pack<int, 8> &p1)
+  {
+    return int(v) > p1;
+  }
+
+  // binary operator>=() //
+
+  inline mask<8> operator>=(const pack<int, 8> &p1,
+                            const pack<int, 8> &p2)
+  {
+    return detail::as_pack(detail::avx_not(_mm256_cmpgt_epi32(p2.v, p1.v)));
+  }
+
+  inline mask<8> operator>=(const pack<int, 8> &p1, int v)
+  {
+    return p1 >= pack<int, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<8> operator>=(const pack<int, 8> &p1, const OTHER_T &v)
+  {
+    return p1 >= int(v);
+  }
+
+  inline mask<8> operator>=(int v, const pack<int, 8> &p1)
+  {
+    return pack<int, 8>(v) >= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<8> operator>=(const OTHER_T &v, const pack<int, 8> &p1)
+  {
+    return int(v) >= p1;
+  }
+
+  // abs() //
+
+  inline pack<int, 8> abs(const pack<int, 8> &p)
+  {
+    return detail::as_pack(_mm256_abs_epi32(p.v));
+  }
+
+  // max() //
+
+  inline pack<int, 8> max(const pack<int, 8> &a,
+                          const pack<int, 8> &b)
+  {
+    return detail::as_pack(_mm256_max_epi32(a.v, b.v));
+  }
+
+  // min() //
+
+  inline pack<int, 8> min(const pack<int, 8> &a,
+                          const pack<int, 8> &b)
+  {
+    return detail::as_pack(_mm256_min_epi32(a.v, b.v));
+  }
+
+  // binary operator&&() //
+
+  inline mask<8> operator&&(const mask<8> &m1, const mask<8> &m2)
+  {
+    const __m256i inactive = _mm256_or_si256(detail::avx_inactive(m1.v),
+                                             detail::avx_inactive(m2.v));
+    return detail::as_pack(detail::avx_not(inactive));
+  }
+
+  // binary operator||() //
+
+  inline mask<8> operator||(const mask<8> &m1, const mask<8> &m2)
+  {
+    const __m256i inactive = _mm256_and_si256(detail::avx_inactive(m1.v),
+                                              detail::avx_inactive(m2.v));
+    return detail::as_pack(detail::avx_not(inactive));
+  }
+
+  // unary operator!() //
+
+  inline mask<8> operator!(const mask<8> &m)
+  {
+    return detail::as_pack(detail::avx_inactive(m.v));
+  }
+
+  // any() //
+
+  inline bool any(const mask<8> &m)
+  {
+    const __m256i inactive = detail::avx_inactive(m.v);
+    return _mm256_movemask_ps(_mm256_castsi256_ps(inactive)) != 0xFF;
+  }
+
+  // all() //
+
+  inline bool all(const mask<8> &m)
+  {
+    const __m256i inactive = detail::avx_inactive(m.v);
+    return _mm256_movemask_ps(_mm256_castsi256_ps(inactive)) == 0x00;
+  }
+
+  // select() //
+
+  inline pack<int, 8> select(const mask<8> &m,
+                             const pack<int, 8> &t,
+                             const pack<int, 8> &f)
+  {
+    return detail::as_pack(
+      _mm256_blendv_epi8(t.v, f.v, detail::avx_inactive(m.v))
+    );
+  }
+
+  // store() //
+
+  inline void store(const pack<int, 8> &p, void* _dst, const mask<8> &m)
+  {
+    const __m256i active = detail::avx_not(detail::avx_inactive(m.v));
+    _mm256_maskstore_epi32((int*) _dst, active, p.v);
+  }
+
+  // pack<double, 4> //////////////////////////////////////////////////////////
+
+  // binary operator+() //
+
+  inline pack<double, 4> operator+(const pack<double, 4> &p1,
+                                   const pack<double, 4> &p2)
+  {
+    return detail::as_pack(_mm256_add_pd(p1.v, p2.v));
+  }
+
+  inline pack<double, 4> operator+(const pack<double, 4> &p1, double v)
+  {
+    return p1 + pack<double, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 4> operator+(const pack<double, 4> &p1, const OTHER_T &v)
+  {
+    return p1 + double(v);
+  }
+
+  inline pack<double, 4> operator+(double v, const pack<double, 4> &p1)
+  {
+    return pack<double, 4>(v) + p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 4> operator+(const OTHER_T &v, const pack<double, 4> &p1)
+  {
+    return double(v) + p1;
+  }
+
+  // binary operator-() //
+
+  inline pack<double, 4> operator-(const pack<double, 4> &p1,
+                                   const pack<double, 4> &p2)
+  {
+    return detail::as_pack(_mm256_sub_pd(p1.v, p2.v));
+  }
+
+  inline pack<double, 4> operator-(const pack<double, 4> &p1, double v)
+  {
+    return p1 - pack<double, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 4> operator-(const pack<double, 4> &p1, const OTHER_T &v)
+  {
+    return p1 - double(v);
+  }
+
+  inline pack<double, 4> operator-(double v, const pack<double, 4> &p1)
+  {
+    return pack<double, 4>(v) - p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 4> operator-(const OTHER_T &v, const pack<double, 4> &p1)
+  {
+    return double(v) - p1;
+  }
+
+  // binary operator*() //
+
+  inline pack<double, 4> operator*(const pack<double, 4> &p1,
+                                   const pack<double, 4> &p2)
+  {
+    return detail::as_pack(_mm256_mul_pd(p1.v, p2.v));
+  }
+
+  inline pack<double, 4> operator*(const pack<double, 4> &p1, double v)
+  {
+    return p1 * pack<double, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 4> operator*(const pack<double, 4> &p1, const OTHER_T &v)
+  {
+    return p1 * double(v);
+  }
+
+  inline pack<double, 4> operator*(double v, const pack<double, 4> &p1)
+  {
+    return pack<double, 4>(v) * p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 4> operator*(const OTHER_T &v, const pack<double, 4> &p1)
+  {
+    return double(v) * p1;
+  }
+
+  // binary operator/() //
+
+  inline pack<double, 4> operator/(const pack<double, 4> &p1,
+                                   const pack<double, 4> &p2)
+  {
+    return detail::as_pack(_mm256_div_pd(p1.v, p2.v));
+  }
+
+  inline pack<double, 4> operator/(const pack<double, 4> &p1, double v)
+  {
+    return p1 / pack<double, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 4> operator/(const pack<double, 4> &p1, const OTHER_T &v)
+  {
+    return p1 / double(v);
+  }
+
+  inline pack<double, 4> operator/(double v, const pack<double, 4> &p1)
+  {
+    return pack<double, 4>(v) / p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 4> operator/(const OTHER_T &v, const pack<double, 4> &p1)
+  {
+    return double(v) / p1;
+  }
+
+  // unary operator-() //
+
+  inline pack<double, 4> operator-(const pack<double, 4> &p)
+  {
+    return detail::as_pack(_mm256_xor_pd(p.v, _mm256_set1_pd(-0.0)));
+  }
+
+  // abs() //
+
+  inline pack<double, 4> abs(const pack<double, 4> &p)
+  {
+    return detail::as_pack(_mm256_andnot_pd(_mm256_set1_pd(-0.0), p.v));
+  }
+
+  // sqrt() //
+
+  inline pack<double, 4> sqrt(const pack<double, 4> &p)
+  {
+    return detail::as_pack(_mm256_sqrt_pd(p.v));
+  }
+
+  // max() //
+
+  inline pack<double, 4> max(const pack<double, 4> &a,
+                             const pack<double, 4> &b)
+  {
+    return detail::as_pack(_mm256_max_pd(b.v, a.v));
+  }
+
+  // min() //
+
+  inline pack<double, 4> min(const pack<double, 4> &a,
+                             const pack<double, 4> &b)
+  {
+    return detail::as_pack(_mm256_min_pd(b.v, a.v));
+  }
+
+  // mask<8> <--> bitmask<8> conversions //////////////////////////////////////
+
+  inline bitmask<8> to_bitmask(const mask<8> &m)
+  {
+    const __m256i inactive = detail::avx_inactive(m.v);
+    return bitmask<8>::from_bits(
+      ~_mm256_movemask_ps(_mm256_castsi256_ps(inactive))
+    );
+  }
+
+  inline mask<8> to_mask(const bitmask<8> &m)
+  {
+    const __m256i lanes = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    const __m256i bits  = _mm256_and_si256(_mm256_set1_epi32(m.bits), lanes);
+    return detail::as_pack(_mm256_cmpeq_epi32(bits, lanes));
+  }
+
+  // mask_for<double, 4> <--> bitmask<4> conversions //////////////////////////
+
+  inline bitmask<4> to_bitmask(const mask_for<double, 4> &m)
+  {
+    const __m256i inactive = detail::avx_inactive64(m.v);
+    return bitmask<4>::from_bits(
+      ~_mm256_movemask_pd(_mm256_castsi256_pd(inactive))
+    );
+  }
+
+  namespace detail {
+
+    template <>
+    struct bitmask_expander<long long, 4>
+    {
+      static pack<long long, 4> expand(const bitmask<4> &m)
+      {
+        const __m256i lanes = _mm256_setr_epi32(1, 1, 2, 2, 4, 4, 8, 8);
+        const __m256i bits  = _mm256_and_si256(_mm256_set1_epi32(m.bits),
+                                               lanes);
+        return as_pack<long long, 4>(_mm256_cmpeq_epi32(bits, lanes));
+      }
+    };
+
+  } // ::psimd::detail
+
+  // bitmask<8> select() //
+
+  inline pack<float, 8> select(const bitmask<8> &m,
+                               const pack<float, 8> &t,
+                               const pack<float, 8> &f)
+  {
+    return select(to_mask(m), t, f);
+  }
+
+  inline pack<int, 8> select(const bitmask<8> &m,
+                             const pack<int, 8> &t,
+                             const pack<int, 8> &f)
+  {
+    return select(to_mask(m), t, f);
+  }
+
+  // bitmask<8> store() //
+
+  inline void store(const pack<float, 8> &p, void* _dst, const bitmask<8> &m)
+  {
+    _mm256_maskstore_ps((float*) _dst, to_mask(m).v, p.v);
+  }
+
+  inline void store(const pack<int, 8> &p, void* _dst, const bitmask<8> &m)
+  {
+    _mm256_maskstore_epi32((int*) _dst, to_mask(m).v, p.v);
+  }
+
+  // mask_for<double, 4> //////////////////////////////////////////////////////
+
+  // binary operator==() //
+
+  inline mask_for<double, 4> operator==(const pack<double, 4> &p1,
+                                        const pack<double, 4> &p2)
+  {
+    return detail::as_pack<long long, 4>(
+      _mm256_castpd_si256(_mm256_cmp_pd(p1.v, p2.v, _CMP_EQ_OQ))
+    );
+  }
+
+  inline mask_for<double, 4> operator==(const pack<double, 4> &p1, double v)
+  {
+    return p1 == pack<double, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 4> operator==(const pack<double, 4> &p1,
+                                        const OTHER_T &v)
+  {
+    return p1 == double(v);
+  }
+
+  inline mask_for<double, 4> operator==(double v, const pack<double, 4> &p1)
+  {
+    return pack<double, 4>(v) == p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 4> operator==(const OTHER_T &v,
+                                        const pack<double, 4> &p1)
+  {
+    return double(v) == p1;
+  }
+
+  // binary operator!=() //
+
+  inline mask_for<double, 4> operator!=(const pack<double, 4> &p1,
+                                        const pack<double, 4> &p2)
+  {
+    return detail::as_pack<long long, 4>(
+      _mm256_castpd_si256(_mm256_cmp_pd(p1.v, p2.v, _CMP_NEQ_UQ))
+    );
+  }
+
+  inline mask_for<double, 4> operator!=(const pack<double, 4> &p1, double v)
+  {
+    return p1 != pack<double, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 4> operator!=(const pack<double, 4> &p1,
+                                        const OTHER_T &v)
+  {
+    return p1 != double(v);
+  }
+
+  inline mask_for<double, 4> operator!=(double v, const pack<double, 4> &p1)
+  {
+    return pack<double, 4>(v) != p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 4> operator!=(const OTHER_T &v,
+                                        const pack<double, 4> &p1)
+  {
+    return double(v) != p1;
+  }
+
+  // binary operator<() //
+
+  inline mask_for<double, 4> operator<(const pack<double, 4> &p1,
+                                       const pack<double, 4> &p2)
+  {
+    return detail::as_pack<long long, 4>(
+      _mm256_castpd_si256(_mm256_cmp_pd(p1.v, p2.v, _CMP_LT_OQ))
+    );
+  }
+
+  inline mask_for<double, 4> operator<(const pack<double, 4> &p1, double v)
+  {
+    return p1 < pack<double, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 4> operator<(const pack<double, 4> &p1,
+                                       const OTHER_T &v)
+  {
+    return p1 < double(v);
+  }
+
+  inline mask_for<double, 4> operator<(double v, const pack<double, 4> &p1)
+  {
+    return pack<double, 4>(v) < p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 4> operator<(const OTHER_T &v,
+                                       const pack<double, 4> &p1)
+  {
+    return double(v) < p1;
+  }
+
+  // binary operator<=() //
+
+  inline mask_for<double, 4> operator<=(const pack<double, 4> &p1,
+                                        const pack<double, 4> &p2)
+  {
+    return detail::as_pack<long long, 4>(
+      _mm256_castpd_si256(_mm256_cmp_pd(p1.v, p2.v, _CMP_LE_OQ))
+    );
+  }
+
+  inline mask_for<double, 4> operator<=(const pack<double, 4> &p1, double v)
+  {
+    return p1 <= pack<double, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 4> operator<=(const pack<double, 4> &p1,
+                                        const OTHER_T &v)
+  {
+    return p1 <= double(v);
+  }
+
+  inline mask_for<double, 4> operator<=(double v, const pack<double, 4> &p1)
+  {
+    return pack<double, 4>(v) <= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 4> operator<=(const OTHER_T &v,
+                                        const pack<double, 4> &p1)
+  {
+    return double(v) <= p1;
+  }
+
+  // binary operator>() //
+
+  inline mask_for<double, 4> operator>(const pack<double, 4> &p1,
+                                       const pack<double, 4> &p2)
+  {
+    return detail::as_pack<long long, 4>(
+      _mm256_castpd_si256(_mm256_cmp_pd(p1.v, p2.v, _CMP_GT_OQ))
+    );
+  }
+
+  inline mask_for<double, 4> operator>(const pack<double, 4> &p1, double v)
+  {
+    return p1 > pack<double, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 4> operator>(const pack<double, 4> &p1,
+                                       const OTHER_T &v)
+  {
+    return p1 > double(v);
+  }
+
+  inline mask_for<double, 4> operator>(double v, const pack<double, 4> &p1)
+  {
+    return pack<double, 4>(v) > p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 4> operator>(const OTHER_T &v,
+                                       const pack<double, 4> &p1)
+  {
+    return double(v) > p1;
+  }
+
+  // binary operator>=() //
+
+  inline mask_for<double, 4> operator>=(const pack<double, 4> &p1,
+                                        const pack<double, 4> &p2)
+  {
+    return detail::as_pack<long long, 4>(
+      _mm256_castpd_si256(_mm256_cmp_pd(p1.v, p2.v, _CMP_GE_OQ))
+    );
+  }
+
+  inline mask_for<double, 4> operator>=(const pack<double, 4> &p1, double v)
+  {
+    return p1 >= pack<double, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 4> operator>=(const pack<double, 4> &p1,
+                                        const OTHER_T &v)
+  {
+    return p1 >= double(v);
+  }
+
+  inline mask_for<double, 4> operator>=(double v, const pack<double, 4> &p1)
+  {
+    return pack<double, 4>(v) >= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 4> operator>=(const OTHER_T &v,
+                                        const pack<double, 4> &p1)
+  {
+    return double(v) >= p1;
+  }
+
+  // binary operator&&() //
+
+  inline mask_for<double, 4> operator&&(const mask_for<double, 4> &m1,
+                                        const mask_for<double, 4> &m2)
+  {
+    const __m256i inactive = _mm256_or_si256(detail::avx_inactive64(m1.v),
+                                             detail::avx_inactive64(m2.v));
+    return detail::as_pack<long long, 4>(detail::avx_not(inactive));
+  }
+
+  // binary operator||() //
+
+  inline mask_for<double, 4> operator||(const mask_for<double, 4> &m1,
+                                        const mask_for<double, 4> &m2)
+  {
+    const __m256i inactive = _mm256_and_si256(detail::avx_inactive64(m1.v),
+                                              detail::avx_inactive64(m2.v));
+    return detail::as_pack<long long, 4>(detail::avx_not(inactive));
+  }
+
+  // unary operator!() //
+
+  inline mask_for<double, 4> operator!(const mask_for<double, 4> &m)
+  {
+    return detail::as_pack<long long, 4>(detail::avx_inactive64(m.v));
+  }
+
+  // any() //
+
+  inline bool any(const mask_for<double, 4> &m)
+  {
+    const __m256i inactive = detail::avx_inactive64(m.v);
+    return _mm256_movemask_pd(_mm256_castsi256_pd(inactive)) != 0xF;
+  }
+
+  // all() //
+
+  inline bool all(const mask_for<double, 4> &m)
+  {
+    const __m256i inactive = detail::avx_inactive64(m.v);
+    return _mm256_movemask_pd(_mm256_castsi256_pd(inactive)) == 0x0;
+  }
+
+  // select() //
+
+  inline pack<double, 4> select(const mask_for<double, 4> &m,
+                                const pack<double, 4> &t,
+                                const pack<double, 4> &f)
+  {
+    const __m256i inactive = detail::avx_inactive64(m.v);
+    return detail::as_pack(
+      _mm256_blendv_pd(t.v, f.v, _mm256_castsi256_pd(inactive))
+    );
+  }
+
+  // pack<long long, 4> ////////////////////////////////////////////////////////
+
+  // binary operator+() //
+
+  inline pack<long long, 4> operator+(const pack<long long, 4> &p1,
+                                      const pack<long long, 4> &p2)
+  {
+    return detail::as_pack<long long, 4>(_mm256_add_epi64(p1.v, p2.v));
+  }
+
+  inline pack<long long, 4> operator+(const pack<long long, 4> &p1, long long v)
+  {
+    return p1 + pack<long long, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 4> operator+(const pack<long long, 4> &p1,
+                                      const OTHER_T &v)
+  {
+    return p1 + static_cast<long long>(v);
+  }
+
+  inline pack<long long, 4> operator+(long long v, const pack<long long, 4> &p1)
+  {
+    return pack<long long, 4>(v) + p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 4> operator+(const OTHER_T &v,
+                                      const pack<long long, 4> &p1)
+  {
+    return static_cast<long long>(v) + p1;
+  }
+
+  // binary operator-() //
+
+  inline pack<long long, 4> operator-(const pack<long long, 4> &p1,
+                                      const pack<long long, 4> &p2)
+  {
+    return detail::as_pack<long long, 4>(_mm256_sub_epi64(p1.v, p2.v));
+  }
+
+  inline pack<long long, 4> operator-(const pack<long long, 4> &p1, long long v)
+  {
+    return p1 - pack<long long, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 4> operator-(const pack<long long, 4> &p1,
+                                      const OTHER_T &v)
+  {
+    return p1 - static_cast<long long>(v);
+  }
+
+  inline pack<long long, 4> operator-(long long v, const pack<long long, 4> &p1)
+  {
+    return pack<long long, 4>(v) - p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 4> operator-(const OTHER_T &v,
+                                      const pack<long long, 4> &p1)
+  {
+    return static_cast<long long>(v) - p1;
+  }
+
+  // binary operator&() //
+
+  inline pack<long long, 4> operator&(const pack<long long, 4> &p1,
+                                      const pack<long long, 4> &p2)
+  {
+    return detail::as_pack<long long, 4>(_mm256_and_si256(p1.v, p2.v));
+  }
+
+  inline pack<long long, 4> operator&(const pack<long long, 4> &p1, long long v)
+  {
+    return p1 & pack<long long, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 4> operator&(const pack<long long, 4> &p1,
+                                      const OTHER_T &v)
+  {
+    return p1 & static_cast<long long>(v);
+  }
+
+  inline pack<long long, 4> operator&(long long v, const pack<long long, 4> &p1)
+  {
+    return pack<long long, 4>(v) & p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 4> operator&(const OTHER_T &v,
+                                      const pack<long long, 4> &p1)
+  {
+    return static_cast<long long>(v) & p1;
+  }
+
+  // binary operator|() //
+
+  inline pack<long long, 4> operator|(const pack<long long, 4> &p1,
+                                      const pack<long long, 4> &p2)
+  {
+    return detail::as_pack<long long, 4>(_mm256_or_si256(p1.v, p2.v));
+  }
+
+  inline pack<long long, 4> operator|(const pack<long long, 4> &p1, long long v)
+  {
+    return p1 | pack<long long, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 4> operator|(const pack<long long, 4> &p1,
+                                      const OTHER_T &v)
+  {
+    return p1 | static_cast<long long>(v);
+  }
+
+  inline pack<long long, 4> operator|(long long v, const pack<long long, 4> &p1)
+  {
+    return pack<long long, 4>(v) | p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 4> operator|(const OTHER_T &v,
+                                      const pack<long long, 4> &p1)
+  {
+    return static_cast<long long>(v) | p1;
+  }
+
+  // binary operator^() //
+
+  inline pack<long long, 4> operator^(const pack<long long, 4> &p1,
+                                      const pack<long long, 4> &p2)
+  {
+    return detail::as_pack<long long, 4>(_mm256_xor_si256(p1.v, p2.v));
+  }
+
+  inline pack<long long, 4> operator^(const pack<long long, 4> &p1, long long v)
+  {
+    return p1 ^ pack<long long, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 4> operator^(const pack<long long, 4> &p1,
+                                      const OTHER_T &v)
+  {
+    return p1 ^ static_cast<long long>(v);
+  }
+
+  inline pack<long long, 4> operator^(long long v, const pack<long long, 4> &p1)
+  {
+    return pack<long long, 4>(v) ^ p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 4> operator^(const OTHER_T &v,
+                                      const pack<long long, 4> &p1)
+  {
+    return static_cast<long long>(v) ^ p1;
+  }
+
+  // andnot() //
+
+  inline pack<long long, 4> andnot(const pack<long long, 4> &p1,
+                                   const pack<long long, 4> &p2)
+  {
+    return detail::as_pack<long long, 4>(_mm256_andnot_si256(p2.v, p1.v));
+  }
+
+  // binary operator<<() //
+
+  inline pack<long long, 4> operator<<(const pack<long long, 4> &p1, int v)
+  {
+    return detail::as_pack<long long, 4>(
+      _mm256_sll_epi64(p1.v, _mm_cvtsi32_si128(v))
+    );
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<long long, 4> operator<<(const pack<long long, 4> &p1,
+                                       const OTHER_T &v)
+  {
+    return p1 << int(v);
+  }
+
+  // binary operator>>() //
+
+  inline pack<long long, 4> operator>>(const pack<long long, 4> &p1, int v)
+  {
+    // no 64-bit arithmetic shift before AVX-512: the sign is shifted in
+    // separately
+    const __m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), p1.v);
+    const __m256i high = _mm256_sll_epi64(sign, _mm_cvtsi32_si128(64 - v));
+    return detail::as_pack<long long, 4>(
+      _mm256_or_si256(_mm256_srl_epi64(p1.v, _mm_cvtsi32_si128(v)), high)
+    );
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<long long, 4> operator>>(const pack<long long, 4> &p1,
+                                       const OTHER_T &v)
+  {
+    return p1 >> int(v);
+  }
+
+  // binary operator==() //
+
+  inline mask_for<long long, 4> operator==(const pack<long long, 4> &p1,
+                                           const pack<long long, 4> &p2)
+  {
+    return detail::as_pack<long long, 4>(_mm256_cmpeq_epi64(p1.v, p2.v));
+  }
+
+  inline mask_for<long long, 4> operator==(const pack<long long, 4> &p1,
+                                           long long v)
+  {
+    return p1 == pack<long long, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 4> operator==(const pack<long long, 4> &p1,
+                                           const OTHER_T &v)
+  {
+    return p1 == static_cast<long long>(v);
+  }
+
+  inline mask_for<long long, 4> operator==(long long v,
+                                           const pack<long long, 4> &p1)
+  {
+    return pack<long long, 4>(v) == p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 4> operator==(const OTHER_T &v,
+                                           const pack<long long, 4> &p1)
+  {
+    return static_cast<long long>(v) == p1;
+  }
+
+  // binary operator!=() //
+
+  inline mask_for<long long, 4> operator!=(const pack<long long, 4> &p1,
+                                           const pack<long long, 4> &p2)
+  {
+    return detail::as_pack<long long, 4>(
+      detail::avx_not(_mm256_cmpeq_epi64(p1.v, p2.v))
+    );
+  }
+
+  inline mask_for<long long, 4> operator!=(const pack<long long, 4> &p1,
+                                           long long v)
+  {
+    return p1 != pack<long long, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 4> operator!=(const pack<long long, 4> &p1,
+                                           const OTHER_T &v)
+  {
+    return p1 != static_cast<long long>(v);
+  }
+
+  inline mask_for<long long, 4> operator!=(long long v,
+                                           const pack<long long, 4> &p1)
+  {
+    return pack<long long, 4>(v) != p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 4> operator!=(const OTHER_T &v,
+                                           const pack<long long, 4> &p1)
+  {
+    return static_cast<long long>(v) != p1;
+  }
+
+  // binary operator<() //
+
+  inline mask_for<long long, 4> operator<(const pack<long long, 4> &p1,
+                                          const pack<long long, 4> &p2)
+  {
+    return detail::as_pack<long long, 4>(_mm256_cmpgt_epi64(p2.v, p1.v));
+  }
+
+  inline mask_for<long long, 4> operator<(const pack<long long, 4> &p1,
+                                          long long v)
+  {
+    return p1 < pack<long long, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 4> operator<(const pack<long long, 4> &p1,
+                                          const OTHER_T &v)
+  {
+    return p1 < static_cast<long long>(v);
+  }
+
+  inline mask_for<long long, 4> operator<(long long v,
+                                          const pack<long long, 4> &p1)
+  {
+    return pack<long long, 4>(v) < p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 4> operator<(const OTHER_T &v,
+                                          const pack<long long, 4> &p1)
+  {
+    return static_cast<long long>(v) < p1;
+  }
+
+  // binary operator<=() //
+
+  inline mask_for<long long, 4> operator<=(const pack<long long, 4> &p1,
+                                           const pack<long long, 4> &p2)
+  {
+    return detail::as_pack<long long, 4>(
+      detail::avx_not(_mm256_cmpgt_epi64(p1.v, p2.v))
+    );
+  }
+
+  inline mask_for<long long, 4> operator<=(const pack<long long, 4> &p1,
+                                           long long v)
+  {
+    return p1 <= pack<long long, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 4> operator<=(const pack<long long, 4> &p1,
+                                           const OTHER_T &v)
+  {
+    return p1 <= static_cast<long long>(v);
+  }
+
+  inline mask_for<long long, 4> operator<=(long long v,
+                                           const pack<long long, 4> &p1)
+  {
+    return pack<long long, 4>(v) <= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 4> operator<=(const OTHER_T &v,
+                                           const pack<long long, 4> &p1)
+  {
+    return static_cast<long long>(v) <= p1;
+  }
+
+  // binary operator>() //
+
+  inline mask_for<long long, 4> operator>(const pack<long long, 4> &p1,
+                                          const pack<long long, 4> &p2)
+  {
+    return detail::as_pack<long long, 4>(_mm256_cmpgt_epi64(p1.v, p2.v));
+  }
+
+  inline mask_for<long long, 4> operator>(const pack<long long, 4> &p1,
+                                          long long v)
+  {
+    return p1 > pack<long long, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 4> operator>(const pack<long long, 4> &p1,
+                                          const OTHER_T &v)
+  {
+    return p1 > static_cast<long long>(v);
+  }
+
+  inline mask_for<long long, 4> operator>(long long v,
+                                          const pack<long long, 4> &p1)
+  {
+    return pack<long long, 4>(v) > p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 4> operator>(const OTHER_T &v,
+                                          const pack<long long, 4> &p1)
+  {
+    return static_cast<long long>(v) > p1;
+  }
+
+  // binary operator>=() //
+
+  inline mask_for<long long, 4> operator>=(const pack<long long, 4> &p1,
+                                           const pack<long long, 4> &p2)
+  {
+    return detail::as_pack<long long, 4>(
+      detail::avx_not(_mm256_cmpgt_epi64(p2.v, p1.v))
+    );
+  }
+
+  inline mask_for<long long, 4> operator>=(const pack<long long, 4> &p1,
+                                           long long v)
+  {
+    return p1 >= pack<long long, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 4> operator>=(const pack<long long, 4> &p1,
+                                           const OTHER_T &v)
+  {
+    return p1 >= static_cast<long long>(v);
+  }
+
+  inline mask_for<long long, 4> operator>=(long long v,
+                                           const pack<long long, 4> &p1)
+  {
+    return pack<long long, 4>(v) >= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 4> operator>=(const OTHER_T &v,
+                                           const pack<long long, 4> &p1)
+  {
+    return static_cast<long long>(v) >= p1;
+  }
+
+  // select() //
+
+  inline pack<long long, 4> select(const mask_for<long long, 4> &m,
+                                   const pack<long long, 4> &t,
+                                   const pack<long long, 4> &f)
+  {
+    const __m256i inactive = detail::avx_inactive64(m.v);
+    return detail::as_pack<long long, 4>(
+      _mm256_blendv_epi8(t.v, f.v, inactive)
+    );
+  }
+
+  // Rounding and conversions to int //////////////////////////////////////////
+
+  // NOTE: the conversions return INT_MIN (the "integer indefinite") for lanes
+  //       out of the range of int, as the generic versions do
+
+  // floor() //
+
+  inline pack<float, 8> floor(const pack<float, 8> &p)
+  {
+    return detail::as_pack(
+      _mm256_round_ps(p.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // ceil() //
+
+  inline pack<float, 8> ceil(const pack<float, 8> &p)
+  {
+    return detail::as_pack(
+      _mm256_round_ps(p.v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // trunc() //
+
+  inline pack<float, 8> trunc(const pack<float, 8> &p)
+  {
+    return detail::as_pack(
+      _mm256_round_ps(p.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // nearbyint() //
+
+  inline pack<float, 8> nearbyint(const pack<float, 8> &p)
+  {
+    return detail::as_pack(
+      _mm256_round_ps(p.v, _MM_FROUND_CUR_DIRECTION | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // floor() //
+
+  inline pack<double, 4> floor(const pack<double, 4> &p)
+  {
+    return detail::as_pack(
+      _mm256_round_pd(p.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // ceil() //
+
+  inline pack<double, 4> ceil(const pack<double, 4> &p)
+  {
+    return detail::as_pack(
+      _mm256_round_pd(p.v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // trunc() //
+
+  inline pack<double, 4> trunc(const pack<double, 4> &p)
+  {
+    return detail::as_pack(
+      _mm256_round_pd(p.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // nearbyint() //
+
+  inline pack<double, 4> nearbyint(const pack<double, 4> &p)
+  {
+    return detail::as_pack(
+      _mm256_round_pd(p.v, _MM_FROUND_CUR_DIRECTION | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // to_int_round() //
+
+  inline pack<int, 8> to_int_round(const pack<float, 8> &p)
+  {
+    return detail::as_pack(_mm256_cvtps_epi32(p.v));
+  }
+
+  // to_int_trunc() //
+
+  inline pack<int, 8> to_int_trunc(const pack<float, 8> &p)
+  {
+    return detail::as_pack(_mm256_cvttps_epi32(p.v));
+  }
+
+  // to_int_round() //
+
+  inline pack<int, 4> to_int_round(const pack<double, 4> &p)
+  {
+    return detail::as_pack(_mm256_cvtpd_epi32(p.v));
+  }
+
+  // to_int_trunc() //
+
+  inline pack<int, 4> to_int_trunc(const pack<double, 4> &p)
+  {
+    return detail::as_pack(_mm256_cvttpd_epi32(p.v));
+  }
+
+  // mask<4> <--> mask_for<double, 4> conversions //
+
+  namespace detail {
+
+    template <>
+    struct mask_converter<long long, int, 4>
+    {
+      static pack<long long, 4> convert(const pack<int, 4> &m)
+      {
+        const __m128i active = sse_not(sse_inactive(m.v));
+        return as_pack<long long, 4>(_mm256_cvtepi32_epi64(active));
+      }
+    };
+
+    template <>
+    struct mask_converter<int, long long, 4>
+    {
+      static pack<int, 4> convert(const pack<long long, 4> &m)
+      {
+        const __m256i active = avx_not(avx_inactive64(m.v));
+        const __m256i lo32   = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+        return as_pack(_mm256_castsi256_si128(
+          _mm256_permutevar8x32_epi32(active, lo32)
+        ));
+      }
+    };
+
+  } // ::psimd::detail
+
+  // Butterfly shuffles of tree reductions (see functions/reduce.h) ///////////
+
+  namespace detail {
+
+    inline pack<float, 8> butterfly(const pack<float, 8> &p,
+                                    std::integral_constant<int, 4>)
+    {
+      return as_pack(_mm256_permute2f128_ps(p.v, p.v, 1));
+    }
+
+    inline pack<float, 8> butterfly(const pack<float, 8> &p,
+                                    std::integral_constant<int, 2>)
+    {
+      return as_pack(_mm256_permute_ps(p.v, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+    inline pack<float, 8> butterfly(const pack<float, 8> &p,
+                                    std::integral_constant<int, 1>)
+    {
+      return as_pack(_mm256_permute_ps(p.v, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    inline pack<int, 8> butterfly(const pack<int, 8> &p,
+                                  std::integral_constant<int, 4>)
+    {
+      return as_pack(_mm256_permute2x128_si256(p.v, p.v, 1));
+    }
+
+    inline pack<int, 8> butterfly(const pack<int, 8> &p,
+                                  std::integral_constant<int, 2>)
+    {
+      return as_pack(_mm256_shuffle_epi32(p.v, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+    inline pack<int, 8> butterfly(const pack<int, 8> &p,
+                                  std::integral_constant<int, 1>)
+    {
+      return as_pack(_mm256_shuffle_epi32(p.v, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    inline pack<double, 4> butterfly(const pack<double, 4> &p,
+                                     std::integral_constant<int, 2>)
+    {
+      return as_pack(_mm256_permute2f128_pd(p.v, p.v, 1));
+    }
+
+    inline pack<double, 4> butterfly(const pack<double, 4> &p,
+                                     std::integral_constant<int, 1>)
+    {
+      return as_pack(_mm256_permute_pd(p.v, 0x5));
+    }
+
+    inline pack<long long, 4> butterfly(const pack<long long, 4> &p,
+                                        std::integral_constant<int, 2>)
+    {
+      return as_pack<long long, 4>(_mm256_permute2x128_si256(p.v, p.v, 1));
+    }
+
+    inline pack<long long, 4> butterfly(const pack<long long, 4> &p,
+                                        std::integral_constant<int, 1>)
+    {
+      return as_pack<long long, 4>(
+        _mm256_shuffle_epi32(p.v, _MM_SHUFFLE(1, 0, 3, 2))
+      );
+    }
+
+  } // ::psimd::detail
+
+  // Lane shifts (see functions/permute.h) ////////////////////////////////////
+
+  // NOTE: lanes shifted in are taken from 'fill', which holds the same value
+  //       in every lane
+
+  namespace detail {
+
+    template <int D>
+    inline pack<float, 8> shift_lanes_up(const pack<float, 8> &p,
+                                         const pack<float, 8> &fill,
+                                         std::integral_constant<int, D>)
+    {
+      const __m256i v = _mm256_castps_si256(p.v);
+      const __m256i f = _mm256_castps_si256(fill.v);
+      const __m256i below   = _mm256_permute2x128_si256(v, f, 0x02);
+      const __m256i shifted = _mm256_alignr_epi8(v, below, 16 - 4 * D);
+      return as_pack(_mm256_castsi256_ps(shifted));
+    }
+
+    template <int D>
+    inline pack<int, 8> shift_lanes_up(const pack<int, 8> &p,
+                                       const pack<int, 8> &fill,
+                                       std::integral_constant<int, D>)
+    {
+      const __m256i below   = _mm256_permute2x128_si256(p.v, fill.v, 0x02);
+      const __m256i shifted = _mm256_alignr_epi8(p.v, below, 16 - 4 * D);
+      return as_pack(shifted);
+    }
+
+    template <int D>
+    inline pack<double, 4> shift_lanes_up(const pack<double, 4> &p,
+                                          const pack<double, 4> &fill,
+                                          std::integral_constant<int, D>)
+    {
+      const __m256i v = _mm256_castpd_si256(p.v);
+      const __m256i f = _mm256_castpd_si256(fill.v);
+      const __m256i below   = _mm256_permute2x128_si256(v, f, 0x02);
+      const __m256i shifted = _mm256_alignr_epi8(v, below, 16 - 8 * D);
+      return as_pack(_mm256_castsi256_pd(shifted));
+    }
+
+    template <int D>
+    inline pack<long long, 4> shift_lanes_up(const pack<long long, 4> &p,
+                                             const pack<long long, 4> &fill,
+                                             std::integral_constant<int, D>)
+    {
+      const __m256i below   = _mm256_permute2x128_si256(p.v, fill.v, 0x02);
+      const __m256i shifted = _mm256_alignr_epi8(p.v, below, 16 - 8 * D);
+      return as_pack<long long, 4>(shifted);
+    }
+
+    template <int D>
+    inline pack<float, 8> shift_lanes_down(const pack<float, 8> &p,
+                                           const pack<float, 8> &fill,
+                                           std::integral_constant<int, D>)
+    {
+      const __m256i v = _mm256_castps_si256(p.v);
+      const __m256i f = _mm256_castps_si256(fill.v);
+      const __m256i above   = _mm256_permute2x128_si256(v, f, 0x21);
+      const __m256i shifted = _mm256_alignr_epi8(above, v, 4 * D);
+      return as_pack(_mm256_castsi256_ps(shifted));
+    }
+
+    template <int D>
+    inline pack<int, 8> shift_lanes_down(const pack<int, 8> &p,
+                                         const pack<int, 8> &fill,
+                                         std::integral_constant<int, D>)
+    {
+      const __m256i above   = _mm256_permute2x128_si256(p.v, fill.v, 0x21);
+      const __m256i shifted = _mm256_alignr_epi8(above, p.v, 4 * D);
+      return as_pack(shifted);
+    }
+
+    template <int D>
+    inline pack<double, 4> shift_lanes_down(const pack<double, 4> &p,
+                                            const pack<double, 4> &fill,
+                                            std::integral_constant<int, D>)
+    {
+      const __m256i v = _mm256_castpd_si256(p.v);
+      const __m256i f = _mm256_castpd_si256(fill.v);
+      const __m256i above   = _mm256_permute2x128_si256(v, f, 0x21);
+      const __m256i shifted = _mm256_alignr_epi8(above, v, 8 * D);
+      return as_pack(_mm256_castsi256_pd(shifted));
+    }
+
+    template <int D>
+    inline pack<long long, 4> shift_lanes_down(const pack<long long, 4> &p,
+                                               const pack<long long, 4> &fill,
+                                               std::integral_constant<int, D>)
+    {
+      const __m256i above   = _mm256_permute2x128_si256(p.v, fill.v, 0x21);
+      const __m256i shifted = _mm256_alignr_epi8(above, p.v, 8 * D);
+      return as_pack<long long, 4>(shifted);
+    }
+
+  } // ::psimd::detail
+
+  // Lane permutations (see functions/permute.h) //////////////////////////////
+
+  inline pack<float, 8> permute(const pack<float, 8> &p,
+                                const pack<int, 8> &indices)
+  {
+    return detail::as_pack(_mm256_permutevar8x32_ps(p.v, indices.v));
+  }
+
+  inline pack<int, 8> permute(const pack<int, 8> &p,
+                              const pack<int, 8> &indices)
+  {
+    return detail::as_pack(_mm256_permutevar8x32_epi32(p.v, indices.v));
+  }
+
+  inline pack<double, 4> permute(const pack<double, 4> &p,
+                                 const pack<int, 4> &indices)
+  {
+    // each 64-bit lane selects the 32-bit halves 2i and 2i + 1
+    const __m256i wide  = _mm256_cvtepu32_epi64(indices.v);
+    const __m256i twice = _mm256_slli_epi64(wide, 1);
+    const __m256i pairs = _mm256_or_si256(twice, _mm256_slli_epi64(
+      _mm256_add_epi64(twice, _mm256_set1_epi64x(1)), 32
+    ));
+    const __m256 v = _mm256_castpd_ps(p.v);
+    return detail::as_pack(
+      _mm256_castps_pd(_mm256_permutevar8x32_ps(v, pairs))
+    );
+  }
+
+  inline pack<long long, 4> permute(const pack<long long, 4> &p,
+                                    const pack<int, 4> &indices)
+  {
+    // each 64-bit lane selects the 32-bit halves 2i and 2i + 1
+    const __m256i wide  = _mm256_cvtepu32_epi64(indices.v);
+    const __m256i twice = _mm256_slli_epi64(wide, 1);
+    const __m256i pairs = _mm256_or_si256(twice, _mm256_slli_epi64(
+      _mm256_add_epi64(twice, _mm256_set1_epi64x(1)), 32
+    ));
+    return detail::as_pack<long long, 4>(
+      _mm256_permutevar8x32_epi32(p.v, pairs)
+    );
+  }
+
+  inline pack<float, 8> interleave_lo(const pack<float, 8> &a,
+                                      const pack<float, 8> &b)
+  {
+    // unpacks interleave within 128-bit halves, recombined across them
+    const __m256 lo = _mm256_unpacklo_ps(a.v, b.v);
+    const __m256 hi = _mm256_unpackhi_ps(a.v, b.v);
+    return detail::as_pack(_mm256_permute2f128_ps(lo, hi, 0x20));
+  }
+
+  inline pack<float, 8> interleave_hi(const pack<float, 8> &a,
+                                      const pack<float, 8> &b)
+  {
+    const __m256 lo = _mm256_unpacklo_ps(a.v, b.v);
+    const __m256 hi = _mm256_unpackhi_ps(a.v, b.v);
+    return detail::as_pack(_mm256_permute2f128_ps(lo, hi, 0x31));
+  }
+
+  inline pack<int, 8> interleave_lo(const pack<int, 8> &a,
+                                    const pack<int, 8> &b)
+  {
+    // unpacks interleave within 128-bit halves, recombined across them
+    const __m256i lo = _mm256_unpacklo_epi32(a.v, b.v);
+    const __m256i hi = _mm256_unpackhi_epi32(a.v, b.v);
+    return detail::as_pack(_mm256_permute2x128_si256(lo, hi, 0x20));
+  }
+
+  inline pack<int, 8> interleave_hi(const pack<int, 8> &a,
+                                    const pack<int, 8> &b)
+  {
+    const __m256i lo = _mm256_unpacklo_epi32(a.v, b.v);
+    const __m256i hi = _mm256_unpackhi_epi32(a.v, b.v);
+    return detail::as_pack(_mm256_permute2x128_si256(lo, hi, 0x31));
+  }
+
+  inline pack<double, 4> interleave_lo(const pack<double, 4> &a,
+                                       const pack<double, 4> &b)
+  {
+    // unpacks interleave within 128-bit halves, recombined across them
+    const __m256d lo = _mm256_unpacklo_pd(a.v, b.v);
+    const __m256d hi = _mm256_unpackhi_pd(a.v, b.v);
+    return detail::as_pack(_mm256_permute2f128_pd(lo, hi, 0x20));
+  }
+
+  inline pack<double, 4> interleave_hi(const pack<double, 4> &a,
+                                       const pack<double, 4> &b)
+  {
+    const __m256d lo = _mm256_unpacklo_pd(a.v, b.v);
+    const __m256d hi = _mm256_unpackhi_pd(a.v, b.v);
+    return detail::as_pack(_mm256_permute2f128_pd(lo, hi, 0x31));
+  }
+
+  inline pack<long long, 4> interleave_lo(const pack<long long, 4> &a,
+                                          const pack<long long, 4> &b)
+  {
+    // unpacks interleave within 128-bit halves, recombined across them
+    const __m256i lo = _mm256_unpacklo_epi64(a.v, b.v);
+    const __m256i hi = _mm256_unpackhi_epi64(a.v, b.v);
+    return detail::as_pack<long long, 4>(
+      _mm256_permute2x128_si256(lo, hi, 0x20)
+    );
+  }
+
+  inline pack<long long, 4> interleave_hi(const pack<long long, 4> &a,
+                                          const pack<long long, 4> &b)
+  {
+    const __m256i lo = _mm256_unpacklo_epi64(a.v, b.v);
+    const __m256i hi = _mm256_unpackhi_epi64(a.v, b.v);
+    return detail::as_pack<long long, 4>(
+      _mm256_permute2x128_si256(lo, hi, 0x31)
+    );
+  }
+
+  // Streaming stores (see functions/memory.h) ////////////////////////////////
+
+  inline void store_stream(const pack<float, 8> &p, void* _dst)
+  {
+    _mm256_stream_ps((float*) _dst, p.v);
+  }
+
+  inline void store_stream(const pack<int, 8> &p, void* _dst)
+  {
+    _mm256_stream_si256((__m256i*) _dst, p.v);
+  }
+
+  inline void store_stream(const pack<double, 4> &p, void* _dst)
+  {
+    _mm256_stream_pd((double*) _dst, p.v);
+  }
+
+  inline void store_stream(const pack<long long, 4> &p, void* _dst)
+  {
+    _mm256_stream_si256((__m256i*) _dst, p.v);
+  }
+
+  // Compress stores and expand loads (see functions/compress.h) //////////////
+
+  namespace detail {
+
+    // NOTE: 256 bit packs have no compress/expand instructions before
+    //       AVX-512, so they permute with vpermps/vpermd by indices
+    //       looked up by the 8 mask bits of their 32 bit lanes (a
+    //       64 bit lane's mask sets two bits), and load/store only the
+    //       active count of lanes with vmaskmov
+
+    struct compress_permutations
+    {
+      compress_permutations()
+      {
+        for (int bits = 0; bits < 256; ++bits) {
+          int active = 0;
+
+          for (int i = 0; i < 8; ++i) {
+            compress[bits][i] = 0;
+            expand[bits][i]   = std::uint8_t(active);
+
+            if (bits & (1 << i))
+              compress[bits][active++] = std::uint8_t(i);
+          }
+
+          count[bits] = std::uint8_t(active);
+        }
+      }
+
+      std::uint8_t compress[256][8]; // lane i <- active lane i
+      std::uint8_t expand[256][8];   // lane i <- active lanes below it
+      std::uint8_t count[256];
+    };
+
+    inline const compress_permutations &compress_table()
+    {
+      static const compress_permutations table;
+      return table;
+    }
+
+    inline __m256i avx_lane_indices(const std::uint8_t (&indices)[8])
+    {
+      return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*) indices));
+    }
+
+    // Mask of the lowest 'count' 32 bit lanes //
+
+    inline __m256i avx_first_lanes(int count)
+    {
+      return _mm256_cmpgt_epi32(_mm256_set1_epi32(count),
+                                _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    }
+
+    inline int avx_active_bits(const mask<8> &m)
+    {
+      const __m256i inactive = avx_inactive(m.v);
+      return ~_mm256_movemask_ps(_mm256_castsi256_ps(inactive)) & 0xFF;
+    }
+
+    inline int avx_active_bits(const mask_for<double, 4> &m)
+    {
+      const __m256i inactive = avx_inactive64(m.v);
+      return ~_mm256_movemask_ps(_mm256_castsi256_ps(inactive)) & 0xFF;
+    }
+
+    inline int compress(const pack<float, 8> &p, const mask<8> &m, float *dst)
+    {
+      const int bits = avx_active_bits(m);
+      const compress_permutations &table = compress_table();
+
+      const __m256i indices = avx_lane_indices(table.compress[bits]);
+      const __m256 packed = _mm256_permutevar8x32_ps(p.v, indices);
+
+      _mm256_maskstore_ps(dst, avx_first_lanes(table.count[bits]), packed);
+      return table.count[bits];
+    }
+
+    inline int compress(const pack<int, 8> &p, const mask<8> &m, int *dst)
+    {
+      const int bits = avx_active_bits(m);
+      const compress_permutations &table = compress_table();
+
+      const __m256i indices = avx_lane_indices(table.compress[bits]);
+      const __m256i packed = _mm256_permutevar8x32_epi32(p.v, indices);
+
+      _mm256_maskstore_epi32(dst, avx_first_lanes(table.count[bits]), packed);
+      return table.count[bits];
+    }
+
+    inline int compress(const pack<double, 4> &p,
+                        const mask_for<double, 4> &m,
+                        double *dst)
+    {
+      const int bits = avx_active_bits(m);
+      const compress_permutations &table = compress_table();
+
+      const __m256i indices = avx_lane_indices(table.compress[bits]);
+      const __m256 packed =
+          _mm256_permutevar8x32_ps(_mm256_castpd_ps(p.v), indices);
+
+      _mm256_maskstore_pd(dst,
+                          avx_first_lanes(table.count[bits]),
+                          _mm256_castps_pd(packed));
+      return table.count[bits] / 2;
+    }
+
+    inline int compress(const pack<long long, 4> &p,
+                        const mask_for<long long, 4> &m,
+                        long long *dst)
+    {
+      const int bits = avx_active_bits(m);
+      const compress_permutations &table = compress_table();
+
+      const __m256i indices = avx_lane_indices(table.compress[bits]);
+      const __m256i packed = _mm256_permutevar8x32_epi32(p.v, indices);
+
+      _mm256_maskstore_epi64((long long*) dst,
+                             avx_first_lanes(table.count[bits]),
+                             packed);
+      return table.count[bits] / 2;
+    }
+
+    inline pack<float, 8> expand(const mask<8> &m, const float *src)
+    {
+      const int bits = avx_active_bits(m);
+      const compress_permutations &table = compress_table();
+
+      const __m256 packed =
+          _mm256_maskload_ps(src, avx_first_lanes(table.count[bits]));
+      const __m256i indices = avx_lane_indices(table.expand[bits]);
+      const __m256 active = _mm256_castsi256_ps(avx_not(avx_inactive(m.v)));
+
+      return as_pack(
+        _mm256_and_ps(active, _mm256_permutevar8x32_ps(packed, indices))
+      );
+    }
+
+    inline pack<int, 8> expand(const mask<8> &m, const int *src)
+    {
+      const int bits = avx_active_bits(m);
+      const compress_permutations &table = compress_table();
+
+      const __m256i packed =
+          _mm256_maskload_epi32(src, avx_first_lanes(table.count[bits]));
+      const __m256i indices = avx_lane_indices(table.expand[bits]);
+      const __m256i active = avx_not(avx_inactive(m.v));
+
+      return as_pack(
+        _mm256_and_si256(active, _mm256_permutevar8x32_epi32(packed, indices))
+      );
+    }
+
+    inline pack<double, 4> expand(const mask_for<double, 4> &m,
+                                  const double *src)
+    {
+      const int bits = avx_active_bits(m);
+      const compress_permutations &table = compress_table();
+
+      const __m256d packed =
+          _mm256_maskload_pd(src, avx_first_lanes(table.count[bits]));
+      const __m256i indices = avx_lane_indices(table.expand[bits]);
+      const __m256 active = _mm256_castsi256_ps(avx_not(avx_inactive64(m.v)));
+
+      const __m256 expanded =
+          _mm256_permutevar8x32_ps(_mm256_castpd_ps(packed), indices);
+
+      return as_pack(_mm256_castps_pd(_mm256_and_ps(active, expanded)));
+    }
+
+    inline pack<long long, 4> expand(const mask_for<long long, 4> &m,
+                                     const long long *src)
+    {
+      const int bits = avx_active_bits(m);
+      const compress_permutations &table = compress_table();
+
+      const __m256i packed = _mm256_maskload_epi64(
+        (const long long*) src, avx_first_lanes(table.count[bits])
+      );
+      const __m256i indices = avx_lane_indices(table.expand[bits]);
+      const __m256i active = avx_not(avx_inactive64(m.v));
+
+      return as_pack<long long, 4>(
+        _mm256_and_si256(active, _mm256_permutevar8x32_epi32(packed, indices))
+      );
+    }
+
+  } // ::psimd::detail
+
+  // Whole-pack loads (see functions/memory.h) ////////////////////////////////
+
+  namespace detail {
+
+    template <>
+    struct pack_loader<float, 8>
+    {
+      static pack<float, 8> aligned(const float *src)
+      {
+        return as_pack(_mm256_load_ps(src));
+      }
+
+      static pack<float, 8> unaligned(const float *src)
+      {
+        return as_pack(_mm256_loadu_ps(src));
+      }
+    };
+
+    template <>
+    struct pack_loader<int, 8>
+    {
+      static pack<int, 8> aligned(const int *src)
+      {
+        return as_pack(_mm256_load_si256((const __m256i*) src));
+      }
+
+      static pack<int, 8> unaligned(const int *src)
+      {
+        return as_pack(_mm256_loadu_si256((const __m256i*) src));
+      }
+    };
+
+    template <>
+    struct pack_loader<double, 4>
+    {
+      static pack<double, 4> aligned(const double *src)
+      {
+        return as_pack(_mm256_load_pd(src));
+      }
+
+      static pack<double, 4> unaligned(const double *src)
+      {
+        return as_pack(_mm256_loadu_pd(src));
+      }
+    };
+
+    template <>
+    struct pack_loader<long long, 4>
+    {
+      static pack<long long, 4> aligned(const long long *src)
+      {
+        return as_pack<long long, 4>(_mm256_load_si256((const __m256i*) src));
+      }
+
+      static pack<long long, 4> unaligned(const long long *src)
+      {
+        return as_pack<long long, 4>(_mm256_loadu_si256((const __m256i*) src));
+      }
+    };
+
+  } // ::psimd::detail
+
+  // Hardware gathers (see functions/memory.h) ////////////////////////////////
+
+  namespace detail {
+
+    // NOTE: AVX2 gathers read only the sign bit of each mask lane, so
+    //       masks are normalized first; masked gathers start from a
+    //       zero register, which inactive lanes keep. AVX2 has no
+    //       scatter instructions, scatter() stays a lane loop
+
+    template <>
+    struct pack_gatherer<float, 4, int>
+    {
+      template <int SCALE>
+      static pack<float, 4> gather(const void *base, const pack<int, 4> &o)
+      {
+        return as_pack(_mm_i32gather_ps((const float*) base, o.v, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<float, 4> gather(const void *base,
+                                   const pack<int, 4> &o,
+                                   const mask<4> &m)
+      {
+        const __m128i active = sse_not(sse_inactive(m.v));
+        return as_pack(_mm_mask_i32gather_ps(_mm_setzero_ps(),
+                                             (const float*) base,
+                                             o.v,
+                                             _mm_castsi128_ps(active),
+                                             SCALE));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<int, 4, int>
+    {
+      template <int SCALE>
+      static pack<int, 4> gather(const void *base, const pack<int, 4> &o)
+      {
+        return as_pack(_mm_i32gather_epi32((const int*) base, o.v, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<int, 4> gather(const void *base,
+                                 const pack<int, 4> &o,
+                                 const mask<4> &m)
+      {
+        const __m128i active = sse_not(sse_inactive(m.v));
+        return as_pack(_mm_mask_i32gather_epi32(_mm_setzero_si128(),
+                                                (const int*) base,
+                                                o.v,
+                                                active,
+                                                SCALE));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<float, 4, long long>
+    {
+      template <int SCALE>
+      static pack<float, 4> gather(const void *base,
+                                   const pack<long long, 4> &o)
+      {
+        return as_pack(_mm256_i64gather_ps((const float*) base, o.v, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<float, 4> gather(const void *base,
+                                   const pack<long long, 4> &o,
+                                   const mask<4> &m)
+      {
+        const __m128i active = sse_not(sse_inactive(m.v));
+        return as_pack(_mm256_mask_i64gather_ps(_mm_setzero_ps(),
+                                                (const float*) base,
+                                                o.v,
+                                                _mm_castsi128_ps(active),
+                                                SCALE));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<int, 4, long long>
+    {
+      template <int SCALE>
+      static pack<int, 4> gather(const void *base,
+                                 const pack<long long, 4> &o)
+      {
+        return as_pack(_mm256_i64gather_epi32((const int*) base, o.v, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<int, 4> gather(const void *base,
+                                 const pack<long long, 4> &o,
+                                 const mask<4> &m)
+      {
+        const __m128i active = sse_not(sse_inactive(m.v));
+        return as_pack(_mm256_mask_i64gather_epi32(_mm_setzero_si128(),
+                                                   (const int*) base,
+                                                   o.v,
+                                                   active,
+                                                   SCALE));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<double, 2, long long>
+    {
+      template <int SCALE>
+      static pack<double, 2> gather(const void *base,
+                                    const pack<long long, 2> &o)
+      {
+        return as_pack(_mm_i64gather_pd((const double*) base, o.v, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<double, 2> gather(const void *base,
+                                    const pack<long long, 2> &o,
+                                    const mask_for<double, 2> &m)
+      {
+        const __m128i active = sse_not(sse_inactive64(m.v));
+        return as_pack(_mm_mask_i64gather_pd(_mm_setzero_pd(),
+                                             (const double*) base,
+                                             o.v,
+                                             _mm_castsi128_pd(active),
+                                             SCALE));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<long long, 2, long long>
+    {
+      template <int SCALE>
+      static pack<long long, 2> gather(const void *base,
+                                       const pack<long long, 2> &o)
+      {
+        return as_pack<long long, 2>(
+            _mm_i64gather_epi64((const long long*) base, o.v, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<long long, 2> gather(const void *base,
+                                       const pack<long long, 2> &o,
+                                       const mask_for<long long, 2> &m)
+      {
+        const __m128i active = sse_not(sse_inactive64(m.v));
+        return as_pack<long long, 2>(
+            _mm_mask_i64gather_epi64(_mm_setzero_si128(),
+                                     (const long long*) base,
+                                     o.v,
+                                     active,
+                                     SCALE));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<float, 8, int>
+    {
+      template <int SCALE>
+      static pack<float, 8> gather(const void *base, const pack<int, 8> &o)
+      {
+        return as_pack(_mm256_i32gather_ps((const float*) base, o.v, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<float, 8> gather(const void *base,
+                                   const pack<int, 8> &o,
+                                   const mask<8> &m)
+      {
+        const __m256i active = avx_not(avx_inactive(m.v));
+        return as_pack(_mm256_mask_i32gather_ps(_mm256_setzero_ps(),
+                                                (const float*) base,
+                                                o.v,
+                                                _mm256_castsi256_ps(active),
+                                                SCALE));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<int, 8, int>
+    {
+      template <int SCALE>
+      static pack<int, 8> gather(const void *base, const pack<int, 8> &o)
+      {
+        return as_pack(_mm256_i32gather_epi32((const int*) base, o.v, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<int, 8> gather(const void *base,
+                                 const pack<int, 8> &o,
+                                 const mask<8> &m)
+      {
+        const __m256i active = avx_not(avx_inactive(m.v));
+        return as_pack(_mm256_mask_i32gather_epi32(_mm256_setzero_si256(),
+                                                   (const int*) base,
+                                                   o.v,
+                                                   active,
+                                                   SCALE));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<double, 4, int>
+    {
+      template <int SCALE>
+      static pack<double, 4> gather(const void *base, const pack<int, 4> &o)
+      {
+        return as_pack(_mm256_i32gather_pd((const double*) base, o.v, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<double, 4> gather(const void *base,
+                                    const pack<int, 4> &o,
+                                    const mask_for<double, 4> &m)
+      {
+        const __m256i active = avx_not(avx_inactive64(m.v));
+        return as_pack(_mm256_mask_i32gather_pd(_mm256_setzero_pd(),
+                                                (const double*) base,
+                                                o.v,
+                                                _mm256_castsi256_pd(active),
+                                                SCALE));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<long long, 4, int>
+    {
+      template <int SCALE>
+      static pack<long long, 4> gather(const void *base,
+                                       const pack<int, 4> &o)
+      {
+        return as_pack<long long, 4>(
+            _mm256_i32gather_epi64((const long long*) base, o.v, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<long long, 4> gather(const void *base,
+                                       const pack<int, 4> &o,
+                                       const mask_for<long long, 4> &m)
+      {
+        const __m256i active = avx_not(avx_inactive64(m.v));
+        return as_pack<long long, 4>(
+            _mm256_mask_i32gather_epi64(_mm256_setzero_si256(),
+                                        (const long long*) base,
+                                        o.v,
+                                        active,
+                                        SCALE));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<double, 4, long long>
+    {
+      template <int SCALE>
+      static pack<double, 4> gather(const void *base,
+                                    const pack<long long, 4> &o)
+      {
+        return as_pack(_mm256_i64gather_pd((const double*) base, o.v, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<double, 4> gather(const void *base,
+                                    const pack<long long, 4> &o,
+                                    const mask_for<double, 4> &m)
+      {
+        const __m256i active = avx_not(avx_inactive64(m.v));
+        return as_pack(_mm256_mask_i64gather_pd(_mm256_setzero_pd(),
+                                                (const double*) base,
+                                                o.v,
+                                                _mm256_castsi256_pd(active),
+                                                SCALE));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<long long, 4, long long>
+    {
+      template <int SCALE>
+      static pack<long long, 4> gather(const void *base,
+                                       const pack<long long, 4> &o)
+      {
+        return as_pack<long long, 4>(
+            _mm256_i64gather_epi64((const long long*) base, o.v, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<long long, 4> gather(const void *base,
+                                       const pack<long long, 4> &o,
+                                       const mask_for<long long, 4> &m)
+      {
+        const __m256i active = avx_not(avx_inactive64(m.v));
+        return as_pack<long long, 4>(
+            _mm256_mask_i64gather_epi64(_mm256_setzero_si256(),
+                                        (const long long*) base,
+                                        o.v,
+                                        active,
+                                        SCALE));
+      }
+    };
+
+#if !PSIMD_NATIVE_AVX512
+    // 8 64 bit offsets span two registers (see native/blocked.h), each
+    // gathering half of the lanes with vgatherqps
+
+    template <>
+    struct pack_gatherer<float, 8, long long>
+    {
+      template <int SCALE>
+      static pack<float, 8> gather(const void *base,
+                                   const pack<long long, 8> &o)
+      {
+        auto *src = (const float*) base;
+
+        const __m128 lo = _mm256_i64gather_ps(src, o.v.block[0].v, SCALE);
+        const __m128 hi = _mm256_i64gather_ps(src, o.v.block[1].v, SCALE);
+
+        return as_pack(_mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1));
+      }
+
+      template <int SCALE>
+      static pack<float, 8> gather(const void *base,
+                                   const pack<long long, 8> &o,
+                                   const mask<8> &m)
+      {
+        auto *src = (const float*) base;
+
+        const __m256 active = _mm256_castsi256_ps(avx_not(avx_inactive(m.v)));
+
+        const __m128 lo = _mm256_mask_i64gather_ps(
+            _mm_setzero_ps(), src, o.v.block[0].v,
+            _mm256_castps256_ps128(active), SCALE);
+        const __m128 hi = _mm256_mask_i64gather_ps(
+            _mm_setzero_ps(), src, o.v.block[1].v,
+            _mm256_extractf128_ps(active, 1), SCALE);
+
+        return as_pack(_mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<int, 8, long long>
+    {
+      template <int SCALE>
+      static pack<int, 8> gather(const void *base,
+                                 const pack<long long, 8> &o)
+      {
+        auto *src = (const int*) base;
+
+        const __m128i lo = _mm256_i64gather_epi32(src, o.v.block[0].v, SCALE);
+        const __m128i hi = _mm256_i64gather_epi32(src, o.v.block[1].v, SCALE);
+
+        return as_pack(
+            _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1));
+      }
+
+      template <int SCALE>
+      static pack<int, 8> gather(const void *base,
+                                 const pack<long long, 8> &o,
+                                 const mask<8> &m)
+      {
+        auto *src = (const int*) base;
+
+        const __m256i active = avx_not(avx_inactive(m.v));
+
+        const __m128i lo = _mm256_mask_i64gather_epi32(
+            _mm_setzero_si128(), src, o.v.block[0].v,
+            _mm256_castsi256_si128(active), SCALE);
+        const __m128i hi = _mm256_mask_i64gather_epi32(
+            _mm_setzero_si128(), src, o.v.block[1].v,
+            _mm256_extracti128_si256(active, 1), SCALE);
+
+        return as_pack(
+            _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1));
+      }
+    };
+#endif
+
+  } // ::psimd::detail
+
+#if !PSIMD_NATIVE_AVX512CD
+
+  // Scatter conflict detection (see functions/scatter_reduce.h) //////////////
+
+  namespace detail {
+
+    // NOTE: without vpconflictd, the offsets are compared against
+    //       themselves shifted up by each distance d with vpermd,
+    //       from the farthest to the nearest so the nearest match wins
+
+    template <>
+    struct conflict_detector<int, 8>
+    {
+      static pack<int, 8> previous(const pack<int, 8> &o, const mask<8> &m)
+      {
+        const __m256i lanes  = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i active = avx_not(avx_inactive(m.v));
+
+        __m256i result = _mm256_set1_epi32(-1);
+
+        for (int d = 7; d > 0; --d) {
+          const __m256i from = _mm256_sub_epi32(lanes, _mm256_set1_epi32(d));
+
+          const __m256i same = _mm256_cmpeq_epi32(
+              o.v, _mm256_permutevar8x32_epi32(o.v, from));
+          const __m256i both = _mm256_and_si256(
+              active, _mm256_permutevar8x32_epi32(active, from));
+          const __m256i in_pack =
+              _mm256_cmpgt_epi32(lanes, _mm256_set1_epi32(d - 1));
+
+          const __m256i match =
+              _mm256_and_si256(_mm256_and_si256(same, both), in_pack);
+
+          result = _mm256_blendv_epi8(result, from, match);
+        }
+
+        return as_pack(result);
+      }
+    };
+
+  } // ::psimd::detail
+
+#endif
+
+PSIMD_NAMESPACE_END // ::psimd
+
+#endif
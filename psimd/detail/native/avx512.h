@@ -0,0 +1,3209 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+#pragma once
+
+#include "avx.h"
+
+#if PSIMD_NATIVE_AVX512
+
+PSIMD_NAMESPACE_BEGIN
+
+  namespace detail {
+
+    inline pack<float, 16> as_pack(const __m512 &v)
+    {
+      pack<float, 16> result;
+      result.v = v;
+      return result;
+    }
+
+    inline pack<int, 16> as_pack(const __m512i &v)
+    {
+      pack<int, 16> result;
+      result.v = v;
+      return result;
+    }
+
+    inline pack<double, 8> as_pack(const __m512d &v)
+    {
+      pack<double, 8> result;
+      result.v = v;
+      return result;
+    }
+
+    inline __mmask16 avx512_active(const __m512i &m)
+    {
+      return _mm512_test_epi32_mask(m, m);
+    }
+
+    inline __m512i avx512_expand(const __mmask16 &k)
+    {
+      return _mm512_maskz_mov_epi32(k, _mm512_set1_epi32(-1));
+    }
+
+    inline __mmask8 avx512_active64(const __m512i &m)
+    {
+      return _mm512_test_epi64_mask(m, m);
+    }
+
+    inline __m512i avx512_expand64(const __mmask8 &k)
+    {
+      return _mm512_maskz_mov_epi64(k, _mm512_set1_epi64(-1));
+    }
+
+    // bit_cast<>() as register casts //
+
+    template <>
+    struct bit_caster<int, float, 16>
+    {
+      static pack<int, 16> convert(const pack<float, 16> &p)
+      {
+        return as_pack(_mm512_castps_si512(p.v));
+      }
+    };
+
+    template <>
+    struct bit_caster<float, int, 16>
+    {
+      static pack<float, 16> convert(const pack<int, 16> &p)
+      {
+        return as_pack(_mm512_castsi512_ps(p.v));
+      }
+    };
+
+    template <>
+    struct bit_caster<long long, double, 8>
+    {
+      static pack<long long, 8> convert(const pack<double, 8> &p)
+      {
+        return as_pack<long long, 8>(_mm512_castpd_si512(p.v));
+      }
+    };
+
+    template <>
+    struct bit_caster<double, long long, 8>
+    {
+      static pack<double, 8> convert(const pack<long long, 8> &p)
+      {
+        return as_pack(_mm512_castsi512_pd(p.v));
+      }
+    };
+
+  } // ::psimd::detail
+
+  // Fused multiply-add ///////////////////////////////////////////////////////
+
+  inline pack<float, 16> fma(const pack<float, 16> &a,
+                             const pack<float, 16> &b,
+                             const pack<float, 16> &c)
+  {
+    return detail::as_pack(_mm512_fmadd_ps(a.v, b.v, c.v));
+  }
+
+  inline pack<float, 16> fms(const pack<float, 16> &a,
+                             const pack<float, 16> &b,
+                             const pack<float, 16> &c)
+  {
+    return detail::as_pack(_mm512_fmsub_ps(a.v, b.v, c.v));
+  }
+
+  inline pack<float, 16> fnma(const pack<float, 16> &a,
+                              const pack<float, 16> &b,
+                              const pack<float, 16> &c)
+  {
+    return detail::as_pack(_mm512_fnmadd_ps(a.v, b.v, c.v));
+  }
+
+  inline pack<float, 16> fnms(const pack<float, 16> &a,
+                              const pack<float, 16> &b,
+                              const pack<float, 16> &c)
+  {
+    return detail::as_pack(_mm512_fnmsub_ps(a.v, b.v, c.v));
+  }
+
+
+  inline pack<double, 8> fma(const pack<double, 8> &a,
+                             const pack<double, 8> &b,
+                             const pack<double, 8> &c)
+  {
+    return detail::as_pack(_mm512_fmadd_pd(a.v, b.v, c.v));
+  }
+
+  inline pack<double, 8> fms(const pack<double, 8> &a,
+                             const pack<double, 8> &b,
+                             const pack<double, 8> &c)
+  {
+    return detail::as_pack(_mm512_fmsub_pd(a.v, b.v, c.v));
+  }
+
+  inline pack<double, 8> fnma(const pack<double, 8> &a,
+                              const pack<double, 8> &b,
+                              const pack<double, 8> &c)
+  {
+    return detail::as_pack(_mm512_fnmadd_pd(a.v, b.v, c.v));
+  }
+
+  inline pack<double, 8> fnms(const pack<double, 8> &a,
+                              const pack<double, 8> &b,
+                              const pack<double, 8> &c)
+  {
+    return detail::as_pack(_mm512_fnmsub_pd(a.v, b.v, c.v));
+  }
+
+  // pack<float, 16> //////////////////////////////////////////////////////////
+
+  // binary operator+() //
+
+  inline pack<float, 16> operator+(const pack<float, 16> &p1,
+                                   const pack<float, 16> &p2)
+  {
+    return detail::as_pack(_mm512_add_ps(p1.v, p2.v));
+  }
+
+  inline pack<float, 16> operator+(const pack<float, 16> &p1, float v)
+  {
+    return p1 + pack<float, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 16> operator+(const pack<float, 16> &p1, const OTHER_T &v)
+  {
+    return p1 + float(v);
+  }
+
+  inline pack<float, 16> operator+(float v, const pack<float, 16> &p1)
+  {
+    return pack<float, 16>(v) + p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 16> operator+(const OTHER_T &v, const pack<float, 16> &p1)
+  {
+    return float(v) + p1;
+  }
+
+  // binary operator-() //
+
+  inline pack<float, 16> operator-(const pack<float, 16> &p1,
+                                   const pack<float, 16> &p2)
+  {
+    return detail::as_pack(_mm512_sub_ps(p1.v, p2.v));
+  }
+
+  inline pack<float, 16> operator-(const pack<float, 16> &p1, float v)
+  {
+    return p1 - pack<float, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 16> operator-(const pack<float, 16> &p1, const OTHER_T &v)
+  {
+    return p1 - float(v);
+  }
+
+  inline pack<float, 16> operator-(float v, const pack<float, 16> &p1)
+  {
+    return pack<float, 16>(v) - p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 16> operator-(const OTHER_T &v, const pack<float, 16> &p1)
+  {
+    return float(v) - p1;
+  }
+
+  // binary operator*() //
+
+  inline pack<float, 16> operator*(const pack<float, 16> &p1,
+                                   const pack<float, 16> &p2)
+  {
+    return detail::as_pack(_mm512_mul_ps(p1.v, p2.v));
+  }
+
+  inline pack<float, 16> operator*(const pack<float, 16> &p1, float v)
+  {
+    return p1 * pack<float, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 16> operator*(const pack<float, 16> &p1, const OTHER_T &v)
+  {
+    return p1 * float(v);
+  }
+
+  inline pack<float, 16> operator*(float v, const pack<float, 16> &p1)
+  {
+    return pack<float, 16>(v) * p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 16> operator*(const OTHER_T &v, const pack<float, 16> &p1)
+  {
+    return float(v) * p1;
+  }
+
+  // binary operator/() //
+
+  inline pack<float, 16> operator/(const pack<float, 16> &p1,
+                                   const pack<float, 16> &p2)
+  {
+    return detail::as_pack(_mm512_div_ps(p1.v, p2.v));
+  }
+
+  inline pack<float, 16> operator/(const pack<float, 16> &p1, float v)
+  {
+    return p1 / pack<float, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 16> operator/(const pack<float, 16> &p1, const OTHER_T &v)
+  {
+    return p1 / float(v);
+  }
+
+  inline pack<float, 16> operator/(float v, const pack<float, 16> &p1)
+  {
+    return pack<float, 16>(v) / p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 16> operator/(const OTHER_T &v, const pack<float, 16> &p1)
+  {
+    return float(v) / p1;
+  }
+
+  // unary operator-() //
+
+  inline pack<float, 16> operator-(const pack<float, 16> &p)
+  {
+    return detail::as_pack(_mm512_castsi512_ps(
+      _mm512_xor_si512(_mm512_castps_si512(p.v), _mm512_set1_epi32(0x80000000))
+    ));
+  }
+
+  // binary operator==() //
+
+  inline mask<16> operator==(const pack<float, 16> &p1,
+                             const pack<float, 16> &p2)
+  {
+    return detail::as_pack(
+      detail::avx512_expand(_mm512_cmp_ps_mask(p1.v, p2.v, _CMP_EQ_OQ))
+    );
+  }
+
+  inline mask<16> operator==(const pack<float, 16> &p1, float v)
+  {
+    return p1 == pack<float, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<16> operator==(const pack<float, 16> &p1, const OTHER_T &v)
+  {
+    return p1 == float(v);
+  }
+
+  inline mask<16> operator==(float v, const pack<float, 16> &p1)
+  {
+    return pack<float, 16>(v) == p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<16> operator==(const OTHER_T &v, const pack<float, 16> &p1)
+  {
+    return float(v) == p1;
+  }
+
+  // binary operator!=() //
+
+  inline mask<16> operator!=(const pack<float, 16> &p1,
+                             const pack<float, 16> &p2)
+  {
+    return detail::as_pack(
+      detail::avx512_expand(_mm512_cmp_ps_mask(p1.v, p2.v, _CMP_NEQ_UQ))
+    );
+  }
+
+  inline mask<16> operator!=(const pack<float, 16> &p1, float v)
+  {
+    return p1 != pack<float, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<16> operator!=(const pack<float, 16> &p1, const OTHER_T &v)
+  {
+    return p1 != float(v);
+  }
+
+  inline mask<16> operator!=(float v, const pack<float, 16> &p1)
+  {
+    return pack<float, 16>(v) != p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<16> operator!=(const OTHER_T &v, const pack<float, 16> &p1)
+  {
+    return float(v) != p1;
+  }
+
+  // binary operator<() //
+
+  inline mask<16> operator<(const pack<float, 16> &p1,
+                            const pack<float, 16> &p2)
+  {
+    return detail::as_pack(
+      detail::avx512_expand(_mm512_cmp_ps_mask(p1.v, p2.v, _CMP_LT_OQ))
+    );
+  }
+
+  inline mask<16> operator<(const pack<float, 16> &p1, float v)
+  {
+    return p1 < pack<float, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<16> operator<(const pack<float, 16> &p1, const OTHER_T &v)
+  {
+    return p1 < float(v);
+  }
+
+  inline mask<16> operator<(float v, const pack<float, 16> &p1)
+  {
+    return pack<float, 16>(v) < p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<16> operator<(const OTHER_T &v, const pack<float, 16> &p1)
+  {
+    return float(v) < p1;
+  }
+
+  // binary operator<=() //
+
+  inline mask<16> operator<=(const pack<float, 16> &p1,
+                             const pack<float, 16> &p2)
+  {
+    return detail::as_pack(
+      detail::avx512_expand(_mm512_cmp_ps_mask(p1.v, p2.v, _CMP_LE_OQ))
+    );
+  }
+
+  inline mask<16> operator<=(const pack<float, 16> &p1, float v)
+  {
+    return p1 <= pack<float, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<16> operator<=(const pack<float, 16> &p1, const OTHER_T &v)
+  {
+    return p1 <= float(v);
+  }
+
+  inline mask<16> operator<=(float v, const pack<float, 16> &p1)
+  {
+    return pack<float, 16>(v) <= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<16> operator<=(const OTHER_T &v, const pack<float, 16> &p1)
+  {
+    return float(v) <= p1;
+  }
+
+  // binary operator>() //
+
+  inline mask<16> operator>(const pack<float, 16> &p1,
+                            const pack<float, 16> &p2)
+  {
+    return detail::as_pack(
+      detail::avx512_expand(_mm512_cmp_ps_mask(p1.v, p2.v, _CMP_GT_OQ))
+    );
+  }
+
+  inline mask<16> operator>(const pack<float, 16> &p1, float v)
+  {
+    return p1 > pack<float, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<16> operator>(const pack<float, 16> &p1, const OTHER_T &v)
+  {
+    return p1 > float(v);
+  }
+
+  inline mask<16> operator>(float v, const pack<float, 16> &p1)
+  {
+    return pack<float, 16>(v) > p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<16> operator>(const OTHER_T &v, const pack<float, 16> &p1)
+  {
+    return float(v) > p1;
+  }
+
+  // binary operator>=() //
+
+  inline mask<16> operator>=(const pack<float, 16> &p1,
+                             const pack<float, 16> &p2)
+  {
+    return detail::as_pack(
+      detail::avx512_expand(_mm512_cmp_ps_mask(p1.v, p2.v, _CMP_GE_OQ))
+    );
+  }
+
+  inline mask<16> operator>=(const pack<float, 16> &p1, float v)
+  {
+    return p1 >= pack<float, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<16> operator>=(const pack<float, 16> &p1, const OTHER_T &v)
+  {
+    return p1 >= float(v);
+  }
+
+  inline mask<16> operator>=(float v, const pack<float, 16> &p1)
+  {
+    return pack<float, 16>(v) >= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<16> operator>=(const OTHER_T &v, const pack<float, 16> &p1)
+  {
+    return float(v) >= p1;
+  }
+
+  // abs() //
+
+  inline pack<float, 16> abs(const pack<float, 16> &p)
+  {
+    return detail::as_pack(_mm512_abs_ps(p.v));
+  }
+
+  // sqrt() //
+
+  inline pack<float, 16> sqrt(const pack<float, 16> &p)
+  {
+    return detail::as_pack(_mm512_sqrt_ps(p.v));
+  }
+
+  // rcp_estimate() and rsqrt_estimate() //
+
+  namespace detail {
+
+    inline pack<float, 16> rcp_estimate(const pack<float, 16> &p)
+    {
+      return as_pack(_mm512_rcp14_ps(p.v));
+    }
+
+    inline pack<float, 16> rsqrt_estimate(const pack<float, 16> &p)
+    {
+      return as_pack(_mm512_rsqrt14_ps(p.v));
+    }
+
+  } // ::psimd::detail
+
+  // max() //
+
+  inline pack<float, 16> max(const pack<float, 16> &a,
+                             const pack<float, 16> &b)
+  {
+    return detail::as_pack(_mm512_max_ps(b.v, a.v));
+  }
+
+  // min() //
+
+  inline pack<float, 16> min(const pack<float, 16> &a,
+                             const pack<float, 16> &b)
+  {
+    return detail::as_pack(_mm512_min_ps(b.v, a.v));
+  }
+
+  // select() //
+
+  inline pack<float, 16> select(const mask<16> &m,
+                                const pack<float, 16> &t,
+                                const pack<float, 16> &f)
+  {
+    return detail::as_pack(
+      _mm512_mask_blend_ps(detail::avx512_active(m.v), f.v, t.v)
+    );
+  }
+
+  // store() //
+
+  inline void store(const pack<float, 16> &p, void* _dst, const mask<16> &m)
+  {
+    _mm512_mask_storeu_ps(_dst, detail::avx512_active(m.v), p.v);
+  }
+
+  // pack<int, 16> ////////////////////////////////////////////////////////////
+
+  // binary operator+() //
+
+  inline pack<int, 16> operator+(const pack<int, 16> &p1,
+                                 const pack<int, 16> &p2)
+  {
+    return detail::as_pack(_mm512_add_epi32(p1.v, p2.v));
+  }
+
+  inline pack<int, 16> operator+(const pack<int, 16> &p1, int v)
+  {
+    return p1 + pack<int, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 16> operator+(const pack<int, 16> &p1, const OTHER_T &v)
+  {
+    return p1 + int(v);
+  }
+
+  inline pack<int, 16> operator+(int v, const pack<int, 16> &p1)
+  {
+    return pack<int, 16>(v) + p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 16> operator+(const OTHER_T &v, const pack<int, 16> &p1)
+  {
+    return int(v) + p1;
+  }
+
+  // binary operator-() //
+
+  inline pack<int, 16> operator-(const pack<int, 16> &p1,
+                                 const pack<int, 16> &p2)
+  {
+    return detail::as_pack(_mm512_sub_epi32(p1.v, p2.v));
+  }
+
+  inline pack<int, 16> operator-(const pack<int, 16> &p1, int v)
+  {
+    return p1 - pack<int, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 16> operator-(const pack<int, 16> &p1, const OTHER_T &v)
+  {
+    return p1 - int(v);
+  }
+
+  inline pack<int, 16> operator-(int v, const pack<int, 16> &p1)
+  {
+    return pack<int, 16>(v) - p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 16> operator-(const OTHER_T &v, const pack<int, 16> &p1)
+  {
+    return int(v) - p1;
+  }
+
+  // binary operator*() //
+
+  inline pack<int, 16> operator*(const pack<int, 16> &p1,
+                                 const pack<int, 16> &p2)
+  {
+    return detail::as_pack(_mm512_mullo_epi32(p1.v, p2.v));
+  }
+
+  inline pack<int, 16> operator*(const pack<int, 16> &p1, int v)
+  {
+    return p1 * pack<int, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 16> operator*(const pack<int, 16> &p1, const OTHER_T &v)
+  {
+    return p1 * int(v);
+  }
+
+  inline pack<int, 16> operator*(int v, const pack<int, 16> &p1)
+  {
+    return pack<int, 16>(v) * p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 16> operator*(const OTHER_T &v, const pack<int, 16> &p1)
+  {
+    return int(v) * p1;
+  }
+
+  // unary operator-() //
+
+  inline pack<int, 16> operator-(const pack<int, 16> &p)
+  {
+    return detail::as_pack(_mm512_sub_epi32(_mm512_setzero_si512(), p.v));
+  }
+
+  // binary operator&() //
+
+  inline pack<int, 16> operator&(const pack<int, 16> &p1,
+                                 const pack<int, 16> &p2)
+  {
+    return detail::as_pack(_mm512_and_si512(p1.v, p2.v));
+  }
+
+  inline pack<int, 16> operator&(const pack<int, 16> &p1, int v)
+  {
+    return p1 & pack<int, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 16> operator&(const pack<int, 16> &p1, const OTHER_T &v)
+  {
+    return p1 & int(v);
+  }
+
+  inline pack<int, 16> operator&(int v, const pack<int, 16> &p1)
+  {
+    return pack<int, 16>(v) & p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 16> operator&(const OTHER_T &v, const pack<int, 16> &p1)
+  {
+    return int(v) & p1;
+  }
+
+  // binary operator|() //
+
+  inline pack<int, 16> operator|(const pack<int, 16> &p1,
+                                 const pack<int, 16> &p2)
+  {
+    return detail::as_pack(_mm512_or_si512(p1.v, p2.v));
+  }
+
+  inline pack<int, 16> operator|(const pack<int, 16> &p1, int v)
+  {
+    return p1 | pack<int, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 16> operator|(const pack<int, 16> &p1, const OTHER_T &v)
+  {
+    return p1 | int(v);
+  }
+
+  inline pack<int, 16> operator|(int v, const pack<int, 16> &p1)
+  {
+    return pack<int, 16>(v) | p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 16> operator|(const OTHER_T &v, const pack<int, 16> &p1)
+  {
+    return int(v) | p1;
+  }
+
+  // unary operator~() //
+
+  // NOTE: vpternlogd with the truth table of ~C, as AVX-512 has no vpnot
+
+  inline pack<int, 16> operator~(const pack<int, 16> &p)
+  {
+    return detail::as_pack(_mm512_ternarylogic_epi32(p.v, p.v, p.v, 0x55));
+  }
+
+  // andnot() //
+
+  inline pack<int, 16> andnot(const pack<int, 16> &p1,
+                              const pack<int, 16> &p2)
+  {
+    return detail::as_pack(_mm512_andnot_si512(p2.v, p1.v));
+  }
+
+  // binary operator^() //
+
+  inline pack<int, 16> operator^(const pack<int, 16> &p1,
+                                 const pack<int, 16> &p2)
+  {
+    return detail::as_pack(_mm512_xor_si512(p1.v, p2.v));
+  }
+
+  inline pack<int, 16> operator^(const pack<int, 16> &p1, int v)
+  {
+    return p1 ^ pack<int, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 16> operator^(const pack<int, 16> &p1, const OTHER_T &v)
+  {
+    return p1 ^ int(v);
+  }
+
+  inline pack<int, 16> operator^(int v, const pack<int, 16> &p1)
+  {
+    return pack<int, 16>(v) ^ p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 16> operator^(const OTHER_T &v, const pack<int, 16> &p1)
+  {
+    return int(v) ^ p1;
+  }
+
+  // binary operator<<() //
+
+  inline pack<int, 16> operator<<(const pack<int, 16> &p1, int v)
+  {
+    return detail::as_pack(_mm512_sll_epi32(p1.v, _mm_cvtsi32_si128(v)));
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 16> operator<<(const pack<int, 16> &p1, const OTHER_T &v)
+  {
+    return p1 << int(v);
+  }
+
+  inline pack<int, 16> operator<<(const pack<int, 16> &p1,
+                                  const pack<int, 16> &p2)
+  {
+    return detail::as_pack(_mm512_sllv_epi32(p1.v, p2.v));
+  }
+
+  // binary operator>>() //
+
+  inline pack<int, 16> operator>>(const pack<int, 16> &p1, int v)
+  {
+    return detail::as_pack(_mm512_sra_epi32(p1.v, _mm_cvtsi32_si128(v)));
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 16> operator>>(const pack<int, 16> &p1, const OTHER_T &v)
+  {
+    return p1 >> int(v);
+  }
+
+  inline pack<int, 16> operator>>(const pack<int, 16> &p1,
+                                  const pack<int, 16> &p2)
+  {
+    return detail::as_pack(_mm512_srav_epi32(p1.v, p2.v));
+  }
+
+  // binary operator==() //
+
+  inline mask<16> operator==(const pack<int, 16> &p1,
+                             const pack<int, 16> &p2)
+  {
+    return detail::as_pack(
+      detail::avx512_expand(_mm512_cmp_epi32_mask(p1.v, p2.v, _MM_CMPINT_EQ))
+    );
+  }
+
+  inline mask<16> operator==(const pack<int, 16> &p1, int v)
+  {
+    return p1 == pack<int, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<16> operator==(const pack<int, 16> &p1, const OTHER_T &v)
+  {
+    return p1 == int(v);
+  }
+
+  inline mask<16> operator==(int v, const pack<int, 16> &p1)
+  {
+    return pack<int, 16>(v) == p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<16> operator==(const OTHER_T &v, const pack<int, 16> &p1)
+  {
+    return int(v) == p1;
+  }
+
+  // binary operator!=() //
+
+  inline mask<16> operator!=(const pack<int, 16> &p1,
+                             const pack<int, 16> &p2)
+  {
+    return detail::as_pack(
+      detail::avx512_expand(_mm512_cmp_epi32_mask(p1.v, p2.v, _MM_CMPINT_NE))
+    );
+  }
+
+  inline mask<16> operator!=(const pack<int, 16> &p1, int v)
+  {
+    return p1 != pack<int, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<16> operator!=(const pack<int, 16> &p1, const OTHER_T &v)
+  {
+    return p1 != int(v);
+  }
+
+  inline mask<16> operator!=(int v, const pack<int, 16> &p1)
+  {
+    return pack<int, 16>(v) != p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<16> operator!=(const OTHER_T &v, const pack<int, 16> &p1)
+  {
+    return int(v) != p1;
+  }
+
+  // binary operator<() //
+
+  inline mask<16> operator<(const pack<int, 16> &p1,
+                            const pack<int, 16> &p2)
+  {
+    return detail::as_pack(
+      detail::avx512_expand(_mm512_cmp_epi32_mask(p1.v, p2.v, _MM_CMPINT_LT))
+    );
+  }
+
+  inline mask<16> operator<(const pack<int, 16> &p1, int v)
+  {
+    return p1 < pack<int, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<16> operator<(const pack<int, 16> &p1, const OTHER_T &v)
+  {
+    return p1 < int(v);
+  }
+
+  inline mask<16> operator<(int v, const pack<int, 16> &p1)
+  {
+    return pack<int, 16>(v) < p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<16> operator<(const OTHER_T &v, const pack<int, 16> &p1)
+  {
+    return int(v) < p1;
+  }
+
+  // binary operator<=() //
+
+  inline mask<16> operator<=(const pack<int, 16> &p1,
+                             const pack<int, 16> &p2)
+  {
+    return detail::as_pack(
+      detail::avx512_expand(_mm512_cmp_epi32_mask(p1.v, p2.v, _MM_CMPINT_LE))
+    );
+  }
+
+  inline mask<16> operator<=(const pack<int, 16> &p1, int v)
+  {
+    return p1 <= pack<int, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<16> operator<=(const pack<int, 16> &p1, const OTHER_T &v)
+  {
+    return p1 <= int(v);
+  }
+
+  inline mask<16> operator<=(int v, const pack<int, 16> &p1)
+  {
+    return pack<int, 16>(v) <= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<16> operator<=(const OTHER_T &v, const pack<int, 16> &p1)
+  {
+    return int(v) <= p1;
+  }
+
+  // binary operator>() //
+
+  inline mask<16> operator>(const pack<int, 16> &p1,
+                            const pack<int, 16> &p2)
+  {
+    return detail::as_pack(
+      detail::avx512_expand(_mm512_cmp_epi32_mask(p1.v, p2.v, _MM_CMPINT_NLE))
+    );
+  }
+
+  inline mask<16> operator>(const pack<int, 16> &p1, int v)
+  {
+    return p1 > pack<int, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<16> operator>(const pack<int, 16> &p1, const OTHER_T &v)
+  {
+    return p1 > int(v);
+  }
+
+  inline mask<16> operator>(int v, const pack<int, 16> &p1)
+  {
+    return pack<int, 16>(v) > p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<16> operator>(const OTHER_T &v, const pack<int, 16> &p1)
+  {
+    return int(v) > p1;
+  }
+
+  // binary operator>=() //
+
+  inline mask<16> operator>=(const pack<int, 16> &p1,
+                             const pack<int, 16> &p2)
+  {
+    return detail::as_pack(
+      detail::avx512_expand(_mm512_cmp_epi32_mask(p1.v, p2.v, _MM_CMPINT_NLT))
+    );
+  }
+
+  inline mask<16> operator>=(const pack<int, 16> &p1, int v)
+  {
+    return p1 >= pack<int, 16>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<16> operator>=(const pack<int, 16> &p1, const OTHER_T &v)
+  {
+    return p1 >= int(v);
+  }
+
+  inline mask<16> operator>=(int v, const pack<int, 16> &p1)
+  {
+    return pack<int, 16>(v) >= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<16> operator>=(const OTHER_T &v, const pack<int, 16> &p1)
+  {
+    return int(v) >= p1;
+  }
+
+  // abs() //
+
+  inline pack<int, 16> abs(const pack<int, 16> &p)
+  {
+    return detail::as_pack(_mm512_abs_epi32(p.v));
+  }
+
+  // max() //
+
+  inline pack<int, 16> max(const pack<int, 16> &a,
+                           const pack<int, 16> &b)
+  {
+    return detail::as_pack(_mm512_max_epi32(a.v, b.v));
+  }
+
+  // min() //
+
+  inline pack<int, 16> min(const pack<int, 16> &a,
+                           const pack<int, 16> &b)
+  {
+    return detail::as_pack(_mm512_min_epi32(a.v, b.v));
+  }
+
+  // binary operator&&() //
+
+  inline mask<16> operator&&(const mask<16> &m1, const mask<16> &m2)
+  {
+    return detail::as_pack(detail::avx512_expand(
+      detail::avx512_active(m1.v) & detail::avx512_active(m2.v)
+    ));
+  }
+
+  // binary operator||() //
+
+  inline mask<16> operator||(const mask<16> &m1, const mask<16> &m2)
+  {
+    return detail::as_pack(detail::avx512_expand(
+      detail::avx512_active(m1.v) | detail::avx512_active(m2.v)
+    ));
+  }
+
+  // unary operator!() //
+
+  inline mask<16> operator!(const mask<16> &m)
+  {
+    return detail::as_pack(
+      detail::avx512_expand(_mm512_testn_epi32_mask(m.v, m.v))
+    );
+  }
+
+  // any() //
+
+  inline bool any(const mask<16> &m)
+  {
+    return detail::avx512_active(m.v) != 0x0000;
+  }
+
+  // all() //
+
+  inline bool all(const mask<16> &m)
+  {
+    return detail::avx512_active(m.v) == 0xFFFF;
+  }
+
+  // select() //
+
+  inline pack<int, 16> select(const mask<16> &m,
+                              const pack<int, 16> &t,
+                              const pack<int, 16> &f)
+  {
+    return detail::as_pack(
+      _mm512_mask_blend_epi32(detail::avx512_active(m.v), f.v, t.v)
+    );
+  }
+
+  // store() //
+
+  inline void store(const pack<int, 16> &p, void* _dst, const mask<16> &m)
+  {
+    _mm512_mask_storeu_epi32(_dst, detail::avx512_active(m.v), p.v);
+  }
+
+  // pack<double, 8> //////////////////////////////////////////////////////////
+
+  // binary operator+() //
+
+  inline pack<double, 8> operator+(const pack<double, 8> &p1,
+                                   const pack<double, 8> &p2)
+  {
+    return detail::as_pack(_mm512_add_pd(p1.v, p2.v));
+  }
+
+  inline pack<double, 8> operator+(const pack<double, 8> &p1, double v)
+  {
+    return p1 + pack<double, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 8> operator+(const pack<double, 8> &p1, const OTHER_T &v)
+  {
+    return p1 + double(v);
+  }
+
+  inline pack<double, 8> operator+(double v, const pack<double, 8> &p1)
+  {
+    return pack<double, 8>(v) + p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 8> operator+(const OTHER_T &v, const pack<double, 8> &p1)
+  {
+    return double(v) + p1;
+  }
+
+  // binary operator-() //
+
+  inline pack<double, 8> operator-(const pack<double, 8> &p1,
+                                   const pack<double, 8> &p2)
+  {
+    return detail::as_pack(_mm512_sub_pd(p1.v, p2.v));
+  }
+
+  inline pack<double, 8> operator-(const pack<double, 8> &p1, double v)
+  {
+    return p1 - pack<double, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 8> operator-(const pack<double, 8> &p1, const OTHER_T &v)
+  {
+    return p1 - double(v);
+  }
+
+  inline pack<double, 8> operator-(double v, const pack<double, 8> &p1)
+  {
+    return pack<double, 8>(v) - p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 8> operator-(const OTHER_T &v, const pack<double, 8> &p1)
+  {
+    return double(v) - p1;
+  }
+
+  // binary operator*() //
+
+  inline pack<double, 8> operator*(const pack<double, 8> &p1,
+                                   const pack<double, 8> &p2)
+  {
+    return detail::as_pack(_mm512_mul_pd(p1.v, p2.v));
+  }
+
+  inline pack<double, 8> operator*(const pack<double, 8> &p1, double v)
+  {
+    return p1 * pack<double, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 8> operator*(const pack<double, 8> &p1, const OTHER_T &v)
+  {
+    return p1 * double(v);
+  }
+
+  inline pack<double, 8> operator*(double v, const pack<double, 8> &p1)
+  {
+    return pack<double, 8>(v) * p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 8> operator*(const OTHER_T &v, const pack<double, 8> &p1)
+  {
+    return double(v) * p1;
+  }
+
+  // binary operator/() //
+
+  inline pack<double, 8> operator/(const pack<double, 8> &p1,
+                                   const pack<double, 8> &p2)
+  {
+    return detail::as_pack(_mm512_div_pd(p1.v, p2.v));
+  }
+
+  inline pack<double, 8> operator/(const pack<double, 8> &p1, double v)
+  {
+    return p1 / pack<double, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 8> operator/(const pack<double, 8> &p1, const OTHER_T &v)
+  {
+    return p1 / double(v);
+  }
+
+  inline pack<double, 8> operator/(double v, const pack<double, 8> &p1)
+  {
+    return pack<double, 8>(v) / p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 8> operator/(const OTHER_T &v, const pack<double, 8> &p1)
+  {
+    return double(v) / p1;
+  }
+
+  // unary operator-() //
+
+  inline pack<double, 8> operator-(const pack<double, 8> &p)
+  {
+    return detail::as_pack(_mm512_castsi512_pd(
+      _mm512_xor_si512(_mm512_castpd_si512(p.v),
+                       _mm512_set1_epi64(0x8000000000000000ll))
+    ));
+  }
+
+  // abs() //
+
+  inline pack<double, 8> abs(const pack<double, 8> &p)
+  {
+    return detail::as_pack(_mm512_abs_pd(p.v));
+  }
+
+  // sqrt() //
+
+  inline pack<double, 8> sqrt(const pack<double, 8> &p)
+  {
+    return detail::as_pack(_mm512_sqrt_pd(p.v));
+  }
+
+  // rcp_estimate() and rsqrt_estimate() //
+
+  namespace detail {
+
+    inline pack<double, 8> rcp_estimate(const pack<double, 8> &p)
+    {
+      return as_pack(_mm512_rcp14_pd(p.v));
+    }
+
+    inline pack<double, 8> rsqrt_estimate(const pack<double, 8> &p)
+    {
+      return as_pack(_mm512_rsqrt14_pd(p.v));
+    }
+
+  } // ::psimd::detail
+
+  // max() //
+
+  inline pack<double, 8> max(const pack<double, 8> &a,
+                             const pack<double, 8> &b)
+  {
+    return detail::as_pack(_mm512_max_pd(b.v, a.v));
+  }
+
+  // min() //
+
+  inline pack<double, 8> min(const pack<double, 8> &a,
+                             const pack<double, 8> &b)
+  {
+    return detail::as_pack(_mm512_min_pd(b.v, a.v));
+  }
+
+  // mask<16> <--> bitmask<16> conversions ////////////////////////////////////
+
+  inline bitmask<16> to_bitmask(const mask<16> &m)
+  {
+    return bitmask<16>::from_bits(detail::avx512_active(m.v));
+  }
+
+  inline mask<16> to_mask(const bitmask<16> &m)
+  {
+    return detail::as_pack(detail::avx512_expand(m.bits));
+  }
+
+  // mask_for<double, 8> <--> bitmask<8> conversions //////////////////////////
+
+  inline bitmask<8> to_bitmask(const mask_for<double, 8> &m)
+  {
+    return bitmask<8>::from_bits(detail::avx512_active64(m.v));
+  }
+
+  namespace detail {
+
+    template <>
+    struct bitmask_expander<long long, 8>
+    {
+      static pack<long long, 8> expand(const bitmask<8> &m)
+      {
+        return as_pack<long long, 8>(avx512_expand64(m.bits));
+      }
+    };
+
+  } // ::psimd::detail
+
+  // bitmask<16> select() //
+
+  inline pack<float, 16> select(const bitmask<16> &m,
+                                const pack<float, 16> &t,
+                                const pack<float, 16> &f)
+  {
+    return detail::as_pack(_mm512_mask_blend_ps(m.bits, f.v, t.v));
+  }
+
+  inline pack<int, 16> select(const bitmask<16> &m,
+                              const pack<int, 16> &t,
+                              const pack<int, 16> &f)
+  {
+    return detail::as_pack(_mm512_mask_blend_epi32(m.bits, f.v, t.v));
+  }
+
+  // bitmask<16> store() //
+
+  inline void store(const pack<float, 16> &p,
+                    void* _dst,
+                    const bitmask<16> &m)
+  {
+    _mm512_mask_storeu_ps(_dst, m.bits, p.v);
+  }
+
+  inline void store(const pack<int, 16> &p,
+                    void* _dst,
+                    const bitmask<16> &m)
+  {
+    _mm512_mask_storeu_epi32(_dst, m.bits, p.v);
+  }
+
+  // bitmask<8> select() //
+
+  inline pack<double, 8> select(const bitmask<8> &m,
+                                const pack<double, 8> &t,
+                                const pack<double, 8> &f)
+  {
+    return detail::as_pack(_mm512_mask_blend_pd(m.bits, f.v, t.v));
+  }
+
+  inline pack<long long, 8> select(const bitmask<8> &m,
+                                   const pack<long long, 8> &t,
+                                   const pack<long long, 8> &f)
+  {
+    return detail::as_pack<long long, 8>(
+      _mm512_mask_blend_epi64(m.bits, f.v, t.v)
+    );
+  }
+
+  // bitmask<8> store() //
+
+  inline void store(const pack<double, 8> &p,
+                    void* _dst,
+                    const bitmask<8> &m)
+  {
+    _mm512_mask_storeu_pd(_dst, m.bits, p.v);
+  }
+
+  inline void store(const pack<long long, 8> &p,
+                    void* _dst,
+                    const bitmask<8> &m)
+  {
+    _mm512_mask_storeu_epi64(_dst, m.bits, p.v);
+  }
+
+  // mask_for<double, 8> //////////////////////////////////////////////////////
+
+  // binary operator==() //
+
+  inline mask_for<double, 8> operator==(const pack<double, 8> &p1,
+                                        const pack<double, 8> &p2)
+  {
+    return detail::as_pack<long long, 8>(
+      detail::avx512_expand64(_mm512_cmp_pd_mask(p1.v, p2.v, _CMP_EQ_OQ))
+    );
+  }
+
+  inline mask_for<double, 8> operator==(const pack<double, 8> &p1, double v)
+  {
+    return p1 == pack<double, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 8> operator==(const pack<double, 8> &p1,
+                                        const OTHER_T &v)
+  {
+    return p1 == double(v);
+  }
+
+  inline mask_for<double, 8> operator==(double v, const pack<double, 8> &p1)
+  {
+    return pack<double, 8>(v) == p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 8> operator==(const OTHER_T &v,
+                                        const pack<double, 8> &p1)
+  {
+    return double(v) == p1;
+  }
+
+  // binary operator!=() //
+
+  inline mask_for<double, 8> operator!=(const pack<double, 8> &p1,
+                                        const pack<double, 8> &p2)
+  {
+    return detail::as_pack<long long, 8>(
+      detail::avx512_expand64(_mm512_cmp_pd_mask(p1.v, p2.v, _CMP_NEQ_UQ))
+    );
+  }
+
+  inline mask_for<double, 8> operator!=(const pack<double, 8> &p1, double v)
+  {
+    return p1 != pack<double, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 8> operator!=(const pack<double, 8> &p1,
+                                        const OTHER_T &v)
+  {
+    return p1 != double(v);
+  }
+
+  inline mask_for<double, 8> operator!=(double v, const pack<double, 8> &p1)
+  {
+    return pack<double, 8>(v) != p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 8> operator!=(const OTHER_T &v,
+                                        const pack<double, 8> &p1)
+  {
+    return double(v) != p1;
+  }
+
+  // binary operator<() //
+
+  inline mask_for<double, 8> operator<(const pack<double, 8> &p1,
+                                       const pack<double, 8> &p2)
+  {
+    return detail::as_pack<long long, 8>(
+      detail::avx512_expand64(_mm512_cmp_pd_mask(p1.v, p2.v, _CMP_LT_OQ))
+    );
+  }
+
+  inline mask_for<double, 8> operator<(const pack<double, 8> &p1, double v)
+  {
+    return p1 < pack<double, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 8> operator<(const pack<double, 8> &p1,
+                                       const OTHER_T &v)
+  {
+    return p1 < double(v);
+  }
+
+  inline mask_for<double, 8> operator<(double v, const pack<double, 8> &p1)
+  {
+    return pack<double, 8>(v) < p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 8> operator<(const OTHER_T &v,
+                                       const pack<double, 8> &p1)
+  {
+    return double(v) < p1;
+  }
+
+  // binary operator<=() //
+
+  inline mask_for<double, 8> operator<=(const pack<double, 8> &p1,
+                                        const pack<double, 8> &p2)
+  {
+    return detail::as_pack<long long, 8>(
+      detail::avx512_expand64(_mm512_cmp_pd_mask(p1.v, p2.v, _CMP_LE_OQ))
+    );
+  }
+
+  inline mask_for<double, 8> operator<=(const pack<double, 8> &p1, double v)
+  {
+    return p1 <= pack<double, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 8> operator<=(const pack<double, 8> &p1,
+                                        const OTHER_T &v)
+  {
+    return p1 <= double(v);
+  }
+
+  inline mask_for<double, 8> operator<=(double v, const pack<double, 8> &p1)
+  {
+    return pack<double, 8>(v) <= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 8> operator<=(const OTHER_T &v,
+                                        const pack<double, 8> &p1)
+  {
+    return double(v) <= p1;
+  }
+
+  // binary operator>() //
+
+  inline mask_for<double, 8> operator>(const pack<double, 8> &p1,
+                                       const pack<double, 8> &p2)
+  {
+    return detail::as_pack<long long, 8>(
+      detail::avx512_expand64(_mm512_cmp_pd_mask(p1.v, p2.v, _CMP_GT_OQ))
+    );
+  }
+
+  inline mask_for<double, 8> operator>(const pack<double, 8> &p1, double v)
+  {
+    return p1 > pack<double, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 8> operator>(const pack<double, 8> &p1,
+                                       const OTHER_T &v)
+  {
+    return p1 > double(v);
+  }
+
+  inline mask_for<double, 8> operator>(double v, const pack<double, 8> &p1)
+  {
+    return pack<double, 8>(v) > p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 8> operator>(const OTHER_T &v,
+                                       const pack<double, 8> &p1)
+  {
+    return double(v) > p1;
+  }
+
+  // binary operator>=() //
+
+  inline mask_for<double, 8> operator>=(const pack<double, 8> &p1,
+                                        const pack<double, 8> &p2)
+  {
+    return detail::as_pack<long long, 8>(
+      detail::avx512_expand64(_mm512_cmp_pd_mask(p1.v, p2.v, _CMP_GE_OQ))
+    );
+  }
+
+  inline mask_for<double, 8> operator>=(const pack<double, 8> &p1, double v)
+  {
+    return p1 >= pack<double, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 8> operator>=(const pack<double, 8> &p1,
+                                        const OTHER_T &v)
+  {
+    return p1 >= double(v);
+  }
+
+  inline mask_for<double, 8> operator>=(double v, const pack<double, 8> &p1)
+  {
+    return pack<double, 8>(v) >= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 8> operator>=(const OTHER_T &v,
+                                        const pack<double, 8> &p1)
+  {
+    return double(v) >= p1;
+  }
+
+  // binary operator&&() //
+
+  inline mask_for<double, 8> operator&&(const mask_for<double, 8> &m1,
+                                        const mask_for<double, 8> &m2)
+  {
+    return detail::as_pack<long long, 8>(detail::avx512_expand64(
+      detail::avx512_active64(m1.v) & detail::avx512_active64(m2.v)
+    ));
+  }
+
+  // binary operator||() //
+
+  inline mask_for<double, 8> operator||(const mask_for<double, 8> &m1,
+                                        const mask_for<double, 8> &m2)
+  {
+    return detail::as_pack<long long, 8>(detail::avx512_expand64(
+      detail::avx512_active64(m1.v) | detail::avx512_active64(m2.v)
+    ));
+  }
+
+  // unary operator!() //
+
+  inline mask_for<double, 8> operator!(const mask_for<double, 8> &m)
+  {
+    return detail::as_pack<long long, 8>(
+      detail::avx512_expand64(_mm512_testn_epi64_mask(m.v, m.v))
+    );
+  }
+
+  // any() //
+
+  inline bool any(const mask_for<double, 8> &m)
+  {
+    return detail::avx512_active64(m.v) != 0x00;
+  }
+
+  // all() //
+
+  inline bool all(const mask_for<double, 8> &m)
+  {
+    return detail::avx512_active64(m.v) == 0xFF;
+  }
+
+  // select() //
+
+  inline pack<double, 8> select(const mask_for<double, 8> &m,
+                                const pack<double, 8> &t,
+                                const pack<double, 8> &f)
+  {
+    return detail::as_pack(
+      _mm512_mask_blend_pd(detail::avx512_active64(m.v), f.v, t.v)
+    );
+  }
+
+  // pack<long long, 8> ////////////////////////////////////////////////////////
+
+  // binary operator+() //
+
+  inline pack<long long, 8> operator+(const pack<long long, 8> &p1,
+                                      const pack<long long, 8> &p2)
+  {
+    return detail::as_pack<long long, 8>(_mm512_add_epi64(p1.v, p2.v));
+  }
+
+  inline pack<long long, 8> operator+(const pack<long long, 8> &p1, long long v)
+  {
+    return p1 + pack<long long, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 8> operator+(const pack<long long, 8> &p1,
+                                      const OTHER_T &v)
+  {
+    return p1 + static_cast<long long>(v);
+  }
+
+  inline pack<long long, 8> operator+(long long v, const pack<long long, 8> &p1)
+  {
+    return pack<long long, 8>(v) + p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 8> operator+(const OTHER_T &v,
+                                      const pack<long long, 8> &p1)
+  {
+    return static_cast<long long>(v) + p1;
+  }
+
+  // binary operator-() //
+
+  inline pack<long long, 8> operator-(const pack<long long, 8> &p1,
+                                      const pack<long long, 8> &p2)
+  {
+    return detail::as_pack<long long, 8>(_mm512_sub_epi64(p1.v, p2.v));
+  }
+
+  inline pack<long long, 8> operator-(const pack<long long, 8> &p1, long long v)
+  {
+    return p1 - pack<long long, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 8> operator-(const pack<long long, 8> &p1,
+                                      const OTHER_T &v)
+  {
+    return p1 - static_cast<long long>(v);
+  }
+
+  inline pack<long long, 8> operator-(long long v, const pack<long long, 8> &p1)
+  {
+    return pack<long long, 8>(v) - p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 8> operator-(const OTHER_T &v,
+                                      const pack<long long, 8> &p1)
+  {
+    return static_cast<long long>(v) - p1;
+  }
+
+  // binary operator&() //
+
+  inline pack<long long, 8> operator&(const pack<long long, 8> &p1,
+                                      const pack<long long, 8> &p2)
+  {
+    return detail::as_pack<long long, 8>(_mm512_and_si512(p1.v, p2.v));
+  }
+
+  inline pack<long long, 8> operator&(const pack<long long, 8> &p1, long long v)
+  {
+    return p1 & pack<long long, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 8> operator&(const pack<long long, 8> &p1,
+                                      const OTHER_T &v)
+  {
+    return p1 & static_cast<long long>(v);
+  }
+
+  inline pack<long long, 8> operator&(long long v, const pack<long long, 8> &p1)
+  {
+    return pack<long long, 8>(v) & p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 8> operator&(const OTHER_T &v,
+                                      const pack<long long, 8> &p1)
+  {
+    return static_cast<long long>(v) & p1;
+  }
+
+  // binary operator|() //
+
+  inline pack<long long, 8> operator|(const pack<long long, 8> &p1,
+                                      const pack<long long, 8> &p2)
+  {
+    return detail::as_pack<long long, 8>(_mm512_or_si512(p1.v, p2.v));
+  }
+
+  inline pack<long long, 8> operator|(const pack<long long, 8> &p1, long long v)
+  {
+    return p1 | pack<long long, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 8> operator|(const pack<long long, 8> &p1,
+                                      const OTHER_T &v)
+  {
+    return p1 | static_cast<long long>(v);
+  }
+
+  inline pack<long long, 8> operator|(long long v, const pack<long long, 8> &p1)
+  {
+    return pack<long long, 8>(v) | p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 8> operator|(const OTHER_T &v,
+                                      const pack<long long, 8> &p1)
+  {
+    return static_cast<long long>(v) | p1;
+  }
+
+  // binary operator^() //
+
+  inline pack<long long, 8> operator^(const pack<long long, 8> &p1,
+                                      const pack<long long, 8> &p2)
+  {
+    return detail::as_pack<long long, 8>(_mm512_xor_si512(p1.v, p2.v));
+  }
+
+  inline pack<long long, 8> operator^(const pack<long long, 8> &p1, long long v)
+  {
+    return p1 ^ pack<long long, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 8> operator^(const pack<long long, 8> &p1,
+                                      const OTHER_T &v)
+  {
+    return p1 ^ static_cast<long long>(v);
+  }
+
+  inline pack<long long, 8> operator^(long long v, const pack<long long, 8> &p1)
+  {
+    return pack<long long, 8>(v) ^ p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 8> operator^(const OTHER_T &v,
+                                      const pack<long long, 8> &p1)
+  {
+    return static_cast<long long>(v) ^ p1;
+  }
+
+  // andnot() //
+
+  inline pack<long long, 8> andnot(const pack<long long, 8> &p1,
+                                   const pack<long long, 8> &p2)
+  {
+    return detail::as_pack<long long, 8>(_mm512_andnot_si512(p2.v, p1.v));
+  }
+
+  // binary operator<<() //
+
+  inline pack<long long, 8> operator<<(const pack<long long, 8> &p1, int v)
+  {
+    return detail::as_pack<long long, 8>(
+      _mm512_sll_epi64(p1.v, _mm_cvtsi32_si128(v))
+    );
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<long long, 8> operator<<(const pack<long long, 8> &p1,
+                                       const OTHER_T &v)
+  {
+    return p1 << int(v);
+  }
+
+  // binary operator>>() //
+
+  inline pack<long long, 8> operator>>(const pack<long long, 8> &p1, int v)
+  {
+    return detail::as_pack<long long, 8>(
+      _mm512_sra_epi64(p1.v, _mm_cvtsi32_si128(v))
+    );
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<long long, 8> operator>>(const pack<long long, 8> &p1,
+                                       const OTHER_T &v)
+  {
+    return p1 >> int(v);
+  }
+
+  // binary operator==() //
+
+  inline mask_for<long long, 8> operator==(const pack<long long, 8> &p1,
+                                           const pack<long long, 8> &p2)
+  {
+    return detail::as_pack<long long, 8>(
+      detail::avx512_expand64(
+        _mm512_cmp_epi64_mask(p1.v, p2.v, _MM_CMPINT_EQ)
+      )
+    );
+  }
+
+  inline mask_for<long long, 8> operator==(const pack<long long, 8> &p1,
+                                           long long v)
+  {
+    return p1 == pack<long long, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 8> operator==(const pack<long long, 8> &p1,
+                                           const OTHER_T &v)
+  {
+    return p1 == static_cast<long long>(v);
+  }
+
+  inline mask_for<long long, 8> operator==(long long v,
+                                           const pack<long long, 8> &p1)
+  {
+    return pack<long long, 8>(v) == p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 8> operator==(const OTHER_T &v,
+                                           const pack<long long, 8> &p1)
+  {
+    return static_cast<long long>(v) == p1;
+  }
+
+  // binary operator!=() //
+
+  inline mask_for<long long, 8> operator!=(const pack<long long, 8> &p1,
+                                           const pack<long long, 8> &p2)
+  {
+    return detail::as_pack<long long, 8>(
+      detail::avx512_expand64(
+        _mm512_cmp_epi64_mask(p1.v, p2.v, _MM_CMPINT_NE)
+      )
+    );
+  }
+
+  inline mask_for<long long, 8> operator!=(const pack<long long, 8> &p1,
+                                           long long v)
+  {
+    return p1 != pack<long long, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 8> operator!=(const pack<long long, 8> &p1,
+                                           const OTHER_T &v)
+  {
+    return p1 != static_cast<long long>(v);
+  }
+
+  inline mask_for<long long, 8> operator!=(long long v,
+                                           const pack<long long, 8> &p1)
+  {
+    return pack<long long, 8>(v) != p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 8> operator!=(const OTHER_T &v,
+                                           const pack<long long, 8> &p1)
+  {
+    return static_cast<long long>(v) != p1;
+  }
+
+  // binary operator<() //
+
+  inline mask_for<long long, 8> operator<(const pack<long long, 8> &p1,
+                                          const pack<long long, 8> &p2)
+  {
+    return detail::as_pack<long long, 8>(
+      detail::avx512_expand64(
+        _mm512_cmp_epi64_mask(p1.v, p2.v, _MM_CMPINT_LT)
+      )
+    );
+  }
+
+  inline mask_for<long long, 8> operator<(const pack<long long, 8> &p1,
+                                          long long v)
+  {
+    return p1 < pack<long long, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 8> operator<(const pack<long long, 8> &p1,
+                                          const OTHER_T &v)
+  {
+    return p1 < static_cast<long long>(v);
+  }
+
+  inline mask_for<long long, 8> operator<(long long v,
+                                          const pack<long long, 8> &p1)
+  {
+    return pack<long long, 8>(v) < p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 8> operator<(const OTHER_T &v,
+                                          const pack<long long, 8> &p1)
+  {
+    return static_cast<long long>(v) < p1;
+  }
+
+  // binary operator<=() //
+
+  inline mask_for<long long, 8> operator<=(const pack<long long, 8> &p1,
+                                           const pack<long long, 8> &p2)
+  {
+    return detail::as_pack<long long, 8>(
+      detail::avx512_expand64(
+        _mm512_cmp_epi64_mask(p1.v, p2.v, _MM_CMPINT_LE)
+      )
+    );
+  }
+
+  inline mask_for<long long, 8> operator<=(const pack<long long, 8> &p1,
+                                           long long v)
+  {
+    return p1 <= pack<long long, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 8> operator<=(const pack<long long, 8> &p1,
+                                           const OTHER_T &v)
+  {
+    return p1 <= static_cast<long long>(v);
+  }
+
+  inline mask_for<long long, 8> operator<=(long long v,
+                                           const pack<long long, 8> &p1)
+  {
+    return pack<long long, 8>(v) <= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 8> operator<=(const OTHER_T &v,
+                                           const pack<long long, 8> &p1)
+  {
+    return static_cast<long long>(v) <= p1;
+  }
+
+  // binary operator>() //
+
+  inline mask_for<long long, 8> operator>(const pack<long long, 8> &p1,
+                                          const pack<long long, 8> &p2)
+  {
+    return detail::as_pack<long long, 8>(
+      detail::avx512_expand64(
+        _mm512_cmp_epi64_mask(p1.v, p2.v, _MM_CMPINT_NLE)
+      )
+    );
+  }
+
+  inline mask_for<long long, 8> operator>(const pack<long long, 8> &p1,
+                                          long long v)
+  {
+    return p1 > pack<long long, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 8> operator>(const pack<long long, 8> &p1,
+                                          const OTHER_T &v)
+  {
+    return p1 > static_cast<long long>(v);
+  }
+
+  inline mask_for<long long, 8> operator>(long long v,
+                                          const pack<long long, 8> &p1)
+  {
+    return pack<long long, 8>(v) > p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 8> operator>(const OTHER_T &v,
+                                          const pack<long long, 8> &p1)
+  {
+    return static_cast<long long>(v) > p1;
+  }
+
+  // binary operator>=() //
+
+  inline mask_for<long long, 8> operator>=(const pack<long long, 8> &p1,
+                                           const pack<long long, 8> &p2)
+  {
+    return detail::as_pack<long long, 8>(
+      detail::avx512_expand64(
+        _mm512_cmp_epi64_mask(p1.v, p2.v, _MM_CMPINT_NLT)
+      )
+    );
+  }
+
+  inline mask_for<long long, 8> operator>=(const pack<long long, 8> &p1,
+                                           long long v)
+  {
+    return p1 >= pack<long long, 8>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 8> operator>=(const pack<long long, 8> &p1,
+                                           const OTHER_T &v)
+  {
+    return p1 >= static_cast<long long>(v);
+  }
+
+  inline mask_for<long long, 8> operator>=(long long v,
+                                           const pack<long long, 8> &p1)
+  {
+    return pack<long long, 8>(v) >= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline mask_for<long long, 8> operator>=(const OTHER_T &v,
+                                           const pack<long long, 8> &p1)
+  {
+    return static_cast<long long>(v) >= p1;
+  }
+
+  // select() //
+
+  inline pack<long long, 8> select(const mask_for<long long, 8> &m,
+                                   const pack<long long, 8> &t,
+                                   const pack<long long, 8> &f)
+  {
+    return detail::as_pack<long long, 8>(
+      _mm512_mask_blend_epi64(detail::avx512_active64(m.v), f.v, t.v)
+    );
+  }
+
+  // Rounding and conversions to int //////////////////////////////////////////
+
+  // NOTE: the roundscale immediates keep a scale of 0, i.e. round to integers;
+  //       the conversions return INT_MIN (the "integer indefinite") for lanes
+  //       out of the range of int, as the generic versions do
+
+  // floor() //
+
+  inline pack<float, 16> floor(const pack<float, 16> &p)
+  {
+    return detail::as_pack(
+      _mm512_roundscale_ps(p.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // ceil() //
+
+  inline pack<float, 16> ceil(const pack<float, 16> &p)
+  {
+    return detail::as_pack(
+      _mm512_roundscale_ps(p.v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // trunc() //
+
+  inline pack<float, 16> trunc(const pack<float, 16> &p)
+  {
+    return detail::as_pack(
+      _mm512_roundscale_ps(p.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // nearbyint() //
+
+  inline pack<float, 16> nearbyint(const pack<float, 16> &p)
+  {
+    return detail::as_pack(
+      _mm512_roundscale_ps(p.v, _MM_FROUND_CUR_DIRECTION | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // floor() //
+
+  inline pack<double, 8> floor(const pack<double, 8> &p)
+  {
+    return detail::as_pack(
+      _mm512_roundscale_pd(p.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // ceil() //
+
+  inline pack<double, 8> ceil(const pack<double, 8> &p)
+  {
+    return detail::as_pack(
+      _mm512_roundscale_pd(p.v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // trunc() //
+
+  inline pack<double, 8> trunc(const pack<double, 8> &p)
+  {
+    return detail::as_pack(
+      _mm512_roundscale_pd(p.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // nearbyint() //
+
+  inline pack<double, 8> nearbyint(const pack<double, 8> &p)
+  {
+    return detail::as_pack(
+      _mm512_roundscale_pd(p.v, _MM_FROUND_CUR_DIRECTION | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // to_int_round() //
+
+  inline pack<int, 16> to_int_round(const pack<float, 16> &p)
+  {
+    return detail::as_pack(_mm512_cvtps_epi32(p.v));
+  }
+
+  // to_int_trunc() //
+
+  inline pack<int, 16> to_int_trunc(const pack<float, 16> &p)
+  {
+    return detail::as_pack(_mm512_cvttps_epi32(p.v));
+  }
+
+  // to_int_round() //
+
+  inline pack<int, 8> to_int_round(const pack<double, 8> &p)
+  {
+    return detail::as_pack(_mm512_cvtpd_epi32(p.v));
+  }
+
+  // to_int_trunc() //
+
+  inline pack<int, 8> to_int_trunc(const pack<double, 8> &p)
+  {
+    return detail::as_pack(_mm512_cvttpd_epi32(p.v));
+  }
+
+  // mask<8> <--> mask_for<double, 8> conversions //
+
+  namespace detail {
+
+    template <>
+    struct mask_converter<long long, int, 8>
+    {
+      static pack<long long, 8> convert(const pack<int, 8> &m)
+      {
+        const __m256i active = avx_not(avx_inactive(m.v));
+        return as_pack<long long, 8>(_mm512_cvtepi32_epi64(active));
+      }
+    };
+
+    template <>
+    struct mask_converter<int, long long, 8>
+    {
+      static pack<int, 8> convert(const pack<long long, 8> &m)
+      {
+        const __m512i active = avx512_expand64(avx512_active64(m.v));
+        return as_pack(_mm512_cvtepi64_epi32(active));
+      }
+    };
+
+  } // ::psimd::detail
+
+  // Butterfly shuffles of tree reductions (see functions/reduce.h) ///////////
+
+  namespace detail {
+
+    inline pack<float, 16> butterfly(const pack<float, 16> &p,
+                                     std::integral_constant<int, 8>)
+    {
+      return as_pack(_mm512_shuffle_f32x4(p.v, p.v, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+    inline pack<float, 16> butterfly(const pack<float, 16> &p,
+                                     std::integral_constant<int, 4>)
+    {
+      return as_pack(_mm512_shuffle_f32x4(p.v, p.v, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    inline pack<float, 16> butterfly(const pack<float, 16> &p,
+                                     std::integral_constant<int, 2>)
+    {
+      return as_pack(_mm512_permute_ps(p.v, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+    inline pack<float, 16> butterfly(const pack<float, 16> &p,
+                                     std::integral_constant<int, 1>)
+    {
+      return as_pack(_mm512_permute_ps(p.v, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    inline pack<int, 16> butterfly(const pack<int, 16> &p,
+                                   std::integral_constant<int, 8>)
+    {
+      return as_pack(_mm512_shuffle_i32x4(p.v, p.v, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+    inline pack<int, 16> butterfly(const pack<int, 16> &p,
+                                   std::integral_constant<int, 4>)
+    {
+      return as_pack(_mm512_shuffle_i32x4(p.v, p.v, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    inline pack<int, 16> butterfly(const pack<int, 16> &p,
+                                   std::integral_constant<int, 2>)
+    {
+      return as_pack(
+        _mm512_shuffle_epi32(p.v, (_MM_PERM_ENUM) _MM_SHUFFLE(1, 0, 3, 2))
+      );
+    }
+
+    inline pack<int, 16> butterfly(const pack<int, 16> &p,
+                                   std::integral_constant<int, 1>)
+    {
+      return as_pack(
+        _mm512_shuffle_epi32(p.v, (_MM_PERM_ENUM) _MM_SHUFFLE(2, 3, 0, 1))
+      );
+    }
+
+    inline pack<double, 8> butterfly(const pack<double, 8> &p,
+                                     std::integral_constant<int, 4>)
+    {
+      return as_pack(_mm512_shuffle_f64x2(p.v, p.v, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+    inline pack<double, 8> butterfly(const pack<double, 8> &p,
+                                     std::integral_constant<int, 2>)
+    {
+      return as_pack(_mm512_shuffle_f64x2(p.v, p.v, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    inline pack<double, 8> butterfly(const pack<double, 8> &p,
+                                     std::integral_constant<int, 1>)
+    {
+      return as_pack(_mm512_permute_pd(p.v, 0x55));
+    }
+
+    inline pack<long long, 8> butterfly(const pack<long long, 8> &p,
+                                        std::integral_constant<int, 4>)
+    {
+      return as_pack<long long, 8>(
+        _mm512_shuffle_i64x2(p.v, p.v, _MM_SHUFFLE(1, 0, 3, 2))
+      );
+    }
+
+    inline pack<long long, 8> butterfly(const pack<long long, 8> &p,
+                                        std::integral_constant<int, 2>)
+    {
+      return as_pack<long long, 8>(
+        _mm512_shuffle_i64x2(p.v, p.v, _MM_SHUFFLE(2, 3, 0, 1))
+      );
+    }
+
+    inline pack<long long, 8> butterfly(const pack<long long, 8> &p,
+                                        std::integral_constant<int, 1>)
+    {
+      return as_pack<long long, 8>(
+        _mm512_shuffle_epi32(p.v, (_MM_PERM_ENUM) _MM_SHUFFLE(1, 0, 3, 2))
+      );
+    }
+
+  } // ::psimd::detail
+
+  // Lane shifts (see functions/permute.h) ////////////////////////////////////
+
+  // NOTE: lanes shifted in are taken from 'fill', which holds the same value
+  //       in every lane
+
+  namespace detail {
+
+    template <int D>
+    inline pack<float, 16> shift_lanes_up(const pack<float, 16> &p,
+                                          const pack<float, 16> &fill,
+                                          std::integral_constant<int, D>)
+    {
+      const __m512i v = _mm512_castps_si512(p.v);
+      const __m512i f = _mm512_castps_si512(fill.v);
+      const __m512i shifted = _mm512_alignr_epi32(v, f, 16 - D);
+      return as_pack(_mm512_castsi512_ps(shifted));
+    }
+
+    template <int D>
+    inline pack<int, 16> shift_lanes_up(const pack<int, 16> &p,
+                                        const pack<int, 16> &fill,
+                                        std::integral_constant<int, D>)
+    {
+      const __m512i shifted = _mm512_alignr_epi32(p.v, fill.v, 16 - D);
+      return as_pack(shifted);
+    }
+
+    template <int D>
+    inline pack<double, 8> shift_lanes_up(const pack<double, 8> &p,
+                                          const pack<double, 8> &fill,
+                                          std::integral_constant<int, D>)
+    {
+      const __m512i v = _mm512_castpd_si512(p.v);
+      const __m512i f = _mm512_castpd_si512(fill.v);
+      const __m512i shifted = _mm512_alignr_epi64(v, f, 8 - D);
+      return as_pack(_mm512_castsi512_pd(shifted));
+    }
+
+    template <int D>
+    inline pack<long long, 8> shift_lanes_up(const pack<long long, 8> &p,
+                                             const pack<long long, 8> &fill,
+                                             std::integral_constant<int, D>)
+    {
+      const __m512i shifted = _mm512_alignr_epi64(p.v, fill.v, 8 - D);
+      return as_pack<long long, 8>(shifted);
+    }
+
+    template <int D>
+    inline pack<float, 16> shift_lanes_down(const pack<float, 16> &p,
+                                            const pack<float, 16> &fill,
+                                            std::integral_constant<int, D>)
+    {
+      const __m512i v = _mm512_castps_si512(p.v);
+      const __m512i f = _mm512_castps_si512(fill.v);
+      const __m512i shifted = _mm512_alignr_epi32(f, v, D);
+      return as_pack(_mm512_castsi512_ps(shifted));
+    }
+
+    template <int D>
+    inline pack<int, 16> shift_lanes_down(const pack<int, 16> &p,
+                                          const pack<int, 16> &fill,
+                                          std::integral_constant<int, D>)
+    {
+      const __m512i shifted = _mm512_alignr_epi32(fill.v, p.v, D);
+      return as_pack(shifted);
+    }
+
+    template <int D>
+    inline pack<double, 8> shift_lanes_down(const pack<double, 8> &p,
+                                            const pack<double, 8> &fill,
+                                            std::integral_constant<int, D>)
+    {
+      const __m512i v = _mm512_castpd_si512(p.v);
+      const __m512i f = _mm512_castpd_si512(fill.v);
+      const __m512i shifted = _mm512_alignr_epi64(f, v, D);
+      return as_pack(_mm512_castsi512_pd(shifted));
+    }
+
+    template <int D>
+    inline pack<long long, 8> shift_lanes_down(const pack<long long, 8> &p,
+                                               const pack<long long, 8> &fill,
+                                               std::integral_constant<int, D>)
+    {
+      const __m512i shifted = _mm512_alignr_epi64(fill.v, p.v, D);
+      return as_pack<long long, 8>(shifted);
+    }
+
+  } // ::psimd::detail
+
+  // Lane permutations (see functions/permute.h) //////////////////////////////
+
+  inline pack<float, 16> permute(const pack<float, 16> &p,
+                                 const pack<int, 16> &indices)
+  {
+    return detail::as_pack(_mm512_permutexvar_ps(indices.v, p.v));
+  }
+
+  inline pack<int, 16> permute(const pack<int, 16> &p,
+                               const pack<int, 16> &indices)
+  {
+    return detail::as_pack(_mm512_permutexvar_epi32(indices.v, p.v));
+  }
+
+  inline pack<double, 8> permute(const pack<double, 8> &p,
+                                 const pack<int, 8> &indices)
+  {
+    const __m512i indices64 = _mm512_cvtepi32_epi64(indices.v);
+    return detail::as_pack(_mm512_permutexvar_pd(indices64, p.v));
+  }
+
+  inline pack<long long, 8> permute(const pack<long long, 8> &p,
+                                    const pack<int, 8> &indices)
+  {
+    const __m512i indices64 = _mm512_cvtepi32_epi64(indices.v);
+    return detail::as_pack<long long, 8>(
+      _mm512_permutexvar_epi64(indices64, p.v)
+    );
+  }
+
+  inline pack<float, 16> interleave_lo(const pack<float, 16> &a,
+                                       const pack<float, 16> &b)
+  {
+    const __m512i indices = _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19,
+                                       4, 20, 5, 21, 6, 22, 7, 23);
+    return detail::as_pack(_mm512_permutex2var_ps(a.v, indices, b.v));
+  }
+
+  inline pack<float, 16> interleave_hi(const pack<float, 16> &a,
+                                       const pack<float, 16> &b)
+  {
+    const __m512i indices = _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27,
+                                       12, 28, 13, 29, 14, 30, 15, 31);
+    return detail::as_pack(_mm512_permutex2var_ps(a.v, indices, b.v));
+  }
+
+  inline pack<int, 16> interleave_lo(const pack<int, 16> &a,
+                                     const pack<int, 16> &b)
+  {
+    const __m512i indices = _mm512_setr_epi32(0, 16, 1, 17, 2, 18, 3, 19,
+                                       4, 20, 5, 21, 6, 22, 7, 23);
+    return detail::as_pack(_mm512_permutex2var_epi32(a.v, indices, b.v));
+  }
+
+  inline pack<int, 16> interleave_hi(const pack<int, 16> &a,
+                                     const pack<int, 16> &b)
+  {
+    const __m512i indices = _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27,
+                                       12, 28, 13, 29, 14, 30, 15, 31);
+    return detail::as_pack(_mm512_permutex2var_epi32(a.v, indices, b.v));
+  }
+
+  inline pack<double, 8> interleave_lo(const pack<double, 8> &a,
+                                       const pack<double, 8> &b)
+  {
+    const __m512i indices = _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11);
+    return detail::as_pack(_mm512_permutex2var_pd(a.v, indices, b.v));
+  }
+
+  inline pack<double, 8> interleave_hi(const pack<double, 8> &a,
+                                       const pack<double, 8> &b)
+  {
+    const __m512i indices = _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15);
+    return detail::as_pack(_mm512_permutex2var_pd(a.v, indices, b.v));
+  }
+
+  inline pack<long long, 8> interleave_lo(const pack<long long, 8> &a,
+                                          const pack<long long, 8> &b)
+  {
+    const __m512i indices = _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11);
+    return detail::as_pack<long long, 8>(
+      _mm512_permutex2var_epi64(a.v, indices, b.v)
+    );
+  }
+
+  inline pack<long long, 8> interleave_hi(const pack<long long, 8> &a,
+                                          const pack<long long, 8> &b)
+  {
+    const __m512i indices = _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15);
+    return detail::as_pack<long long, 8>(
+      _mm512_permutex2var_epi64(a.v, indices, b.v)
+    );
+  }
+
+  // Streaming stores (see functions/memory.h) ////////////////////////////////
+
+  inline void store_stream(const pack<float, 16> &p, void* _dst)
+  {
+    _mm512_stream_ps((float*) _dst, p.v);
+  }
+
+  inline void store_stream(const pack<int, 16> &p, void* _dst)
+  {
+    _mm512_stream_si512((__m512i*) _dst, p.v);
+  }
+
+  inline void store_stream(const pack<double, 8> &p, void* _dst)
+  {
+    _mm512_stream_pd((double*) _dst, p.v);
+  }
+
+  inline void store_stream(const pack<long long, 8> &p, void* _dst)
+  {
+    _mm512_stream_si512((__m512i*) _dst, p.v);
+  }
+
+  // Compress stores and expand loads (see functions/compress.h) /////////////
+
+  namespace detail {
+
+    // NOTE: vcompressps/vexpandps with a memory operand are microcoded
+    //       and much slower than compressing in a register and storing
+    //       (or loading and expanding) only the first 'count' lanes
+
+    inline int avx512_count(unsigned int k)
+    {
+#if defined(_MSC_VER)
+      return int(__popcnt(k));
+#else
+      return __builtin_popcount(k);
+#endif
+    }
+
+    inline __mmask16 avx512_first_lanes(int count)
+    {
+      return __mmask16((1u << count) - 1);
+    }
+
+    inline int compress(const pack<float, 16> &p,
+                        const mask<16> &m,
+                        float *dst)
+    {
+      const __mmask16 k = avx512_active(m.v);
+      const int count = avx512_count(k);
+      _mm512_mask_storeu_ps(dst, avx512_first_lanes(count),
+                            _mm512_maskz_compress_ps(k, p.v));
+      return count;
+    }
+
+    inline int compress(const pack<int, 16> &p, const mask<16> &m, int *dst)
+    {
+      const __mmask16 k = avx512_active(m.v);
+      const int count = avx512_count(k);
+      _mm512_mask_storeu_epi32(dst, avx512_first_lanes(count),
+                               _mm512_maskz_compress_epi32(k, p.v));
+      return count;
+    }
+
+    inline int compress(const pack<double, 8> &p,
+                        const mask_for<double, 8> &m,
+                        double *dst)
+    {
+      const __mmask8 k = avx512_active64(m.v);
+      const int count = avx512_count(k);
+      _mm512_mask_storeu_pd(dst, __mmask8(avx512_first_lanes(count)),
+                            _mm512_maskz_compress_pd(k, p.v));
+      return count;
+    }
+
+    inline int compress(const pack<long long, 8> &p,
+                        const mask_for<long long, 8> &m,
+                        long long *dst)
+    {
+      const __mmask8 k = avx512_active64(m.v);
+      const int count = avx512_count(k);
+      _mm512_mask_storeu_epi64(dst, __mmask8(avx512_first_lanes(count)),
+                               _mm512_maskz_compress_epi64(k, p.v));
+      return count;
+    }
+
+    inline pack<float, 16> expand(const mask<16> &m, const float *src)
+    {
+      const __mmask16 k = avx512_active(m.v);
+      const __m512 packed =
+          _mm512_maskz_loadu_ps(avx512_first_lanes(avx512_count(k)), src);
+      return as_pack(_mm512_maskz_expand_ps(k, packed));
+    }
+
+    inline pack<int, 16> expand(const mask<16> &m, const int *src)
+    {
+      const __mmask16 k = avx512_active(m.v);
+      const __m512i packed =
+          _mm512_maskz_loadu_epi32(avx512_first_lanes(avx512_count(k)), src);
+      return as_pack(_mm512_maskz_expand_epi32(k, packed));
+    }
+
+    inline pack<double, 8> expand(const mask_for<double, 8> &m,
+                                  const double *src)
+    {
+      const __mmask8 k = avx512_active64(m.v);
+      const __mmask8 first = __mmask8(avx512_first_lanes(avx512_count(k)));
+      const __m512d packed = _mm512_maskz_loadu_pd(first, src);
+      return as_pack(_mm512_maskz_expand_pd(k, packed));
+    }
+
+    inline pack<long long, 8> expand(const mask_for<long long, 8> &m,
+                                     const long long *src)
+    {
+      const __mmask8 k = avx512_active64(m.v);
+      const __mmask8 first = __mmask8(avx512_first_lanes(avx512_count(k)));
+      const __m512i packed = _mm512_maskz_loadu_epi64(first, src);
+      return as_pack<long long, 8>(_mm512_maskz_expand_epi64(k, packed));
+    }
+
+  } // ::psimd::detail
+
+  // Whole-pack loads (see functions/memory.h) ////////////////////////////////
+
+  namespace detail {
+
+    template <>
+    struct pack_loader<float, 16>
+    {
+      static pack<float, 16> aligned(const float *src)
+      {
+        return as_pack(_mm512_load_ps(src));
+      }
+
+      static pack<float, 16> unaligned(const float *src)
+      {
+        return as_pack(_mm512_loadu_ps(src));
+      }
+    };
+
+    template <>
+    struct pack_loader<int, 16>
+    {
+      static pack<int, 16> aligned(const int *src)
+      {
+        return as_pack(_mm512_load_si512((const void*) src));
+      }
+
+      static pack<int, 16> unaligned(const int *src)
+      {
+        return as_pack(_mm512_loadu_si512((const void*) src));
+      }
+    };
+
+    template <>
+    struct pack_loader<double, 8>
+    {
+      static pack<double, 8> aligned(const double *src)
+      {
+        return as_pack(_mm512_load_pd(src));
+      }
+
+      static pack<double, 8> unaligned(const double *src)
+      {
+        return as_pack(_mm512_loadu_pd(src));
+      }
+    };
+
+    template <>
+    struct pack_loader<long long, 8>
+    {
+      static pack<long long, 8> aligned(const long long *src)
+      {
+        return as_pack<long long, 8>(_mm512_load_si512((const void*) src));
+      }
+
+      static pack<long long, 8> unaligned(const long long *src)
+      {
+        return as_pack<long long, 8>(_mm512_loadu_si512((const void*) src));
+      }
+    };
+
+  } // ::psimd::detail
+
+  // Hardware gathers and scatters (see functions/memory.h) ///////////////////
+
+  namespace detail {
+
+    // NOTE: 256 bit masks have no mask register compares before
+    //       AVX512VL, so their lanes are tested in a widened register
+    //       whose undefined upper half the 8 bit mask drops
+
+    inline __mmask8 avx512_active(const mask<8> &m)
+    {
+      return __mmask8(avx512_active(_mm512_castsi256_si512(m.v)));
+    }
+
+    template <>
+    struct pack_gatherer<float, 16, int>
+    {
+      template <int SCALE>
+      static pack<float, 16> gather(const void *base, const pack<int, 16> &o)
+      {
+        return as_pack(_mm512_i32gather_ps(o.v, base, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<float, 16> gather(const void *base,
+                                    const pack<int, 16> &o,
+                                    const mask<16> &m)
+      {
+        return as_pack(_mm512_mask_i32gather_ps(
+            _mm512_setzero_ps(), avx512_active(m.v), o.v, base, SCALE));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<int, 16, int>
+    {
+      template <int SCALE>
+      static pack<int, 16> gather(const void *base, const pack<int, 16> &o)
+      {
+        return as_pack(_mm512_i32gather_epi32(o.v, base, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<int, 16> gather(const void *base,
+                                  const pack<int, 16> &o,
+                                  const mask<16> &m)
+      {
+        return as_pack(_mm512_mask_i32gather_epi32(
+            _mm512_setzero_si512(), avx512_active(m.v), o.v, base, SCALE));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<float, 8, long long>
+    {
+      template <int SCALE>
+      static pack<float, 8> gather(const void *base,
+                                   const pack<long long, 8> &o)
+      {
+        return as_pack(_mm512_i64gather_ps(o.v, base, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<float, 8> gather(const void *base,
+                                   const pack<long long, 8> &o,
+                                   const mask<8> &m)
+      {
+        return as_pack(_mm512_mask_i64gather_ps(
+            _mm256_setzero_ps(), avx512_active(m), o.v, base, SCALE));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<int, 8, long long>
+    {
+      template <int SCALE>
+      static pack<int, 8> gather(const void *base,
+                                 const pack<long long, 8> &o)
+      {
+        return as_pack(_mm512_i64gather_epi32(o.v, base, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<int, 8> gather(const void *base,
+                                 const pack<long long, 8> &o,
+                                 const mask<8> &m)
+      {
+        return as_pack(_mm512_mask_i64gather_epi32(
+            _mm256_setzero_si256(), avx512_active(m), o.v, base, SCALE));
+      }
+    };
+
+    // 16 64 bit offsets span two registers (see native/blocked.h), each
+    // gathering half of the lanes with vgatherqps
+
+    template <>
+    struct pack_gatherer<float, 16, long long>
+    {
+      template <int SCALE>
+      static pack<float, 16> gather(const void *base,
+                                    const pack<long long, 16> &o)
+      {
+        const __m256 lo = _mm512_i64gather_ps(o.v.block[0].v, base, SCALE);
+        const __m256 hi = _mm512_i64gather_ps(o.v.block[1].v, base, SCALE);
+
+        const __m512d lo512 = _mm512_castps_pd(_mm512_castps256_ps512(lo));
+        return as_pack(_mm512_castpd_ps(
+            _mm512_insertf64x4(lo512, _mm256_castps_pd(hi), 1)));
+      }
+
+      template <int SCALE>
+      static pack<float, 16> gather(const void *base,
+                                    const pack<long long, 16> &o,
+                                    const mask<16> &m)
+      {
+        const __mmask16 k = avx512_active(m.v);
+
+        const __m256 lo = _mm512_mask_i64gather_ps(
+            _mm256_setzero_ps(), __mmask8(k), o.v.block[0].v, base, SCALE);
+        const __m256 hi = _mm512_mask_i64gather_ps(
+            _mm256_setzero_ps(), __mmask8(k >> 8), o.v.block[1].v, base,
+            SCALE);
+
+        const __m512d lo512 = _mm512_castps_pd(_mm512_castps256_ps512(lo));
+        return as_pack(_mm512_castpd_ps(
+            _mm512_insertf64x4(lo512, _mm256_castps_pd(hi), 1)));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<int, 16, long long>
+    {
+      template <int SCALE>
+      static pack<int, 16> gather(const void *base,
+                                  const pack<long long, 16> &o)
+      {
+        const __m256i lo = _mm512_i64gather_epi32(o.v.block[0].v, base, SCALE);
+        const __m256i hi = _mm512_i64gather_epi32(o.v.block[1].v, base, SCALE);
+
+        return as_pack(_mm512_inserti64x4(_mm512_castsi256_si512(lo), hi, 1));
+      }
+
+      template <int SCALE>
+      static pack<int, 16> gather(const void *base,
+                                  const pack<long long, 16> &o,
+                                  const mask<16> &m)
+      {
+        const __mmask16 k = avx512_active(m.v);
+
+        const __m256i lo = _mm512_mask_i64gather_epi32(
+            _mm256_setzero_si256(), __mmask8(k), o.v.block[0].v, base, SCALE);
+        const __m256i hi = _mm512_mask_i64gather_epi32(
+            _mm256_setzero_si256(), __mmask8(k >> 8), o.v.block[1].v, base,
+            SCALE);
+
+        return as_pack(_mm512_inserti64x4(_mm512_castsi256_si512(lo), hi, 1));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<double, 8, long long>
+    {
+      template <int SCALE>
+      static pack<double, 8> gather(const void *base,
+                                    const pack<long long, 8> &o)
+      {
+        return as_pack(_mm512_i64gather_pd(o.v, base, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<double, 8> gather(const void *base,
+                                    const pack<long long, 8> &o,
+                                    const mask_for<double, 8> &m)
+      {
+        return as_pack(_mm512_mask_i64gather_pd(
+            _mm512_setzero_pd(), avx512_active64(m.v), o.v, base, SCALE));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<long long, 8, long long>
+    {
+      template <int SCALE>
+      static pack<long long, 8> gather(const void *base,
+                                       const pack<long long, 8> &o)
+      {
+        return as_pack<long long, 8>(
+            _mm512_i64gather_epi64(o.v, base, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<long long, 8> gather(const void *base,
+                                       const pack<long long, 8> &o,
+                                       const mask_for<long long, 8> &m)
+      {
+        return as_pack<long long, 8>(_mm512_mask_i64gather_epi64(
+            _mm512_setzero_si512(), avx512_active64(m.v), o.v, base, SCALE));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<double, 8, int>
+    {
+      template <int SCALE>
+      static pack<double, 8> gather(const void *base, const pack<int, 8> &o)
+      {
+        return as_pack(_mm512_i32gather_pd(o.v, base, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<double, 8> gather(const void *base,
+                                    const pack<int, 8> &o,
+                                    const mask_for<double, 8> &m)
+      {
+        return as_pack(_mm512_mask_i32gather_pd(
+            _mm512_setzero_pd(), avx512_active64(m.v), o.v, base, SCALE));
+      }
+    };
+
+    template <>
+    struct pack_gatherer<long long, 8, int>
+    {
+      template <int SCALE>
+      static pack<long long, 8> gather(const void *base,
+                                       const pack<int, 8> &o)
+      {
+        return as_pack<long long, 8>(
+            _mm512_i32gather_epi64(o.v, base, SCALE));
+      }
+
+      template <int SCALE>
+      static pack<long long, 8> gather(const void *base,
+                                       const pack<int, 8> &o,
+                                       const mask_for<long long, 8> &m)
+      {
+        return as_pack<long long, 8>(_mm512_mask_i32gather_epi64(
+            _mm512_setzero_si512(), avx512_active64(m.v), o.v, base, SCALE));
+      }
+    };
+
+    template <>
+    struct pack_scatterer<float, 16, int>
+    {
+      template <int SCALE>
+      static void scatter(const pack<float, 16> &p,
+                          void *base,
+                          const pack<int, 16> &o)
+      {
+        _mm512_i32scatter_ps(base, o.v, p.v, SCALE);
+      }
+
+      template <int SCALE>
+      static void scatter(const pack<float, 16> &p,
+                          void *base,
+                          const pack<int, 16> &o,
+                          const mask<16> &m)
+      {
+        _mm512_mask_i32scatter_ps(base, avx512_active(m.v), o.v, p.v, SCALE);
+      }
+    };
+
+    template <>
+    struct pack_scatterer<int, 16, int>
+    {
+      template <int SCALE>
+      static void scatter(const pack<int, 16> &p,
+                          void *base,
+                          const pack<int, 16> &o)
+      {
+        _mm512_i32scatter_epi32(base, o.v, p.v, SCALE);
+      }
+
+      template <int SCALE>
+      static void scatter(const pack<int, 16> &p,
+                          void *base,
+                          const pack<int, 16> &o,
+                          const mask<16> &m)
+      {
+        _mm512_mask_i32scatter_epi32(base, avx512_active(m.v), o.v, p.v,
+                                     SCALE);
+      }
+    };
+
+    template <>
+    struct pack_scatterer<float, 8, long long>
+    {
+      template <int SCALE>
+      static void scatter(const pack<float, 8> &p,
+                          void *base,
+                          const pack<long long, 8> &o)
+      {
+        _mm512_i64scatter_ps(base, o.v, p.v, SCALE);
+      }
+
+      template <int SCALE>
+      static void scatter(const pack<float, 8> &p,
+                          void *base,
+                          const pack<long long, 8> &o,
+                          const mask<8> &m)
+      {
+        _mm512_mask_i64scatter_ps(base, avx512_active(m), o.v, p.v, SCALE);
+      }
+    };
+
+    template <>
+    struct pack_scatterer<int, 8, long long>
+    {
+      template <int SCALE>
+      static void scatter(const pack<int, 8> &p,
+                          void *base,
+                          const pack<long long, 8> &o)
+      {
+        _mm512_i64scatter_epi32(base, o.v, p.v, SCALE);
+      }
+
+      template <int SCALE>
+      static void scatter(const pack<int, 8> &p,
+                          void *base,
+                          const pack<long long, 8> &o,
+                          const mask<8> &m)
+      {
+        _mm512_mask_i64scatter_epi32(base, avx512_active(m), o.v, p.v, SCALE);
+      }
+    };
+
+    // the lower half of the lanes is scattered first, as a single scatter
+    // orders its lanes
+
+    template <>
+    struct pack_scatterer<float, 16, long long>
+    {
+      template <int SCALE>
+      static void scatter(const pack<float, 16> &p,
+                          void *base,
+                          const pack<long long, 16> &o)
+      {
+        const __m256 lo = _mm512_castps512_ps256(p.v);
+        const __m256 hi = _mm256_castpd_ps(
+            _mm512_extractf64x4_pd(_mm512_castps_pd(p.v), 1));
+
+        _mm512_i64scatter_ps(base, o.v.block[0].v, lo, SCALE);
+        _mm512_i64scatter_ps(base, o.v.block[1].v, hi, SCALE);
+      }
+
+      template <int SCALE>
+      static void scatter(const pack<float, 16> &p,
+                          void *base,
+                          const pack<long long, 16> &o,
+                          const mask<16> &m)
+      {
+        const __mmask16 k = avx512_active(m.v);
+
+        const __m256 lo = _mm512_castps512_ps256(p.v);
+        const __m256 hi = _mm256_castpd_ps(
+            _mm512_extractf64x4_pd(_mm512_castps_pd(p.v), 1));
+
+        _mm512_mask_i64scatter_ps(base, __mmask8(k), o.v.block[0].v, lo,
+                                  SCALE);
+        _mm512_mask_i64scatter_ps(base, __mmask8(k >> 8), o.v.block[1].v, hi,
+                                  SCALE);
+      }
+    };
+
+    template <>
+    struct pack_scatterer<int, 16, long long>
+    {
+      template <int SCALE>
+      static void scatter(const pack<int, 16> &p,
+                          void *base,
+                          const pack<long long, 16> &o)
+      {
+        const __m256i lo = _mm512_castsi512_si256(p.v);
+        const __m256i hi = _mm512_extracti64x4_epi64(p.v, 1);
+
+        _mm512_i64scatter_epi32(base, o.v.block[0].v, lo, SCALE);
+        _mm512_i64scatter_epi32(base, o.v.block[1].v, hi, SCALE);
+      }
+
+      template <int SCALE>
+      static void scatter(const pack<int, 16> &p,
+                          void *base,
+                          const pack<long long, 16> &o,
+                          const mask<16> &m)
+      {
+        const __mmask16 k = avx512_active(m.v);
+
+        const __m256i lo = _mm512_castsi512_si256(p.v);
+        const __m256i hi = _mm512_extracti64x4_epi64(p.v, 1);
+
+        _mm512_mask_i64scatter_epi32(base, __mmask8(k), o.v.block[0].v, lo,
+                                     SCALE);
+        _mm512_mask_i64scatter_epi32(base, __mmask8(k >> 8), o.v.block[1].v,
+                                     hi, SCALE);
+      }
+    };
+
+    template <>
+    struct pack_scatterer<double, 8, long long>
+    {
+      template <int SCALE>
+      static void scatter(const pack<double, 8> &p,
+                          void *base,
+                          const pack<long long, 8> &o)
+      {
+        _mm512_i64scatter_pd(base, o.v, p.v, SCALE);
+      }
+
+      template <int SCALE>
+      static void scatter(const pack<double, 8> &p,
+                          void *base,
+                          const pack<long long, 8> &o,
+                          const mask_for<double, 8> &m)
+      {
+        _mm512_mask_i64scatter_pd(base, avx512_active64(m.v), o.v, p.v,
+                                  SCALE);
+      }
+    };
+
+    template <>
+    struct pack_scatterer<long long, 8, long long>
+    {
+      template <int SCALE>
+      static void scatter(const pack<long long, 8> &p,
+                          void *base,
+                          const pack<long long, 8> &o)
+      {
+        _mm512_i64scatter_epi64(base, o.v, p.v, SCALE);
+      }
+
+      template <int SCALE>
+      static void scatter(const pack<long long, 8> &p,
+                          void *base,
+                          const pack<long long, 8> &o,
+                          const mask_for<long long, 8> &m)
+      {
+        _mm512_mask_i64scatter_epi64(base, avx512_active64(m.v), o.v, p.v,
+                                     SCALE);
+      }
+    };
+
+    template <>
+    struct pack_scatterer<double, 8, int>
+    {
+      template <int SCALE>
+      static void scatter(const pack<double, 8> &p,
+                          void *base,
+                          const pack<int, 8> &o)
+      {
+        _mm512_i32scatter_pd(base, o.v, p.v, SCALE);
+      }
+
+      template <int SCALE>
+      static void scatter(const pack<double, 8> &p,
+                          void *base,
+                          const pack<int, 8> &o,
+                          const mask_for<double, 8> &m)
+      {
+        _mm512_mask_i32scatter_pd(base, avx512_active64(m.v), o.v, p.v,
+                                  SCALE);
+      }
+    };
+
+    template <>
+    struct pack_scatterer<long long, 8, int>
+    {
+      template <int SCALE>
+      static void scatter(const pack<long long, 8> &p,
+                          void *base,
+                          const pack<int, 8> &o)
+      {
+        _mm512_i32scatter_epi64(base, o.v, p.v, SCALE);
+      }
+
+      template <int SCALE>
+      static void scatter(const pack<long long, 8> &p,
+                          void *base,
+                          const pack<int, 8> &o,
+                          const mask_for<long long, 8> &m)
+      {
+        _mm512_mask_i32scatter_epi64(base, avx512_active64(m.v), o.v, p.v,
+                                     SCALE);
+      }
+    };
+
+  } // ::psimd::detail
+
+#if PSIMD_NATIVE_AVX512CD
+
+  // Scatter conflict detection (see functions/scatter_reduce.h) //////////////
+
+  namespace detail {
+
+    // NOTE: vpconflictd sets, in each lane, the bits of the earlier
+    //       lanes holding the same offset; those of inactive lanes are
+    //       cleared, and the highest remaining bit is the nearest
+    //       match: 31 - lzcnt, which is -1 where no bit is set
+
+    template <>
+    struct conflict_detector<int, 16>
+    {
+      static pack<int, 16> previous(const pack<int, 16> &o, const mask<16> &m)
+      {
+        const __mmask16 k = avx512_active(m.v);
+
+        const __m512i conflicts = _mm512_and_si512(
+            _mm512_maskz_conflict_epi32(k, o.v), _mm512_set1_epi32(k));
+
+        return as_pack(_mm512_sub_epi32(_mm512_set1_epi32(31),
+                                        _mm512_lzcnt_epi32(conflicts)));
+      }
+    };
+
+    template <>
+    struct conflict_detector<int, 8>
+    {
+      static pack<int, 8> previous(const pack<int, 8> &o, const mask<8> &m)
+      {
+        const __mmask16 k = avx512_active(m);
+
+        const __m512i conflicts = _mm512_and_si512(
+            _mm512_maskz_conflict_epi32(k, _mm512_castsi256_si512(o.v)),
+            _mm512_set1_epi32(k));
+
+        const __m512i previous = _mm512_sub_epi32(
+            _mm512_set1_epi32(31), _mm512_lzcnt_epi32(conflicts));
+
+        return as_pack(_mm512_castsi512_si256(previous));
+      }
+    };
+
+    template <>
+    struct conflict_detector<long long, 8>
+    {
+      static pack<int, 8> previous(const pack<long long, 8> &o,
+                                   const mask_for<long long, 8> &m)
+      {
+        const __mmask8 k = avx512_active64(m.v);
+
+        const __m512i conflicts = _mm512_and_si512(
+            _mm512_maskz_conflict_epi64(k, o.v), _mm512_set1_epi64(k));
+
+        const __m512i previous = _mm512_sub_epi64(
+            _mm512_set1_epi64(63), _mm512_lzcnt_epi64(conflicts));
+
+        return as_pack(_mm512_cvtepi64_epi32(previous));
+      }
+    };
+
+  } // ::psimd::detail
+
+#endif
+
+PSIMD_NAMESPACE_END // ::psimd
+
+#endif
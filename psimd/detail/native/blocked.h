@@ -0,0 +1,1171 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+
+#pragma once
+
+#include "../bitmask.h"
+#include "../functions/memory.h"
+#include "../pack.h"
+
+// Register-blocked packs: a pack<T, W> whose W is a multiple of the native
+// width is stored as an array of native-width sub-packs (see
+// detail::blocking<>), and every operation is applied sub-pack by sub-pack
+// using the native backends. Independent sub-packs give latency-bound code
+// instruction level parallelism which a lane-by-lane loop does not expose.
+
+PSIMD_NAMESPACE_BEGIN
+
+  // Arithmetic operators ///////////////////////////////////////////////////
+
+  // binary operator+() //
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> operator+(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] + p2.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator+(const pack<T, W> &p1, const OTHER_T &v)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] + T(v));
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator+(const OTHER_T &v, const pack<T, W> &p1)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (T(v) + p1.v.block[i]);
+
+    return result;
+  }
+
+  // binary operator-() //
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> operator-(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] - p2.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator-(const pack<T, W> &p1, const OTHER_T &v)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] - T(v));
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator-(const OTHER_T &v, const pack<T, W> &p1)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (T(v) - p1.v.block[i]);
+
+    return result;
+  }
+
+  // binary operator*() //
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> operator*(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] * p2.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator*(const pack<T, W> &p1, const OTHER_T &v)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] * T(v));
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator*(const OTHER_T &v, const pack<T, W> &p1)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (T(v) * p1.v.block[i]);
+
+    return result;
+  }
+
+  // binary operator/() //
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> operator/(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] / p2.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator/(const pack<T, W> &p1, const OTHER_T &v)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] / T(v));
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator/(const OTHER_T &v, const pack<T, W> &p1)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (T(v) / p1.v.block[i]);
+
+    return result;
+  }
+
+  // binary operator%() //
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> operator%(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] % p2.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator%(const pack<T, W> &p1, const OTHER_T &v)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] % T(v));
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator%(const OTHER_T &v, const pack<T, W> &p1)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (T(v) % p1.v.block[i]);
+
+    return result;
+  }
+
+  // unary operator-() //
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> operator-(const pack<T, W> &p)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = -p.v.block[i];
+
+    return result;
+  }
+
+  // Bitwise operators //////////////////////////////////////////////////////
+
+  // binary operator<<() //
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> operator<<(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] << p2.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator<<(const pack<T, W> &p1, const OTHER_T &v)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] << T(v));
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator<<(const OTHER_T &v, const pack<T, W> &p1)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (T(v) << p1.v.block[i]);
+
+    return result;
+  }
+
+  // binary operator>>() //
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> operator>>(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] >> p2.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator>>(const pack<T, W> &p1, const OTHER_T &v)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] >> T(v));
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator>>(const OTHER_T &v, const pack<T, W> &p1)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (T(v) >> p1.v.block[i]);
+
+    return result;
+  }
+
+  // binary operator&() //
+
+  template <typename T, int W,
+            detail::blockwise<T, W> = 0, detail::integral<T> = 0>
+  inline pack<T, W> operator&(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] & p2.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0, detail::integral<T> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator&(const pack<T, W> &p1, const OTHER_T &v)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] & T(v));
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0, detail::integral<T> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator&(const OTHER_T &v, const pack<T, W> &p1)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (T(v) & p1.v.block[i]);
+
+    return result;
+  }
+
+  // binary operator|() //
+
+  template <typename T, int W,
+            detail::blockwise<T, W> = 0, detail::integral<T> = 0>
+  inline pack<T, W> operator|(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] | p2.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0, detail::integral<T> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator|(const pack<T, W> &p1, const OTHER_T &v)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] | T(v));
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0, detail::integral<T> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator|(const OTHER_T &v, const pack<T, W> &p1)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (T(v) | p1.v.block[i]);
+
+    return result;
+  }
+
+  // binary operator^() //
+
+  template <typename T, int W,
+            detail::blockwise<T, W> = 0, detail::integral<T> = 0>
+  inline pack<T, W> operator^(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] ^ p2.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0, detail::integral<T> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator^(const pack<T, W> &p1, const OTHER_T &v)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] ^ T(v));
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0, detail::integral<T> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator^(const OTHER_T &v, const pack<T, W> &p1)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (T(v) ^ p1.v.block[i]);
+
+    return result;
+  }
+
+  // unary operator~() //
+
+  template <typename T, int W,
+            detail::blockwise<T, W> = 0, detail::integral<T> = 0>
+  inline pack<T, W> operator~(const pack<T, W> &p)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = ~p.v.block[i];
+
+    return result;
+  }
+
+  // andnot() //
+
+  template <typename T, int W,
+            detail::blockwise<T, W> = 0, detail::integral<T> = 0>
+  inline pack<T, W> andnot(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = andnot(p1.v.block[i], p2.v.block[i]);
+
+    return result;
+  }
+
+  // Comparison operators ///////////////////////////////////////////////////
+
+  // binary operator==() //
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline mask_for<T, W> operator==(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    mask_for<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] == p2.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
+  operator==(const pack<T, W> &p1, const OTHER_T &v)
+  {
+    mask_for<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] == T(v));
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
+  operator==(const OTHER_T &v, const pack<T, W> &p1)
+  {
+    mask_for<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (T(v) == p1.v.block[i]);
+
+    return result;
+  }
+
+  // binary operator!=() //
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline mask_for<T, W> operator!=(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    mask_for<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] != p2.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
+  operator!=(const pack<T, W> &p1, const OTHER_T &v)
+  {
+    mask_for<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] != T(v));
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
+  operator!=(const OTHER_T &v, const pack<T, W> &p1)
+  {
+    mask_for<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (T(v) != p1.v.block[i]);
+
+    return result;
+  }
+
+  // binary operator<() //
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline mask_for<T, W> operator<(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    mask_for<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] < p2.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
+  operator<(const pack<T, W> &p1, const OTHER_T &v)
+  {
+    mask_for<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] < T(v));
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
+  operator<(const OTHER_T &v, const pack<T, W> &p1)
+  {
+    mask_for<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (T(v) < p1.v.block[i]);
+
+    return result;
+  }
+
+  // binary operator<=() //
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline mask_for<T, W> operator<=(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    mask_for<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] <= p2.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
+  operator<=(const pack<T, W> &p1, const OTHER_T &v)
+  {
+    mask_for<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] <= T(v));
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
+  operator<=(const OTHER_T &v, const pack<T, W> &p1)
+  {
+    mask_for<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (T(v) <= p1.v.block[i]);
+
+    return result;
+  }
+
+  // binary operator>() //
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline mask_for<T, W> operator>(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    mask_for<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] > p2.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
+  operator>(const pack<T, W> &p1, const OTHER_T &v)
+  {
+    mask_for<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] > T(v));
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
+  operator>(const OTHER_T &v, const pack<T, W> &p1)
+  {
+    mask_for<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (T(v) > p1.v.block[i]);
+
+    return result;
+  }
+
+  // binary operator>=() //
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline mask_for<T, W> operator>=(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    mask_for<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] >= p2.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
+  operator>=(const pack<T, W> &p1, const OTHER_T &v)
+  {
+    mask_for<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (p1.v.block[i] >= T(v));
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
+  operator>=(const OTHER_T &v, const pack<T, W> &p1)
+  {
+    mask_for<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = (T(v) >= p1.v.block[i]);
+
+    return result;
+  }
+
+  // Mask logic operators ///////////////////////////////////////////////////
+
+  // binary operator&&() //
+
+  template <typename M, int W, detail::blockwise<M, W> = 0>
+  inline typename
+  std::enable_if<detail::is_mask_element<M>::value, pack<M, W>>::type
+  operator&&(const pack<M, W> &m1, const pack<M, W> &m2)
+  {
+    pack<M, W> result;
+
+    for (int i = 0; i < detail::blocking<M, W>::blocks; ++i)
+      result.v.block[i] = (m1.v.block[i] && m2.v.block[i]);
+
+    return result;
+  }
+
+  // binary operator||() //
+
+  template <typename M, int W, detail::blockwise<M, W> = 0>
+  inline typename
+  std::enable_if<detail::is_mask_element<M>::value, pack<M, W>>::type
+  operator||(const pack<M, W> &m1, const pack<M, W> &m2)
+  {
+    pack<M, W> result;
+
+    for (int i = 0; i < detail::blocking<M, W>::blocks; ++i)
+      result.v.block[i] = (m1.v.block[i] || m2.v.block[i]);
+
+    return result;
+  }
+
+  // unary operator!() //
+
+  template <typename M, int W, detail::blockwise<M, W> = 0>
+  inline typename
+  std::enable_if<detail::is_mask_element<M>::value, pack<M, W>>::type
+  operator!(const pack<M, W> &m)
+  {
+    pack<M, W> result;
+
+    for (int i = 0; i < detail::blocking<M, W>::blocks; ++i)
+      result.v.block[i] = !m.v.block[i];
+
+    return result;
+  }
+
+  // Reductions /////////////////////////////////////////////////////////////
+
+  // NOTE: sub-masks are combined vertically first, so only one horizontal
+  //       reduction is done regardless of the number of sub-packs
+
+  template <typename M, int W, detail::blockwise<M, W> = 0>
+  inline typename std::enable_if<detail::is_mask_element<M>::value, bool>::type
+  any(const pack<M, W> &m)
+  {
+    auto active = m.v.block[0];
+
+    for (int i = 1; i < detail::blocking<M, W>::blocks; ++i)
+      active = (active || m.v.block[i]);
+
+    return any(active);
+  }
+
+  template <typename M, int W, detail::blockwise<M, W> = 0>
+  inline typename std::enable_if<detail::is_mask_element<M>::value, bool>::type
+  all(const pack<M, W> &m)
+  {
+    auto active = m.v.block[0];
+
+    for (int i = 1; i < detail::blocking<M, W>::blocks; ++i)
+      active = (active && m.v.block[i]);
+
+    return all(active);
+  }
+
+  // Algorithms /////////////////////////////////////////////////////////////
+
+  template <typename M, typename T, int W, detail::blockwise<T, W> = 0>
+  inline typename
+  std::enable_if<detail::is_mask_element<M>::value, pack<T, W>>::type
+  select(const pack<M, W> &m, const pack<T, W> &t, const pack<T, W> &f)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = select(m.v.block[i], t.v.block[i], f.v.block[i]);
+
+    return result;
+  }
+
+  // Math functions /////////////////////////////////////////////////////////
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> abs(const pack<T, W> &p)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = abs(p.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> sqrt(const pack<T, W> &p)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = sqrt(p.v.block[i]);
+
+    return result;
+  }
+
+  namespace detail {
+
+    template <typename T, int W, blockwise<T, W> = 0>
+    inline pack<T, W> rcp_estimate(const pack<T, W> &p)
+    {
+      pack<T, W> result;
+
+      for (int i = 0; i < blocking<T, W>::blocks; ++i)
+        result.v.block[i] = rcp_estimate(p.v.block[i]);
+
+      return result;
+    }
+
+    template <typename T, int W, blockwise<T, W> = 0>
+    inline pack<T, W> rsqrt_estimate(const pack<T, W> &p)
+    {
+      pack<T, W> result;
+
+      for (int i = 0; i < blocking<T, W>::blocks; ++i)
+        result.v.block[i] = rsqrt_estimate(p.v.block[i]);
+
+      return result;
+    }
+
+  } // ::psimd::detail
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> max(const pack<T, W> &a, const pack<T, W> &b)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = max(a.v.block[i], b.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> min(const pack<T, W> &a, const pack<T, W> &b)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = min(a.v.block[i], b.v.block[i]);
+
+    return result;
+  }
+
+  // Fused multiply-add ///////////////////////////////////////////////////////
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> fma(const pack<T, W> &a,
+                        const pack<T, W> &b,
+                        const pack<T, W> &c)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = fma(a.v.block[i], b.v.block[i], c.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> fms(const pack<T, W> &a,
+                        const pack<T, W> &b,
+                        const pack<T, W> &c)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = fms(a.v.block[i], b.v.block[i], c.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> fnma(const pack<T, W> &a,
+                         const pack<T, W> &b,
+                         const pack<T, W> &c)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = fnma(a.v.block[i], b.v.block[i], c.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> fnms(const pack<T, W> &a,
+                         const pack<T, W> &b,
+                         const pack<T, W> &c)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = fnms(a.v.block[i], b.v.block[i], c.v.block[i]);
+
+    return result;
+  }
+
+  // Rounding and conversions to int ////////////////////////////////////////
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> floor(const pack<T, W> &p)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = floor(p.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> ceil(const pack<T, W> &p)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = ceil(p.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> trunc(const pack<T, W> &p)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = trunc(p.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<T, W> nearbyint(const pack<T, W> &p)
+  {
+    pack<T, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      result.v.block[i] = nearbyint(p.v.block[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<int, W> to_int_round(const pack<T, W> &p)
+  {
+    constexpr int block_size = detail::blocking<T, W>::block_size;
+
+    pack<int, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i) {
+      const pack<int, block_size> block = to_int_round(p.v.block[i]);
+      for (int j = 0; j < block_size; ++j)
+        result[i * block_size + j] = block[j];
+    }
+
+    return result;
+  }
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline pack<int, W> to_int_trunc(const pack<T, W> &p)
+  {
+    constexpr int block_size = detail::blocking<T, W>::block_size;
+
+    pack<int, W> result;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i) {
+      const pack<int, block_size> block = to_int_trunc(p.v.block[i]);
+      for (int j = 0; j < block_size; ++j)
+        result[i * block_size + j] = block[j];
+    }
+
+    return result;
+  }
+
+  // Streaming stores ///////////////////////////////////////////////////////
+
+  template <typename T, int W, detail::blockwise<T, W> = 0>
+  inline void store_stream(const pack<T, W> &p, void* _dst)
+  {
+    constexpr int block_size = detail::blocking<T, W>::block_size;
+
+    auto *dst = (T*) _dst;
+
+    for (int i = 0; i < detail::blocking<T, W>::blocks; ++i)
+      store_stream(p.v.block[i], dst + i * block_size);
+  }
+
+  // Whole-pack loads ///////////////////////////////////////////////////////
+
+  namespace detail {
+
+    template <typename T, int W>
+    struct pack_loader<T, W, true>
+    {
+      using block_loader = pack_loader<T, blocking<T, W>::block_size>;
+
+      static pack<T, W> aligned(const T *src)
+      {
+        constexpr int block_size = blocking<T, W>::block_size;
+
+        pack<T, W> result;
+
+        for (int i = 0; i < blocking<T, W>::blocks; ++i)
+          result.v.block[i] = block_loader::aligned(src + i * block_size);
+
+        return result;
+      }
+
+      static pack<T, W> unaligned(const T *src)
+      {
+        constexpr int block_size = blocking<T, W>::block_size;
+
+        pack<T, W> result;
+
+        for (int i = 0; i < blocking<T, W>::blocks; ++i)
+          result.v.block[i] = block_loader::unaligned(src + i * block_size);
+
+        return result;
+      }
+    };
+
+  } // ::psimd::detail
+
+  // Gathers and scatters ///////////////////////////////////////////////////
+
+  namespace detail {
+
+    // Offsets of sub-pack b of a pack<T, W> //
+
+    template <typename T, int W, typename OFFSET_T>
+    inline pack<OFFSET_T, blocking<T, W>::block_size>
+    block_offsets(const pack<OFFSET_T, W> &o, int b)
+    {
+      constexpr int block_size = blocking<T, W>::block_size;
+      return pack_loader<OFFSET_T, block_size>::unaligned(&o[b * block_size]);
+    }
+
+    template <typename T, int W, typename OFFSET_T>
+    struct pack_gatherer<T, W, OFFSET_T, true>
+    {
+      using block_gatherer =
+          pack_gatherer<T, blocking<T, W>::block_size, OFFSET_T>;
+
+      template <int SCALE>
+      static pack<T, W> gather(const void *base, const pack<OFFSET_T, W> &o)
+      {
+        pack<T, W> result;
+
+        for (int i = 0; i < blocking<T, W>::blocks; ++i) {
+          result.v.block[i] = block_gatherer::template gather<SCALE>(
+              base, block_offsets<T>(o, i));
+        }
+
+        return result;
+      }
+
+      template <int SCALE>
+      static pack<T, W> gather(const void *base,
+                               const pack<OFFSET_T, W> &o,
+                               const mask_for<T, W> &m)
+      {
+        pack<T, W> result;
+
+        for (int i = 0; i < blocking<T, W>::blocks; ++i) {
+          result.v.block[i] = block_gatherer::template gather<SCALE>(
+              base, block_offsets<T>(o, i), m.v.block[i]);
+        }
+
+        return result;
+      }
+    };
+
+    template <typename T, int W, typename OFFSET_T>
+    struct pack_scatterer<T, W, OFFSET_T, true>
+    {
+      using block_scatterer =
+          pack_scatterer<T, blocking<T, W>::block_size, OFFSET_T>;
+
+      template <int SCALE>
+      static void scatter(const pack<T, W> &p,
+                          void *base,
+                          const pack<OFFSET_T, W> &o)
+      {
+        for (int i = 0; i < blocking<T, W>::blocks; ++i) {
+          block_scatterer::template scatter<SCALE>(
+              p.v.block[i], base, block_offsets<T>(o, i));
+        }
+      }
+
+      template <int SCALE>
+      static void scatter(const pack<T, W> &p,
+                          void *base,
+                          const pack<OFFSET_T, W> &o,
+                          const mask_for<T, W> &m)
+      {
+        for (int i = 0; i < blocking<T, W>::blocks; ++i) {
+          block_scatterer::template scatter<SCALE>(
+              p.v.block[i], base, block_offsets<T>(o, i), m.v.block[i]);
+        }
+      }
+    };
+
+  } // ::psimd::detail
+
+PSIMD_NAMESPACE_END // ::psimd
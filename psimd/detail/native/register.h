@@ -0,0 +1,184 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+#pragma once
+
+#include <type_traits>
+
+#include "../config.h"
+
+#if PSIMD_NATIVE_SSE2
+#  include <immintrin.h>
+#endif
+
+PSIMD_NAMESPACE_BEGIN
+
+  template <typename T, int W>
+  struct pack;
+
+  namespace detail {
+
+    // Storage overlaid on pack<>::data when no native register fits //
+
+    struct no_register {};
+
+    // Native register type backing a pack<T, W> //
+
+    template <typename T, int W>
+    struct native_register
+    {
+      using type = no_register;
+    };
+
+#if PSIMD_NATIVE_SSE2
+    template <> struct native_register<float, 4>     { using type = __m128;  };
+    template <> struct native_register<int, 4>       { using type = __m128i; };
+    template <> struct native_register<double, 2>    { using type = __m128d; };
+    template <> struct native_register<long long, 2> { using type = __m128i; };
+#endif
+
+#if PSIMD_NATIVE_AVX2
+    template <> struct native_register<float, 8>     { using type = __m256;  };
+    template <> struct native_register<int, 8>       { using type = __m256i; };
+    template <> struct native_register<double, 4>    { using type = __m256d; };
+    template <> struct native_register<long long, 4> { using type = __m256i; };
+#endif
+
+#if PSIMD_NATIVE_AVX512
+    template <> struct native_register<float, 16>    { using type = __m512;  };
+    template <> struct native_register<int, 16>      { using type = __m512i; };
+    template <> struct native_register<double, 8>    { using type = __m512d; };
+    template <> struct native_register<long long, 8> { using type = __m512i; };
+#endif
+
+    template <typename T, int W>
+    struct has_native_register
+        : std::integral_constant<bool,
+            !std::is_same<typename native_register<T, W>::type,
+                          no_register>::value>
+    {
+    };
+
+    // Over-wide packs (W a multiple of native_width<T>() with no register of
+    // their own) are register-blocked: stored and operated on as an array of
+    // native-width sub-packs, see native/blocked.h //
+
+    template <typename T, int W>
+    struct blocking
+    {
+      static constexpr int block_size = native_width<T>();
+      static constexpr int blocks     = W / block_size;
+
+      static constexpr bool value =
+          has_native_register<T, block_size>::value &&
+          !has_native_register<T, W>::value &&
+          W > block_size && W % block_size == 0;
+    };
+
+    template <typename T, int W>
+    struct is_blocked : std::integral_constant<bool, blocking<T, W>::value>
+    {
+    };
+
+    template <typename T, int BLOCK_SIZE, int BLOCKS>
+    struct blocked_register
+    {
+      pack<T, BLOCK_SIZE> block[BLOCKS];
+    };
+
+    // Storage overlaid on pack<T, W>::data //
+
+    template <typename T, int W, bool BLOCKED = is_blocked<T, W>::value>
+    struct pack_register
+    {
+      using type = typename native_register<T, W>::type;
+    };
+
+    template <typename T, int W>
+    struct pack_register<T, W, true>
+    {
+      using type = blocked_register<T, blocking<T, W>::block_size,
+                                    blocking<T, W>::blocks>;
+    };
+
+    // Packs with hardware reciprocal and reciprocal square root estimates
+    // (rcp_estimate() and rsqrt_estimate() in the native backends) //
+
+    template <typename T, int W, bool BLOCKED = is_blocked<T, W>::value>
+    struct has_native_estimate : std::false_type
+    {
+    };
+
+    template <typename T, int W>
+    struct has_native_estimate<T, W, true>
+        : has_native_estimate<T, blocking<T, W>::block_size>
+    {
+    };
+
+#if PSIMD_NATIVE_SSE2
+    template <> struct has_native_estimate<float, 4>  : std::true_type {};
+#endif
+
+#if PSIMD_NATIVE_AVX2
+    template <> struct has_native_estimate<float, 8>  : std::true_type {};
+#endif
+
+#if PSIMD_NATIVE_AVX512
+    template <> struct has_native_estimate<float, 16> : std::true_type {};
+    template <> struct has_native_estimate<double, 8> : std::true_type {};
+#endif
+
+    // Overload constraints selecting between the lane-by-lane implementation
+    // of an operation and its per sub-pack one for register-blocked packs //
+
+    template <typename T, int W>
+    using lanewise =
+        typename std::enable_if<!is_blocked<T, W>::value, int>::type;
+
+    template <typename T, int W>
+    using blockwise =
+        typename std::enable_if<is_blocked<T, W>::value, int>::type;
+
+    // Overload constraints on the lane type, for operations whose integer and
+    // floating point versions differ (e.g. bitwise operators) //
+
+    template <typename T>
+    using integral =
+        typename std::enable_if<std::is_integral<T>::value, int>::type;
+
+    template <typename T>
+    using floating_point =
+        typename std::enable_if<std::is_floating_point<T>::value, int>::type;
+
+    // Overload constraint on arithmetic scalar operands of another type than
+    // T, which native packs forward to their overloads taking exactly a T //
+
+    template <typename OTHER_T, typename T>
+    using other_scalar =
+        typename std::enable_if<std::is_arithmetic<OTHER_T>::value &&
+                                    !std::is_same<OTHER_T, T>::value,
+                                int>::type;
+
+  } // ::psimd::detail
+PSIMD_NAMESPACE_END // ::psimd
@@ -0,0 +1,2114 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+#pragma once
+
+#include "../bitmask.h"
+#include "../functions/memory.h"
+#include "../pack.h"
+
+#if PSIMD_NATIVE_SSE2
+
+PSIMD_NAMESPACE_BEGIN
+
+  namespace detail {
+
+    inline pack<float, 4> as_pack(const __m128 &v)
+    {
+      pack<float, 4> result;
+      result.v = v;
+      return result;
+    }
+
+    inline pack<int, 4> as_pack(const __m128i &v)
+    {
+      pack<int, 4> result;
+      result.v = v;
+      return result;
+    }
+
+    inline pack<double, 2> as_pack(const __m128d &v)
+    {
+      pack<double, 2> result;
+      result.v = v;
+      return result;
+    }
+
+    // Explicitly typed variant for registers shared by several pack types //
+
+    template <typename T, int W>
+    inline pack<T, W> as_pack(const typename native_register<T, W>::type &v)
+    {
+      pack<T, W> result;
+      result.v = v;
+      return result;
+    }
+
+    // NOTE: masks follow the generic semantics where any non-zero lane is
+    //       active, so they are normalized before being used bitwise
+
+    inline __m128i sse_inactive(const __m128i &m)
+    {
+      return _mm_cmpeq_epi32(m, _mm_setzero_si128());
+    }
+
+    inline __m128i sse_inactive64(const __m128i &m)
+    {
+      const __m128i inactive32 = sse_inactive(m);
+      const __m128i swapped    = _mm_shuffle_epi32(inactive32,
+                                                   _MM_SHUFFLE(2, 3, 0, 1));
+      return _mm_and_si128(inactive32, swapped);
+    }
+
+    inline __m128i sse_not(const __m128i &m)
+    {
+      return _mm_xor_si128(m, _mm_set1_epi32(-1));
+    }
+
+    inline __m128i sse_blend(const __m128i &inactive,
+                             const __m128i &t,
+                             const __m128i &f)
+    {
+      // NOTE: no _mm_blendv_epi8() here, GCC 12 swaps its operands when the
+      //       mask is a compare of a compare (m == 0 with m from ==)
+      return _mm_or_si128(_mm_and_si128(inactive, f),
+                          _mm_andnot_si128(inactive, t));
+    }
+
+    // bit_cast<>() as register casts //
+
+    template <>
+    struct bit_caster<int, float, 4>
+    {
+      static pack<int, 4> convert(const pack<float, 4> &p)
+      {
+        return as_pack(_mm_castps_si128(p.v));
+      }
+    };
+
+    template <>
+    struct bit_caster<float, int, 4>
+    {
+      static pack<float, 4> convert(const pack<int, 4> &p)
+      {
+        return as_pack(_mm_castsi128_ps(p.v));
+      }
+    };
+
+    template <>
+    struct bit_caster<long long, double, 2>
+    {
+      static pack<long long, 2> convert(const pack<double, 2> &p)
+      {
+        return as_pack<long long, 2>(_mm_castpd_si128(p.v));
+      }
+    };
+
+    template <>
+    struct bit_caster<double, long long, 2>
+    {
+      static pack<double, 2> convert(const pack<long long, 2> &p)
+      {
+        return as_pack(_mm_castsi128_pd(p.v));
+      }
+    };
+
+  } // ::psimd::detail
+
+  // pack<float, 4> ///////////////////////////////////////////////////////////
+
+  // binary operator+() //
+
+  inline pack<float, 4> operator+(const pack<float, 4> &p1,
+                                  const pack<float, 4> &p2)
+  {
+    return detail::as_pack(_mm_add_ps(p1.v, p2.v));
+  }
+
+  inline pack<float, 4> operator+(const pack<float, 4> &p1, float v)
+  {
+    return p1 + pack<float, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 4> operator+(const pack<float, 4> &p1, const OTHER_T &v)
+  {
+    return p1 + float(v);
+  }
+
+  inline pack<float, 4> operator+(float v, const pack<float, 4> &p1)
+  {
+    return pack<float, 4>(v) + p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 4> operator+(const OTHER_T &v, const pack<float, 4> &p1)
+  {
+    return float(v) + p1;
+  }
+
+  // binary operator-() //
+
+  inline pack<float, 4> operator-(const pack<float, 4> &p1,
+                                  const pack<float, 4> &p2)
+  {
+    return detail::as_pack(_mm_sub_ps(p1.v, p2.v));
+  }
+
+  inline pack<float, 4> operator-(const pack<float, 4> &p1, float v)
+  {
+    return p1 - pack<float, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 4> operator-(const pack<float, 4> &p1, const OTHER_T &v)
+  {
+    return p1 - float(v);
+  }
+
+  inline pack<float, 4> operator-(float v, const pack<float, 4> &p1)
+  {
+    return pack<float, 4>(v) - p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 4> operator-(const OTHER_T &v, const pack<float, 4> &p1)
+  {
+    return float(v) - p1;
+  }
+
+  // binary operator*() //
+
+  inline pack<float, 4> operator*(const pack<float, 4> &p1,
+                                  const pack<float, 4> &p2)
+  {
+    return detail::as_pack(_mm_mul_ps(p1.v, p2.v));
+  }
+
+  inline pack<float, 4> operator*(const pack<float, 4> &p1, float v)
+  {
+    return p1 * pack<float, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 4> operator*(const pack<float, 4> &p1, const OTHER_T &v)
+  {
+    return p1 * float(v);
+  }
+
+  inline pack<float, 4> operator*(float v, const pack<float, 4> &p1)
+  {
+    return pack<float, 4>(v) * p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 4> operator*(const OTHER_T &v, const pack<float, 4> &p1)
+  {
+    return float(v) * p1;
+  }
+
+  // binary operator/() //
+
+  inline pack<float, 4> operator/(const pack<float, 4> &p1,
+                                  const pack<float, 4> &p2)
+  {
+    return detail::as_pack(_mm_div_ps(p1.v, p2.v));
+  }
+
+  inline pack<float, 4> operator/(const pack<float, 4> &p1, float v)
+  {
+    return p1 / pack<float, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 4> operator/(const pack<float, 4> &p1, const OTHER_T &v)
+  {
+    return p1 / float(v);
+  }
+
+  inline pack<float, 4> operator/(float v, const pack<float, 4> &p1)
+  {
+    return pack<float, 4>(v) / p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline pack<float, 4> operator/(const OTHER_T &v, const pack<float, 4> &p1)
+  {
+    return float(v) / p1;
+  }
+
+  // unary operator-() //
+
+  inline pack<float, 4> operator-(const pack<float, 4> &p)
+  {
+    return detail::as_pack(_mm_xor_ps(p.v, _mm_set1_ps(-0.f)));
+  }
+
+  // binary operator==() //
+
+  inline mask<4> operator==(const pack<float, 4> &p1,
+                            const pack<float, 4> &p2)
+  {
+    return detail::as_pack(_mm_castps_si128(_mm_cmpeq_ps(p1.v, p2.v)));
+  }
+
+  inline mask<4> operator==(const pack<float, 4> &p1, float v)
+  {
+    return p1 == pack<float, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<4> operator==(const pack<float, 4> &p1, const OTHER_T &v)
+  {
+    return p1 == float(v);
+  }
+
+  inline mask<4> operator==(float v, const pack<float, 4> &p1)
+  {
+    return pack<float, 4>(v) == p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<4> operator==(const OTHER_T &v, const pack<float, 4> &p1)
+  {
+    return float(v) == p1;
+  }
+
+  // binary operator!=() //
+
+  inline mask<4> operator!=(const pack<float, 4> &p1,
+                            const pack<float, 4> &p2)
+  {
+    return detail::as_pack(_mm_castps_si128(_mm_cmpneq_ps(p1.v, p2.v)));
+  }
+
+  inline mask<4> operator!=(const pack<float, 4> &p1, float v)
+  {
+    return p1 != pack<float, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<4> operator!=(const pack<float, 4> &p1, const OTHER_T &v)
+  {
+    return p1 != float(v);
+  }
+
+  inline mask<4> operator!=(float v, const pack<float, 4> &p1)
+  {
+    return pack<float, 4>(v) != p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<4> operator!=(const OTHER_T &v, const pack<float, 4> &p1)
+  {
+    return float(v) != p1;
+  }
+
+  // binary operator<() //
+
+  inline mask<4> operator<(const pack<float, 4> &p1,
+                           const pack<float, 4> &p2)
+  {
+    return detail::as_pack(_mm_castps_si128(_mm_cmplt_ps(p1.v, p2.v)));
+  }
+
+  inline mask<4> operator<(const pack<float, 4> &p1, float v)
+  {
+    return p1 < pack<float, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<4> operator<(const pack<float, 4> &p1, const OTHER_T &v)
+  {
+    return p1 < float(v);
+  }
+
+  inline mask<4> operator<(float v, const pack<float, 4> &p1)
+  {
+    return pack<float, 4>(v) < p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<4> operator<(const OTHER_T &v, const pack<float, 4> &p1)
+  {
+    return float(v) < p1;
+  }
+
+  // binary operator<=() //
+
+  inline mask<4> operator<=(const pack<float, 4> &p1,
+                            const pack<float, 4> &p2)
+  {
+    return detail::as_pack(_mm_castps_si128(_mm_cmple_ps(p1.v, p2.v)));
+  }
+
+  inline mask<4> operator<=(const pack<float, 4> &p1, float v)
+  {
+    return p1 <= pack<float, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<4> operator<=(const pack<float, 4> &p1, const OTHER_T &v)
+  {
+    return p1 <= float(v);
+  }
+
+  inline mask<4> operator<=(float v, const pack<float, 4> &p1)
+  {
+    return pack<float, 4>(v) <= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<4> operator<=(const OTHER_T &v, const pack<float, 4> &p1)
+  {
+    return float(v) <= p1;
+  }
+
+  // binary operator>() //
+
+  inline mask<4> operator>(const pack<float, 4> &p1,
+                           const pack<float, 4> &p2)
+  {
+    return detail::as_pack(_mm_castps_si128(_mm_cmpgt_ps(p1.v, p2.v)));
+  }
+
+  inline mask<4> operator>(const pack<float, 4> &p1, float v)
+  {
+    return p1 > pack<float, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<4> operator>(const pack<float, 4> &p1, const OTHER_T &v)
+  {
+    return p1 > float(v);
+  }
+
+  inline mask<4> operator>(float v, const pack<float, 4> &p1)
+  {
+    return pack<float, 4>(v) > p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<4> operator>(const OTHER_T &v, const pack<float, 4> &p1)
+  {
+    return float(v) > p1;
+  }
+
+  // binary operator>=() //
+
+  inline mask<4> operator>=(const pack<float, 4> &p1,
+                            const pack<float, 4> &p2)
+  {
+    return detail::as_pack(_mm_castps_si128(_mm_cmpge_ps(p1.v, p2.v)));
+  }
+
+  inline mask<4> operator>=(const pack<float, 4> &p1, float v)
+  {
+    return p1 >= pack<float, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<4> operator>=(const pack<float, 4> &p1, const OTHER_T &v)
+  {
+    return p1 >= float(v);
+  }
+
+  inline mask<4> operator>=(float v, const pack<float, 4> &p1)
+  {
+    return pack<float, 4>(v) >= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, float> = 0>
+  inline mask<4> operator>=(const OTHER_T &v, const pack<float, 4> &p1)
+  {
+    return float(v) >= p1;
+  }
+
+  // abs() //
+
+  inline pack<float, 4> abs(const pack<float, 4> &p)
+  {
+    return detail::as_pack(_mm_andnot_ps(_mm_set1_ps(-0.f), p.v));
+  }
+
+  // sqrt() //
+
+  inline pack<float, 4> sqrt(const pack<float, 4> &p)
+  {
+    return detail::as_pack(_mm_sqrt_ps(p.v));
+  }
+
+  // rcp_estimate() and rsqrt_estimate() //
+
+  namespace detail {
+
+    inline pack<float, 4> rcp_estimate(const pack<float, 4> &p)
+    {
+      return as_pack(_mm_rcp_ps(p.v));
+    }
+
+    inline pack<float, 4> rsqrt_estimate(const pack<float, 4> &p)
+    {
+      return as_pack(_mm_rsqrt_ps(p.v));
+    }
+
+  } // ::psimd::detail
+
+  // max() //
+
+  // NOTE: operands are swapped so NaN lanes resolve like std::max()/std::min()
+
+  inline pack<float, 4> max(const pack<float, 4> &a,
+                            const pack<float, 4> &b)
+  {
+    return detail::as_pack(_mm_max_ps(b.v, a.v));
+  }
+
+  // min() //
+
+  inline pack<float, 4> min(const pack<float, 4> &a,
+                            const pack<float, 4> &b)
+  {
+    return detail::as_pack(_mm_min_ps(b.v, a.v));
+  }
+
+  // select() //
+
+  inline pack<float, 4> select(const mask<4> &m,
+                               const pack<float, 4> &t,
+                               const pack<float, 4> &f)
+  {
+    const __m128i inactive = detail::sse_inactive(m.v);
+    return detail::as_pack(_mm_castsi128_ps(
+      detail::sse_blend(inactive, _mm_castps_si128(t.v), _mm_castps_si128(f.v))
+    ));
+  }
+
+  // pack<int, 4> /////////////////////////////////////////////////////////////
+
+  // binary operator+() //
+
+  inline pack<int, 4> operator+(const pack<int, 4> &p1,
+                                const pack<int, 4> &p2)
+  {
+    return detail::as_pack(_mm_add_epi32(p1.v, p2.v));
+  }
+
+  inline pack<int, 4> operator+(const pack<int, 4> &p1, int v)
+  {
+    return p1 + pack<int, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 4> operator+(const pack<int, 4> &p1, const OTHER_T &v)
+  {
+    return p1 + int(v);
+  }
+
+  inline pack<int, 4> operator+(int v, const pack<int, 4> &p1)
+  {
+    return pack<int, 4>(v) + p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 4> operator+(const OTHER_T &v, const pack<int, 4> &p1)
+  {
+    return int(v) + p1;
+  }
+
+  // binary operator-() //
+
+  inline pack<int, 4> operator-(const pack<int, 4> &p1,
+                                const pack<int, 4> &p2)
+  {
+    return detail::as_pack(_mm_sub_epi32(p1.v, p2.v));
+  }
+
+  inline pack<int, 4> operator-(const pack<int, 4> &p1, int v)
+  {
+    return p1 - pack<int, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 4> operator-(const pack<int, 4> &p1, const OTHER_T &v)
+  {
+    return p1 - int(v);
+  }
+
+  inline pack<int, 4> operator-(int v, const pack<int, 4> &p1)
+  {
+    return pack<int, 4>(v) - p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 4> operator-(const OTHER_T &v, const pack<int, 4> &p1)
+  {
+    return int(v) - p1;
+  }
+
+  // unary operator-() //
+
+  inline pack<int, 4> operator-(const pack<int, 4> &p)
+  {
+    return detail::as_pack(_mm_sub_epi32(_mm_setzero_si128(), p.v));
+  }
+
+  // binary operator&() //
+
+  inline pack<int, 4> operator&(const pack<int, 4> &p1,
+                                const pack<int, 4> &p2)
+  {
+    return detail::as_pack(_mm_and_si128(p1.v, p2.v));
+  }
+
+  inline pack<int, 4> operator&(const pack<int, 4> &p1, int v)
+  {
+    return p1 & pack<int, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 4> operator&(const pack<int, 4> &p1, const OTHER_T &v)
+  {
+    return p1 & int(v);
+  }
+
+  inline pack<int, 4> operator&(int v, const pack<int, 4> &p1)
+  {
+    return pack<int, 4>(v) & p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 4> operator&(const OTHER_T &v, const pack<int, 4> &p1)
+  {
+    return int(v) & p1;
+  }
+
+  // binary operator|() //
+
+  inline pack<int, 4> operator|(const pack<int, 4> &p1,
+                                const pack<int, 4> &p2)
+  {
+    return detail::as_pack(_mm_or_si128(p1.v, p2.v));
+  }
+
+  inline pack<int, 4> operator|(const pack<int, 4> &p1, int v)
+  {
+    return p1 | pack<int, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 4> operator|(const pack<int, 4> &p1, const OTHER_T &v)
+  {
+    return p1 | int(v);
+  }
+
+  inline pack<int, 4> operator|(int v, const pack<int, 4> &p1)
+  {
+    return pack<int, 4>(v) | p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 4> operator|(const OTHER_T &v, const pack<int, 4> &p1)
+  {
+    return int(v) | p1;
+  }
+
+  // unary operator~() //
+
+  inline pack<int, 4> operator~(const pack<int, 4> &p)
+  {
+    return detail::as_pack(detail::sse_not(p.v));
+  }
+
+  // andnot() //
+
+  inline pack<int, 4> andnot(const pack<int, 4> &p1,
+                             const pack<int, 4> &p2)
+  {
+    return detail::as_pack(_mm_andnot_si128(p2.v, p1.v));
+  }
+
+  // binary operator^() //
+
+  inline pack<int, 4> operator^(const pack<int, 4> &p1,
+                                const pack<int, 4> &p2)
+  {
+    return detail::as_pack(_mm_xor_si128(p1.v, p2.v));
+  }
+
+  inline pack<int, 4> operator^(const pack<int, 4> &p1, int v)
+  {
+    return p1 ^ pack<int, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 4> operator^(const pack<int, 4> &p1, const OTHER_T &v)
+  {
+    return p1 ^ int(v);
+  }
+
+  inline pack<int, 4> operator^(int v, const pack<int, 4> &p1)
+  {
+    return pack<int, 4>(v) ^ p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 4> operator^(const OTHER_T &v, const pack<int, 4> &p1)
+  {
+    return int(v) ^ p1;
+  }
+
+  // binary operator<<() //
+
+  inline pack<int, 4> operator<<(const pack<int, 4> &p1, int v)
+  {
+    return detail::as_pack(_mm_sll_epi32(p1.v, _mm_cvtsi32_si128(v)));
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 4> operator<<(const pack<int, 4> &p1, const OTHER_T &v)
+  {
+    return p1 << int(v);
+  }
+
+  // binary operator>>() //
+
+  inline pack<int, 4> operator>>(const pack<int, 4> &p1, int v)
+  {
+    return detail::as_pack(_mm_sra_epi32(p1.v, _mm_cvtsi32_si128(v)));
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 4> operator>>(const pack<int, 4> &p1, const OTHER_T &v)
+  {
+    return p1 >> int(v);
+  }
+
+  // binary operator==() //
+
+  inline mask<4> operator==(const pack<int, 4> &p1,
+                            const pack<int, 4> &p2)
+  {
+    return detail::as_pack(_mm_cmpeq_epi32(p1.v, p2.v));
+  }
+
+  inline mask<4> operator==(const pack<int, 4> &p1, int v)
+  {
+    return p1 == pack<int, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<4> operator==(const pack<int, 4> &p1, const OTHER_T &v)
+  {
+    return p1 == int(v);
+  }
+
+  inline mask<4> operator==(int v, const pack<int, 4> &p1)
+  {
+    return pack<int, 4>(v) == p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<4> operator==(const OTHER_T &v, const pack<int, 4> &p1)
+  {
+    return int(v) == p1;
+  }
+
+  // binary operator!=() //
+
+  inline mask<4> operator!=(const pack<int, 4> &p1,
+                            const pack<int, 4> &p2)
+  {
+    return detail::as_pack(detail::sse_not(_mm_cmpeq_epi32(p1.v, p2.v)));
+  }
+
+  inline mask<4> operator!=(const pack<int, 4> &p1, int v)
+  {
+    return p1 != pack<int, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<4> operator!=(const pack<int, 4> &p1, const OTHER_T &v)
+  {
+    return p1 != int(v);
+  }
+
+  inline mask<4> operator!=(int v, const pack<int, 4> &p1)
+  {
+    return pack<int, 4>(v) != p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<4> operator!=(const OTHER_T &v, const pack<int, 4> &p1)
+  {
+    return int(v) != p1;
+  }
+
+  // binary operator<() //
+
+  inline mask<4> operator<(const pack<int, 4> &p1,
+                           const pack<int, 4> &p2)
+  {
+    return detail::as_pack(_mm_cmplt_epi32(p1.v, p2.v));
+  }
+
+  inline mask<4> operator<(const pack<int, 4> &p1, int v)
+  {
+    return p1 < pack<int, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<4> operator<(const pack<int, 4> &p1, const OTHER_T &v)
+  {
+    return p1 < int(v);
+  }
+
+  inline mask<4> operator<(int v, const pack<int, 4> &p1)
+  {
+    return pack<int, 4>(v) < p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<4> operator<(const OTHER_T &v, const pack<int, 4> &p1)
+  {
+    return int(v) < p1;
+  }
+
+  // binary operator<=() //
+
+  inline mask<4> operator<=(const pack<int, 4> &p1,
+                            const pack<int, 4> &p2)
+  {
+    return detail::as_pack(detail::sse_not(_mm_cmpgt_epi32(p1.v, p2.v)));
+  }
+
+  inline mask<4> operator<=(const pack<int, 4> &p1, int v)
+  {
+    return p1 <= pack<int, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<4> operator<=(const pack<int, 4> &p1, const OTHER_T &v)
+  {
+    return p1 <= int(v);
+  }
+
+  inline mask<4> operator<=(int v, const pack<int, 4> &p1)
+  {
+    return pack<int, 4>(v) <= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<4> operator<=(const OTHER_T &v, const pack<int, 4> &p1)
+  {
+    return int(v) <= p1;
+  }
+
+  // binary operator>() //
+
+  inline mask<4> operator>(const pack<int, 4> &p1,
+                           const pack<int, 4> &p2)
+  {
+    return detail::as_pack(_mm_cmpgt_epi32(p1.v, p2.v));
+  }
+
+  inline mask<4> operator>(const pack<int, 4> &p1, int v)
+  {
+    return p1 > pack<int, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<4> operator>(const pack<int, 4> &p1, const OTHER_T &v)
+  {
+    return p1 > int(v);
+  }
+
+  inline mask<4> operator>(int v, const pack<int, 4> &p1)
+  {
+    return pack<int, 4>(v) > p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<4> operator>(const OTHER_T &v, const pack<int, 4> &p1)
+  {
+    return int(v) > p1;
+  }
+
+  // binary operator>=() //
+
+  inline mask<4> operator>=(const pack<int, 4> &p1,
+                            const pack<int, 4> &p2)
+  {
+    return detail::as_pack(detail::sse_not(_mm_cmplt_epi32(p1.v, p2.v)));
+  }
+
+  inline mask<4> operator>=(const pack<int, 4> &p1, int v)
+  {
+    return p1 >= pack<int, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<4> operator>=(const pack<int, 4> &p1, const OTHER_T &v)
+  {
+    return p1 >= int(v);
+  }
+
+  inline mask<4> operator>=(int v, const pack<int, 4> &p1)
+  {
+    return pack<int, 4>(v) >= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline mask<4> operator>=(const OTHER_T &v, const pack<int, 4> &p1)
+  {
+    return int(v) >= p1;
+  }
+
+  // binary operator&&() //
+
+  inline mask<4> operator&&(const mask<4> &m1, const mask<4> &m2)
+  {
+    const __m128i inactive = _mm_or_si128(detail::sse_inactive(m1.v),
+                                          detail::sse_inactive(m2.v));
+    return detail::as_pack(detail::sse_not(inactive));
+  }
+
+  // binary operator||() //
+
+  inline mask<4> operator||(const mask<4> &m1, const mask<4> &m2)
+  {
+    const __m128i inactive = _mm_and_si128(detail::sse_inactive(m1.v),
+                                           detail::sse_inactive(m2.v));
+    return detail::as_pack(detail::sse_not(inactive));
+  }
+
+  // unary operator!() //
+
+  inline mask<4> operator!(const mask<4> &m)
+  {
+    return detail::as_pack(detail::sse_inactive(m.v));
+  }
+
+  // any() //
+
+  inline bool any(const mask<4> &m)
+  {
+    return _mm_movemask_ps(_mm_castsi128_ps(detail::sse_inactive(m.v))) != 0xF;
+  }
+
+  // all() //
+
+  inline bool all(const mask<4> &m)
+  {
+    return _mm_movemask_ps(_mm_castsi128_ps(detail::sse_inactive(m.v))) == 0x0;
+  }
+
+  // select() //
+
+  inline pack<int, 4> select(const mask<4> &m,
+                             const pack<int, 4> &t,
+                             const pack<int, 4> &f)
+  {
+    return detail::as_pack(
+      detail::sse_blend(detail::sse_inactive(m.v), t.v, f.v)
+    );
+  }
+
+#if PSIMD_NATIVE_SSE4_1
+
+  // binary operator*() //
+
+  inline pack<int, 4> operator*(const pack<int, 4> &p1,
+                                const pack<int, 4> &p2)
+  {
+    return detail::as_pack(_mm_mullo_epi32(p1.v, p2.v));
+  }
+
+  inline pack<int, 4> operator*(const pack<int, 4> &p1, int v)
+  {
+    return p1 * pack<int, 4>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 4> operator*(const pack<int, 4> &p1, const OTHER_T &v)
+  {
+    return p1 * int(v);
+  }
+
+  inline pack<int, 4> operator*(int v, const pack<int, 4> &p1)
+  {
+    return pack<int, 4>(v) * p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<int, 4> operator*(const OTHER_T &v, const pack<int, 4> &p1)
+  {
+    return int(v) * p1;
+  }
+
+  // abs() //
+
+  inline pack<int, 4> abs(const pack<int, 4> &p)
+  {
+    return detail::as_pack(_mm_abs_epi32(p.v));
+  }
+
+  // max() //
+
+  inline pack<int, 4> max(const pack<int, 4> &a,
+                          const pack<int, 4> &b)
+  {
+    return detail::as_pack(_mm_max_epi32(a.v, b.v));
+  }
+
+  // min() //
+
+  inline pack<int, 4> min(const pack<int, 4> &a,
+                          const pack<int, 4> &b)
+  {
+    return detail::as_pack(_mm_min_epi32(a.v, b.v));
+  }
+
+#endif
+
+  // pack<double, 2> //////////////////////////////////////////////////////////
+
+  // binary operator+() //
+
+  inline pack<double, 2> operator+(const pack<double, 2> &p1,
+                                   const pack<double, 2> &p2)
+  {
+    return detail::as_pack(_mm_add_pd(p1.v, p2.v));
+  }
+
+  inline pack<double, 2> operator+(const pack<double, 2> &p1, double v)
+  {
+    return p1 + pack<double, 2>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 2> operator+(const pack<double, 2> &p1, const OTHER_T &v)
+  {
+    return p1 + double(v);
+  }
+
+  inline pack<double, 2> operator+(double v, const pack<double, 2> &p1)
+  {
+    return pack<double, 2>(v) + p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 2> operator+(const OTHER_T &v, const pack<double, 2> &p1)
+  {
+    return double(v) + p1;
+  }
+
+  // binary operator-() //
+
+  inline pack<double, 2> operator-(const pack<double, 2> &p1,
+                                   const pack<double, 2> &p2)
+  {
+    return detail::as_pack(_mm_sub_pd(p1.v, p2.v));
+  }
+
+  inline pack<double, 2> operator-(const pack<double, 2> &p1, double v)
+  {
+    return p1 - pack<double, 2>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 2> operator-(const pack<double, 2> &p1, const OTHER_T &v)
+  {
+    return p1 - double(v);
+  }
+
+  inline pack<double, 2> operator-(double v, const pack<double, 2> &p1)
+  {
+    return pack<double, 2>(v) - p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 2> operator-(const OTHER_T &v, const pack<double, 2> &p1)
+  {
+    return double(v) - p1;
+  }
+
+  // binary operator*() //
+
+  inline pack<double, 2> operator*(const pack<double, 2> &p1,
+                                   const pack<double, 2> &p2)
+  {
+    return detail::as_pack(_mm_mul_pd(p1.v, p2.v));
+  }
+
+  inline pack<double, 2> operator*(const pack<double, 2> &p1, double v)
+  {
+    return p1 * pack<double, 2>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 2> operator*(const pack<double, 2> &p1, const OTHER_T &v)
+  {
+    return p1 * double(v);
+  }
+
+  inline pack<double, 2> operator*(double v, const pack<double, 2> &p1)
+  {
+    return pack<double, 2>(v) * p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 2> operator*(const OTHER_T &v, const pack<double, 2> &p1)
+  {
+    return double(v) * p1;
+  }
+
+  // binary operator/() //
+
+  inline pack<double, 2> operator/(const pack<double, 2> &p1,
+                                   const pack<double, 2> &p2)
+  {
+    return detail::as_pack(_mm_div_pd(p1.v, p2.v));
+  }
+
+  inline pack<double, 2> operator/(const pack<double, 2> &p1, double v)
+  {
+    return p1 / pack<double, 2>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 2> operator/(const pack<double, 2> &p1, const OTHER_T &v)
+  {
+    return p1 / double(v);
+  }
+
+  inline pack<double, 2> operator/(double v, const pack<double, 2> &p1)
+  {
+    return pack<double, 2>(v) / p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline pack<double, 2> operator/(const OTHER_T &v, const pack<double, 2> &p1)
+  {
+    return double(v) / p1;
+  }
+
+  // unary operator-() //
+
+  inline pack<double, 2> operator-(const pack<double, 2> &p)
+  {
+    return detail::as_pack(_mm_xor_pd(p.v, _mm_set1_pd(-0.0)));
+  }
+
+  // abs() //
+
+  inline pack<double, 2> abs(const pack<double, 2> &p)
+  {
+    return detail::as_pack(_mm_andnot_pd(_mm_set1_pd(-0.0), p.v));
+  }
+
+  // sqrt() //
+
+  inline pack<double, 2> sqrt(const pack<double, 2> &p)
+  {
+    return detail::as_pack(_mm_sqrt_pd(p.v));
+  }
+
+  // max() //
+
+  inline pack<double, 2> max(const pack<double, 2> &a,
+                             const pack<double, 2> &b)
+  {
+    return detail::as_pack(_mm_max_pd(b.v, a.v));
+  }
+
+  // min() //
+
+  inline pack<double, 2> min(const pack<double, 2> &a,
+                             const pack<double, 2> &b)
+  {
+    return detail::as_pack(_mm_min_pd(b.v, a.v));
+  }
+
+  // mask<4> <--> bitmask<4> conversions //////////////////////////////////////
+
+  inline bitmask<4> to_bitmask(const mask<4> &m)
+  {
+    const __m128i inactive = detail::sse_inactive(m.v);
+    return bitmask<4>::from_bits(~_mm_movemask_ps(_mm_castsi128_ps(inactive)));
+  }
+
+  inline mask<4> to_mask(const bitmask<4> &m)
+  {
+    const __m128i lanes = _mm_setr_epi32(1, 2, 4, 8);
+    const __m128i bits  = _mm_and_si128(_mm_set1_epi32(m.bits), lanes);
+    return detail::as_pack(_mm_cmpeq_epi32(bits, lanes));
+  }
+
+  // mask_for<double, 2> <--> bitmask<2> conversions //////////////////////////
+
+  inline bitmask<2> to_bitmask(const mask_for<double, 2> &m)
+  {
+    const __m128i inactive = detail::sse_inactive64(m.v);
+    return bitmask<2>::from_bits(~_mm_movemask_pd(_mm_castsi128_pd(inactive)));
+  }
+
+  namespace detail {
+
+    template <>
+    struct bitmask_expander<long long, 2>
+    {
+      static pack<long long, 2> expand(const bitmask<2> &m)
+      {
+        const __m128i lanes = _mm_setr_epi32(1, 1, 2, 2);
+        const __m128i bits  = _mm_and_si128(_mm_set1_epi32(m.bits), lanes);
+        return as_pack<long long, 2>(_mm_cmpeq_epi32(bits, lanes));
+      }
+    };
+
+  } // ::psimd::detail
+
+  // mask_for<double, 2> //////////////////////////////////////////////////////
+
+  // binary operator==() //
+
+  inline mask_for<double, 2> operator==(const pack<double, 2> &p1,
+                                        const pack<double, 2> &p2)
+  {
+    return detail::as_pack<long long, 2>(
+      _mm_castpd_si128(_mm_cmpeq_pd(p1.v, p2.v))
+    );
+  }
+
+  inline mask_for<double, 2> operator==(const pack<double, 2> &p1, double v)
+  {
+    return p1 == pack<double, 2>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 2> operator==(const pack<double, 2> &p1,
+                                        const OTHER_T &v)
+  {
+    return p1 == double(v);
+  }
+
+  inline mask_for<double, 2> operator==(double v, const pack<double, 2> &p1)
+  {
+    return pack<double, 2>(v) == p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 2> operator==(const OTHER_T &v,
+                                        const pack<double, 2> &p1)
+  {
+    return double(v) == p1;
+  }
+
+  // binary operator!=() //
+
+  inline mask_for<double, 2> operator!=(const pack<double, 2> &p1,
+                                        const pack<double, 2> &p2)
+  {
+    return detail::as_pack<long long, 2>(
+      _mm_castpd_si128(_mm_cmpneq_pd(p1.v, p2.v))
+    );
+  }
+
+  inline mask_for<double, 2> operator!=(const pack<double, 2> &p1, double v)
+  {
+    return p1 != pack<double, 2>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 2> operator!=(const pack<double, 2> &p1,
+                                        const OTHER_T &v)
+  {
+    return p1 != double(v);
+  }
+
+  inline mask_for<double, 2> operator!=(double v, const pack<double, 2> &p1)
+  {
+    return pack<double, 2>(v) != p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 2> operator!=(const OTHER_T &v,
+                                        const pack<double, 2> &p1)
+  {
+    return double(v) != p1;
+  }
+
+  // binary operator<() //
+
+  inline mask_for<double, 2> operator<(const pack<double, 2> &p1,
+                                       const pack<double, 2> &p2)
+  {
+    return detail::as_pack<long long, 2>(
+      _mm_castpd_si128(_mm_cmplt_pd(p1.v, p2.v))
+    );
+  }
+
+  inline mask_for<double, 2> operator<(const pack<double, 2> &p1, double v)
+  {
+    return p1 < pack<double, 2>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 2> operator<(const pack<double, 2> &p1,
+                                       const OTHER_T &v)
+  {
+    return p1 < double(v);
+  }
+
+  inline mask_for<double, 2> operator<(double v, const pack<double, 2> &p1)
+  {
+    return pack<double, 2>(v) < p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 2> operator<(const OTHER_T &v,
+                                       const pack<double, 2> &p1)
+  {
+    return double(v) < p1;
+  }
+
+  // binary operator<=() //
+
+  inline mask_for<double, 2> operator<=(const pack<double, 2> &p1,
+                                        const pack<double, 2> &p2)
+  {
+    return detail::as_pack<long long, 2>(
+      _mm_castpd_si128(_mm_cmple_pd(p1.v, p2.v))
+    );
+  }
+
+  inline mask_for<double, 2> operator<=(const pack<double, 2> &p1, double v)
+  {
+    return p1 <= pack<double, 2>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 2> operator<=(const pack<double, 2> &p1,
+                                        const OTHER_T &v)
+  {
+    return p1 <= double(v);
+  }
+
+  inline mask_for<double, 2> operator<=(double v, const pack<double, 2> &p1)
+  {
+    return pack<double, 2>(v) <= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 2> operator<=(const OTHER_T &v,
+                                        const pack<double, 2> &p1)
+  {
+    return double(v) <= p1;
+  }
+
+  // binary operator>() //
+
+  inline mask_for<double, 2> operator>(const pack<double, 2> &p1,
+                                       const pack<double, 2> &p2)
+  {
+    return detail::as_pack<long long, 2>(
+      _mm_castpd_si128(_mm_cmpgt_pd(p1.v, p2.v))
+    );
+  }
+
+  inline mask_for<double, 2> operator>(const pack<double, 2> &p1, double v)
+  {
+    return p1 > pack<double, 2>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 2> operator>(const pack<double, 2> &p1,
+                                       const OTHER_T &v)
+  {
+    return p1 > double(v);
+  }
+
+  inline mask_for<double, 2> operator>(double v, const pack<double, 2> &p1)
+  {
+    return pack<double, 2>(v) > p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 2> operator>(const OTHER_T &v,
+                                       const pack<double, 2> &p1)
+  {
+    return double(v) > p1;
+  }
+
+  // binary operator>=() //
+
+  inline mask_for<double, 2> operator>=(const pack<double, 2> &p1,
+                                        const pack<double, 2> &p2)
+  {
+    return detail::as_pack<long long, 2>(
+      _mm_castpd_si128(_mm_cmpge_pd(p1.v, p2.v))
+    );
+  }
+
+  inline mask_for<double, 2> operator>=(const pack<double, 2> &p1, double v)
+  {
+    return p1 >= pack<double, 2>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 2> operator>=(const pack<double, 2> &p1,
+                                        const OTHER_T &v)
+  {
+    return p1 >= double(v);
+  }
+
+  inline mask_for<double, 2> operator>=(double v, const pack<double, 2> &p1)
+  {
+    return pack<double, 2>(v) >= p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, double> = 0>
+  inline mask_for<double, 2> operator>=(const OTHER_T &v,
+                                        const pack<double, 2> &p1)
+  {
+    return double(v) >= p1;
+  }
+
+  // binary operator&&() //
+
+  inline mask_for<double, 2> operator&&(const mask_for<double, 2> &m1,
+                                        const mask_for<double, 2> &m2)
+  {
+    const __m128i inactive = _mm_or_si128(detail::sse_inactive64(m1.v),
+                                          detail::sse_inactive64(m2.v));
+    return detail::as_pack<long long, 2>(detail::sse_not(inactive));
+  }
+
+  // binary operator||() //
+
+  inline mask_for<double, 2> operator||(const mask_for<double, 2> &m1,
+                                        const mask_for<double, 2> &m2)
+  {
+    const __m128i inactive = _mm_and_si128(detail::sse_inactive64(m1.v),
+                                           detail::sse_inactive64(m2.v));
+    return detail::as_pack<long long, 2>(detail::sse_not(inactive));
+  }
+
+  // unary operator!() //
+
+  inline mask_for<double, 2> operator!(const mask_for<double, 2> &m)
+  {
+    return detail::as_pack<long long, 2>(detail::sse_inactive64(m.v));
+  }
+
+  // any() //
+
+  inline bool any(const mask_for<double, 2> &m)
+  {
+    const __m128i inactive = detail::sse_inactive64(m.v);
+    return _mm_movemask_pd(_mm_castsi128_pd(inactive)) != 0x3;
+  }
+
+  // all() //
+
+  inline bool all(const mask_for<double, 2> &m)
+  {
+    const __m128i inactive = detail::sse_inactive64(m.v);
+    return _mm_movemask_pd(_mm_castsi128_pd(inactive)) == 0x0;
+  }
+
+  // select() //
+
+  inline pack<double, 2> select(const mask_for<double, 2> &m,
+                                const pack<double, 2> &t,
+                                const pack<double, 2> &f)
+  {
+    const __m128i inactive = detail::sse_inactive64(m.v);
+    return detail::as_pack(_mm_castsi128_pd(
+      detail::sse_blend(inactive, _mm_castpd_si128(t.v), _mm_castpd_si128(f.v))
+    ));
+  }
+
+  // pack<long long, 2> ////////////////////////////////////////////////////////
+
+  // NOTE: SSE2 has no 64-bit compares, which stay lane by lane here
+
+  // binary operator+() //
+
+  inline pack<long long, 2> operator+(const pack<long long, 2> &p1,
+                                      const pack<long long, 2> &p2)
+  {
+    return detail::as_pack<long long, 2>(_mm_add_epi64(p1.v, p2.v));
+  }
+
+  inline pack<long long, 2> operator+(const pack<long long, 2> &p1, long long v)
+  {
+    return p1 + pack<long long, 2>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 2> operator+(const pack<long long, 2> &p1,
+                                      const OTHER_T &v)
+  {
+    return p1 + static_cast<long long>(v);
+  }
+
+  inline pack<long long, 2> operator+(long long v, const pack<long long, 2> &p1)
+  {
+    return pack<long long, 2>(v) + p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 2> operator+(const OTHER_T &v,
+                                      const pack<long long, 2> &p1)
+  {
+    return static_cast<long long>(v) + p1;
+  }
+
+  // binary operator-() //
+
+  inline pack<long long, 2> operator-(const pack<long long, 2> &p1,
+                                      const pack<long long, 2> &p2)
+  {
+    return detail::as_pack<long long, 2>(_mm_sub_epi64(p1.v, p2.v));
+  }
+
+  inline pack<long long, 2> operator-(const pack<long long, 2> &p1, long long v)
+  {
+    return p1 - pack<long long, 2>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 2> operator-(const pack<long long, 2> &p1,
+                                      const OTHER_T &v)
+  {
+    return p1 - static_cast<long long>(v);
+  }
+
+  inline pack<long long, 2> operator-(long long v, const pack<long long, 2> &p1)
+  {
+    return pack<long long, 2>(v) - p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 2> operator-(const OTHER_T &v,
+                                      const pack<long long, 2> &p1)
+  {
+    return static_cast<long long>(v) - p1;
+  }
+
+  // binary operator&() //
+
+  inline pack<long long, 2> operator&(const pack<long long, 2> &p1,
+                                      const pack<long long, 2> &p2)
+  {
+    return detail::as_pack<long long, 2>(_mm_and_si128(p1.v, p2.v));
+  }
+
+  inline pack<long long, 2> operator&(const pack<long long, 2> &p1, long long v)
+  {
+    return p1 & pack<long long, 2>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 2> operator&(const pack<long long, 2> &p1,
+                                      const OTHER_T &v)
+  {
+    return p1 & static_cast<long long>(v);
+  }
+
+  inline pack<long long, 2> operator&(long long v, const pack<long long, 2> &p1)
+  {
+    return pack<long long, 2>(v) & p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 2> operator&(const OTHER_T &v,
+                                      const pack<long long, 2> &p1)
+  {
+    return static_cast<long long>(v) & p1;
+  }
+
+  // binary operator|() //
+
+  inline pack<long long, 2> operator|(const pack<long long, 2> &p1,
+                                      const pack<long long, 2> &p2)
+  {
+    return detail::as_pack<long long, 2>(_mm_or_si128(p1.v, p2.v));
+  }
+
+  inline pack<long long, 2> operator|(const pack<long long, 2> &p1, long long v)
+  {
+    return p1 | pack<long long, 2>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 2> operator|(const pack<long long, 2> &p1,
+                                      const OTHER_T &v)
+  {
+    return p1 | static_cast<long long>(v);
+  }
+
+  inline pack<long long, 2> operator|(long long v, const pack<long long, 2> &p1)
+  {
+    return pack<long long, 2>(v) | p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 2> operator|(const OTHER_T &v,
+                                      const pack<long long, 2> &p1)
+  {
+    return static_cast<long long>(v) | p1;
+  }
+
+  // binary operator^() //
+
+  inline pack<long long, 2> operator^(const pack<long long, 2> &p1,
+                                      const pack<long long, 2> &p2)
+  {
+    return detail::as_pack<long long, 2>(_mm_xor_si128(p1.v, p2.v));
+  }
+
+  inline pack<long long, 2> operator^(const pack<long long, 2> &p1, long long v)
+  {
+    return p1 ^ pack<long long, 2>(v);
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 2> operator^(const pack<long long, 2> &p1,
+                                      const OTHER_T &v)
+  {
+    return p1 ^ static_cast<long long>(v);
+  }
+
+  inline pack<long long, 2> operator^(long long v, const pack<long long, 2> &p1)
+  {
+    return pack<long long, 2>(v) ^ p1;
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, long long> = 0>
+  inline pack<long long, 2> operator^(const OTHER_T &v,
+                                      const pack<long long, 2> &p1)
+  {
+    return static_cast<long long>(v) ^ p1;
+  }
+
+  // andnot() //
+
+  inline pack<long long, 2> andnot(const pack<long long, 2> &p1,
+                                   const pack<long long, 2> &p2)
+  {
+    return detail::as_pack<long long, 2>(_mm_andnot_si128(p2.v, p1.v));
+  }
+
+  // binary operator<<() //
+
+  inline pack<long long, 2> operator<<(const pack<long long, 2> &p1, int v)
+  {
+    return detail::as_pack<long long, 2>(
+      _mm_sll_epi64(p1.v, _mm_cvtsi32_si128(v))
+    );
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<long long, 2> operator<<(const pack<long long, 2> &p1,
+                                       const OTHER_T &v)
+  {
+    return p1 << int(v);
+  }
+
+  // binary operator>>() //
+
+  inline pack<long long, 2> operator>>(const pack<long long, 2> &p1, int v)
+  {
+    // no 64-bit arithmetic shift before AVX-512: the sign is shifted in
+    // separately, from the high halves of the lanes
+    const __m128i sign = _mm_shuffle_epi32(_mm_srai_epi32(p1.v, 31),
+                                           _MM_SHUFFLE(3, 3, 1, 1));
+    const __m128i high = _mm_sll_epi64(sign, _mm_cvtsi32_si128(64 - v));
+    return detail::as_pack<long long, 2>(
+      _mm_or_si128(_mm_srl_epi64(p1.v, _mm_cvtsi32_si128(v)), high)
+    );
+  }
+
+  template <typename OTHER_T, detail::other_scalar<OTHER_T, int> = 0>
+  inline pack<long long, 2> operator>>(const pack<long long, 2> &p1,
+                                       const OTHER_T &v)
+  {
+    return p1 >> int(v);
+  }
+
+  // select() //
+
+  inline pack<long long, 2> select(const mask_for<long long, 2> &m,
+                                   const pack<long long, 2> &t,
+                                   const pack<long long, 2> &f)
+  {
+    const __m128i inactive = detail::sse_inactive64(m.v);
+    return detail::as_pack<long long, 2>(detail::sse_blend(inactive, t.v, f.v));
+  }
+
+  // Rounding and conversions to int //////////////////////////////////////////
+
+  // NOTE: the conversions return INT_MIN (the "integer indefinite") for lanes
+  //       out of the range of int, as the generic versions do
+
+  // to_int_round() //
+
+  inline pack<int, 4> to_int_round(const pack<float, 4> &p)
+  {
+    return detail::as_pack(_mm_cvtps_epi32(p.v));
+  }
+
+  // to_int_trunc() //
+
+  inline pack<int, 4> to_int_trunc(const pack<float, 4> &p)
+  {
+    return detail::as_pack(_mm_cvttps_epi32(p.v));
+  }
+
+#if PSIMD_NATIVE_SSE4_1
+  // floor() //
+
+  inline pack<float, 4> floor(const pack<float, 4> &p)
+  {
+    return detail::as_pack(
+      _mm_round_ps(p.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // ceil() //
+
+  inline pack<float, 4> ceil(const pack<float, 4> &p)
+  {
+    return detail::as_pack(
+      _mm_round_ps(p.v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // trunc() //
+
+  inline pack<float, 4> trunc(const pack<float, 4> &p)
+  {
+    return detail::as_pack(
+      _mm_round_ps(p.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // nearbyint() //
+
+  inline pack<float, 4> nearbyint(const pack<float, 4> &p)
+  {
+    return detail::as_pack(
+      _mm_round_ps(p.v, _MM_FROUND_CUR_DIRECTION | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // floor() //
+
+  inline pack<double, 2> floor(const pack<double, 2> &p)
+  {
+    return detail::as_pack(
+      _mm_round_pd(p.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // ceil() //
+
+  inline pack<double, 2> ceil(const pack<double, 2> &p)
+  {
+    return detail::as_pack(
+      _mm_round_pd(p.v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // trunc() //
+
+  inline pack<double, 2> trunc(const pack<double, 2> &p)
+  {
+    return detail::as_pack(
+      _mm_round_pd(p.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC)
+    );
+  }
+
+  // nearbyint() //
+
+  inline pack<double, 2> nearbyint(const pack<double, 2> &p)
+  {
+    return detail::as_pack(
+      _mm_round_pd(p.v, _MM_FROUND_CUR_DIRECTION | _MM_FROUND_NO_EXC)
+    );
+  }
+#else
+  // NOTE: without SSE4.1, nearbyint() converts to int and back (cvtps2dq and
+  //       cvtpd2dq round in the current rounding mode); larger lanes are
+  //       integral already (or inf or NaN) and pass through. When a double
+  //       lane is beyond the int range, the pack is split into a multiple of
+  //       2^22 (truncated, exact) and a remainder below 2^22 in magnitude,
+  //       which is rounded; ties still go to even, as the multiple of 2^22 is
+  //       even. Only packs with such lanes take that longer path, which would
+  //       add to the latency of every call
+
+  namespace detail {
+
+    // 'rounded' with the sign of p (for results of -0) in the lanes where
+    // |p| < limit, p elsewhere //
+
+    inline __m128 sse_rounded_lanes(const __m128 &p,
+                                    const __m128 &rounded,
+                                    const __m128 &limit)
+    {
+      const __m128 sign  = _mm_set1_ps(-0.f);
+      const __m128 small = _mm_cmplt_ps(_mm_andnot_ps(sign, p), limit);
+      const __m128 r = _mm_or_ps(rounded, _mm_and_ps(p, sign));
+      return _mm_or_ps(_mm_and_ps(small, r), _mm_andnot_ps(small, p));
+    }
+
+    inline __m128d sse_rounded_lanes(const __m128d &p,
+                                     const __m128d &rounded,
+                                     const __m128d &limit)
+    {
+      const __m128d sign  = _mm_set1_pd(-0.0);
+      const __m128d small = _mm_cmplt_pd(_mm_andnot_pd(sign, p), limit);
+      const __m128d r = _mm_or_pd(rounded, _mm_and_pd(p, sign));
+      return _mm_or_pd(_mm_and_pd(small, r), _mm_andnot_pd(small, p));
+    }
+
+    // nearbyint() of double lanes up to 2^52 in magnitude //
+
+    inline __m128d sse_nearbyint_large(const __m128d &p)
+    {
+      const __m128d scaled = _mm_mul_pd(p, _mm_set1_pd(2.384185791015625e-7));
+      const __m128d high   =
+          _mm_mul_pd(_mm_cvtepi32_pd(_mm_cvttpd_epi32(scaled)),
+                     _mm_set1_pd(4194304.0));
+      const __m128d low     = _mm_sub_pd(p, high);
+      const __m128d rounded =
+          _mm_add_pd(high, _mm_cvtepi32_pd(_mm_cvtpd_epi32(low)));
+      return sse_rounded_lanes(p, rounded, _mm_set1_pd(4503599627370496.0));
+    }
+
+  } // ::psimd::detail
+
+  // nearbyint() //
+
+  inline pack<float, 4> nearbyint(const pack<float, 4> &p)
+  {
+    const __m128 rounded = _mm_cvtepi32_ps(_mm_cvtps_epi32(p.v));
+    return detail::as_pack(
+      detail::sse_rounded_lanes(p.v, rounded, _mm_set1_ps(8388608.f))
+    );
+  }
+
+  inline pack<double, 2> nearbyint(const pack<double, 2> &p)
+  {
+    const __m128d int_range = _mm_set1_pd(1073741824.0);
+
+    const __m128d ap = _mm_andnot_pd(_mm_set1_pd(-0.0), p.v);
+    if (_mm_movemask_pd(_mm_cmpge_pd(ap, int_range)))
+      return detail::as_pack(detail::sse_nearbyint_large(p.v));
+
+    const __m128d rounded = _mm_cvtepi32_pd(_mm_cvtpd_epi32(p.v));
+    return detail::as_pack(detail::sse_rounded_lanes(p.v, rounded, int_range));
+  }
+#endif
+
+  // Butterfly shuffles of tree reductions (see functions/reduce.h) ///////////
+
+  namespace detail {
+
+    inline pack<float, 4> butterfly(const pack<float, 4> &p,
+                                    std::integral_constant<int, 2>)
+    {
+      return as_pack(_mm_shuffle_ps(p.v, p.v, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+    inline pack<float, 4> butterfly(const pack<float, 4> &p,
+                                    std::integral_constant<int, 1>)
+    {
+      return as_pack(_mm_shuffle_ps(p.v, p.v, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    inline pack<int, 4> butterfly(const pack<int, 4> &p,
+                                  std::integral_constant<int, 2>)
+    {
+      return as_pack(_mm_shuffle_epi32(p.v, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+    inline pack<int, 4> butterfly(const pack<int, 4> &p,
+                                  std::integral_constant<int, 1>)
+    {
+      return as_pack(_mm_shuffle_epi32(p.v, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    inline pack<double, 2> butterfly(const pack<double, 2> &p,
+                                     std::integral_constant<int, 1>)
+    {
+      return as_pack(_mm_shuffle_pd(p.v, p.v, 1));
+    }
+
+    inline pack<long long, 2> butterfly(const pack<long long, 2> &p,
+                                        std::integral_constant<int, 1>)
+    {
+      return as_pack<long long, 2>(
+        _mm_shuffle_epi32(p.v, _MM_SHUFFLE(1, 0, 3, 2))
+      );
+    }
+
+  } // ::psimd::detail
+
+  // Lane shifts (see functions/permute.h) ////////////////////////////////////
+
+  // NOTE: lanes shifted in are taken from 'fill', which holds the same value
+  //       in every lane
+
+  namespace detail {
+
+    template <int D>
+    inline pack<float, 4> shift_lanes_up(const pack<float, 4> &p,
+                                         const pack<float, 4> &fill,
+                                         std::integral_constant<int, D>)
+    {
+      const __m128i v = _mm_castps_si128(p.v);
+      const __m128i f = _mm_castps_si128(fill.v);
+      const __m128i shifted = _mm_or_si128(_mm_slli_si128(v, 4 * D),
+                                           _mm_srli_si128(f, 16 - 4 * D));
+      return as_pack(_mm_castsi128_ps(shifted));
+    }
+
+    template <int D>
+    inline pack<int, 4> shift_lanes_up(const pack<int, 4> &p,
+                                       const pack<int, 4> &fill,
+                                       std::integral_constant<int, D>)
+    {
+      const __m128i shifted = _mm_or_si128(_mm_slli_si128(p.v, 4 * D),
+                                           _mm_srli_si128(fill.v, 16 - 4 * D));
+      return as_pack(shifted);
+    }
+
+    template <int D>
+    inline pack<double, 2> shift_lanes_up(const pack<double, 2> &p,
+                                          const pack<double, 2> &fill,
+                                          std::integral_constant<int, D>)
+    {
+      const __m128i v = _mm_castpd_si128(p.v);
+      const __m128i f = _mm_castpd_si128(fill.v);
+      const __m128i shifted = _mm_or_si128(_mm_slli_si128(v, 8 * D),
+                                           _mm_srli_si128(f, 16 - 8 * D));
+      return as_pack(_mm_castsi128_pd(shifted));
+    }
+
+    template <int D>
+    inline pack<long long, 2> shift_lanes_up(const pack<long long, 2> &p,
+                                             const pack<long long, 2> &fill,
+                                             std::integral_constant<int, D>)
+    {
+      const __m128i shifted = _mm_or_si128(_mm_slli_si128(p.v, 8 * D),
+                                           _mm_srli_si128(fill.v, 16 - 8 * D));
+      return as_pack<long long, 2>(shifted);
+    }
+
+    template <int D>
+    inline pack<float, 4> shift_lanes_down(const pack<float, 4> &p,
+                                           const pack<float, 4> &fill,
+                                           std::integral_constant<int, D>)
+    {
+      const __m128i v = _mm_castps_si128(p.v);
+      const __m128i f = _mm_castps_si128(fill.v);
+      const __m128i shifted = _mm_or_si128(_mm_srli_si128(v, 4 * D),
+                                           _mm_slli_si128(f, 16 - 4 * D));
+      return as_pack(_mm_castsi128_ps(shifted));
+    }
+
+    template <int D>
+    inline pack<int, 4> shift_lanes_down(const pack<int, 4> &p,
+                                         const pack<int, 4> &fill,
+                                         std::integral_constant<int, D>)
+    {
+      const __m128i shifted = _mm_or_si128(_mm_srli_si128(p.v, 4 * D),
+                                           _mm_slli_si128(fill.v, 16 - 4 * D));
+      return as_pack(shifted);
+    }
+
+    template <int D>
+    inline pack<double, 2> shift_lanes_down(const pack<double, 2> &p,
+                                            const pack<double, 2> &fill,
+                                            std::integral_constant<int, D>)
+    {
+      const __m128i v = _mm_castpd_si128(p.v);
+      const __m128i f = _mm_castpd_si128(fill.v);
+      const __m128i shifted = _mm_or_si128(_mm_srli_si128(v, 8 * D),
+                                           _mm_slli_si128(f, 16 - 8 * D));
+      return as_pack(_mm_castsi128_pd(shifted));
+    }
+
+    template <int D>
+    inline pack<long long, 2> shift_lanes_down(const pack<long long, 2> &p,
+                                               const pack<long long, 2> &fill,
+                                               std::integral_constant<int, D>)
+    {
+      const __m128i shifted = _mm_or_si128(_mm_srli_si128(p.v, 8 * D),
+                                           _mm_slli_si128(fill.v, 16 - 8 * D));
+      return as_pack<long long, 2>(shifted);
+    }
+
+  } // ::psimd::detail
+
+  // Lane permutations (see functions/permute.h) //////////////////////////////
+
+  inline pack<float, 4> interleave_lo(const pack<float, 4> &a,
+                                      const pack<float, 4> &b)
+  {
+    return detail::as_pack(_mm_unpacklo_ps(a.v, b.v));
+  }
+
+  inline pack<float, 4> interleave_hi(const pack<float, 4> &a,
+                                      const pack<float, 4> &b)
+  {
+    return detail::as_pack(_mm_unpackhi_ps(a.v, b.v));
+  }
+
+  inline pack<int, 4> interleave_lo(const pack<int, 4> &a,
+                                    const pack<int, 4> &b)
+  {
+    return detail::as_pack(_mm_unpacklo_epi32(a.v, b.v));
+  }
+
+  inline pack<int, 4> interleave_hi(const pack<int, 4> &a,
+                                    const pack<int, 4> &b)
+  {
+    return detail::as_pack(_mm_unpackhi_epi32(a.v, b.v));
+  }
+
+  inline pack<double, 2> interleave_lo(const pack<double, 2> &a,
+                                       const pack<double, 2> &b)
+  {
+    return detail::as_pack(_mm_unpacklo_pd(a.v, b.v));
+  }
+
+  inline pack<double, 2> interleave_hi(const pack<double, 2> &a,
+                                       const pack<double, 2> &b)
+  {
+    return detail::as_pack(_mm_unpackhi_pd(a.v, b.v));
+  }
+
+  inline pack<long long, 2> interleave_lo(const pack<long long, 2> &a,
+                                          const pack<long long, 2> &b)
+  {
+    return detail::as_pack<long long, 2>(_mm_unpacklo_epi64(a.v, b.v));
+  }
+
+  inline pack<long long, 2> interleave_hi(const pack<long long, 2> &a,
+                                          const pack<long long, 2> &b)
+  {
+    return detail::as_pack<long long, 2>(_mm_unpackhi_epi64(a.v, b.v));
+  }
+
+  // Streaming stores (see functions/memory.h) ////////////////////////////////
+
+  inline void store_stream(const pack<float, 4> &p, void* _dst)
+  {
+    _mm_stream_ps((float*) _dst, p.v);
+  }
+
+  inline void store_stream(const pack<int, 4> &p, void* _dst)
+  {
+    _mm_stream_si128((__m128i*) _dst, p.v);
+  }
+
+  inline void store_stream(const pack<double, 2> &p, void* _dst)
+  {
+    _mm_stream_pd((double*) _dst, p.v);
+  }
+
+  inline void store_stream(const pack<long long, 2> &p, void* _dst)
+  {
+    _mm_stream_si128((__m128i*) _dst, p.v);
+  }
+
+  // Whole-pack loads (see functions/memory.h) ////////////////////////////////
+
+  namespace detail {
+
+    template <>
+    struct pack_loader<float, 4>
+    {
+      static pack<float, 4> aligned(const float *src)
+      {
+        return as_pack(_mm_load_ps(src));
+      }
+
+      static pack<float, 4> unaligned(const float *src)
+      {
+        return as_pack(_mm_loadu_ps(src));
+      }
+    };
+
+    template <>
+    struct pack_loader<int, 4>
+    {
+      static pack<int, 4> aligned(const int *src)
+      {
+        return as_pack(_mm_load_si128((const __m128i*) src));
+      }
+
+      static pack<int, 4> unaligned(const int *src)
+      {
+        return as_pack(_mm_loadu_si128((const __m128i*) src));
+      }
+    };
+
+    template <>
+    struct pack_loader<double, 2>
+    {
+      static pack<double, 2> aligned(const double *src)
+      {
+        return as_pack(_mm_load_pd(src));
+      }
+
+      static pack<double, 2> unaligned(const double *src)
+      {
+        return as_pack(_mm_loadu_pd(src));
+      }
+    };
+
+    template <>
+    struct pack_loader<long long, 2>
+    {
+      static pack<long long, 2> aligned(const long long *src)
+      {
+        return as_pack<long long, 2>(_mm_load_si128((const __m128i*) src));
+      }
+
+      static pack<long long, 2> unaligned(const long long *src)
+      {
+        return as_pack<long long, 2>(_mm_loadu_si128((const __m128i*) src));
+      }
+    };
+
+  } // ::psimd::detail
+
+PSIMD_NAMESPACE_END // ::psimd
+
+#endif
@@ -28,11 +28,14 @@
 
 #include "../pack.h"
 
-namespace psimd {
+PSIMD_NAMESPACE_BEGIN
+
+#ifndef PSIMD_LAZY // lazy versions in lazy.h
 
   // binary operator+() //
 
-  template <typename T, int W>
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
   inline pack<T, W> operator+(const pack<T, W> &p1, const pack<T, W> &p2)
   {
     pack<T, W> result;
@@ -44,7 +47,8 @@ namespace psimd {
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
   std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
   operator+(const pack<T, W> &p1, const OTHER_T &v)
@@ -58,7 +62,8 @@ namespace psimd {
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
   std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
   operator+(const OTHER_T &v, const pack<T, W> &p1)
@@ -66,6 +71,8 @@ namespace psimd {
     return p1 + v;
   }
 
+#endif
+
   // binary operator+=() //
 
   template <typename T, int W>
@@ -82,9 +89,12 @@ namespace psimd {
     return p1 = (p1 + pack<T, W>(v));
   }
 
+#ifndef PSIMD_LAZY // lazy versions in lazy.h
+
   // binary operator-() //
 
-  template <typename T, int W>
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
   inline pack<T, W> operator-(const pack<T, W> &p1, const pack<T, W> &p2)
   {
     pack<T, W> result;
@@ -96,7 +106,8 @@ namespace psimd {
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
   std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
   operator-(const pack<T, W> &p1, const OTHER_T &v)
@@ -110,7 +121,8 @@ namespace psimd {
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
   std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
   operator-(const OTHER_T &v, const pack<T, W> &p1)
@@ -118,6 +130,8 @@ namespace psimd {
     return pack<T, W>(v) - p1;
   }
 
+#endif
+
   // binary operator-=() //
 
   template <typename T, int W>
@@ -134,9 +148,12 @@ namespace psimd {
     return p1 = (p1 - pack<T, W>(v));
   }
 
+#ifndef PSIMD_LAZY // lazy versions in lazy.h
+
   // binary operator*() //
 
-  template <typename T, int W>
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
   inline pack<T, W> operator*(const pack<T, W> &p1, const pack<T, W> &p2)
   {
     pack<T, W> result;
@@ -148,7 +165,8 @@ namespace psimd {
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
   std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
   operator*(const pack<T, W> &p1, const OTHER_T &v)
@@ -162,7 +180,8 @@ namespace psimd {
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
   std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
   operator*(const OTHER_T &v, const pack<T, W> &p1)
@@ -170,6 +189,8 @@ namespace psimd {
     return p1 * v;
   }
 
+#endif
+
   // binary operator*=() //
 
   template <typename T, int W>
@@ -186,9 +207,12 @@ namespace psimd {
     return p1 = (p1 * pack<T, W>(v));
   }
 
+#ifndef PSIMD_LAZY // lazy versions in lazy.h
+
   // binary operator/() //
 
-  template <typename T, int W>
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
   inline pack<T, W> operator/(const pack<T, W> &p1, const pack<T, W> &p2)
   {
     pack<T, W> result;
@@ -200,7 +224,8 @@ namespace psimd {
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
   std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
   operator/(const pack<T, W> &p1, const OTHER_T &v)
@@ -214,7 +239,8 @@ namespace psimd {
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
   std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
   operator/(const OTHER_T &v, const pack<T, W> &p1)
@@ -222,6 +248,8 @@ namespace psimd {
     return pack<T, W>(v) / p1;
   }
 
+#endif
+
   // binary operator/=() //
 
   template <typename T, int W>
@@ -240,7 +268,8 @@ namespace psimd {
 
   // binary operator%() //
 
-  template <typename T, int W>
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
   inline pack<T, W> operator%(const pack<T, W> &p1, const pack<T, W> &p2)
   {
     pack<T, W> result;
@@ -252,7 +281,8 @@ namespace psimd {
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
   std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
   operator%(const pack<T, W> &p1, const OTHER_T &v)
@@ -266,7 +296,8 @@ namespace psimd {
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
   std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
   operator%(const OTHER_T &v, const pack<T, W> &p1)
@@ -292,7 +323,8 @@ namespace psimd {
 
   // unary operator-() //
 
-  template <typename T, int W>
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
   inline pack<T, W> operator-(const pack<T, W> &p)
   {
     pack<T, W> result;
@@ -304,4 +336,4 @@ namespace psimd {
     return result;
   }
 
-} // ::psimd
\ No newline at end of file
+PSIMD_NAMESPACE_END // ::psimd
\ No newline at end of file
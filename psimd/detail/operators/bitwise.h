@@ -28,11 +28,12 @@
 
 #include "../pack.h"
 
-namespace psimd {
+PSIMD_NAMESPACE_BEGIN
 
   // binary operator<<() //
 
-  template <typename T, int W>
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
   inline pack<T, W> operator<<(const pack<T, W> &p1, const pack<T, W> &p2)
   {
     pack<T, W> result;
@@ -44,7 +45,8 @@ namespace psimd {
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
   std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
   operator<<(const pack<T, W> &p1, const OTHER_T &v)
@@ -58,7 +60,8 @@ namespace psimd {
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
   std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
   operator<<(const OTHER_T &v, const pack<T, W> &p1)
@@ -68,7 +71,8 @@ namespace psimd {
 
   // binary operator>>() //
 
-  template <typename T, int W>
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
   inline pack<T, W> operator>>(const pack<T, W> &p1, const pack<T, W> &p2)
   {
     pack<T, W> result;
@@ -80,7 +84,8 @@ namespace psimd {
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
   std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
   operator>>(const pack<T, W> &p1, const OTHER_T &v)
@@ -94,7 +99,8 @@ namespace psimd {
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
   std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
   operator>>(const OTHER_T &v, const pack<T, W> &p1)
@@ -102,9 +108,88 @@ namespace psimd {
     return pack<T, W>(v) >> p1;
   }
 
+  // binary operator&() //
+
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0, detail::integral<T> = 0>
+  inline pack<T, W> operator&(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    pack<T, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      result[i] = (p1[i] & p2[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0, detail::integral<T> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator&(const pack<T, W> &p1, const OTHER_T &v)
+  {
+    pack<T, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      result[i] = (p1[i] & v);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0, detail::integral<T> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator&(const OTHER_T &v, const pack<T, W> &p1)
+  {
+    return pack<T, W>(v) & p1;
+  }
+
+  // binary operator|() //
+
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0, detail::integral<T> = 0>
+  inline pack<T, W> operator|(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    pack<T, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      result[i] = (p1[i] | p2[i]);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0, detail::integral<T> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator|(const pack<T, W> &p1, const OTHER_T &v)
+  {
+    pack<T, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      result[i] = (p1[i] | v);
+
+    return result;
+  }
+
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0, detail::integral<T> = 0>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
+  operator|(const OTHER_T &v, const pack<T, W> &p1)
+  {
+    return pack<T, W>(v) | p1;
+  }
+
   // binary operator^() //
 
-  template <typename T, int W>
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0, detail::integral<T> = 0>
   inline pack<T, W> operator^(const pack<T, W> &p1, const pack<T, W> &p2)
   {
     pack<T, W> result;
@@ -116,7 +201,8 @@ namespace psimd {
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0, detail::integral<T> = 0>
   inline typename
   std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
   operator^(const pack<T, W> &p1, const OTHER_T &v)
@@ -130,7 +216,8 @@ namespace psimd {
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0, detail::integral<T> = 0>
   inline typename
   std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>>::type
   operator^(const OTHER_T &v, const pack<T, W> &p1)
@@ -138,4 +225,156 @@ namespace psimd {
     return pack<T, W>(v) ^ p1;
   }
 
-} // ::psimd
\ No newline at end of file
+  // unary operator~() //
+
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0, detail::integral<T> = 0>
+  inline pack<T, W> operator~(const pack<T, W> &p)
+  {
+    pack<T, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      result[i] = ~p[i];
+
+    return result;
+  }
+
+  // andnot(): p1 & ~p2 in one operation //
+
+  // NOTE: the operands are in reading order, unlike the x86 andnot
+  //       instructions which negate their first operand
+
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0, detail::integral<T> = 0>
+  inline pack<T, W> andnot(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    pack<T, W> result;
+
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      result[i] = (p1[i] & ~p2[i]);
+
+    return result;
+  }
+
+  // Floating point lanes, operated on through their bits /////////////////////
+
+  template <typename T, int W, detail::floating_point<T> = 0>
+  inline pack<T, W> operator&(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    using bits = mask_for<T, W>;
+    return bit_cast<pack<T, W>>(bit_cast<bits>(p1) & bit_cast<bits>(p2));
+  }
+
+  template <typename T, int W, detail::floating_point<T> = 0>
+  inline pack<T, W> operator|(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    using bits = mask_for<T, W>;
+    return bit_cast<pack<T, W>>(bit_cast<bits>(p1) | bit_cast<bits>(p2));
+  }
+
+  template <typename T, int W, detail::floating_point<T> = 0>
+  inline pack<T, W> operator^(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    using bits = mask_for<T, W>;
+    return bit_cast<pack<T, W>>(bit_cast<bits>(p1) ^ bit_cast<bits>(p2));
+  }
+
+  template <typename T, int W, detail::floating_point<T> = 0>
+  inline pack<T, W> operator~(const pack<T, W> &p)
+  {
+    using bits = mask_for<T, W>;
+    return bit_cast<pack<T, W>>(~bit_cast<bits>(p));
+  }
+
+  template <typename T, int W, detail::floating_point<T> = 0>
+  inline pack<T, W> andnot(const pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    using bits = mask_for<T, W>;
+    return bit_cast<pack<T, W>>(andnot(bit_cast<bits>(p1), bit_cast<bits>(p2)));
+  }
+
+  // Compound assignments /////////////////////////////////////////////////////
+
+  // binary operator&=() //
+
+  template <typename T, int W>
+  inline pack<T, W>& operator&=(pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    return p1 = (p1 & p2);
+  }
+
+  template <typename T, int W, typename OTHER_T>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>&>::type
+  operator&=(pack<T, W> &p1, const OTHER_T &v)
+  {
+    return p1 = (p1 & v);
+  }
+
+  // binary operator|=() //
+
+  template <typename T, int W>
+  inline pack<T, W>& operator|=(pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    return p1 = (p1 | p2);
+  }
+
+  template <typename T, int W, typename OTHER_T>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>&>::type
+  operator|=(pack<T, W> &p1, const OTHER_T &v)
+  {
+    return p1 = (p1 | v);
+  }
+
+  // binary operator^=() //
+
+  template <typename T, int W>
+  inline pack<T, W>& operator^=(pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    return p1 = (p1 ^ p2);
+  }
+
+  template <typename T, int W, typename OTHER_T>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>&>::type
+  operator^=(pack<T, W> &p1, const OTHER_T &v)
+  {
+    return p1 = (p1 ^ v);
+  }
+
+  // binary operator<<=() //
+
+  template <typename T, int W>
+  inline pack<T, W>& operator<<=(pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    return p1 = (p1 << p2);
+  }
+
+  template <typename T, int W, typename OTHER_T>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>&>::type
+  operator<<=(pack<T, W> &p1, const OTHER_T &v)
+  {
+    return p1 = (p1 << v);
+  }
+
+  // binary operator>>=() //
+
+  template <typename T, int W>
+  inline pack<T, W>& operator>>=(pack<T, W> &p1, const pack<T, W> &p2)
+  {
+    return p1 = (p1 >> p2);
+  }
+
+  template <typename T, int W, typename OTHER_T>
+  inline typename
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, pack<T, W>&>::type
+  operator>>=(pack<T, W> &p1, const OTHER_T &v)
+  {
+    return p1 = (p1 >> v);
+  }
+
+PSIMD_NAMESPACE_END // ::psimd
\ No newline at end of file
@@ -0,0 +1,421 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+#pragma once
+
+#include "../functions/math.h"
+#include "../pack.h"
+
+// Opt-in expression templates: with PSIMD_LAZY defined, +, -, * and / on
+// packs (and scalars mixed with packs) build an expression tree instead of a
+// temporary pack per operator. The tree is evaluated in a single lane-by-lane
+// loop when it is assigned to (or used to construct) a pack, and a*b+c style
+// sub-expressions are evaluated with a fused multiply-add.
+//
+// Only generic packs become expressions, i.e. widths with neither a native
+// register nor register blocking (pack<float, 5>, pack<double, 3>, ...).
+// Native packs, such as the native width pack<float> of examples/mandelbrot,
+// keep their own operators: each one is already a single instruction on
+// registers, with no temporary array to fuse away. Register-blocked packs
+// keep theirs as well, one native instruction per block. PSIMD_LAZY changes
+// nothing for either; write fma() where a fused a*b+c is wanted on them.
+//
+// NOTE: expressions refer to the packs they are built from, so they must not
+//       outlive the full expression which creates them: assign them to a
+//       pack rather than to 'auto'. Functions other than comparisons and
+//       select() take an evaluated pack, see eval().
+
+#ifdef PSIMD_LAZY
+
+PSIMD_NAMESPACE_BEGIN
+
+  // Expression node applying OP lane by lane to L and R, evaluated as a
+  // pack<T, W> (lives in psimd:: so operators are found by ADL) //
+
+  template <typename OP, typename L, typename R, typename T, int W>
+  struct expression;
+
+  namespace detail {
+
+    // Lane operations //
+
+    struct add_op
+    {
+      template <typename T>
+      static T apply(T a, T b) { return a + b; }
+    };
+
+    struct sub_op
+    {
+      template <typename T>
+      static T apply(T a, T b) { return a - b; }
+    };
+
+    struct mul_op
+    {
+      template <typename T>
+      static T apply(T a, T b) { return a * b; }
+    };
+
+    struct div_op
+    {
+      template <typename T>
+      static T apply(T a, T b) { return a / b; }
+    };
+
+    // Expression leaves //
+
+    template <typename T, int W>
+    struct pack_term
+    {
+      const pack<T, W> &p;
+
+      T operator[](int i) const { return p[i]; }
+    };
+
+    template <typename T>
+    struct scalar_term
+    {
+      T v;
+
+      T operator[](int) const { return v; }
+    };
+
+    // Expression evaluation //
+
+    template <typename OP, typename L, typename R>
+    inline auto evaluate_lane(OP, const L &l, const R &r, int i)
+        -> decltype(OP::apply(l[i], r[i]))
+    {
+      return OP::apply(l[i], r[i]);
+    }
+
+    // a*b + c, c + a*b, a*b - c and c - a*b contract to a multiply-add //
+
+    template <typename A, typename B, typename R, typename T, int W>
+    inline T evaluate_lane(add_op,
+                           const expression<mul_op, A, B, T, W> &l,
+                           const R &r,
+                           int i)
+    {
+      return contract_multiply_add(l.l[i], l.r[i], r[i]);
+    }
+
+    template <typename L, typename A, typename B, typename T, int W>
+    inline T evaluate_lane(add_op,
+                           const L &l,
+                           const expression<mul_op, A, B, T, W> &r,
+                           int i)
+    {
+      return contract_multiply_add(r.l[i], r.r[i], l[i]);
+    }
+
+    template <typename A, typename B, typename C, typename D,
+              typename T, int W>
+    inline T evaluate_lane(add_op,
+                           const expression<mul_op, A, B, T, W> &l,
+                           const expression<mul_op, C, D, T, W> &r,
+                           int i)
+    {
+      return contract_multiply_add(l.l[i], l.r[i], r[i]);
+    }
+
+    template <typename A, typename B, typename R, typename T, int W>
+    inline T evaluate_lane(sub_op,
+                           const expression<mul_op, A, B, T, W> &l,
+                           const R &r,
+                           int i)
+    {
+      return contract_multiply_add(l.l[i], l.r[i], T(-r[i]));
+    }
+
+    template <typename L, typename A, typename B, typename T, int W>
+    inline T evaluate_lane(sub_op,
+                           const L &l,
+                           const expression<mul_op, A, B, T, W> &r,
+                           int i)
+    {
+      return contract_multiply_add(T(-r.l[i]), r.r[i], l[i]);
+    }
+
+    template <typename A, typename B, typename C, typename D,
+              typename T, int W>
+    inline T evaluate_lane(sub_op,
+                           const expression<mul_op, A, B, T, W> &l,
+                           const expression<mul_op, C, D, T, W> &r,
+                           int i)
+    {
+      return contract_multiply_add(l.l[i], l.r[i], T(-r[i]));
+    }
+
+    template <typename X>
+    struct is_expression : std::false_type {};
+
+    template <typename OP, typename L, typename R, typename T, int W>
+    struct is_expression<expression<OP, L, R, T, W>> : std::true_type {};
+
+    // Operands which make an expression out of an operator: lanewise packs
+    // (native and register-blocked packs keep their own operators) and other
+    // expressions //
+
+    template <typename X>
+    struct lazy_term
+    {
+      static constexpr bool value = false;
+      using type = void;
+      static constexpr int width = 0;
+    };
+
+    template <typename T, int W>
+    struct lazy_term<pack<T, W>>
+    {
+      static constexpr bool value = !is_blocked<T, W>::value;
+      using type = T;
+      static constexpr int width = W;
+
+      using node = pack_term<T, W>;
+      static node make(const pack<T, W> &p) { return {p}; }
+    };
+
+    template <typename OP, typename L, typename R, typename T, int W>
+    struct lazy_term<expression<OP, L, R, T, W>>
+    {
+      static constexpr bool value = true;
+      using type = T;
+      static constexpr int width = W;
+
+      using node = expression<OP, L, R, T, W>;
+      static node make(const node &e) { return e; }
+    };
+
+    // An operand of an expression over pack<T, W>: a matching term, or an
+    // arithmetic scalar broadcast to every lane //
+
+    template <typename X, typename T, int W,
+              bool IS_TERM = lazy_term<X>::value>
+    struct lazy_operand
+    {
+      static constexpr bool value = std::is_arithmetic<X>::value &&
+                                    std::is_convertible<X, T>::value;
+
+      using node = scalar_term<T>;
+      static node make(const X &x) { return {T(x)}; }
+    };
+
+    template <typename X, typename T, int W>
+    struct lazy_operand<X, T, W, true>
+    {
+      static constexpr bool value =
+          std::is_same<typename lazy_term<X>::type, T>::value &&
+          lazy_term<X>::width == W;
+
+      using node = typename lazy_term<X>::node;
+      static node make(const X &x) { return lazy_term<X>::make(x); }
+    };
+
+    template <typename A, typename B>
+    struct lazy_operands
+    {
+      using term = typename std::conditional<lazy_term<A>::value,
+                                             lazy_term<A>,
+                                             lazy_term<B>>::type;
+      using T = typename term::type;
+      static constexpr int W = term::width;
+
+      static constexpr bool value = term::value &&
+                                    lazy_operand<A, T, W>::value &&
+                                    lazy_operand<B, T, W>::value;
+    };
+
+    template <typename OP, typename A, typename B>
+    using expression_for = expression<
+        OP,
+        typename lazy_operand<A, typename lazy_operands<A, B>::T,
+                              lazy_operands<A, B>::W>::node,
+        typename lazy_operand<B, typename lazy_operands<A, B>::T,
+                              lazy_operands<A, B>::W>::node,
+        typename lazy_operands<A, B>::T,
+        lazy_operands<A, B>::W
+    >;
+
+    template <typename OP, typename A, typename B>
+    inline expression_for<OP, A, B> make_expression(const A &a, const B &b)
+    {
+      using T = typename lazy_operands<A, B>::T;
+      constexpr int W = lazy_operands<A, B>::W;
+      return {lazy_operand<A, T, W>::make(a), lazy_operand<B, T, W>::make(b)};
+    }
+
+    template <typename A, typename B>
+    struct has_expression
+        : std::integral_constant<bool, is_expression<A>::value ||
+                                       is_expression<B>::value>
+    {
+    };
+
+  } // ::psimd::detail
+
+  template <typename OP, typename L, typename R, typename T, int W>
+  struct expression
+  {
+    using type      = T;
+    using pack_type = pack<T, W>;
+    enum {static_size = W};
+
+    L l;
+    R r;
+
+    T operator[](int i) const
+    {
+      return detail::evaluate_lane(OP(), l, r, i);
+    }
+  };
+
+  // eval() //
+
+  template <typename X>
+  inline const X& eval(const X &x)
+  {
+    return x;
+  }
+
+  template <typename OP, typename L, typename R, typename T, int W>
+  inline pack<T, W> eval(const expression<OP, L, R, T, W> &e)
+  {
+    return pack<T, W>(e);
+  }
+
+  // binary operator+() //
+
+  template <typename A, typename B>
+  inline typename std::enable_if<detail::lazy_operands<A, B>::value,
+                                 detail::expression_for<detail::add_op, A, B>
+                                >::type
+  operator+(const A &a, const B &b)
+  {
+    return detail::make_expression<detail::add_op>(a, b);
+  }
+
+  // binary operator-() //
+
+  template <typename A, typename B>
+  inline typename std::enable_if<detail::lazy_operands<A, B>::value,
+                                 detail::expression_for<detail::sub_op, A, B>
+                                >::type
+  operator-(const A &a, const B &b)
+  {
+    return detail::make_expression<detail::sub_op>(a, b);
+  }
+
+  // binary operator*() //
+
+  template <typename A, typename B>
+  inline typename std::enable_if<detail::lazy_operands<A, B>::value,
+                                 detail::expression_for<detail::mul_op, A, B>
+                                >::type
+  operator*(const A &a, const B &b)
+  {
+    return detail::make_expression<detail::mul_op>(a, b);
+  }
+
+  // binary operator/() //
+
+  template <typename A, typename B>
+  inline typename std::enable_if<detail::lazy_operands<A, B>::value,
+                                 detail::expression_for<detail::div_op, A, B>
+                                >::type
+  operator/(const A &a, const B &b)
+  {
+    return detail::make_expression<detail::div_op>(a, b);
+  }
+
+  // unary operator-() //
+
+  template <typename OP, typename L, typename R, typename T, int W>
+  inline pack<T, W> operator-(const expression<OP, L, R, T, W> &e)
+  {
+    return -eval(e);
+  }
+
+  // Comparisons and select() evaluate their expression operands //
+
+  template <typename A, typename B, typename = typename
+            std::enable_if<detail::has_expression<A, B>::value>::type>
+  inline auto operator==(const A &a, const B &b)
+      -> decltype(eval(a) == eval(b))
+  {
+    return eval(a) == eval(b);
+  }
+
+  template <typename A, typename B, typename = typename
+            std::enable_if<detail::has_expression<A, B>::value>::type>
+  inline auto operator!=(const A &a, const B &b)
+      -> decltype(eval(a) != eval(b))
+  {
+    return eval(a) != eval(b);
+  }
+
+  template <typename A, typename B, typename = typename
+            std::enable_if<detail::has_expression<A, B>::value>::type>
+  inline auto operator<(const A &a, const B &b)
+      -> decltype(eval(a) < eval(b))
+  {
+    return eval(a) < eval(b);
+  }
+
+  template <typename A, typename B, typename = typename
+            std::enable_if<detail::has_expression<A, B>::value>::type>
+  inline auto operator<=(const A &a, const B &b)
+      -> decltype(eval(a) <= eval(b))
+  {
+    return eval(a) <= eval(b);
+  }
+
+  template <typename A, typename B, typename = typename
+            std::enable_if<detail::has_expression<A, B>::value>::type>
+  inline auto operator>(const A &a, const B &b)
+      -> decltype(eval(a) > eval(b))
+  {
+    return eval(a) > eval(b);
+  }
+
+  template <typename A, typename B, typename = typename
+            std::enable_if<detail::has_expression<A, B>::value>::type>
+  inline auto operator>=(const A &a, const B &b)
+      -> decltype(eval(a) >= eval(b))
+  {
+    return eval(a) >= eval(b);
+  }
+
+  template <typename M, typename A, typename B, typename = typename
+            std::enable_if<detail::has_expression<A, B>::value>::type>
+  inline auto select(const M &m, const A &t, const B &f)
+      -> decltype(select(m, eval(t), eval(f)))
+  {
+    return select(m, eval(t), eval(f));
+  }
+
+PSIMD_NAMESPACE_END // ::psimd
+
+#endif
@@ -26,41 +26,45 @@
 
 #include <type_traits>
 
+#include "../bitmask.h"
 #include "../pack.h"
 
-namespace psimd {
+PSIMD_NAMESPACE_BEGIN
 
   // binary operator==() //
 
-  template <typename T, int W>
-  inline mask<W> operator==(const pack<T, W> &p1, const pack<T, W> &p2)
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline mask_for<T, W> operator==(const pack<T, W> &p1, const pack<T, W> &p2)
   {
-    mask<W> result;
+    mask_for<T, W> result;
 
     #pragma omp simd
     for (int i = 0; i < W; ++i)
-      result[i] = (p1[i] == p2[i]) ? 0xFFFFFFFF : 0x00000000;
+      result[i] = (p1[i] == p2[i]) ? -1 : 0;
 
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
-  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask<W>>::type
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
   operator==(const pack<T, W> &p1, const OTHER_T &v)
   {
-    mask<W> result;
+    mask_for<T, W> result;
 
     #pragma omp simd
     for (int i = 0; i < W; ++i)
-      result[i] = (p1[i] == v) ? 0xFFFFFFFF : 0x00000000;
+      result[i] = (p1[i] == v) ? -1 : 0;
 
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
-  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask<W>>::type
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
   operator==(const OTHER_T &v, const pack<T, W> &p1)
   {
     return p1 == v;
@@ -68,35 +72,38 @@ namespace psimd {
 
   // binary operator!=() //
 
-  template <typename T, int W>
-  inline mask<W> operator!=(const pack<T, W> &p1, const pack<T, W> &p2)
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline mask_for<T, W> operator!=(const pack<T, W> &p1, const pack<T, W> &p2)
   {
-    mask<W> result;
+    mask_for<T, W> result;
 
     #pragma omp simd
     for (int i = 0; i < W; ++i)
-      result[i] = (p1[i] != p2[i]) ? 0xFFFFFFFF : 0x00000000;
+      result[i] = (p1[i] != p2[i]) ? -1 : 0;
 
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
-  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask<W>>::type
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
   operator!=(const pack<T, W> &p1, const OTHER_T &v)
   {
-    mask<W> result;
+    mask_for<T, W> result;
 
     #pragma omp simd
     for (int i = 0; i < W; ++i)
-      result[i] = (p1[i] != v) ? 0xFFFFFFFF : 0x00000000;
+      result[i] = (p1[i] != v) ? -1 : 0;
 
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
-  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask<W>>::type
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
   operator!=(const OTHER_T &v, const pack<T, W> &p1)
   {
     return p1 != v;
@@ -104,35 +111,38 @@ namespace psimd {
 
   // binary operator<() //
 
-  template <typename T, int W>
-  inline mask<W> operator<(const pack<T, W> &p1, const pack<T, W> &p2)
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline mask_for<T, W> operator<(const pack<T, W> &p1, const pack<T, W> &p2)
   {
-    mask<W> result;
+    mask_for<T, W> result;
 
     #pragma omp simd
     for (int i = 0; i < W; ++i)
-      result[i] = (p1[i] < p2[i]) ? 0xFFFFFFFF : 0x00000000;
+      result[i] = (p1[i] < p2[i]) ? -1 : 0;
 
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
-  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask<W>>::type
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
   operator<(const pack<T, W> &p1, const OTHER_T &v)
   {
-    mask<W> result;
+    mask_for<T, W> result;
 
     #pragma omp simd
     for (int i = 0; i < W; ++i)
-      result[i] = (p1[i] < v) ? 0xFFFFFFFF : 0x00000000;
+      result[i] = (p1[i] < v) ? -1 : 0;
 
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
-  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask<W>>::type
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
   operator<(const OTHER_T &v, const pack<T, W> &p1)
   {
     return pack<T, W>(v) < p1;
@@ -140,35 +150,38 @@ namespace psimd {
 
   // binary operator<=() //
 
-  template <typename T, int W>
-  inline mask<W> operator<=(const pack<T, W> &p1, const pack<T, W> &p2)
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline mask_for<T, W> operator<=(const pack<T, W> &p1, const pack<T, W> &p2)
   {
-    mask<W> result;
+    mask_for<T, W> result;
 
     #pragma omp simd
     for (int i = 0; i < W; ++i)
-      result[i] = (p1[i] <= p2[i]) ? 0xFFFFFFFF : 0x00000000;
+      result[i] = (p1[i] <= p2[i]) ? -1 : 0;
 
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
-  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask<W>>::type
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
   operator<=(const pack<T, W> &p1, const OTHER_T &v)
   {
-    mask<W> result;
+    mask_for<T, W> result;
 
     #pragma omp simd
     for (int i = 0; i < W; ++i)
-      result[i] = (p1[i] <= v) ? 0xFFFFFFFF : 0x00000000;
+      result[i] = (p1[i] <= v) ? -1 : 0;
 
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
-  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask<W>>::type
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
   operator<=(const OTHER_T &v, const pack<T, W> &p1)
   {
     return pack<T, W>(v) <= p1;
@@ -176,35 +189,38 @@ namespace psimd {
 
   // binary operator>() //
 
-  template <typename T, int W>
-  inline mask<W> operator>(const pack<T, W> &p1, const pack<T, W> &p2)
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline mask_for<T, W> operator>(const pack<T, W> &p1, const pack<T, W> &p2)
   {
-    mask<W> result;
+    mask_for<T, W> result;
 
     #pragma omp simd
     for (int i = 0; i < W; ++i)
-      result[i] = (p1[i] > p2[i]) ? 0xFFFFFFFF : 0x00000000;
+      result[i] = (p1[i] > p2[i]) ? -1 : 0;
 
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
-  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask<W>>::type
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
   operator>(const pack<T, W> &p1, const OTHER_T &v)
   {
-    mask<W> result;
+    mask_for<T, W> result;
 
     #pragma omp simd
     for (int i = 0; i < W; ++i)
-      result[i] = (p1[i] > v) ? 0xFFFFFFFF : 0x00000000;
+      result[i] = (p1[i] > v) ? -1 : 0;
 
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
-  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask<W>>::type
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
   operator>(const OTHER_T &v, const pack<T, W> &p1)
   {
     return pack<T, W>(v) > p1;
@@ -212,35 +228,38 @@ namespace psimd {
 
   // binary operator>=() //
 
-  template <typename T, int W>
-  inline mask<W> operator>=(const pack<T, W> &p1, const pack<T, W> &p2)
+  template <typename T, int W,
+            detail::lanewise<T, W> = 0>
+  inline mask_for<T, W> operator>=(const pack<T, W> &p1, const pack<T, W> &p2)
   {
-    mask<W> result;
+    mask_for<T, W> result;
 
     #pragma omp simd
     for (int i = 0; i < W; ++i)
-      result[i] = (p1[i] >= p2[i]) ? 0xFFFFFFFF : 0x00000000;
+      result[i] = (p1[i] >= p2[i]) ? -1 : 0;
 
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
-  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask<W>>::type
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
   operator>=(const pack<T, W> &p1, const OTHER_T &v)
   {
-    mask<W> result;
+    mask_for<T, W> result;
 
     #pragma omp simd
     for (int i = 0; i < W; ++i)
-      result[i] = (p1[i] >= v) ? 0xFFFFFFFF : 0x00000000;
+      result[i] = (p1[i] >= v) ? -1 : 0;
 
     return result;
   }
 
-  template <typename T, int W, typename OTHER_T>
+  template <typename T, int W, typename OTHER_T,
+            detail::lanewise<T, W> = 0>
   inline typename
-  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask<W>>::type
+  std::enable_if<std::is_convertible<OTHER_T, T>::value, mask_for<T, W>>::type
   operator>=(const OTHER_T &v, const pack<T, W> &p1)
   {
     return pack<T, W>(v) >= p1;
@@ -248,44 +267,84 @@ namespace psimd {
 
   // binary operator&&() //
 
-  template <int W>
-  inline mask<W> operator&&(const mask<W> &m1, const mask<W> &m2)
+  template <typename M, int W,
+            detail::lanewise<M, W> = 0>
+  inline typename
+  std::enable_if<detail::is_mask_element<M>::value, pack<M, W>>::type
+  operator&&(const pack<M, W> &m1, const pack<M, W> &m2)
   {
-    mask<W> result;
+    pack<M, W> result;
 
     #pragma omp simd
     for (int i = 0; i < W; ++i)
-      result[i] = (m1[i] && m2[i]) ? 0xFFFFFFFF : 0x00000000;
+      result[i] = (m1[i] && m2[i]) ? -1 : 0;
 
     return result;
   }
 
   // binary operator||() //
 
-  template <int W>
-  inline mask<W> operator||(const mask<W> &m1, const mask<W> &m2)
+  template <typename M, int W,
+            detail::lanewise<M, W> = 0>
+  inline typename
+  std::enable_if<detail::is_mask_element<M>::value, pack<M, W>>::type
+  operator||(const pack<M, W> &m1, const pack<M, W> &m2)
   {
-    mask<W> result;
+    pack<M, W> result;
 
     #pragma omp simd
     for (int i = 0; i < W; ++i)
-      result[i] = (m1[i] || m2[i]) ? 0xFFFFFFFF : 0x00000000;
+      result[i] = (m1[i] || m2[i]) ? -1 : 0;
 
     return result;
   }
 
   // unary operator!() //
 
-  template <int W>
-  inline mask<W> operator!(const mask<W> &m)
+  template <typename M, int W,
+            detail::lanewise<M, W> = 0>
+  inline typename
+  std::enable_if<detail::is_mask_element<M>::value, pack<M, W>>::type
+  operator!(const pack<M, W> &m)
   {
-    mask<W> result;
+    pack<M, W> result;
 
     #pragma omp simd
     for (int i = 0; i < W; ++i)
-      result[i] = !m[i] ? 0xFFFFFFFF : 0x00000000;
+      result[i] = !m[i] ? -1 : 0;
 
     return result;
   }
 
-} // ::psimd
\ No newline at end of file
+  // bitmask<> logic operators //
+
+  template <int W>
+  inline bitmask<W> operator&&(const bitmask<W> &m1, const bitmask<W> &m2)
+  {
+    return bitmask<W>::from_bits(m1.bits & m2.bits);
+  }
+
+  template <int W>
+  inline bitmask<W> operator||(const bitmask<W> &m1, const bitmask<W> &m2)
+  {
+    return bitmask<W>::from_bits(m1.bits | m2.bits);
+  }
+
+  template <int W>
+  inline bitmask<W> operator!(const bitmask<W> &m)
+  {
+    return bitmask<W>::from_bits(~m.bits);
+  }
+
+  // mask_cast() //
+
+  template <typename T, typename M, int W>
+  inline typename
+  std::enable_if<detail::is_mask_element<M>::value, mask_for<T, W>>::type
+  mask_cast(const pack<M, W> &m)
+  {
+    using to_mask_t = typename detail::mask_element<T>::type;
+    return detail::mask_converter<to_mask_t, M, W>::convert(m);
+  }
+
+PSIMD_NAMESPACE_END // ::psimd
\ No newline at end of file
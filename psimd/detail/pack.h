@@ -24,11 +24,15 @@
 
 #pragma once
 
+#include <cstring>
+#include <type_traits>
+
 #include "config.h"
+#include "native/register.h"
 
-namespace psimd {
+PSIMD_NAMESPACE_BEGIN
 
-  template <typename T, int W = DEFAULT_WIDTH>
+  template <typename T, int W = PSIMD_DEFAULT_WIDTH(T)>
   struct pack
   {
     pack() = default;
@@ -40,21 +44,110 @@ namespace psimd {
           T& operator[](int i);
 
     template <typename OTHER_T>
-    pack<OTHER_T, W> as();
+    pack<OTHER_T, W> as() const;
+
+#ifdef PSIMD_LAZY
+    // Evaluation of a lazy expression in one loop, see operators/lazy.h //
+
+    template <typename EXPR_T, typename = typename std::enable_if<
+        std::is_same<typename EXPR_T::pack_type, pack<T, W>>::value>::type>
+    pack(const EXPR_T &e);
+
+    template <typename EXPR_T, typename = typename std::enable_if<
+        std::is_same<typename EXPR_T::pack_type, pack<T, W>>::value>::type>
+    pack<T, W>& operator=(const EXPR_T &e);
+#endif
 
     // Compile-time info //
 
     enum {static_size = W};
+    enum {static_alignment = pack_alignment<T, W>::value};
     using type = T;
 
     // Data //
 
-    PSIMD_ALIGN(16) T data[W];
+    union
+    {
+      alignas(static_alignment) T data[W];
+      typename detail::pack_register<T, W>::type v;
+    };
+
+    // NOTE: alignof(pack<T, W>) is exactly pack_alignment<T, W>::value, so
+    //       packs stored in user arrays never straddle their natural boundary
+    static_assert(alignof(typename detail::pack_register<T, W>::type) <=
+                  static_alignment,
+                  "native register must not raise pack<> alignment");
   };
 
-  template <int W = DEFAULT_WIDTH>
+  template <int W = PSIMD_DEFAULT_WIDTH(int)>
   using mask = pack<int, W>;
 
+  namespace detail {
+
+    // Mask lane type with the same width as T's lanes //
+
+    template <typename T>
+    struct mask_element
+    {
+      using type =
+          typename std::conditional<sizeof(T) == 8, long long, int>::type;
+    };
+
+    template <typename M>
+    struct is_mask_element
+        : std::integral_constant<bool, std::is_same<M, int>::value ||
+                                       std::is_same<M, long long>::value>
+    {
+    };
+
+  } // ::psimd::detail
+
+  template <typename T, int W = PSIMD_DEFAULT_WIDTH(T)>
+  using mask_for = pack<typename detail::mask_element<T>::type, W>;
+
+  namespace detail {
+
+    // Conversion between mask lane widths, specialized by native backends //
+
+    template <typename TO_M, typename FROM_M, int W>
+    struct mask_converter
+    {
+      static pack<TO_M, W> convert(const pack<FROM_M, W> &m)
+      {
+        pack<TO_M, W> result;
+
+        #pragma omp simd
+        for (int i = 0; i < W; ++i)
+          result[i] = m[i] ? -1 : 0;
+
+        return result;
+      }
+    };
+
+    // Reinterpretation of lane bits, specialized by native backends //
+
+    template <typename TO_T, typename FROM_T, int W>
+    struct bit_caster
+    {
+      static pack<TO_T, W> convert(const pack<FROM_T, W> &p)
+      {
+        pack<TO_T, W> result;
+        std::memcpy(&result.data, &p.data, sizeof(p.data));
+        return result;
+      }
+    };
+
+    template <typename T, int W>
+    struct bit_caster<T, T, W>
+    {
+      static pack<T, W> convert(const pack<T, W> &p)
+      {
+        return p;
+      }
+    };
+
+  } // ::psimd::detail
+
   // pack<> inlined members ///////////////////////////////////////////////////
 
   template <typename T, int W>
@@ -79,7 +172,7 @@ namespace psimd {
 
   template <typename T, int W>
   template <typename OTHER_T>
-  inline pack<OTHER_T, W> pack<T, W>::as()
+  inline pack<OTHER_T, W> pack<T, W>::as() const
   {
     pack<OTHER_T, W> result;
 
@@ -90,4 +183,42 @@ namespace psimd {
     return result;
   }
 
-} // ::psimd
\ No newline at end of file
+  // bit_cast<pack<U, W>>(): lanes reinterpreted as U, as opposed to the value
+  //                         conversion of as<U>() //
+
+  template <typename TO_PACK_T, typename T, int W>
+  inline TO_PACK_T bit_cast(const pack<T, W> &p)
+  {
+    using to_t = typename TO_PACK_T::type;
+
+    static_assert(std::is_same<TO_PACK_T, pack<to_t, W>>::value,
+                  "bit_cast<>() requires a pack<> of the same width");
+    static_assert(sizeof(to_t) == sizeof(T),
+                  "bit_cast<>() requires lanes of the same size");
+
+    return detail::bit_caster<to_t, T, W>::convert(p);
+  }
+
+#ifdef PSIMD_LAZY
+  template <typename T, int W>
+  template <typename EXPR_T, typename>
+  inline pack<T, W>::pack(const EXPR_T &e)
+  {
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      data[i] = e[i];
+  }
+
+  template <typename T, int W>
+  template <typename EXPR_T, typename>
+  inline pack<T, W>& pack<T, W>::operator=(const EXPR_T &e)
+  {
+    #pragma omp simd
+    for (int i = 0; i < W; ++i)
+      data[i] = e[i];
+
+    return *this;
+  }
+#endif
+
+PSIMD_NAMESPACE_END // ::psimd
\ No newline at end of file
@@ -0,0 +1,149 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+#pragma once
+
+// Runtime ISA dispatch of psimd kernels
+//
+// A kernel is written once in its own source file, which is compiled once per
+// dispatch target by psimd_dispatch_sources() (cmake/psimd.cmake). Each
+// compilation exports its variant of the kernel with PSIMD_DISPATCH_EXPORT():
+//
+//   // kernel.cpp
+//   #include "psimd/psimd.h"
+//   #include "psimd/dispatch.h"
+//
+//   static void saxpy(float a, const float *x, float *y, int n) { ... }
+//
+//   PSIMD_DISPATCH_EXPORT(saxpy_kernel, saxpy)
+//
+// Callers declare the kernel with its signature and call it like a function.
+// The first call selects the best variant the host supports, after which the
+// resolved function pointer is called directly:
+//
+//   PSIMD_DISPATCH_DECLARE(saxpy_kernel, void(float, const float *, float *,
+//                                             int))
+//
+//   saxpy_kernel(2.f, x, y, n);
+
+#include <atomic>
+#include <utility>
+
+#include "detail/cpu.h"
+
+#ifndef PSIMD_DISPATCH_ISA
+#  define PSIMD_DISPATCH_ISA generic
+#endif
+
+#define PSIMD_DISPATCH_CONCAT_IMPL(a, b) a##_##b
+#define PSIMD_DISPATCH_CONCAT(a, b) PSIMD_DISPATCH_CONCAT_IMPL(a, b)
+
+// Define the variant of kernel NAME for the ISA this file is compiled for, by
+// forwarding to FCN (which must match the signature given to
+// PSIMD_DISPATCH_DECLARE()) //
+
+#define PSIMD_DISPATCH_EXPORT(NAME, FCN)                                      \
+  namespace psimd { namespace dispatch_targets {                              \
+    extern decltype(FCN) *const                                               \
+        PSIMD_DISPATCH_CONCAT(NAME, PSIMD_DISPATCH_ISA);                      \
+    decltype(FCN) *const                                                      \
+        PSIMD_DISPATCH_CONCAT(NAME, PSIMD_DISPATCH_ISA) = &FCN;               \
+  } }
+
+// Declare the dispatched kernel NAME with the given signature (a function
+// type) as a callable object; must be used at global scope //
+
+#define PSIMD_DISPATCH_DECLARE(NAME, ...)                                     \
+  namespace psimd { namespace dispatch_targets {                              \
+    using NAME##_signature = __VA_ARGS__;                                     \
+    extern NAME##_signature *const NAME##_generic;                            \
+    extern NAME##_signature *const NAME##_sse42;                              \
+    extern NAME##_signature *const NAME##_avx2;                               \
+    extern NAME##_signature *const NAME##_avx512;                             \
+  } }                                                                         \
+  struct NAME##_dispatch_table                                                \
+  {                                                                           \
+    using signature = psimd::dispatch_targets::NAME##_signature;              \
+                                                                              \
+    static signature *variant(psimd::isa i)                                   \
+    {                                                                         \
+      switch (i) {                                                            \
+      case psimd::isa::avx512: return psimd::dispatch_targets::NAME##_avx512; \
+      case psimd::isa::avx2  : return psimd::dispatch_targets::NAME##_avx2;   \
+      case psimd::isa::sse42 : return psimd::dispatch_targets::NAME##_sse42;  \
+      default                : return psimd::dispatch_targets::NAME##_generic;\
+      }                                                                       \
+    }                                                                         \
+  };                                                                          \
+  static const psimd::dispatched<NAME##_dispatch_table, __VA_ARGS__> NAME{}
+
+PSIMD_NAMESPACE_BEGIN
+
+  template <typename TABLE_T, typename SIG_T>
+  struct dispatched;
+
+  template <typename TABLE_T, typename R, typename... Args>
+  struct dispatched<TABLE_T, R(Args...)>
+  {
+    using function_t = R(*)(Args...);
+
+    R operator()(Args... args) const
+    {
+      return target.load(std::memory_order_relaxed)(
+        std::forward<Args>(args)...
+      );
+    }
+
+    // The variant which is (or will be) called on this host
+    static function_t resolve()
+    {
+      return TABLE_T::variant(selected_isa());
+    }
+
+    // The ISA of the variant which is (or will be) called on this host
+    static isa selected_isa()
+    {
+      return detect_isa();
+    }
+
+  private:
+
+    // First call: resolve the variant, cache it and forward the call
+    static R resolve_and_call(Args... args)
+    {
+      function_t fcn = resolve();
+      target.store(fcn, std::memory_order_relaxed);
+      return fcn(std::forward<Args>(args)...);
+    }
+
+    static std::atomic<function_t> target;
+  };
+
+  template <typename TABLE_T, typename R, typename... Args>
+  std::atomic<R(*)(Args...)> dispatched<TABLE_T, R(Args...)>::target
+  {
+    &dispatched<TABLE_T, R(Args...)>::resolve_and_call
+  };
+
+PSIMD_NAMESPACE_END // ::psimd
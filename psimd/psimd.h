@@ -24,12 +24,41 @@
 
 #pragma once
 
+#include "detail/bitmask.h"
 #include "detail/pack.h"
 
 #include "detail/functions/algorithm.h"
+#include "detail/functions/classify.h"
 #include "detail/functions/math.h"
+#include "detail/functions/transcendental.h"
 #include "detail/functions/memory.h"
 
 #include "detail/operators/arithmetic.h"
+#include "detail/operators/lazy.h"
 #include "detail/operators/bitwise.h"
 #include "detail/operators/logic.h"
+
+#include "detail/native/sse.h"
+#include "detail/native/avx.h"
+#include "detail/native/avx512.h"
+#include "detail/native/blocked.h"
+
+// Built on the native backends' reciprocal estimates //
+
+#include "detail/functions/reciprocal.h"
+#include "detail/functions/precision.h"
+#include "detail/functions/pow.h"
+
+// Built on the native backends' shuffles //
+
+#include "detail/functions/permute.h"
+#include "detail/functions/reduce.h"
+#include "detail/functions/scan.h"
+
+// Built on the native backends' compress stores and expand loads //
+
+#include "detail/functions/compress.h"
+
+// Built on the native backends' gathers, scatters and conflict detection //
+
+#include "detail/functions/scatter_reduce.h"
@@ -0,0 +1,77 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+// Kernel compiled once per dispatch target by psimd_dispatch_sources()
+
+#include "psimd/psimd.h"
+#include "psimd/dispatch.h"
+
+static float dot(float *a, float *b, int n)
+{
+  using vfloat = psimd::pack<float>;
+
+  vfloat sum(0.f);
+
+  int i = 0;
+  for (; i + vfloat::static_size <= n; i += vfloat::static_size) {
+    vfloat va = psimd::load<vfloat>(a + i);
+    vfloat vb = psimd::load<vfloat>(b + i);
+    sum += va * vb;
+  }
+
+  float result = 0.f;
+  for (int j = 0; j < vfloat::static_size; ++j)
+    result += sum[j];
+
+  for (; i < n; ++i)
+    result += a[i] * b[i];
+
+  return result;
+}
+
+static psimd::isa compiled_isa()
+{
+  return psimd::isa::PSIMD_DISPATCH_ISA;
+}
+
+// What the compiler actually targeted: the ISA namespace psimd was built in
+// (see psimd/detail/config.h) and the resulting default float width
+
+#define PSIMD_TEST_STRINGIFY_IMPL(x) #x
+#define PSIMD_TEST_STRINGIFY(x) PSIMD_TEST_STRINGIFY_IMPL(x)
+
+static const char *compiled_namespace()
+{
+  return PSIMD_TEST_STRINGIFY(PSIMD_ISA_NAMESPACE);
+}
+
+static int compiled_float_width()
+{
+  return psimd::pack<float>::static_size;
+}
+
+PSIMD_DISPATCH_EXPORT(dot_kernel, dot)
+PSIMD_DISPATCH_EXPORT(isa_kernel, compiled_isa)
+PSIMD_DISPATCH_EXPORT(namespace_kernel, compiled_namespace)
+PSIMD_DISPATCH_EXPORT(float_width_kernel, compiled_float_width)
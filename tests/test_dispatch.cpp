@@ -0,0 +1,115 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "tests/doctest.h"
+#include "psimd/dispatch.h"
+
+#include <string>
+#include <vector>
+
+PSIMD_DISPATCH_DECLARE(dot_kernel, float(float *, float *, int));
+PSIMD_DISPATCH_DECLARE(isa_kernel, psimd::isa());
+PSIMD_DISPATCH_DECLARE(namespace_kernel, const char *());
+PSIMD_DISPATCH_DECLARE(float_width_kernel, int());
+
+TEST_SUITE_BEGIN("dispatch");
+
+TEST_CASE("detect_isa()")
+{
+  REQUIRE(psimd::detect_isa() == psimd::detect_isa());
+  REQUIRE(std::string(psimd::isa_name(psimd::detect_isa())) != "");
+}
+
+TEST_CASE("dispatched kernel selects the host ISA")
+{
+  REQUIRE(isa_kernel() == psimd::detect_isa());
+  REQUIRE(isa_kernel() == psimd::detect_isa());
+}
+
+TEST_CASE("dispatched kernel results")
+{
+  std::vector<float> a(37), b(37);
+
+  float expected = 0.f;
+  for (int i = 0; i < 37; ++i) {
+    a[i] = float(i);
+    b[i] = 2.f;
+    expected += a[i] * b[i];
+  }
+
+  REQUIRE(dot_kernel(a.data(), b.data(), 37) == expected);
+  REQUIRE(dot_kernel(a.data(), b.data(), 37) == expected);
+}
+
+TEST_CASE("all variants agree")
+{
+  std::vector<float> a(37), b(37);
+
+  for (int i = 0; i < 37; ++i) {
+    a[i] = float(i);
+    b[i] = 2.f;
+  }
+
+  const auto host = psimd::detect_isa();
+
+  for (auto i : {psimd::isa::generic, psimd::isa::sse42,
+                 psimd::isa::avx2, psimd::isa::avx512}) {
+    if (i > host)
+      continue;
+    REQUIRE(dot_kernel_dispatch_table::variant(i)(a.data(), b.data(), 37) ==
+            1332.f);
+  }
+}
+
+TEST_CASE("each variant is compiled for its own ISA")
+{
+  struct expected_variant
+  {
+    psimd::isa isa;
+    const char *ns;
+    int float_width;
+  };
+
+  // the generic variant targets baseline x86-64, which includes SSE2
+  const expected_variant variants[] = {
+    {psimd::isa::generic, "isa_sse2",   4},
+    {psimd::isa::sse42,   "isa_sse42",  4},
+    {psimd::isa::avx2,    "isa_avx2",   8},
+    {psimd::isa::avx512,  "isa_avx512", 16},
+  };
+
+  const auto host = psimd::detect_isa();
+
+  for (const auto &v : variants) {
+    if (v.isa > host)
+      continue;
+    REQUIRE(std::string(namespace_kernel_dispatch_table::variant(v.isa)()) ==
+            v.ns);
+    REQUIRE(float_width_kernel_dispatch_table::variant(v.isa)() ==
+            v.float_width);
+  }
+}
+
+TEST_SUITE_END();
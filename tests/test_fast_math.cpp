@@ -0,0 +1,193 @@
+// ========================================================================== //
+// The MIT License (MIT)                                                      //
+//                                                                            //
+// Copyright (c) 2017 Jefferson Amstutz                                       //
+//                                                                            //
+// Permission is hereby granted, free of charge, to any person obtaining a    //
+// copy of this software and associated documentation files (the "Software"), //
+// to deal in the Software without restriction, including without limitation  //
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,   //
+// and/or sell copies of the Software, and to permit persons to whom the      //
+// Software is furnished to do so, subject to the following conditions:       //
+//                                                                            //
+// The above copyright notice and this permission notice shall be included in //
+// in all copies or substantial portions of the Software.                     //
+//                                                                            //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,   //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL    //
+// THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING    //
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER        //
+// DEALINGS IN THE SOFTWARE.                                                  //
+// ========================================================================== //
+
+// Built with -ffast-math: the classification functions must not rely on
+// floating point compares that the compiler is allowed to fold away
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "tests/doctest.h"
+#include "psimd/psimd.h"
+
+#include <cmath>
+#include <limits>
+
+TEST_SUITE_BEGIN("fast math");
+
+using fast_math_packs = doctest::Types<psimd::pack<float, 4>,
+                                       psimd::pack<float, 8>,
+                                       psimd::pack<float, 16>,
+                                       psimd::pack<double, 2>,
+                                       psimd::pack<double, 4>,
+                                       psimd::pack<double, 8>>;
+
+TEST_CASE_TEMPLATE("classification under -ffast-math", PACK_T, fast_math_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  using vtype  = psimd::pack<T, W>;
+  using limits = std::numeric_limits<T>;
+
+  const T values[4] = {
+    limits::quiet_NaN(), limits::infinity(), T(-0.0), T(-1)
+  };
+
+  vtype x(T(1));
+  for (int i = 0; i < 4 && i < W; ++i)
+    x[i] = values[i];
+
+  const auto nan    = psimd::isnan(x);
+  const auto inf    = psimd::isinf(x);
+  const auto finite = psimd::isfinite(x);
+  const auto sign   = psimd::signbit(x);
+
+  const bool expect_nan[4]    = {true, false, false, false};
+  const bool expect_inf[4]    = {false, true, false, false};
+  const bool expect_finite[4] = {false, false, true, true};
+  const bool expect_sign[4]   = {false, false, true, true};
+
+  for (int i = 0; i < 4 && i < W; ++i) {
+    REQUIRE(bool(nan[i])    == expect_nan[i]);
+    REQUIRE(bool(inf[i])    == expect_inf[i]);
+    REQUIRE(bool(finite[i]) == expect_finite[i]);
+    REQUIRE(bool(sign[i])   == expect_sign[i]);
+  }
+
+  REQUIRE(psimd::all(psimd::copysign(vtype(T(2)), vtype(T(-0.0))) ==
+                     vtype(T(-2))));
+  REQUIRE(psimd::all(psimd::flipsign(vtype(T(-2)), vtype(T(-3))) ==
+                     vtype(T(2))));
+}
+
+// The argument reductions of the transcendentals round to the nearest
+// integer, which must not fold away under -ffast-math either
+
+TEST_CASE_TEMPLATE("transcendentals under -ffast-math", PACK_T, fast_math_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  using vtype = psimd::pack<T, W>;
+
+  const T values[4] = {T(2.3), T(-1.7), T(10.25), T(0.4)};
+
+  vtype x(T(1));
+  for (int i = 0; i < 4 && i < W; ++i)
+    x[i] = values[i];
+
+  const vtype s = psimd::sin(x);
+  const vtype c = psimd::cos(x);
+  const vtype e = psimd::exp(x);
+  const vtype e2 = psimd::exp2(x);
+
+  const T eps = std::numeric_limits<T>::epsilon() * T(8);
+
+  for (int i = 0; i < W; ++i) {
+    REQUIRE(std::abs(s[i] - std::sin(x[i])) <= eps);
+    REQUIRE(std::abs(c[i] - std::cos(x[i])) <= eps);
+    REQUIRE(std::abs(e[i] - std::exp(x[i])) <= eps * std::exp(x[i]));
+    REQUIRE(std::abs(e2[i] - std::exp2(x[i])) <= eps * std::exp2(x[i]));
+  }
+}
+
+// pow() of a negative base takes its sign from whether y is an odd integer
+
+TEST_CASE_TEMPLATE("pow of negative bases under -ffast-math", PACK_T,
+                   fast_math_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  using vtype = psimd::pack<T, W>;
+
+  const T bases[4]     = {T(-2), T(-2), T(-1.5), T(-3)};
+  const T exponents[4] = {T(3), T(2), T(5), T(-1)};
+
+  vtype x(T(-2)), y(T(4));
+  for (int i = 0; i < 4 && i < W; ++i) {
+    x[i] = bases[i];
+    y[i] = exponents[i];
+  }
+
+  const vtype p = psimd::pow(x, y);
+
+  const T eps = std::numeric_limits<T>::epsilon() * T(8);
+
+  for (int i = 0; i < W; ++i) {
+    const T expected = std::pow(x[i], y[i]);
+    REQUIRE(std::abs(p[i] - expected) <= eps * std::abs(expected));
+  }
+}
+
+// rcp() and rsqrt() of 0 and inf, and rcp() of denormals, are exact, where a
+// Newton step (ours or the one the compiler emits for 1 / x) would give NaN
+
+TEST_CASE_TEMPLATE("rcp and rsqrt of 0 and inf under -ffast-math", PACK_T,
+                   fast_math_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  using vtype  = psimd::pack<T, W>;
+  using limits = std::numeric_limits<T>;
+
+  // compared by their bits, as == inf may fold away under -ffast-math
+  auto is_inf = [](const vtype &v, bool negative) {
+    return psimd::all(psimd::isinf(v)) &&
+           (negative ? psimd::all(psimd::signbit(v))
+                     : psimd::none(psimd::signbit(v)));
+  };
+
+  auto is_zero = [](const vtype &v, bool negative) {
+    using vbits = psimd::mask_for<T, W>;
+    using I     = typename vbits::type;
+    const I zero_bits = negative ? std::numeric_limits<I>::min() : I(0);
+    return psimd::all(psimd::bit_cast<vbits>(v) == vbits(zero_bits));
+  };
+
+  const T inf = limits::infinity();
+
+  REQUIRE(is_inf(psimd::rcp(vtype(T(0))), false));
+  REQUIRE(is_inf(psimd::rcp(vtype(T(-0.0))), true));
+  REQUIRE(is_zero(psimd::rcp(vtype(inf)), false));
+  REQUIRE(is_zero(psimd::rcp(vtype(-inf)), true));
+  REQUIRE(is_inf(psimd::rcp(vtype(limits::denorm_min())), false));
+  REQUIRE(is_inf(psimd::rcp(vtype(-limits::denorm_min())), true));
+  REQUIRE(is_inf(psimd::rsqrt(vtype(T(0))), false));
+  REQUIRE(is_zero(psimd::rsqrt(vtype(inf)), false));
+
+  vtype x(T(4));
+  x[0] = T(0);
+  const vtype r = psimd::rcp(x);
+  const vtype s = psimd::rsqrt(x);
+
+  REQUIRE(psimd::isinf(r)[0]);
+  REQUIRE(psimd::isinf(s)[0]);
+  for (int i = 1; i < W; ++i) {
+    REQUIRE(std::abs(r[i] - T(0.25)) <= T(1e-6));
+    REQUIRE(std::abs(s[i] - T(0.5))  <= T(1e-6));
+  }
+}
+
+TEST_SUITE_END();
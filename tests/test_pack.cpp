@@ -27,11 +27,45 @@
 #include "psimd/psimd.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <vector>
 
 using vfloat = psimd::pack<float>;
 using vint   = psimd::pack<int>;
-using vmask  = psimd::mask<DEFAULT_WIDTH>;
+using vmask  = psimd::mask<>;
+
+// pack<> types the functions are checked with: the native and a
+// register-blocked width of each element type, plus partial widths //
+
+#define FLOATING_POINT_PACKS                                                   \
+  psimd::pack<float, 4>,                                                       \
+  psimd::pack<float, 8>,                                                       \
+  psimd::pack<float, 16>,                                                      \
+  psimd::pack<float, 4 * psimd::native_width<float>()>,                        \
+  psimd::pack<double, 2>,                                                      \
+  psimd::pack<double, 4>,                                                      \
+  psimd::pack<double, 8>,                                                      \
+  psimd::pack<double, 4 * psimd::native_width<double>()>
+
+#define INTEGER_PACKS                                                          \
+  psimd::pack<int, 4>,                                                         \
+  psimd::pack<int, 8>,                                                         \
+  psimd::pack<int, 16>,                                                        \
+  psimd::pack<int, 4 * psimd::native_width<int>()>,                            \
+  psimd::pack<long long, 2>,                                                   \
+  psimd::pack<long long, 4>,                                                   \
+  psimd::pack<long long, 8>
+
+using floating_point_packs =
+    doctest::Types<psimd::pack<float, 3>, FLOATING_POINT_PACKS>;
+
+using all_packs =
+    doctest::Types<psimd::pack<float, 3>, psimd::pack<int, 5>,
+                   FLOATING_POINT_PACKS, INTEGER_PACKS>;
+
+using even_width_packs =
+    doctest::Types<psimd::pack<int, 6>, FLOATING_POINT_PACKS, INTEGER_PACKS>;
 
 /* TODO: add tests for -->
  *         - operator<<()
@@ -41,6 +75,28 @@ using vmask  = psimd::mask<DEFAULT_WIDTH>;
  *         - store()
  */
 
+// pack<> layout //////////////////////////////////////////////////////////////
+
+static_assert(alignof(psimd::pack<float, 4>)  == 16, "pack<float, 4>");
+static_assert(alignof(psimd::pack<float, 8>)  == 32, "pack<float, 8>");
+static_assert(alignof(psimd::pack<float, 16>) == 64, "pack<float, 16>");
+static_assert(alignof(psimd::pack<double, 16>) == PSIMD_MAX_ALIGNMENT,
+              "pack<> alignment is capped");
+static_assert(alignof(psimd::pack<char, 4>)  == 4,  "pack<char, 4>");
+static_assert(sizeof(psimd::pack<float, 3>) == 16, "pack<float, 3> size");
+static_assert(alignof(vfloat) == vfloat::static_alignment,
+              "pack<> alignment matches pack_alignment<>");
+static_assert(vfloat::static_size == DEFAULT_WIDTH,
+              "DEFAULT_WIDTH is the default width of pack<float>");
+#if !PSIMD_USER_DEFAULT_WIDTH
+static_assert(vfloat::static_size == psimd::native_width<float>(),
+              "pack<float> defaults to the native width");
+static_assert(psimd::pack<double>::static_size * 2 == vfloat::static_size,
+              "pack<double> fills the same register as pack<float>");
+static_assert(psimd::pack<char>::static_size == 4 * vfloat::static_size,
+              "pack<char> fills the same register as pack<float>");
+#endif
+
 // pack<> arithmetic operators ////////////////////////////////////////////////
 
 TEST_SUITE_BEGIN("arithmetic operators");
@@ -209,6 +265,108 @@ TEST_CASE("binary operator^()")
   REQUIRE(psimd::all((2 ^ v1)  == vint(3)));
 }
 
+TEST_CASE("binary operator&()")
+{
+  vint v1(3);
+  vint v2(6);
+
+  REQUIRE(psimd::all((v1 & v2) == vint(2)));
+  REQUIRE(psimd::all((v1 & 6)  == vint(2)));
+  REQUIRE(psimd::all((6 & v1)  == vint(2)));
+}
+
+TEST_CASE("binary operator|()")
+{
+  vint v1(3);
+  vint v2(6);
+
+  REQUIRE(psimd::all((v1 | v2) == vint(7)));
+  REQUIRE(psimd::all((v1 | 6)  == vint(7)));
+  REQUIRE(psimd::all((6 | v1)  == vint(7)));
+}
+
+TEST_CASE("unary operator~() and andnot()")
+{
+  vint v1(3);
+  vint v2(6);
+
+  REQUIRE(psimd::all(~v1 == vint(~3)));
+  REQUIRE(psimd::all(psimd::andnot(v1, v2) == vint(1)));
+  REQUIRE(psimd::all(psimd::andnot(v2, v1) == vint(4)));
+}
+
+TEST_CASE("compound bitwise assignments")
+{
+  vint v(12);
+
+  v &= vint(10);
+  REQUIRE(psimd::all(v == vint(8)));
+  v |= 3;
+  REQUIRE(psimd::all(v == vint(11)));
+  v ^= vint(1);
+  REQUIRE(psimd::all(v == vint(10)));
+  v <<= 2;
+  REQUIRE(psimd::all(v == vint(40)));
+  v >>= vint(3);
+  REQUIRE(psimd::all(v == vint(5)));
+}
+
+template <int W>
+inline void check_variable_shifts()
+{
+  psimd::pack<int, W> v(-64), counts;
+
+  for (int i = 0; i < W; ++i)
+    counts[i] = i % 8;
+
+  const psimd::pack<int, W> left  = v << counts;
+  const psimd::pack<int, W> right = v >> counts;
+
+  for (int i = 0; i < W; ++i) {
+    REQUIRE(left[i]  == int(-64 * (1 << (i % 8))));
+    REQUIRE(right[i] == (-64 >> (i % 8)));
+  }
+}
+
+TEST_CASE("per-lane shift counts")
+{
+  check_variable_shifts<3>();
+  check_variable_shifts<4>();
+  check_variable_shifts<8>();
+  check_variable_shifts<16>();
+  check_variable_shifts<4 * psimd::native_width<int>()>();
+}
+
+TEST_CASE_TEMPLATE("bitwise operators on float and double packs", PACK_T,
+                   floating_point_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  using vtype = psimd::pack<T, W>;
+
+  const vtype x(T(-2.5)), sign(T(-0.0));
+
+  REQUIRE(psimd::all(psimd::andnot(x, sign) == vtype(T(2.5))));
+  REQUIRE(psimd::all((x & sign) == sign));
+  REQUIRE(psimd::all((psimd::abs(x) | sign) == x));
+  REQUIRE(psimd::all((x ^ sign) == vtype(T(2.5))));
+  REQUIRE(psimd::all(~(~x) == x));
+
+  // blend through a mask reinterpreted as lane bits
+  psimd::mask_for<T, W> m(0);
+  m[0] = -1;
+
+  const vtype bits = psimd::bit_cast<vtype>(m);
+  const vtype blend = (bits & x) | psimd::andnot(vtype(T(1)), bits);
+  REQUIRE(blend[0] == T(-2.5));
+  REQUIRE(blend[W - 1] == T(1));
+
+  vtype y = x;
+  y ^= sign;
+  REQUIRE(psimd::all(y == vtype(T(2.5))));
+}
+
 TEST_SUITE_END();
 
 // pack<> logic operators /////////////////////////////////////////////////////
@@ -312,6 +470,84 @@ TEST_CASE("unary operator!()")
   REQUIRE(psimd::all(!v == vmask(false)));
 }
 
+TEST_CASE("mask_for<> lane widths")
+{
+  using vdouble = psimd::pack<double>;
+
+  bool value = std::is_same<decltype(vdouble(1.0) < vdouble(2.0)),
+                            psimd::pack<long long>>::value;
+  value &= std::is_same<decltype(vfloat(1.f) < vfloat(2.f)), vmask>::value;
+  REQUIRE(value);
+
+  vdouble v1(1.0), v2(2.0);
+  v1[0] = 3.0;
+
+  auto m = v1 < v2;
+
+  REQUIRE(psimd::any(m));
+  REQUIRE(!psimd::all(m));
+  REQUIRE(psimd::all(m || !m));
+  REQUIRE(psimd::none(m && !m));
+
+  auto result = psimd::select(m, v1, v2);
+  REQUIRE(result[0] == 2.0);
+  REQUIRE(result[1] == 1.0);
+}
+
+template <int W>
+inline void check_mask_cast()
+{
+  psimd::mask<W> m(0);
+  m[0] = 1;
+
+  auto wide = psimd::mask_cast<double>(m);
+  REQUIRE(wide[0] == -1);
+  REQUIRE(wide[1] == 0);
+
+  auto narrow = psimd::mask_cast<float>(wide);
+  REQUIRE(narrow[0] == -1);
+  REQUIRE(narrow[1] == 0);
+}
+
+TEST_CASE("mask_cast()")
+{
+  check_mask_cast<2>();
+  check_mask_cast<4>();
+  check_mask_cast<8>();
+  check_mask_cast<16>();
+}
+
+template <int W>
+inline void check_bit_cast()
+{
+  psimd::pack<float, W> f(1.f);
+  f[0] = -0.f;
+
+  auto i = psimd::bit_cast<psimd::pack<int, W>>(f);
+  REQUIRE(i[0] == std::numeric_limits<int>::min());
+  REQUIRE(i[W - 1] == 0x3f800000);
+  REQUIRE(psimd::all(psimd::bit_cast<psimd::pack<float, W>>(i) == f));
+
+  psimd::pack<double, W> d(-2.0);
+
+  auto l = psimd::bit_cast<psimd::pack<long long, W>>(d);
+  REQUIRE(l[0] == (long long) 0xc000000000000000ull);
+  REQUIRE(psimd::all(psimd::bit_cast<psimd::pack<double, W>>(l) == d));
+
+  // as<>() converts values instead, also on const packs
+  const psimd::pack<int, W> ci(3);
+  REQUIRE(psimd::all(ci.template as<float>() == psimd::pack<float, W>(3.f)));
+}
+
+TEST_CASE("bit_cast<>()")
+{
+  check_bit_cast<2>();
+  check_bit_cast<4>();
+  check_bit_cast<8>();
+  check_bit_cast<16>();
+  check_bit_cast<4 * psimd::native_width<float>()>();
+}
+
 TEST_CASE("unary operator-()")
 {
   vint v1(2);
@@ -340,25 +576,578 @@ TEST_CASE("sqrt()")
   REQUIRE(psimd::all((v1) == vfloat(2.f)));
 }
 
+// Distance in units in the last place of 'expected' (NaNs and infinities
+// must match exactly)
+template <typename T>
+inline double ulp_error(T actual, long double reference)
+{
+  const T expected = T(reference);
+
+  if (std::isnan(expected) || std::isnan(actual))
+    return std::isnan(expected) && std::isnan(actual) ? 0.0 : 1e9;
+  if (std::isinf(expected) || std::isinf(actual))
+    return expected == actual ? 0.0 : 1e9;
+
+  const T magnitude = std::max(std::abs(expected),
+                               std::numeric_limits<T>::min());
+  const T ulp = std::nextafter(magnitude, std::numeric_limits<T>::infinity())
+                - magnitude;
+
+  return double(std::abs((long double)actual - reference) / ulp);
+}
+
+// Check fcn() lane by lane against ref(), computed in long double, over a
+// set of inputs which covers the lanes of several packs
+template <typename T, int W, typename FCN_T, typename REF_T>
+inline void check_ulp(const std::vector<T> &inputs,
+                      FCN_T fcn, REF_T ref, double max_ulps)
+{
+  using vtype = psimd::pack<T, W>;
+
+  for (size_t base = 0; base < inputs.size(); base += W) {
+    vtype v;
+    for (int i = 0; i < W; ++i)
+      v[i] = inputs[(base + i) % inputs.size()];
+
+    const vtype r = fcn(v);
+
+    for (int i = 0; i < W; ++i) {
+      INFO("x = " << v[i] << ", result = " << r[i]);
+      REQUIRE(ulp_error(r[i], ref((long double)v[i])) <= max_ulps);
+    }
+  }
+}
+
+template <typename T>
+inline std::vector<T> sample_range(T lo, T hi, int count = 997)
+{
+  std::vector<T> values;
+  for (int i = 0; i < count; ++i)
+    values.push_back(lo + (hi - lo) * (T(i) / T(count - 1)));
+  return values;
+}
+
+template <typename T>
+inline std::vector<T> with_specials(std::vector<T> values)
+{
+  using limits = std::numeric_limits<T>;
+
+  values.push_back(T(0));
+  values.push_back(limits::infinity());
+  values.push_back(-limits::infinity());
+  values.push_back(limits::quiet_NaN());
+  return values;
+}
+
 TEST_CASE("sin()")
 {
   vfloat v1(4.f);
   v1 = psimd::sin(v1);
-  REQUIRE(psimd::all((v1) == vfloat(sin(4.f))));
+  REQUIRE(psimd::all(psimd::abs(vfloat(v1 - std::sin(4.f))) < 1e-6f));
 }
 
 TEST_CASE("cos()")
 {
   vfloat v1(4.f);
   v1 = psimd::cos(v1);
-  REQUIRE(psimd::all((v1) == vfloat(cos(4.f))));
+  REQUIRE(psimd::all(psimd::abs(vfloat(v1 - std::cos(4.f))) < 1e-6f));
 }
 
 TEST_CASE("tan()")
 {
   vfloat v1(4.f);
   v1 = psimd::tan(v1);
-  REQUIRE(psimd::all((v1) == vfloat(tan(4.f))));
+  REQUIRE(psimd::all(psimd::abs(vfloat(v1 - std::tan(4.f))) < 1e-6f));
+}
+
+TEST_CASE_TEMPLATE("transcendental functions", PACK_T, floating_point_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  using vtype = psimd::pack<T, W>;
+
+  // bounds documented in psimd/detail/functions/transcendental.h, plus the
+  // error of the reference at long double precision
+
+  const auto exp_inputs = with_specials(sample_range(T(-120), T(120)));
+  check_ulp<T, W>(exp_inputs, [](const vtype &v){ return psimd::exp(v); },
+                  [](long double x){ return std::exp(x); }, 2);
+  check_ulp<T, W>(exp_inputs, [](const vtype &v){ return psimd::exp2(v); },
+                  [](long double x){ return std::exp2(x); }, 2);
+
+  auto log_inputs = with_specials(sample_range(T(0.01), T(100)));
+  log_inputs.push_back(T(-1));
+  log_inputs.push_back(std::numeric_limits<T>::denorm_min());
+  log_inputs.push_back(std::numeric_limits<T>::max());
+  check_ulp<T, W>(log_inputs, [](const vtype &v){ return psimd::log(v); },
+                  [](long double x){ return std::log(x); }, 1.5);
+  check_ulp<T, W>(log_inputs, [](const vtype &v){ return psimd::log2(v); },
+                  [](long double x){ return std::log2(x); }, 1.5);
+
+  auto trig_inputs = with_specials(sample_range(T(-100), T(100)));
+  trig_inputs.push_back(T(1e6));
+  trig_inputs.push_back(T(2e9)); // beyond the reduction range
+  check_ulp<T, W>(trig_inputs, [](const vtype &v){ return psimd::sin(v); },
+                  [](long double x){ return std::sin(x); }, 2.5);
+  check_ulp<T, W>(trig_inputs, [](const vtype &v){ return psimd::cos(v); },
+                  [](long double x){ return std::cos(x); }, 2.5);
+  check_ulp<T, W>(trig_inputs, [](const vtype &v){ return psimd::tan(v); },
+                  [](long double x){ return std::tan(x); }, 4.5);
+
+  check_ulp<T, W>(trig_inputs, [](const vtype &v){
+                    vtype s, c;
+                    psimd::sincos(v, s, c);
+                    return vtype(s * s + c * c);
+                  },
+                  [](long double x){
+                    return std::isfinite(x) ? 1.0L : std::sin(x);
+                  }, 4);
+
+  const auto atan_inputs = with_specials(sample_range(T(-20), T(20)));
+  check_ulp<T, W>(atan_inputs, [](const vtype &v){ return psimd::atan(v); },
+                  [](long double x){ return std::atan(x); }, 3);
+  check_ulp<T, W>(atan_inputs,
+                  [](const vtype &v){ return psimd::atan2(v, vtype(T(-3))); },
+                  [](long double x){ return std::atan2(x, -3.0L); },
+                  3);
+  check_ulp<T, W>(atan_inputs,
+                  [](const vtype &v){ return psimd::atan2(vtype(T(-3)), v); },
+                  [](long double x){ return std::atan2(-3.0L, x); },
+                  3);
+
+  auto asin_inputs = sample_range(T(-1), T(1));
+  asin_inputs.push_back(T(1.5));
+  asin_inputs.push_back(std::numeric_limits<T>::quiet_NaN());
+  check_ulp<T, W>(asin_inputs, [](const vtype &v){ return psimd::asin(v); },
+                  [](long double x){ return std::asin(x); }, 2.5);
+  check_ulp<T, W>(asin_inputs, [](const vtype &v){ return psimd::acos(v); },
+                  [](long double x){ return std::acos(x); }, 2.5);
+
+  // odd functions keep the sign of zero, as the standard library does
+
+  const vtype zero(T(0)), negative_zero(T(-0.0));
+
+  for (const vtype &v : {psimd::sin(negative_zero), psimd::tan(negative_zero),
+                         psimd::atan(negative_zero),
+                         psimd::asin(negative_zero)}) {
+    REQUIRE(psimd::all(v == T(0)));
+    REQUIRE(psimd::all(psimd::signbit(v)));
+  }
+
+  for (const vtype &v : {psimd::sin(zero), psimd::tan(zero),
+                         psimd::atan(zero), psimd::asin(zero)}) {
+    REQUIRE(psimd::all(v == T(0)));
+    REQUIRE(psimd::none(psimd::signbit(v)));
+  }
+}
+
+TEST_CASE("atan2() quadrants")
+{
+  using psimd::atan2;
+
+  const float pi = 3.14159265f;
+
+  REQUIRE(atan2(vfloat(1.f), vfloat(1.f))[0]   == doctest::Approx(pi / 4));
+  REQUIRE(atan2(vfloat(1.f), vfloat(-1.f))[0]  == doctest::Approx(3 * pi / 4));
+  REQUIRE(atan2(vfloat(-1.f), vfloat(-1.f))[0] == doctest::Approx(-3 * pi / 4));
+  REQUIRE(atan2(vfloat(-1.f), vfloat(1.f))[0]  == doctest::Approx(-pi / 4));
+  REQUIRE(atan2(vfloat(1.f), vfloat(0.f))[0]   == doctest::Approx(pi / 2));
+  REQUIRE(atan2(vfloat(0.f), vfloat(-1.f))[0]  == doctest::Approx(pi));
+  REQUIRE(atan2(vfloat(0.f), vfloat(0.f))[0]   == 0.f);
+}
+
+TEST_CASE_TEMPLATE("precision policies", PACK_T, floating_point_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  // fast sqrt() and divide() are exact without a hardware estimate
+  const double fast_ulps =
+      psimd::detail::has_native_estimate<T, W>::value
+          ? (sizeof(T) == 4 ? 4 : 3) : 0.5;
+
+  using vtype = psimd::pack<T, W>;
+  using psimd::precision::exact;
+  using psimd::precision::accurate;
+  using psimd::precision::fast;
+
+  // exact: bit for bit the standard library and IEEE-754 results
+
+  const auto inputs = with_specials(sample_range(T(-50), T(50)));
+
+  for (size_t base = 0; base < inputs.size(); base += W) {
+    vtype v;
+    for (int i = 0; i < W; ++i)
+      v[i] = inputs[(base + i) % inputs.size()];
+
+    const vtype s = psimd::sin<exact>(v);
+    const vtype c = psimd::cos<exact>(v);
+    const vtype p = psimd::pow<exact>(vtype(T(1.5)), v);
+    const vtype d = psimd::divide<exact>(T(1), v);
+
+    for (int i = 0; i < W; ++i) {
+      INFO("x = " << v[i]);
+      REQUIRE(ulp_error(s[i], std::sin(v[i])) == 0.0);
+      REQUIRE(ulp_error(c[i], std::cos(v[i])) == 0.0);
+      REQUIRE(ulp_error(p[i], std::pow(T(1.5), v[i])) == 0.0);
+      REQUIRE(ulp_error(d[i], T(1) / v[i]) == 0.0);
+    }
+  }
+
+  // bounds documented in psimd/detail/functions/precision.h
+
+  auto positive = with_specials(sample_range(T(1e-3), T(1e3)));
+  check_ulp<T, W>(positive,
+                  [](const vtype &v){ return psimd::divide<fast>(T(3), v); },
+                  [](long double x){ return 3 / x; }, fast_ulps);
+
+  positive.push_back(std::numeric_limits<T>::max());
+  check_ulp<T, W>(positive, [](const vtype &v){ return psimd::sqrt<fast>(v); },
+                  [](long double x){ return std::sqrt(x); }, fast_ulps);
+  check_ulp<T, W>(positive,
+                  [](const vtype &v){ return psimd::sqrt<accurate>(v); },
+                  [](long double x){ return std::sqrt(x); }, 0.5);
+
+  const auto trig_inputs = sample_range(T(-3), T(3));
+  check_ulp<T, W>(trig_inputs,
+                  [](const vtype &v){ return psimd::sin<fast>(v); },
+                  [](long double x){ return std::sin(x); }, 4);
+  check_ulp<T, W>(trig_inputs,
+                  [](const vtype &v){ return psimd::cos<fast>(v); },
+                  [](long double x){ return std::cos(x); }, 4);
+
+  // |y log2(x)| stays below 10 over these inputs
+  const auto exponents = with_specials(sample_range(T(-10), T(10)));
+  check_ulp<T, W>(exponents,
+                  [](const vtype &v){
+                    return psimd::pow<fast>(vtype(T(1.9)), v);
+                  },
+                  [](long double x){ return std::pow((long double)T(1.9), x); },
+                  12);
+  check_ulp<T, W>(exponents,
+                  [](const vtype &v){
+                    return psimd::pow<accurate>(vtype(T(1.9)), v);
+                  },
+                  [](long double x){ return std::pow((long double)T(1.9), x); },
+                  1);
+}
+
+TEST_CASE_TEMPLATE("rcp()/rsqrt()/rcp_fast()/rsqrt_fast()", PACK_T,
+                   floating_point_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  const bool is_float = sizeof(T) == 4;
+
+  const double rcp_ulps   = is_float ? 3 : 1;
+  const double rsqrt_ulps = is_float ? 4 : 2.5;
+
+  // packs without a hardware estimate compute 1 / x and 1 / sqrt(x)
+  const double estimate_error =
+      (psimd::detail::has_native_estimate<T, W>::value
+           ? 1.6 * std::ldexp(1.0, -12) : 0) + (is_float ? 1e-7 : 1e-15);
+
+  using vtype = psimd::pack<T, W>;
+
+  // bounds documented in psimd/detail/functions/reciprocal.h
+
+  auto inputs = with_specials(sample_range(T(1e-3), T(1e3)));
+  inputs.push_back(T(1e-30));
+  inputs.push_back(T(1e30));
+
+  check_ulp<T, W>(inputs, [](const vtype &v){ return psimd::rcp(v); },
+                  [](long double x){ return 1 / x; }, rcp_ulps);
+  check_ulp<T, W>(inputs, [](const vtype &v){ return psimd::rsqrt(v); },
+                  [](long double x){ return 1 / std::sqrt(x); }, rsqrt_ulps);
+
+  REQUIRE(psimd::all(psimd::rcp(vtype(T(-0.0))) ==
+                     vtype(-std::numeric_limits<T>::infinity())));
+
+  // denormals, which the hardware estimates flush to zero
+  const T denormal = std::numeric_limits<T>::denorm_min();
+  const vtype inf(std::numeric_limits<T>::infinity());
+
+  REQUIRE(psimd::all(psimd::rcp(vtype(denormal)) == inf));
+  REQUIRE(psimd::all(psimd::rcp(vtype(-denormal)) == -inf));
+  REQUIRE(psimd::all(psimd::divide<psimd::precision::fast>(
+                         vtype(T(2)), vtype(-denormal)) == -inf));
+
+  for (size_t base = 0; base < inputs.size(); base += W) {
+    vtype v;
+    for (int i = 0; i < W; ++i)
+      v[i] = std::abs(inputs[(base + i) % inputs.size()]);
+
+    const vtype r = psimd::rcp_fast(v);
+    const vtype s = psimd::rsqrt_fast(v);
+
+    for (int i = 0; i < W; ++i) {
+      if (v[i] == T(0) || !std::isfinite(v[i]))
+        continue;
+      INFO("x = " << v[i]);
+      REQUIRE(std::abs(r[i] * v[i] - T(1)) <= estimate_error);
+      REQUIRE(std::abs(s[i] * std::sqrt(v[i]) - T(1)) <= estimate_error);
+    }
+  }
+}
+
+TEST_CASE_TEMPLATE("pow<N>()/powi()", PACK_T, floating_point_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  using vtype = psimd::pack<T, W>;
+
+  const auto inputs = sample_range(T(0.5), T(2));
+
+  // bounds documented in psimd/detail/functions/pow.h
+  check_ulp<T, W>(inputs, [](const vtype &v){ return psimd::pow<8>(v); },
+                  [](long double x){ return std::pow(x, 8); }, 5.5);
+  check_ulp<T, W>(inputs, [](const vtype &v){ return psimd::pow<-8>(v); },
+                  [](long double x){ return std::pow(x, -8); }, 7.5);
+  check_ulp<T, W>(inputs, [](const vtype &v){ return psimd::powi(v, 5); },
+                  [](long double x){ return std::pow(x, 5); }, 3.5);
+  check_ulp<T, W>(inputs, [](const vtype &v){ return psimd::powi(v, -3); },
+                  [](long double x){ return std::pow(x, -3); }, 3);
+
+  for (int n = -8; n <= 8; ++n) {
+    INFO("n = " << n);
+    const vtype x(T(1.5));
+    REQUIRE(psimd::all(psimd::pow(x, n) == psimd::powi(x, n)));
+    REQUIRE(psimd::all(psimd::pow(x, T(n)) == psimd::powi(x, n)));
+  }
+
+  REQUIRE(psimd::all(psimd::pow<0>(vtype(T(3))) == vtype(T(1))));
+  REQUIRE(psimd::all(psimd::pow<1>(vtype(T(3))) == vtype(T(3))));
+  REQUIRE(psimd::all(psimd::pow<3>(vtype(T(-3))) == vtype(T(-27))));
+  REQUIRE(psimd::all(psimd::powi(vtype(T(-3)), 3) == vtype(T(-27))));
+  REQUIRE(psimd::all(psimd::powi(vtype(T(2)), -2) == vtype(T(0.25))));
+  REQUIRE(psimd::all(psimd::powi(vtype(T(0)), 0) == vtype(T(1))));
+}
+
+TEST_CASE("pow<N>()/powi() of int packs")
+{
+  REQUIRE(psimd::all(psimd::pow<3>(vint(2)) == vint(8)));
+  REQUIRE(psimd::all(psimd::powi(vint(-2), 3) == vint(-8)));
+}
+
+TEST_CASE("pow()")
+{
+  using psimd::precision::accurate;
+
+  vfloat x, y;
+  for (int i = 0; i < vfloat::static_size; ++i) {
+    x[i] = 0.25f + 0.5f * i;
+    y[i] = -2.f + 0.75f * i;
+  }
+
+  // per-lane exponents and non-integral scalar exponents are the accurate
+  // policy, lane types other than float and double use std::pow()
+  REQUIRE(psimd::all(psimd::pow(x, y) == psimd::pow<accurate>(x, y)));
+  REQUIRE(psimd::all(psimd::pow(x, 1.f / 2.2f) ==
+                     psimd::pow<accurate>(x, 1.f / 2.2f)));
+  REQUIRE(psimd::all(psimd::pow(vint(3), 2.f) == vint(9)));
+}
+
+TEST_CASE("pow() special cases")
+{
+  using psimd::precision::exact;
+  using psimd::precision::accurate;
+  using psimd::precision::fast;
+  using limits = std::numeric_limits<float>;
+
+  const std::vector<float> values = {
+    0.f, -0.f, 1.f, -1.f, 2.f, -2.f, 0.5f, -0.5f, 3.f, -3.f, 2.5f,
+    8388609.f, limits::infinity(), -limits::infinity(), limits::quiet_NaN()
+  };
+
+  for (float x : values) {
+    for (float y : values) {
+      const float expected = std::pow(x, y);
+      const float f = psimd::pow<fast>(vfloat(x), vfloat(y))[0];
+      const float a = psimd::pow<accurate>(vfloat(x), vfloat(y))[0];
+      const float e = psimd::pow<exact>(vfloat(x), vfloat(y))[0];
+
+      // the fast version loses about 1 ulp per unit of |y log2(x)|
+      const double magnitude = std::abs(double(y) * std::log2(std::abs(x)));
+      const double fast_ulps = 2 + (std::isfinite(magnitude) ? magnitude : 0);
+
+      INFO("pow(" << x << ", " << y << ") = " << expected);
+      REQUIRE(ulp_error(f, expected) <= fast_ulps);
+      REQUIRE(ulp_error(a, expected) <= 0.5);
+      REQUIRE(ulp_error(e, expected) == 0.0);
+      if (!std::isnan(expected))
+        REQUIRE(std::signbit(f) == std::signbit(expected));
+    }
+  }
+}
+
+template <typename T>
+inline bool same_value(T a, T b)
+{
+  return (std::isnan(a) && std::isnan(b)) ||
+         (a == b && std::signbit(a) == std::signbit(b));
+}
+
+template <typename T>
+inline int expected_int(T integral)
+{
+  return integral >= T(-2147483648.0) && integral < T(2147483648.0) ?
+      int(integral) : std::numeric_limits<int>::min();
+}
+
+TEST_CASE_TEMPLATE("floor()/ceil()/trunc()/round()/nearbyint()/frac()", PACK_T,
+                   floating_point_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  using vtype = psimd::pack<T, W>;
+
+  const T inf = std::numeric_limits<T>::infinity();
+  const T big = T(1) / std::numeric_limits<T>::epsilon();
+
+  const std::vector<T> values = {
+    T(0), T(-0.0), T(0.25), T(-0.25), T(0.5), T(-0.5), T(0.75), T(1.5),
+    T(-1.5), T(2.5), T(-2.5), T(3.49), T(-3.51), T(41.9), T(-41.9),
+    big - T(0.5), -big + T(0.5), big * T(3), T(3e9), T(-3e9),
+    T(2147483520.0), T(-2147483648.0), T(-0.3), T(1073741824.5),
+    T(-1073741825.5), T(3e9 + 0.5), T(-1e15 - 0.5), inf, -inf,
+    std::numeric_limits<T>::quiet_NaN()
+  };
+
+  for (size_t first = 0; first < values.size(); first += W) {
+    vtype x(T(0.5));
+    for (int i = 0; i < W && first + i < values.size(); ++i)
+      x[i] = values[first + i];
+
+    const vtype fl = psimd::floor(x);
+    const vtype ce = psimd::ceil(x);
+    const vtype tr = psimd::trunc(x);
+    const vtype ro = psimd::round(x);
+    const vtype ne = psimd::nearbyint(x);
+    const vtype fr = psimd::frac(x);
+
+    const psimd::pack<int, W> ri = psimd::to_int_round(x);
+    const psimd::pack<int, W> ti = psimd::to_int_trunc(x);
+
+    for (int i = 0; i < W; ++i) {
+      CAPTURE(x[i]);
+      REQUIRE(same_value(fl[i], std::floor(x[i])));
+      REQUIRE(same_value(ce[i], std::ceil(x[i])));
+      REQUIRE(same_value(tr[i], std::trunc(x[i])));
+      REQUIRE(same_value(ro[i], std::round(x[i])));
+      REQUIRE(same_value(ne[i], std::nearbyint(x[i])));
+      if (std::isfinite(x[i]))
+        REQUIRE(same_value(fr[i], T(x[i] - std::floor(x[i]))));
+      REQUIRE(ri[i] == expected_int(std::nearbyint(x[i])));
+      REQUIRE(ti[i] == expected_int(std::trunc(x[i])));
+    }
+  }
+}
+
+TEST_CASE("to_int_round()/to_int_trunc() rounding semantics")
+{
+  const vfloat x(2.5f), y(-3.5f), z(-0.7f);
+
+  REQUIRE(psimd::all(psimd::to_int_round(x) == vint(2)));
+  REQUIRE(psimd::all(psimd::to_int_round(y) == vint(-4)));
+  REQUIRE(psimd::all(psimd::to_int_round(z) == vint(-1)));
+  REQUIRE(psimd::all(psimd::to_int_trunc(x) == vint(2)));
+  REQUIRE(psimd::all(psimd::to_int_trunc(y) == vint(-3)));
+  REQUIRE(psimd::all(psimd::to_int_trunc(z) == vint(0)));
+  REQUIRE(psimd::all(psimd::round(y) == vfloat(-4.f)));
+}
+
+TEST_CASE_TEMPLATE(
+    "isnan()/isinf()/isfinite()/signbit()/copysign()/flipsign()",
+    PACK_T, floating_point_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  using vtype = psimd::pack<T, W>;
+  using limits = std::numeric_limits<T>;
+
+  const std::vector<T> values = {
+    T(0), T(-0.0), T(1), T(-2.5), limits::max(), limits::lowest(),
+    limits::min(), limits::denorm_min(), -limits::denorm_min(),
+    limits::infinity(), -limits::infinity(), limits::quiet_NaN(),
+    -limits::quiet_NaN(), limits::signaling_NaN()
+  };
+
+  for (size_t first = 0; first < values.size(); first += W) {
+    vtype x(T(1)), y(T(-3));
+    for (int i = 0; i < W && first + i < values.size(); ++i) {
+      x[i] = values[first + i];
+      y[i] = values[values.size() - 1 - (first + i)];
+    }
+
+    const auto nan    = psimd::isnan(x);
+    const auto inf    = psimd::isinf(x);
+    const auto finite = psimd::isfinite(x);
+    const auto sign   = psimd::signbit(x);
+
+    const vtype copied  = psimd::copysign(x, y);
+    const vtype flipped = psimd::flipsign(x, y);
+
+    for (int i = 0; i < W; ++i) {
+      CAPTURE(x[i]);
+      REQUIRE(bool(nan[i])    == std::isnan(x[i]));
+      REQUIRE(bool(inf[i])    == std::isinf(x[i]));
+      REQUIRE(bool(finite[i]) == std::isfinite(x[i]));
+      REQUIRE(bool(sign[i])   == std::signbit(x[i]));
+
+      REQUIRE(same_value(copied[i], std::copysign(x[i], y[i])));
+      REQUIRE(same_value(flipped[i],
+                         std::signbit(y[i]) ? T(-x[i]) : x[i]));
+    }
+  }
+}
+
+TEST_CASE_TEMPLATE("fma()/fms()/fnma()/fnms()", PACK_T, floating_point_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  using vtype = psimd::pack<T, W>;
+
+  vtype a(T(2)), b(T(3)), c(T(1));
+
+  REQUIRE(psimd::all(psimd::fma(a, b, c)  == vtype(T(7))));
+  REQUIRE(psimd::all(psimd::fms(a, b, c)  == vtype(T(5))));
+  REQUIRE(psimd::all(psimd::fnma(a, b, c) == vtype(T(-5))));
+  REQUIRE(psimd::all(psimd::fnms(a, b, c) == vtype(T(-7))));
+
+  REQUIRE(psimd::all(psimd::fma(a, b, T(1)) == vtype(T(7))));
+  REQUIRE(psimd::all(psimd::fma(a, T(3), c) == vtype(T(7))));
+  REQUIRE(psimd::all(psimd::fma(T(2), b, c) == vtype(T(7))));
+  REQUIRE(psimd::all(psimd::fnms(a, b, T(1)) == vtype(T(-7))));
+}
+
+TEST_CASE("fma() rounds once")
+{
+  const float x = 1.f + std::ldexp(1.f, -12);
+  const float y = -(1.f + std::ldexp(1.f, -11));
+
+  // x * x rounds to -y, so only a fused operation keeps the low bits
+  REQUIRE(psimd::all(psimd::fma(vfloat(x), vfloat(x), vfloat(y)) ==
+                     vfloat(std::ldexp(1.f, -24))));
+  REQUIRE(psimd::all(psimd::fms(vfloat(x), vfloat(x), vfloat(-y)) ==
+                     vfloat(std::ldexp(1.f, -24))));
+  REQUIRE(psimd::all(psimd::fnma(vfloat(x), vfloat(x), vfloat(-y)) ==
+                     vfloat(-std::ldexp(1.f, -24))));
+  REQUIRE(psimd::all(psimd::fnms(vfloat(x), vfloat(x), vfloat(y)) ==
+                     vfloat(-std::ldexp(1.f, -24))));
+
+  const double dx = 1.0 + std::ldexp(1.0, -27);
+  const double dy = -(1.0 + std::ldexp(1.0, -26));
+
+  REQUIRE(psimd::all(psimd::fma(psimd::pack<double, 4>(dx),
+                                psimd::pack<double, 4>(dx),
+                                psimd::pack<double, 4>(dy)) ==
+                     psimd::pack<double, 4>(std::ldexp(1.0, -54))));
 }
 
 TEST_SUITE_END();
@@ -446,6 +1235,339 @@ TEST_CASE("select()")
   REQUIRE(psimd::any(v2     != expected));
 }
 
+TEST_CASE("bitmask<> conversions")
+{
+  vmask m(0);
+  m[1] = 1;
+  m[2] = 7;
+
+  auto bm = psimd::to_bitmask(m);
+
+  REQUIRE(bm.bits == 0x6);
+  REQUIRE(!bm[0]);
+  REQUIRE(bm[1]);
+  REQUIRE(bm[2]);
+
+  REQUIRE(psimd::all(psimd::to_mask(bm) == psimd::to_mask(bm && bm)));
+  REQUIRE(psimd::to_mask(bm)[1] == int(0xFFFFFFFF));
+  REQUIRE(psimd::to_mask(bm)[0] == 0);
+}
+
+template <int W>
+inline void check_double_bitmask_conversions()
+{
+  using vdouble = psimd::pack<double, W>;
+
+  vdouble v;
+  for (int i = 0; i < W; ++i)
+    v[i] = double(i);
+
+  // lanes 1, 3, 5, ... compare true
+  const auto m  = (v * 0.5) != psimd::floor(vdouble(v * 0.5));
+  const auto bm = psimd::to_bitmask(m);
+
+  for (int i = 0; i < W; ++i)
+    REQUIRE(bm[i] == (i % 2 == 1));
+
+  const psimd::mask_for<double, W> back = psimd::to_mask<double>(bm);
+
+  for (int i = 0; i < W; ++i)
+    REQUIRE(back[i] == (i % 2 == 1 ? -1ll : 0ll));
+
+  REQUIRE(psimd::all(psimd::select(back, v, vdouble(-1.0)) ==
+                     psimd::select(m, v, vdouble(-1.0))));
+  REQUIRE(psimd::all(psimd::to_mask<float>(psimd::bitmask<W>(true)) != 0));
+}
+
+TEST_CASE("bitmask<> conversions of double masks")
+{
+  check_double_bitmask_conversions<2>();
+  check_double_bitmask_conversions<4>();
+  check_double_bitmask_conversions<8>();
+  check_double_bitmask_conversions<16>();
+}
+
+TEST_CASE("bitmask<> any()/none()/all()")
+{
+  psimd::bitmask<vint::static_size> m(false);
+  REQUIRE(psimd::none(m));
+  m.set(0, true);
+  REQUIRE(psimd::any(m));
+  REQUIRE(!psimd::all(m));
+  REQUIRE(psimd::all(m || !m));
+  REQUIRE(psimd::none(m && !m));
+
+  psimd::bitmask<3> m3(true);
+  REQUIRE(psimd::all(m3));
+  REQUIRE(m3.bits == 0x7);
+  REQUIRE(psimd::none(!m3));
+}
+
+TEST_CASE("bitmask<> select()/foreach_active()")
+{
+  psimd::bitmask<4> m(false);
+  m.set(0, true);
+  m.set(2, true);
+
+  psimd::pack<int, 4> v1(0);
+  psimd::pack<int, 4> v2(2);
+
+  auto result = psimd::select(m, v1, v2);
+
+  psimd::pack<int, 4> expected;
+  expected[0] = 0;
+  expected[1] = 2;
+  expected[2] = 0;
+  expected[3] = 2;
+
+  REQUIRE(psimd::all(result == expected));
+
+  psimd::foreach_active(m, v2, [](int &v){ v = 0; });
+
+  REQUIRE(psimd::all(v2 == expected));
+
+  vfloat f1(1.f), f2(2.f);
+  auto bm = psimd::to_bitmask(f1 < vfloat(2.f));
+  REQUIRE(psimd::all(psimd::select(bm, f1, f2) == f1));
+}
+
+template <int W>
+inline void check_bitwise_reductions()
+{
+  psimd::pack<int, W> p;
+  psimd::mask<W> m;
+
+  int all_and = ~0, all_or = 0, all_xor = 0, masked_or = 0;
+
+  for (int i = 0; i < W; ++i) {
+    p[i] = ~(1 << (i % 31)) ^ (i * 0x10001);
+    m[i] = i % 2;
+
+    all_and &= p[i];
+    all_or  |= p[i];
+    all_xor ^= p[i];
+    if (m[i])
+      masked_or |= p[i];
+  }
+
+  REQUIRE(psimd::reduce_and(p) == all_and);
+  REQUIRE(psimd::reduce_or(p)  == all_or);
+  REQUIRE(psimd::reduce_xor(p) == all_xor);
+  REQUIRE(psimd::reduce_or(p, m) == masked_or);
+  REQUIRE(psimd::reduce_and(p, psimd::mask<W>(0)) == ~0);
+}
+
+template <typename T, int W, typename OP, typename SCALAR_OP>
+inline void check_scan(const psimd::pack<T, W> &p,
+                       const psimd::mask<W> &heads,
+                       OP op, SCALAR_OP scalar_op, T identity)
+{
+  const psimd::pack<T, W> inclusive = psimd::inclusive_scan(p, op);
+  const psimd::pack<T, W> exclusive = psimd::exclusive_scan(p, op);
+  const psimd::pack<T, W> seg_inclusive = psimd::inclusive_scan(p, heads, op);
+  const psimd::pack<T, W> seg_exclusive = psimd::exclusive_scan(p, heads, op);
+
+  T running = identity, segment = identity;
+
+  for (int i = 0; i < W; ++i) {
+    CAPTURE(i);
+    if (heads[i])
+      segment = identity;
+
+    REQUIRE(exclusive[i] == running);
+    REQUIRE(seg_exclusive[i] == segment);
+
+    running = scalar_op(running, p[i]);
+    segment = scalar_op(segment, p[i]);
+
+    REQUIRE(inclusive[i] == running);
+    REQUIRE(seg_inclusive[i] == segment);
+  }
+}
+
+TEST_CASE_TEMPLATE("inclusive_scan()/exclusive_scan()", PACK_T, all_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  psimd::pack<T, W> p;
+  psimd::mask<W> heads;
+
+  for (int i = 0; i < W; ++i) {
+    p[i] = T(((i * 5) % 7) - 3);
+    heads[i] = (i % 5 == 0) || i == 3;
+  }
+
+  using limits = std::numeric_limits<T>;
+  const T lowest  = limits::has_infinity ? -limits::infinity() :
+                                           limits::lowest();
+  const T highest = limits::has_infinity ? limits::infinity() : limits::max();
+
+  check_scan(p, heads, psimd::plus(),
+             [](T a, T b) { return a + b; }, T(0));
+  check_scan(p, heads, psimd::minimum(),
+             [](T a, T b) { return std::min(a, b); }, highest);
+  check_scan(p, heads, psimd::maximum(),
+             [](T a, T b) { return std::max(a, b); }, lowest);
+
+  // the default operation is a sum
+  REQUIRE(psimd::all(psimd::inclusive_scan(p) ==
+                     psimd::inclusive_scan(p, psimd::plus())));
+  REQUIRE(psimd::all(psimd::exclusive_scan(p, heads) ==
+                     psimd::exclusive_scan(p, heads, psimd::plus())));
+}
+
+TEST_CASE_TEMPLATE(
+    "permute()/broadcast()/rotate_*()/shift_lanes()/reverse()",
+    PACK_T, all_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  psimd::pack<T, W> p;
+  psimd::pack<int, W> indices;
+
+  for (int i = 0; i < W; ++i) {
+    p[i] = T(i + 1);
+    indices[i] = (i * 3 + 1) % W;
+  }
+
+  const psimd::pack<T, W> permuted  = psimd::permute(p, indices);
+  const psimd::pack<T, W> broadcast = psimd::broadcast<W - 1>(p);
+  const psimd::pack<T, W> left      = psimd::rotate_left<1>(p);
+  const psimd::pack<T, W> right     = psimd::rotate_right<W + 2>(p);
+  const psimd::pack<T, W> up        = psimd::shift_lanes<2>(p);
+  const psimd::pack<T, W> down      = psimd::shift_lanes<-1>(p);
+  const psimd::pack<T, W> reversed  = psimd::reverse(p);
+
+  for (int i = 0; i < W; ++i) {
+    CAPTURE(i);
+    REQUIRE(permuted[i] == p[indices[i]]);
+    REQUIRE(broadcast[i] == p[W - 1]);
+    REQUIRE(left[i] == p[(i + 1) % W]);
+    REQUIRE(right[i] == p[(i + W - 2 % W) % W]);
+    REQUIRE(up[i] == (i >= 2 ? p[i - 2] : T(0)));
+    REQUIRE(down[i] == (i + 1 < W ? p[i + 1] : T(0)));
+    REQUIRE(reversed[i] == p[W - 1 - i]);
+  }
+
+  REQUIRE(psimd::all(psimd::rotate_left<W>(p) == p));
+  REQUIRE(psimd::all(psimd::rotate_right<-1>(p) == left));
+  REQUIRE(psimd::all(psimd::shift_lanes<0>(p) == p));
+  REQUIRE(psimd::all(psimd::shift_lanes<W>(p) == T(0)));
+  REQUIRE(psimd::all(psimd::shift_lanes<-W>(p) == T(0)));
+}
+
+TEST_CASE("shuffle<>()")
+{
+  psimd::pack<float, 4> f4(0.f);
+  psimd::pack<int, 8> i8(0);
+  psimd::pack<double, 2> d2(0.0);
+
+  for (int i = 0; i < 8; ++i) {
+    if (i < 4)
+      f4[i] = float(i);
+    if (i < 2)
+      d2[i] = double(i);
+    i8[i] = i * 10;
+  }
+
+  const auto sf4 = psimd::shuffle<3, 3, 0, 1>(f4);
+  REQUIRE(sf4[0] == 3.f);
+  REQUIRE(sf4[1] == 3.f);
+  REQUIRE(sf4[2] == 0.f);
+  REQUIRE(sf4[3] == 1.f);
+
+  const auto si8 = psimd::shuffle<7, 6, 5, 4, 0, 0, 2, 1>(i8);
+  const int expected[8] = {70, 60, 50, 40, 0, 0, 20, 10};
+  for (int i = 0; i < 8; ++i)
+    REQUIRE(si8[i] == expected[i]);
+
+  const auto sd2 = psimd::shuffle<1, 0>(d2);
+  REQUIRE(sd2[0] == 1.0);
+  REQUIRE(sd2[1] == 0.0);
+}
+
+TEST_CASE_TEMPLATE("interleave_lo()/interleave_hi()", PACK_T, even_width_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  psimd::pack<T, W> a, b;
+
+  for (int i = 0; i < W; ++i) {
+    a[i] = T(i);
+    b[i] = T(-i - 1);
+  }
+
+  const psimd::pack<T, W> lo = psimd::interleave_lo(a, b);
+  const psimd::pack<T, W> hi = psimd::interleave_hi(a, b);
+
+  for (int i = 0; i < W / 2; ++i) {
+    CAPTURE(i);
+    REQUIRE(lo[2 * i] == a[i]);
+    REQUIRE(lo[2 * i + 1] == b[i]);
+    REQUIRE(hi[2 * i] == a[W / 2 + i]);
+    REQUIRE(hi[2 * i + 1] == b[W / 2 + i]);
+  }
+}
+
+TEST_CASE_TEMPLATE(
+    "reduce_add()/reduce_mul()/reduce_min()/reduce_max()",
+    PACK_T, all_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  psimd::pack<T, W> p;
+  psimd::mask_for<T, W> m;
+
+  T sum = 0, product = 1, low = T(W), high = T(-W);
+  T masked_sum = 0, masked_low = std::numeric_limits<T>::max();
+
+  for (int i = 0; i < W; ++i) {
+    p[i] = T(((i * 7) % W) - W / 2);
+    m[i] = i % 3 == 0;
+
+    sum += p[i];
+    low  = std::min(low, p[i]);
+    high = std::max(high, p[i]);
+    if (m[i]) {
+      masked_sum += p[i];
+      masked_low  = std::min(masked_low, p[i]);
+    }
+  }
+
+  const psimd::pack<T, W> twos = psimd::select(m, psimd::pack<T, W>(T(2)),
+                                                   psimd::pack<T, W>(T(1)));
+  for (int i = 0; i < W; ++i)
+    product *= twos[i];
+
+  REQUIRE(psimd::reduce_add(p) == sum);
+  REQUIRE(psimd::reduce_mul(twos) == product);
+  REQUIRE(psimd::reduce_min(p) == low);
+  REQUIRE(psimd::reduce_max(p) == high);
+
+  REQUIRE(psimd::reduce_add(p, m) == masked_sum);
+  REQUIRE(psimd::reduce_mul(twos, m) == product);
+  REQUIRE(psimd::reduce_min(p, m) == masked_low);
+
+  // no active lane leaves the identity
+  const psimd::mask_for<T, W> none(0);
+  REQUIRE(psimd::reduce_add(p, none) == T(0));
+  REQUIRE(psimd::reduce_mul(p, none) == T(1));
+  REQUIRE(psimd::reduce_max(p, none) < T(-W));
+}
+
+TEST_CASE("reduce_and()/reduce_or()/reduce_xor()")
+{
+  check_bitwise_reductions<3>();
+  check_bitwise_reductions<4>();
+  check_bitwise_reductions<8>();
+  check_bitwise_reductions<16>();
+  check_bitwise_reductions<4 * psimd::native_width<int>()>();
+}
+
 TEST_SUITE_END();
 
 // pack<> memory operations ///////////////////////////////////////////////////
@@ -454,20 +1576,57 @@ TEST_SUITE_BEGIN("memory operations");
 
 TEST_CASE("unmasked load()")
 {
-  std::vector<int> values(DEFAULT_WIDTH);
+  std::vector<int> values(vint::static_size);
   std::fill(values.begin(), values.end(), 5);
 
   auto v1 = psimd::load<vint>(values.data());
   REQUIRE(psimd::all(v1 == 5));
 }
 
+TEST_CASE_TEMPLATE(
+    "load_aligned()/load_unaligned()/store_aligned()/store_unaligned()",
+    PACK_T, all_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  using pack_t = psimd::pack<T, W>;
+
+  pack_t p;
+  for (int i = 0; i < W; ++i)
+    p[i] = T(i * 3 + 1);
+
+  // packs in an array are aligned to static_alignment
+  pack_t aligned[2];
+  T unaligned[2 * W + 1];
+
+  psimd::store_aligned(p, &aligned[0]);
+  psimd::store_stream(p, &aligned[1]);
+  psimd::stream_fence();
+  psimd::store_unaligned(p, unaligned + 1);
+
+  const pack_t from_aligned   = psimd::load_aligned<pack_t>(&aligned[0]);
+  const pack_t from_stream    = psimd::load_aligned<pack_t>(&aligned[1]);
+  const pack_t from_unaligned = psimd::load_unaligned<pack_t>(unaligned + 1);
+
+  for (int i = 0; i < W; ++i) {
+    CAPTURE(i);
+    REQUIRE(aligned[0][i] == p[i]);
+    REQUIRE(aligned[1][i] == p[i]);
+    REQUIRE(unaligned[i + 1] == p[i]);
+    REQUIRE(from_aligned[i] == p[i]);
+    REQUIRE(from_stream[i] == p[i]);
+    REQUIRE(from_unaligned[i] == p[i]);
+  }
+}
+
 TEST_CASE("unmasked gather()")
 {
-  std::vector<int> values(DEFAULT_WIDTH);
+  std::vector<int> values(vint::static_size);
   std::fill(values.begin(), values.end(), 4);
 
   vint offset;
-  for (int i = 0; i < DEFAULT_WIDTH; ++i)
+  for (int i = 0; i < vint::static_size; ++i)
     offset[i] = i;
 
   auto result = psimd::gather<vint>(values.data(), offset);
@@ -475,9 +1634,249 @@ TEST_CASE("unmasked gather()")
   REQUIRE(psimd::all(result == 4));
 }
 
+TEST_CASE("bitmask<> gather()")
+{
+  std::vector<double> values(vint::static_size, 4.0);
+
+  vint offset;
+  psimd::bitmask<vint::static_size> m(false);
+  for (int i = 0; i < vint::static_size; ++i) {
+    offset[i] = i;
+    m.set(i, i % 2 == 0);
+  }
+
+  using vdouble = psimd::pack<double, vint::static_size>;
+
+  auto result = psimd::gather<vdouble>(values.data(), offset, m);
+
+  for (int i = 0; i < vint::static_size; ++i)
+    REQUIRE(result[i] == (m[i] ? 4.0 : 0.0));
+}
+
+TEST_CASE("bitmask<> scatter() to shared offsets")
+{
+  constexpr int W = vint::static_size;
+
+  // pairs of lanes share an offset, lanes with i % 3 == 1 are inactive
+  vint offset;
+  psimd::bitmask<W> m(false);
+  for (int i = 0; i < W; ++i) {
+    offset[i] = i / 2;
+    m.set(i, i % 3 != 1);
+  }
+
+  vint p;
+  for (int i = 0; i < W; ++i)
+    p[i] = i;
+
+  std::vector<int> values(W, -1);
+  psimd::scatter(p, values.data(), offset, m);
+
+  std::vector<int> scaled(W, -1);
+  psimd::scatter<int(sizeof(int))>(p, scaled.data(), offset, m);
+
+  // the highest active lane of each offset is stored last
+  std::vector<int> expected(W, -1);
+  for (int i = 0; i < W; ++i)
+    if (m[i])
+      expected[offset[i]] = i;
+
+  REQUIRE(values == expected);
+  REQUIRE(scaled == expected);
+}
+
+template <typename T, int W, typename OFFSET_T, int SCALE>
+inline void check_gather_scatter_scaled()
+{
+  // element offsets in units of SCALE bytes
+  constexpr int stride = SCALE < int(sizeof(T)) ? int(sizeof(T)) / SCALE : 1;
+  constexpr int size   = 4 * W;
+
+  std::vector<T> values(size * stride * SCALE / int(sizeof(T)) + 1);
+  for (int i = 0; i < int(values.size()); ++i)
+    values[i] = T(3 * i + 1);
+
+  psimd::pack<OFFSET_T, W> o;
+  psimd::mask<W> m;
+  std::vector<int> element(W);
+
+  for (int i = 0; i < W; ++i) {
+    o[i]       = OFFSET_T(((5 * i + 1) % size) * stride);
+    m[i]       = (i % 3 == 0) || i == W - 1;
+    element[i] = int(o[i]) * SCALE / int(sizeof(T));
+  }
+
+  using pack_t = psimd::pack<T, W>;
+
+  const auto gathered = psimd::gather<pack_t, SCALE>(values.data(), o);
+  const auto masked   = psimd::gather<pack_t, SCALE>(values.data(), o, m);
+
+  const auto masked_64 = psimd::gather<pack_t, SCALE>(
+      values.data(), o, psimd::mask_cast<T>(m));
+  const auto masked_bits = psimd::gather<pack_t, SCALE>(
+      values.data(), o, psimd::to_bitmask(m));
+
+  for (int i = 0; i < W; ++i) {
+    CAPTURE(i);
+    REQUIRE(gathered[i] == values[element[i]]);
+    REQUIRE(masked[i] == (m[i] ? values[element[i]] : T(0)));
+    REQUIRE(masked_64[i] == masked[i]);
+    REQUIRE(masked_bits[i] == masked[i]);
+  }
+
+  const T sentinel = T(-7);
+
+  std::vector<T> scattered(values.size(), sentinel);
+  psimd::scatter<SCALE>(gathered, scattered.data(), o);
+
+  std::vector<T> masked_scattered(values.size(), sentinel);
+  psimd::scatter<SCALE>(gathered, masked_scattered.data(), o, m);
+
+  std::vector<T> bits_scattered(values.size(), sentinel);
+  psimd::scatter<SCALE>(gathered, bits_scattered.data(), o,
+                        psimd::to_bitmask(m));
+
+  std::vector<T> expected(values.size(), sentinel);
+  std::vector<T> masked_expected(values.size(), sentinel);
+  for (int i = 0; i < W; ++i) {
+    expected[element[i]] = gathered[i];
+    if (m[i])
+      masked_expected[element[i]] = gathered[i];
+  }
+
+  REQUIRE(scattered == expected);
+  REQUIRE(masked_scattered == masked_expected);
+  REQUIRE(bits_scattered == masked_expected);
+}
+
+TEST_CASE_TEMPLATE("gather()/scatter() with scales and 64 bit offsets", PACK_T,
+                   all_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  check_gather_scatter_scaled<T, W, int, 1>();
+  check_gather_scatter_scaled<T, W, int, int(sizeof(T))>();
+  check_gather_scatter_scaled<T, W, int, 8>();
+  check_gather_scatter_scaled<T, W, long long, 1>();
+  check_gather_scatter_scaled<T, W, long long, int(sizeof(T))>();
+  check_gather_scatter_scaled<T, W, long long, 8>();
+
+  // unscaled forms index elements, as with 64 bit offsets
+  std::vector<T> values(2 * W);
+  for (int i = 0; i < 2 * W; ++i)
+    values[i] = T(i);
+
+  psimd::pack<long long, W> o;
+  for (int i = 0; i < W; ++i)
+    o[i] = 2 * W - 1 - i;
+
+  const auto p = psimd::gather<psimd::pack<T, W>>(values.data(), o);
+  for (int i = 0; i < W; ++i)
+    REQUIRE(p[i] == T(2 * W - 1 - i));
+
+  std::vector<T> scattered(2 * W, T(0));
+  psimd::scatter(p, scattered.data(), o);
+  for (int i = 0; i < 2 * W; ++i)
+    REQUIRE(scattered[i] == (i < W ? T(0) : values[i]));
+}
+
+template <typename T, int W, typename OFFSET_T>
+inline void check_scatter_reduce_offsets(int groups)
+{
+  // 'groups' distinct offsets, each shared by several lanes in no order
+  psimd::pack<OFFSET_T, W> o;
+  psimd::pack<T, W> values;
+  psimd::mask<W> m;
+
+  for (int i = 0; i < W; ++i) {
+    o[i]      = OFFSET_T(((i * 7) % groups) * 3);
+    values[i] = T((i * 5) % 11 + 1);
+    m[i]      = (i % 4 != 1);
+  }
+
+  const int size = 3 * groups;
+
+  std::vector<T> sum(size), minimum(size), maximum(size);
+  for (int i = 0; i < size; ++i) {
+    sum[i]     = T(i);
+    minimum[i] = T(6);
+    maximum[i] = T(6);
+  }
+
+  auto expected_sum = sum, expected_min = minimum, expected_max = maximum;
+  auto masked_sum   = sum, expected_masked_sum = sum;
+
+  for (int i = 0; i < W; ++i) {
+    expected_sum[o[i]] += values[i];
+    expected_min[o[i]] = std::min(expected_min[o[i]], values[i]);
+    expected_max[o[i]] = std::max(expected_max[o[i]], values[i]);
+    if (m[i])
+      expected_masked_sum[o[i]] += values[i];
+  }
+
+  psimd::scatter_add(sum.data(), o, values);
+  psimd::scatter_min(minimum.data(), o, values);
+  psimd::scatter_max(maximum.data(), o, values);
+  psimd::scatter_add(masked_sum.data(), o, values, m);
+
+  REQUIRE(sum == expected_sum);
+  REQUIRE(minimum == expected_min);
+  REQUIRE(maximum == expected_max);
+  REQUIRE(masked_sum == expected_masked_sum);
+
+  // a mask of the values' lane width
+  auto masked_min = std::vector<T>(size, T(6));
+  auto expected_masked_min = masked_min;
+  for (int i = 0; i < W; ++i)
+    if (m[i])
+      expected_masked_min[o[i]] = std::min(expected_masked_min[o[i]],
+                                           values[i]);
+
+  psimd::scatter_min(masked_min.data(), o, values, psimd::mask_cast<T>(m));
+  REQUIRE(masked_min == expected_masked_min);
+}
+
+TEST_CASE_TEMPLATE("scatter_add()/scatter_min()/scatter_max()", PACK_T,
+                   all_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  for (int groups : {1, 2, 3, W / 2 + 1, W}) {
+    CAPTURE(groups);
+    check_scatter_reduce_offsets<T, W, int>(groups);
+    check_scatter_reduce_offsets<T, W, long long>(groups);
+  }
+}
+
+TEST_CASE("prefetch()/prefetch_gather()")
+{
+  // prefetches are hints without visible effect: these only have to compile
+  // and leave memory unchanged
+  std::vector<float> values(1024, 2.f);
+
+  psimd::prefetch(values.data());
+  psimd::prefetch<psimd::cache_level::l2>(values.data() + 16);
+  psimd::prefetch<psimd::cache_level::l3>(values.data() + 32);
+  psimd::prefetch<psimd::cache_level::non_temporal>(values.data() + 48);
+
+  vint offsets;
+  for (int i = 0; i < vint::static_size; ++i)
+    offsets[i] = (i * 37) % 1024;
+
+  psimd::prefetch_gather(values.data(), offsets);
+  psimd::prefetch_gather<psimd::cache_level::l2>(values.data(), offsets,
+                                                 vmask(-1));
+  psimd::prefetch_gather(values.data(), offsets,
+                         psimd::bitmask<vint::static_size>(false));
+
+  REQUIRE(psimd::all(psimd::gather<vfloat>(values.data(), offsets) == 2.f));
+}
+
 TEST_CASE("unmasked store()")
 {
-  std::vector<int> values(DEFAULT_WIDTH);
+  std::vector<int> values(vint::static_size);
 
   vint v1(7);
 
@@ -488,14 +1887,133 @@ TEST_CASE("unmasked store()")
   });
 }
 
+TEST_CASE("bitmask<> load()/store()")
+{
+  std::vector<int> values(vint::static_size, 3);
+
+  psimd::bitmask<vint::static_size> m(false);
+  m.set(1, true);
+
+  vint v1(9);
+  psimd::store(v1, values.data(), m);
+
+  REQUIRE(values[0] == 3);
+  REQUIRE(values[1] == 9);
+
+  vint v2(0);
+  v2 = psimd::load<vint>(values.data(), !m);
+
+  REQUIRE(v2[0] == 3);
+  REQUIRE(v2[1] == 0);
+}
+
+TEST_CASE_TEMPLATE("bitmask<> select()/store() of every pack type", PACK_T,
+                   all_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  psimd::pack<T, W> t, f;
+  psimd::bitmask<W> m(false);
+
+  for (int i = 0; i < W; ++i) {
+    t[i] = T(i + 1);
+    f[i] = T(-i - 1);
+    m.set(i, i % 3 != 1);
+  }
+
+  const auto s = psimd::select(m, t, f);
+
+  std::vector<T> values(W + 1, T(7));
+  psimd::store(t, values.data() + 1, m);
+
+  REQUIRE(values[0] == T(7));
+
+  for (int i = 0; i < W; ++i) {
+    CAPTURE(i);
+    REQUIRE(s[i] == (m[i] ? t[i] : f[i]));
+    REQUIRE(values[i + 1] == (m[i] ? t[i] : T(7)));
+  }
+}
+
+TEST_CASE_TEMPLATE("compress_store()/expand_load()", PACK_T, all_packs)
+{
+  using T = typename PACK_T::type;
+  constexpr int W = PACK_T::static_size;
+
+  psimd::pack<T, W> p;
+  psimd::mask<W> m;
+
+  for (int i = 0; i < W; ++i) {
+    p[i] = T(i + 1);
+    m[i] = (i % 3 == 0) || i == W - 1;
+  }
+
+  const T sentinel = T(-7);
+
+  std::vector<T> compressed(W + 1, sentinel);
+  const int count = psimd::compress_store(p, m, compressed.data());
+
+  std::vector<T> expected;
+  for (int i = 0; i < W; ++i)
+    if (m[i])
+      expected.push_back(p[i]);
+
+  REQUIRE(count == int(expected.size()));
+  for (int i = 0; i < count; ++i)
+    REQUIRE(compressed[i] == expected[i]);
+  for (int i = count; i <= W; ++i)
+    REQUIRE(compressed[i] == sentinel);
+
+  const auto expanded =
+      psimd::expand_load<psimd::pack<T, W>>(compressed.data(), m);
+
+  for (int i = 0; i < W; ++i) {
+    CAPTURE(i);
+    REQUIRE(expanded[i] == (m[i] ? p[i] : T(0)));
+  }
+
+  // all or none active
+  REQUIRE(psimd::compress_store(p, psimd::mask<W>(0), compressed.data()) == 0);
+  REQUIRE(compressed[0] == expected[0]);
+  REQUIRE(psimd::compress_store(p, psimd::mask<W>(-1), compressed.data()) == W);
+  REQUIRE(psimd::all(psimd::load<psimd::pack<T, W>>(compressed.data()) == p));
+}
+
+TEST_CASE("copy_if()")
+{
+  for (int size : {0, 1, 7, 64, 1000, 1003}) {
+    CAPTURE(size);
+
+    std::vector<float> values(size);
+    for (int i = 0; i < size; ++i)
+      values[i] = float((i * 37) % 101) - 50.f;
+
+    std::vector<float> expected(size), result(size + 1, -1.f);
+
+    auto expected_end = std::copy_if(values.begin(), values.end(),
+                                     expected.begin(),
+                                     [](float v) { return v > 0.f; });
+    expected.erase(expected_end, expected.end());
+
+    float *result_end =
+        psimd::copy_if(values.data(), values.data() + size, result.data(),
+                       [](const vfloat &v) { return v > 0.f; });
+
+    REQUIRE(result_end - result.data() == int(expected.size()));
+    REQUIRE(std::equal(expected.begin(), expected.end(), result.begin()));
+    REQUIRE(*result_end == -1.f);
+  }
+}
+
 TEST_CASE("unmasked scatter()")
 {
-  std::vector<int> values(DEFAULT_WIDTH);
+  std::vector<int> values(vint::static_size);
 
   vint v1(5);
 
   vint offset;
-  for (int i = 0; i < DEFAULT_WIDTH; ++i)
+  for (int i = 0; i < vint::static_size; ++i)
     offset[i] = i;
 
   psimd::scatter(v1, values.data(), offset);
@@ -505,4 +2023,297 @@ TEST_CASE("unmasked scatter()")
   });
 }
 
+TEST_SUITE_END();
+
+#ifdef PSIMD_LAZY
+
+// lazy expressions ///////////////////////////////////////////////////////////
+
+TEST_SUITE_BEGIN("lazy expressions");
+
+using vlazy = psimd::pack<float, 5>;
+
+TEST_CASE("operators build expressions")
+{
+  vlazy a(2.f), b(3.f), c(1.f);
+
+  static_assert(psimd::detail::is_expression<decltype(a * b + c)>::value,
+                "a * b + c is an expression");
+  static_assert(psimd::detail::is_expression<decltype(2.f * a - 1)>::value,
+                "scalar operands are part of the expression");
+
+  vlazy r1 = a * b + c;
+  vlazy r2 = c - a * b;
+  vlazy r3 = (a + b) * (a - b) / c;
+  vlazy r4 = 2.f * a - 1;
+
+  REQUIRE(psimd::all(r1 == vlazy(7.f)));
+  REQUIRE(psimd::all(r2 == vlazy(-5.f)));
+  REQUIRE(psimd::all(r3 == vlazy(-5.f)));
+  REQUIRE(psimd::all(r4 == vlazy(3.f)));
+}
+
+TEST_CASE("expressions assigned to an operand")
+{
+  vlazy a(2.f), b(3.f);
+
+  a = a * a + b;
+  REQUIRE(psimd::all(a == vlazy(7.f)));
+
+  a += b;
+  REQUIRE(psimd::all(a == vlazy(10.f)));
+}
+
+TEST_CASE("expressions in comparisons and select()")
+{
+  vlazy a(2.f), b(3.f);
+
+  REQUIRE(psimd::all(a * b == 6.f));
+  REQUIRE(psimd::all(a + b > a * a));
+  REQUIRE(psimd::all(-(a - b) == vlazy(1.f)));
+
+  vlazy r = psimd::select(a < b, a + b, b - a);
+  REQUIRE(psimd::all(r == vlazy(5.f)));
+}
+
+#if PSIMD_NATIVE_SSE2
+TEST_CASE("native packs keep their own operators")
+{
+  using vnative = psimd::pack<float>;
+
+  vnative a(2.f), b(3.f);
+
+  static_assert(std::is_same<decltype(a * b + a), vnative>::value,
+                "native pack operators are not lazy");
+  static_assert(std::is_same<decltype(2 * a - 1.f), vnative>::value,
+                "mixed scalar operands on native packs are not lazy");
+
+  REQUIRE(psimd::all(a * b + a == vnative(8.f)));
+}
+#endif
+
+#if PSIMD_NATIVE_FMA
+TEST_CASE("a * b + c is fused")
+{
+  const float x = 1.f + std::ldexp(1.f, -12);
+  const float y = -(1.f + std::ldexp(1.f, -11));
+
+  vlazy a(x), c(y);
+  vlazy r = a * a + c;
+
+  REQUIRE(r[0] == std::fma(x, x, y));
+  REQUIRE(r[0] != 0.f);
+}
+#endif
+
+TEST_SUITE_END();
+
+#endif
+
+// pack<> native backends /////////////////////////////////////////////////////
+
+TEST_SUITE_BEGIN("native backends");
+
+template <typename T, int W>
+inline void check_native_float_ops()
+{
+  using vtype = psimd::pack<T, W>;
+
+  vtype v1(T(4)), v2(T(2));
+
+  REQUIRE(psimd::all((v1 + v2) == vtype(T(6))));
+  REQUIRE(psimd::all((v1 - v2) == vtype(T(2))));
+  REQUIRE(psimd::all((v1 * v2) == vtype(T(8))));
+  REQUIRE(psimd::all((v1 / v2) == vtype(T(2))));
+  REQUIRE(psimd::all((T(1) - v1) == vtype(T(-3))));
+  REQUIRE(psimd::all(-v1 == vtype(T(-4))));
+
+  // scalar operands of other types than T //
+
+  REQUIRE(psimd::all((v1 * 2) == vtype(T(8))));
+  REQUIRE(psimd::all((v1 + 1.0) == vtype(T(5))));
+  REQUIRE(psimd::all((1.0f - v1) == vtype(T(-3))));
+  REQUIRE(psimd::all((v1 / 2L) == v2));
+  REQUIRE(psimd::all(v1 > 3));
+  REQUIRE(psimd::all(2 == v2));
+
+  REQUIRE(psimd::all(psimd::sqrt(v1) == v2));
+  REQUIRE(psimd::all(psimd::abs(-v1) == v1));
+  REQUIRE(psimd::all(psimd::max(v1, v2) == v1));
+  REQUIRE(psimd::all(psimd::min(v1, v2) == v2));
+}
+
+template <int W>
+inline void check_native_int_ops()
+{
+  using vtype = psimd::pack<int, W>;
+  using vmask = psimd::mask<W>;
+
+  vtype v1(4), v2(2);
+
+  REQUIRE(psimd::all((v1 + v2) == vtype(6)));
+  REQUIRE(psimd::all((v1 - v2) == vtype(2)));
+  REQUIRE(psimd::all((v1 * v2) == vtype(8)));
+  REQUIRE(psimd::all((v1 << 1) == vtype(8)));
+  REQUIRE(psimd::all((-v1 >> 1) == vtype(-2)));
+  REQUIRE(psimd::all((v1 ^ v2) == vtype(6)));
+
+  // scalar operands of other types than int //
+
+  REQUIRE(psimd::all((v1 + 2L) == vtype(6)));
+  REQUIRE(psimd::all((v1 << 1u) == vtype(8)));
+  REQUIRE(psimd::all((short(2) * v1) == vtype(8)));
+  REQUIRE(psimd::all(v1 >= 4L));
+
+  REQUIRE(psimd::all(v1 != v2));
+  REQUIRE(psimd::all(v2 < v1));
+  REQUIRE(psimd::all(v2 <= v1));
+  REQUIRE(psimd::all(v1 > v2));
+  REQUIRE(psimd::all(v1 >= v2));
+  REQUIRE(psimd::none(v1 == v2));
+
+  vmask m(0);
+  m[1] = 1;
+
+  REQUIRE(psimd::any(m));
+  REQUIRE(!psimd::all(m));
+  REQUIRE(psimd::all(m || !m));
+  REQUIRE(psimd::none(m && !m));
+
+  auto result = psimd::select(m, v1, v2);
+  REQUIRE(result[0] == 2);
+  REQUIRE(result[1] == 4);
+
+  auto fresult = psimd::select(m, v1.template as<float>(),
+                                  v2.template as<float>());
+  REQUIRE(fresult[0] == 2.f);
+  REQUIRE(fresult[1] == 4.f);
+
+  std::vector<int> values(W, 0);
+  psimd::store(v1, values.data(), m);
+  REQUIRE(values[0] == 0);
+  REQUIRE(values[1] == 4);
+}
+
+template <int W>
+inline void check_native_long_long_ops()
+{
+  using vtype = psimd::pack<long long, W>;
+  using vmask = psimd::mask_for<long long, W>;
+
+  const long long big = 0x123456789all;
+
+  vtype v1(big), v2(-big);
+
+  REQUIRE(psimd::all((v1 + v2) == vtype(0)));
+  REQUIRE(psimd::all((v1 - v2) == vtype(2 * big)));
+  REQUIRE(psimd::all((v1 << 20) == vtype(big << 20)));
+  REQUIRE(psimd::all((v1 >> 3) == vtype(big >> 3)));
+  REQUIRE(psimd::all((v2 >> 3) == vtype(-big >> 3)));
+  REQUIRE(psimd::all((v2 >> 0) == v2));
+  REQUIRE(psimd::all((v2 >> 63) == vtype(-1)));
+  REQUIRE(psimd::all((v1 ^ v2) == vtype(big ^ -big)));
+  REQUIRE(psimd::all((v1 & v2) == vtype(big & -big)));
+  REQUIRE(psimd::all((v1 | v2) == vtype(big | -big)));
+
+  // scalar operands of other types than long long //
+
+  REQUIRE(psimd::all((v1 + 1) == vtype(big + 1)));
+  REQUIRE(psimd::all((v1 << 1u) == vtype(big << 1)));
+  REQUIRE(psimd::all(v1 >= 2));
+
+  REQUIRE(psimd::all(v1 != v2));
+  REQUIRE(psimd::all(v2 < v1));
+  REQUIRE(psimd::all(v2 <= v1));
+  REQUIRE(psimd::all(v1 > v2));
+  REQUIRE(psimd::all(v1 >= v2));
+  REQUIRE(psimd::none(v1 == v2));
+
+  vmask m(0);
+  m[1] = 1;
+
+  auto result = psimd::select(m, v1, v2);
+  REQUIRE(result[0] == -big);
+  REQUIRE(result[1] == big);
+}
+
+TEST_CASE("pack<float> operators")
+{
+  check_native_float_ops<float, 4>();
+  check_native_float_ops<float, 8>();
+  check_native_float_ops<float, 16>();
+}
+
+TEST_CASE("pack<double> operators")
+{
+  check_native_float_ops<double, 2>();
+  check_native_float_ops<double, 4>();
+  check_native_float_ops<double, 8>();
+}
+
+TEST_CASE("pack<int> operators")
+{
+  check_native_int_ops<4>();
+  check_native_int_ops<8>();
+  check_native_int_ops<16>();
+}
+
+TEST_CASE("pack<long long> operators")
+{
+  check_native_long_long_ops<2>();
+  check_native_long_long_ops<4>();
+  check_native_long_long_ops<8>();
+}
+
+TEST_CASE("register-blocked packs")
+{
+  constexpr int FW = 4 * psimd::native_width<float>();
+  constexpr int DW = 4 * psimd::native_width<double>();
+
+#if PSIMD_NATIVE_SSE2
+  static_assert(psimd::detail::is_blocked<float, FW>::value,
+                "over-wide pack<float> is register-blocked");
+  static_assert(psimd::detail::is_blocked<int, FW>::value,
+                "over-wide pack<int> is register-blocked");
+#endif
+
+  check_native_float_ops<float, FW>();
+  check_native_float_ops<double, DW>();
+  check_native_int_ops<FW>();
+}
+
+TEST_CASE("register-blocked reductions see every sub-pack")
+{
+  constexpr int W = 4 * psimd::native_width<int>();
+
+  psimd::mask<W> m(0);
+  REQUIRE(psimd::none(m));
+
+  m[W - 1] = -1;
+  REQUIRE(psimd::any(m));
+  REQUIRE(!psimd::all(m));
+
+  psimd::mask<W> all_on(-1);
+  all_on[W - 1] = 0;
+  REQUIRE(psimd::any(all_on));
+  REQUIRE(!psimd::all(all_on));
+
+  using vtype = psimd::pack<int, W>;
+
+  auto result = psimd::select(m, vtype(1), vtype(0));
+  REQUIRE(result[0] == 0);
+  REQUIRE(result[W - 1] == 1);
+}
+
+TEST_CASE("float comparisons with NaN")
+{
+  psimd::pack<float, 8> v1(std::numeric_limits<float>::quiet_NaN());
+  psimd::pack<float, 8> v2(1.f);
+
+  REQUIRE(psimd::none(v1 == v2));
+  REQUIRE(psimd::all(v1 != v2));
+  REQUIRE(psimd::none(v1 < v2));
+  REQUIRE(psimd::none(v1 >= v2));
+}
+
 TEST_SUITE_END();
\ No newline at end of file